@@ -0,0 +1,23 @@
+#-------------------------------------------------------------------------------
+# Remove the music from the header of the level ${INPUT} and write the result
+# in ${OUTPUT}. The music is the seventh line of the level; it is then played
+# by rp::music_player instead of the engine.
+#
+# Usage: cmake -DINPUT=level.cl -DOUTPUT=output.cl -P strip-level-music.cmake
+
+file( READ "${INPUT}" CONTENT )
+
+set( HEADER "" )
+
+foreach( LINE_INDEX RANGE 1 6 )
+  string( FIND "${CONTENT}" "\n" LINE_END )
+  math( EXPR LINE_END "${LINE_END} + 1" )
+  string( SUBSTRING "${CONTENT}" 0 ${LINE_END} LINE )
+  string( SUBSTRING "${CONTENT}" ${LINE_END} -1 CONTENT )
+  set( HEADER "${HEADER}${LINE}" )
+endforeach()
+
+string( FIND "${CONTENT}" "\n" LINE_END )
+string( SUBSTRING "${CONTENT}" ${LINE_END} -1 CONTENT )
+
+file( WRITE "${OUTPUT}" "${HEADER}${CONTENT}" )
@@ -14,12 +14,17 @@
 #include "launcher.hpp"
 
 #include "bear_gettext.hpp"
+#include "engine/variable/variable.hpp"
 
 #include <claw/logger.hpp>
 #include <boost/preprocessor/stringize.hpp>
 
 #include <libintl.h>
 
+#include <list>
+#include <sstream>
+#include <vector>
+
 #define STRINGIZE_HELPER(a) # a
 
 #define STRINGIZE(a) STRINGIZE_HELPER(a)
@@ -42,6 +47,45 @@ rp::launcher::launcher( int& argc, char** &argv )
 
   m_arguments.add
     ("-h", "--help", bear_gettext("Print this help screen and exit."), true);
+  m_arguments.add_long
+    ( "--benchmark-level",
+      bear_gettext("Run the given level without rendering nor sound and write "
+                   "the cost of each frame."), true, bear_gettext("file") );
+  m_arguments.add_long
+    ( "--benchmark-input",
+      bear_gettext("The inputs to replay on the cart during the benchmark."),
+      true, bear_gettext("file") );
+  m_arguments.add_long
+    ( "--benchmark-output",
+      bear_gettext("The file where the measures of the benchmark are written, "
+                   "as JSON if it ends with .json, as CSV otherwise."),
+      true, bear_gettext("file") );
+  m_arguments.add_long
+    ( "--benchmark-frames",
+      bear_gettext("The count of frames measured by the benchmark."), true,
+      bear_gettext("integer") );
+  m_arguments.add_long
+    ( "--benchmark-seed",
+      bear_gettext("The seed of the random numbers during the benchmark."),
+      true, bear_gettext("integer") );
+  m_arguments.add_long
+    ( "--capture-format",
+      bear_gettext("The format of the images of the screenshot sequence: bmp, "
+                   "png, qoi or raw."), true, bear_gettext("format") );
+  m_arguments.add_long
+    ( "--capture-threads",
+      bear_gettext("The number of threads encoding the images of the "
+                   "screenshot sequence."), true, bear_gettext("integer") );
+  m_arguments.add_long
+    ( "--population-census",
+      bear_gettext("Count the items of the levels at each iteration and write "
+                   "the highest counts in the log."), true );
+  m_arguments.add_long
+    ( "--decoration-budget",
+      bear_gettext("The maximum count of live decorations of a category in a "
+                   "level, zero for no limit. The categories are wave, "
+                   "hit_star, debris and feather. This option can be given "
+                   "several times."), true, bear_gettext("category:integer") );
   m_arguments.parse(argc, argv);
 
   if ( m_arguments.get_bool("--help") )
@@ -126,6 +170,7 @@ void rp::launcher::create_game( int& argc, char** &argv )
   const std::string data_path_argument( get_data_path_argument() );
   const std::string generic_item_argument( get_generic_items_argument() );
   const std::string rp_argument( get_rp_argument() );
+  const std::string start_level_argument( get_start_level_argument() );
 
   const char* default_args[] =
     {
@@ -151,28 +196,43 @@ void rp::launcher::create_game( int& argc, char** &argv )
       rp_argument.c_str(),
 #endif
 
-      "--start-level=level/start.cl",
+      start_level_argument.c_str(),
       NULL
     };
 
+  std::vector<const char*> benchmark_args;
+
+  if ( is_benchmark() )
+    benchmark_args.push_back( "--dumb-rendering" );
+
   // Compute the number of elements in default_args
   int default_argc(0);
   while ( default_args[ default_argc ] != NULL )
     ++default_argc;
 
-  int final_argc( argc + default_argc );
+  const int benchmark_argc( benchmark_args.size() );
+  int final_argc( argc + default_argc + benchmark_argc );
   const char** final_args = new const char*[ final_argc ];
 
   for ( int i=0; i!=default_argc; ++i )
     final_args[i] = default_args[i];
 
+  for ( int i=0; i!=benchmark_argc; ++i )
+    final_args[ default_argc + i ] = benchmark_args[i];
+
   for ( int i=0; i!=argc; ++i )
-    final_args[ default_argc + i ] = argv[i];
+    final_args[ default_argc + benchmark_argc + i ] = argv[i];
 
   try
     {
       char** engine_args = const_cast<char**>(final_args);
       m_game = new bear::engine::game( final_argc, engine_args );
+
+      if ( is_benchmark() )
+        set_benchmark_variables();
+
+      set_capture_variables();
+      set_population_variables();
     }
   catch( std::exception& e )
     {
@@ -183,6 +243,98 @@ void rp::launcher::create_game( int& argc, char** &argv )
   delete[] final_args;
 } // running_bear::create_game()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pass the options of the benchmark to the game, via the game
+ *        variables.
+ */
+void rp::launcher::set_benchmark_variables()
+{
+  std::string output( "benchmark.csv" );
+
+  if ( m_arguments.has_value( "--benchmark-output" ) )
+    output = m_arguments.get_string( "--benchmark-output" );
+
+  m_game->set_game_variable
+    ( bear::engine::variable<std::string>( "benchmark/output", output ) );
+
+  if ( m_arguments.has_value( "--benchmark-input" ) )
+    m_game->set_game_variable
+      ( bear::engine::variable<std::string>
+        ( "benchmark/input", m_arguments.get_string( "--benchmark-input" ) ) );
+
+  if ( m_arguments.only_integer_values( "--benchmark-frames" ) )
+    m_game->set_game_variable
+      ( bear::engine::variable<unsigned int>
+        ( "benchmark/frames",
+          m_arguments.get_integer( "--benchmark-frames" ) ) );
+
+  // A fixed seed makes the runs comparable.
+  unsigned int seed( 0 );
+
+  if ( m_arguments.only_integer_values( "--benchmark-seed" ) )
+    seed = m_arguments.get_integer( "--benchmark-seed" );
+
+  m_game->set_game_variable
+    ( bear::engine::variable<unsigned int>( "random_seed", seed ) );
+
+  m_game->set_sound_muted( true );
+  m_game->set_music_muted( true );
+} // launcher::set_benchmark_variables()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pass the options of the screenshot sequence to the game, via the
+ *        game variables.
+ */
+void rp::launcher::set_capture_variables()
+{
+  if ( m_arguments.has_value( "--capture-format" ) )
+    m_game->set_game_variable
+      ( bear::engine::variable<std::string>
+        ( "capture/format", m_arguments.get_string( "--capture-format" ) ) );
+
+  if ( m_arguments.only_integer_values( "--capture-threads" ) )
+    m_game->set_game_variable
+      ( bear::engine::variable<unsigned int>
+        ( "capture/threads",
+          m_arguments.get_integer( "--capture-threads" ) ) );
+} // launcher::set_capture_variables()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pass the options of the population of the levels to the game, via
+ *        the game variables.
+ */
+void rp::launcher::set_population_variables()
+{
+  if ( m_arguments.get_bool( "--population-census" ) )
+    m_game->set_game_variable
+      ( bear::engine::variable<bool>( "population/census", true ) );
+
+  const std::list<std::string> budgets
+    ( m_arguments.get_all_of_string( "--decoration-budget" ) );
+
+  for ( std::list<std::string>::const_iterator it( budgets.begin() );
+        it != budgets.end(); ++it )
+    {
+      const std::string::size_type sep( it->find_last_of( ':' ) );
+      std::istringstream iss;
+      unsigned int budget;
+
+      if ( sep != std::string::npos )
+        iss.str( it->substr( sep + 1 ) );
+
+      if ( ( sep == std::string::npos ) || !( iss >> budget ) )
+        claw::logger << claw::log_warning << "Invalid decoration budget '"
+                     << *it << "'." << std::endl;
+      else
+        m_game->set_game_variable
+          ( bear::engine::variable<unsigned int>
+            ( "population/budget/" + it->substr( 0, sep ), budget ) );
+    }
+} // launcher::set_population_variables()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Print some help about the usage of the program.
@@ -267,3 +419,26 @@ std::string rp::launcher::get_rp_argument() const
   return a + STRINGIZE(RP_LIBRARY_PATH);
 #endif
 } // launcher::get_rp_argument()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the game is launched to run a benchmark.
+ */
+bool rp::launcher::is_benchmark() const
+{
+  return m_arguments.has_value( "--benchmark-level" );
+} // launcher::is_benchmark()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Returns the argument that gives the first level to run.
+ */
+std::string rp::launcher::get_start_level_argument() const
+{
+  std::string a( "--start-level=" );
+
+  if ( is_benchmark() )
+    return a + m_arguments.get_string( "--benchmark-level" );
+  else
+    return a + "level/start.cl";
+} // launcher::get_start_level_argument()
@@ -34,12 +34,18 @@ namespace rp
 
   private:
     void create_game( int& argc, char** &argv );
+    void set_benchmark_variables();
+    void set_capture_variables();
+    void set_population_variables();
     void help() const;
 
+    bool is_benchmark() const;
+
     std::string get_application_path() const;
     std::string get_data_path_argument() const;
     std::string get_generic_items_argument() const;
     std::string get_rp_argument() const;
+    std::string get_start_level_argument() const;
 
   private:
     /** \brief The game we are running. */
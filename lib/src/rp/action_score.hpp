@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The contribution of an item to the score of the current action.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ACTION_SCORE_HPP__
+#define __RP_ACTION_SCORE_HPP__
+
+#include "universe/types.hpp"
+
+#include <set>
+
+namespace bear
+{
+  namespace universe
+  {
+    class physical_item;
+  }
+}
+
+namespace rp
+{
+  /**
+   * \brief The contribution of an item to the score of the current action.
+   *
+   * The items owning an instance of this class attach it to themselves when
+   * they enter the layer, then update their contribution when their state
+   * changes (afraid, ejected, dying, covered with tar, etc.) and tell it the
+   * camera during their progress. The contributions of the items in the camera
+   * are kept in a running total, updated when an item enters or leaves the
+   * camera and when the contribution of such an item changes, thus the
+   * best_action_observer gets the score without querying the world nor casting
+   * the items.
+   *
+   * The items progress only in the active region around the camera, thus an
+   * item leaves the camera before it stops to progress.
+   *
+   * \author Julien Jorge
+   */
+  class action_score
+  {
+  public:
+    explicit action_score( bool counted_once = false );
+    action_score( const action_score& that );
+    ~action_score();
+
+    action_score& operator=( const action_score& that );
+
+    void attach( const bear::universe::physical_item& owner );
+
+    void update_camera( const bear::universe::rectangle_type& camera );
+
+    void set( unsigned int value );
+    unsigned int get() const;
+
+    static unsigned int get_total();
+
+  private:
+    void enter_camera();
+    void leave_camera();
+
+  private:
+    /** \brief The item owning this instance. */
+    const bear::universe::physical_item* m_owner;
+
+    /** \brief Tells if the contribution is counted in the total. */
+    bool m_in_camera;
+
+    /** \brief The contribution of the item owning this instance. */
+    unsigned int m_value;
+
+    /** \brief Tells if the greatest contribution of all the instances having
+        this flag is counted, instead of their sum. */
+    bool m_counted_once;
+
+    /** \brief The sum of the contributions of the items in the camera,
+        except those counted once. */
+    static unsigned int s_total;
+
+    /** \brief The contributions counted once of the items in the camera. */
+    static std::multiset<unsigned int> s_counted_once;
+
+  }; // class action_score
+} // namespace rp
+
+#endif // __RP_ACTION_SCORE_HPP__
@@ -0,0 +1,39 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A counter of the memory allocations done by the program.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ALLOCATION_COUNTER_HPP__
+#define __RP_ALLOCATION_COUNTER_HPP__
+
+#include <cstddef>
+
+namespace rp
+{
+  /**
+   * \brief A counter of the memory allocations done by the program.
+   *
+   * The allocations are counted only if the game is compiled with
+   * RP_COUNT_ALLOCATIONS defined, in which case the global operator new is
+   * replaced. Otherwise the count is always zero.
+   *
+   * \author Julien Jorge
+   */
+  class allocation_counter
+  {
+  public:
+    static bool is_enabled();
+    static std::size_t get_count();
+
+  }; // class allocation_counter
+} // namespace rp
+
+#endif // __RP_ALLOCATION_COUNTER_HPP__
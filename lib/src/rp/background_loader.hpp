@@ -0,0 +1,79 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that loads the optional resources of the level during the
+ *        game, a few at each iteration.
+ * \author Julien Jorge
+ */
+#ifndef __RP_BACKGROUND_LOADER_HPP__
+#define __RP_BACKGROUND_LOADER_HPP__
+
+#include "rp/preload_plan.hpp"
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+
+#include <set>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief An item that loads the optional resources of the level during the
+   *        game, a few at each iteration.
+   *
+   * The resources are the models of the classes of items not used by the
+   * level and the images of the themes other than the one of the level. They
+   * were previously loaded with the level, thus the time and the memory
+   * spent here are removed from the loading of the level.
+   *
+   * The images are decoded by a worker thread and only their textures are
+   * created during the iterations. The time spent in the game thread is
+   * limited by a budget per iteration: a resource longer to load than the
+   * remaining budget delays the loading of the next ones.
+   *
+   * \author Julien Jorge
+   */
+  class background_loader:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( background_loader );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+  public:
+    background_loader();
+
+    void progress( bear::universe::time_type elapsed_time );
+
+  private:
+    void create_plan();
+    void get_level_classes( std::set<std::string>& classes ) const;
+    void report() const;
+
+  private:
+    /** \brief The resources to load. */
+    preload_plan m_plan;
+
+    /** \brief Tells if the resources to load have been listed. */
+    bool m_plan_created;
+
+    /** \brief The time that can still be spent loading the resources. */
+    preload_plan::duration_type m_time_credit;
+
+    /** \brief The maximum time spent loading at each iteration. */
+    static const preload_plan::duration_type s_time_budget;
+
+  }; // class background_loader
+} // namespace rp
+
+#endif // __RP_BACKGROUND_LOADER_HPP__
@@ -14,7 +14,9 @@
 #ifndef __RP_BALLOON_HPP__
 #define __RP_BALLOON_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/attractable_item.hpp"
+#include "rp/collision_dispatcher.hpp"
 
 #include <claw/tween/single_tweener.hpp>
 
@@ -44,6 +46,9 @@ namespace rp
   
   public:
     balloon();
+
+    static void* operator new( std::size_t size );
+    static void operator delete( void* p, std::size_t size );
     
     static std::string get_random_color();
 
@@ -67,6 +72,8 @@ namespace rp
     bear::universe::position_type get_attack_point() const;
     
   private:
+    static collision_dispatcher<balloon> create_collision_dispatcher();
+
     bool collision_with_cannonball(bear::engine::base_item& that);
     bool collision_with_cable(bear::engine::base_item& that);
     bool collision_with_explosion
@@ -107,6 +114,9 @@ namespace rp
 
     /** \brief Initial position of the balloon. */
     bear::universe::position_type m_initial_position;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class balloon
 } // namespace rp
 
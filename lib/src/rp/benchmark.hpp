@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that replays an input script and measures the cost of each
+ *        frame.
+ * \author Julien Jorge
+ */
+#ifndef __RP_BENCHMARK_HPP__
+#define __RP_BENCHMARK_HPP__
+
+#include "rp/input_script.hpp"
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "universe/derived_item_handle.hpp"
+
+#include <iosfwd>
+
+namespace rp
+{
+  class cart;
+
+  /**
+   * \brief An item that replays an input script on the cart and measures the
+   *        cost of each frame.
+   *
+   * The item is created by the level settings when the game variable
+   * "benchmark/output" is set, which is done by the launcher with the
+   * --benchmark-* options. After the count of frames given by
+   * "benchmark/frames", the measures are written in the output file, as JSON
+   * if its extension is ".json" and as CSV otherwise, and the game ends.
+   *
+   * The frames are delimited by a benchmark_layer pushed on top of the other
+   * layers, which tells when the progress of the iteration and its rendering
+   * are done.
+   *
+   * \author Julien Jorge
+   */
+  class benchmark:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( benchmark );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+  private:
+    /** \brief The type of the handle on the cart. */
+    typedef bear::universe::derived_item_handle<cart> cart_handle;
+
+    /** \brief The measures of a frame. */
+    struct frame_record
+    {
+      /** \brief The processor time spent by the game thread from the end of
+          the rendering of the previous frame to the end of the progress of
+          the level, in milliseconds. */
+      double update_time;
+
+      /** \brief The processor time spent by the game thread since the
+          previous frame, in milliseconds. */
+      double cpu_time;
+
+      /** \brief The count of items in the world. */
+      std::size_t item_count;
+
+      /** \brief The count of allocations since the previous frame. */
+      std::size_t allocation_count;
+
+      /** \brief The count of blocks allocated by the pools of items since the
+          previous frame. */
+      std::size_t pool_allocation_count;
+
+    }; // struct frame_record
+
+  public:
+    benchmark();
+
+    void set_cart( cart& c );
+
+    void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
+
+    void end_update();
+    void end_render();
+
+  private:
+    void record_frame();
+    void start_frame();
+    std::size_t count_items() const;
+
+    void write_report() const;
+    void write_csv( std::ostream& os ) const;
+    void write_json( std::ostream& os ) const;
+
+    static double get_thread_cpu_time();
+
+  private:
+    /** \brief The cart receiving the inputs. */
+    cart_handle m_cart;
+
+    /** \brief The inputs to replay. */
+    input_script m_script;
+
+    /** \brief The measures of the frames. */
+    std::vector<frame_record> m_frames;
+
+    /** \brief The count of frames to measure. */
+    std::size_t m_frame_limit;
+
+    /** \brief Tells if the layer delimiting the frames has been pushed. */
+    bool m_layer_pushed;
+
+    /** \brief The processor time of the game thread at the end of the
+        rendering of the previous frame, in milliseconds. */
+    double m_frame_update_start;
+
+    /** \brief The processor time of the game thread at the beginning of the
+        current frame, in milliseconds. */
+    double m_frame_cpu_time;
+
+    /** \brief The count of allocations at the beginning of the current
+        frame. */
+    std::size_t m_frame_allocations;
+
+    /** \brief The count of blocks allocated by the pools of items at the
+        beginning of the current frame. */
+    std::size_t m_frame_pool_allocations;
+
+  }; // class benchmark
+} // namespace rp
+
+#endif // __RP_BENCHMARK_HPP__
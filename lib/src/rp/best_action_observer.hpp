@@ -29,6 +29,7 @@ namespace rp
 
   private:
     void scan();
+    void capture( unsigned int score );
     void render_capture();
     void store_capture( const claw::graphic::image& image );
     void saved
@@ -38,7 +39,12 @@ namespace rp
     void dispatch_progress( double p );
     
   private:
-    double m_best_score;
+    unsigned int m_best_score;
+    unsigned int m_pending_score;
+    bear::universe::time_type m_time_since_capture;
+    std::size_t m_capture_count;
+    std::size_t m_coalesced_count;
+    std::size_t m_dropped_count;
     bear::visual::capture m_best_scene;
     boost::function< void() > m_progress;
     boost::mutex m_mutex;
@@ -47,5 +53,7 @@ namespace rp
     boost::signals2::connection m_snapshot_connection;
     boost::signals2::connection m_finalize_connection;
     boost::signals2::connection m_saved_connection;
+
+    static const bear::universe::time_type s_min_capture_interval;
   };
 }
@@ -14,9 +14,11 @@
 #ifndef __RP_BIRD_HPP__
 #define __RP_BIRD_HPP__
 
+#include "rp/action_score.hpp"
+#include "rp/collision_dispatcher.hpp"
 #include "rp/entity.hpp"
+#include "rp/indexed_model.hpp"
 
-#include "engine/model.hpp"
 #include "engine/base_item.hpp"
 #include "generic_items/decorative_item.hpp"
 #include "generic_items/reference_item.hpp"
@@ -32,14 +34,14 @@ namespace rp
    * \author Sebastien Angibaud
    */
   class bird :
-    public bear::engine::model< bear::engine::base_item >,
+    public indexed_model< bear::engine::base_item >,
     public entity
   {
     DECLARE_BASE_ITEM(bird);
     
   public:
     /** \brief The type of the parent class. */
-    typedef bear::engine::model< bear::engine::base_item >  super;
+    typedef indexed_model< bear::engine::base_item >  super;
   
     TEXT_INTERFACE_DECLARE_METHOD_LIST(super, init_exported_methods)
   
@@ -51,6 +53,7 @@ namespace rp
     
     void pre_cache();
     void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
     void collision
     ( bear::engine::base_item& that, bear::universe::collision_info& info );
     void afraid(bool give_points = true);
@@ -64,6 +67,8 @@ namespace rp
     void populate_loader_map( bear::engine::item_loader_map& m );
     
   private:
+    static collision_dispatcher<bird> create_collision_dispatcher();
+
     bool collision_with_cannonball(bear::engine::base_item& that);
     bool collision_with_explosion
     (bear::engine::base_item& that, bear::universe::collision_info& info);
@@ -84,6 +89,7 @@ namespace rp
     void start_fly();
     void start_hit();
     void make_dirty();
+    void update_action_score();
  
     void on_beak_collision
     ( bear::engine::base_item& mark, bear::engine::base_item& that,
@@ -101,6 +107,9 @@ namespace rp
   private:
     /* \brief Number of plunger's collision */
     unsigned int m_plunger_collision;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class bird
 } // namespace rp
 
@@ -14,6 +14,7 @@
 #ifndef __RP_BOMB_HPP__
 #define __RP_BOMB_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/attractable_item.hpp"
 
 namespace rp
@@ -78,6 +79,13 @@ namespace rp
     /** \brief Indicates if the bomb has been explosed. */
     bool m_explosed;  
 
+    /** \brief Tells if the bomb had a bottom contact at the previous
+        iteration. */
+    bool m_bottom_contact;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
+
     /** \brief The initial mass. */
     static const double s_initial_mass;
   }; // class bomb
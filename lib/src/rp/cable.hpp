@@ -14,6 +14,8 @@
 #ifndef __RP_CABLE_HPP__
 #define __RP_CABLE_HPP__
 
+#include "rp/action_score.hpp"
+#include "rp/collision_dispatcher.hpp"
 #include "rp/obstacle.hpp"
 #include "engine/export.hpp"
 
@@ -47,6 +49,8 @@ namespace rp
     bool is_ejected() const;
 
   private:
+    static collision_dispatcher<cable> create_collision_dispatcher();
+
     bool collision_with_cart
     (bear::engine::base_item& that, bear::universe::collision_info& info );
     bool collision_with_cable
@@ -61,6 +65,9 @@ namespace rp
 
     /* \brief Indicates if the cable has already hitted the cart. */
     bool m_has_hit;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class cable
 } // namespace rp
 
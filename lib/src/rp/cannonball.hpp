@@ -14,6 +14,8 @@
 #ifndef __RP_CANNONBALL_HPP__
 #define __RP_CANNONBALL_HPP__
 
+#include "rp/action_score.hpp"
+
 #include "engine/model.hpp"
 #include "engine/base_item.hpp"
 #include "engine/export.hpp"
@@ -39,6 +41,9 @@ namespace rp
 
   public:
     cannonball();
+
+    static void* operator new( std::size_t size );
+    static void operator delete( void* p, std::size_t size );
     
     void pre_cache();
     void on_enters_layer();    
@@ -70,6 +75,9 @@ namespace rp
     
     /* \brief Value of the combo. */
     unsigned int m_combo_value;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class cannonball
 } // namespace rp
 
@@ -0,0 +1,75 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+#pragma once
+
+#include <claw/image.hpp>
+
+#include <boost/signals2/signal.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <string>
+
+namespace rp
+{
+  /**
+   * A single worker thread writing the captures of the game as PNG files. The
+   * images are copied once in a pending buffer, which the worker swaps with
+   * the buffer it writes, such that the two buffers are reused from one
+   * capture to the other. A capture still waiting to be written is replaced
+   * by the next one, and the last one is written before the worker stops.
+   */
+  class capture_writer
+  {
+  public:
+    typedef
+    boost::signals2::signal
+    <
+      void( const std::string& save_path, const claw::graphic::image& image )
+    > signal_type;
+
+  public:
+    capture_writer( const capture_writer& ) = delete;
+    capture_writer& operator=( const capture_writer& ) = delete;
+
+    static capture_writer& get_instance();
+
+    boost::signals2::connection
+    connect_saved( const signal_type::slot_type& f );
+
+    void
+    write( const std::string& file_name, const claw::graphic::image& image );
+
+    std::size_t get_coalesced_count() const;
+
+  private:
+    capture_writer();
+    ~capture_writer();
+
+    void run();
+
+  private:
+    boost::thread m_thread;
+    mutable boost::mutex m_mutex;
+    boost::condition_variable m_condition;
+
+    bool m_quit;
+    bool m_pending;
+    std::size_t m_coalesced;
+
+    std::string m_pending_file_name;
+    claw::graphic::image m_pending_image;
+
+    std::string m_file_name;
+    claw::graphic::image m_image;
+
+    signal_type m_saved;
+  };
+}
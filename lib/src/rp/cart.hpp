@@ -14,6 +14,9 @@
 #ifndef __RP_CART_HPP__
 #define __RP_CART_HPP__
 
+#include "rp/action_score.hpp"
+#include "rp/collision_dispatcher.hpp"
+#include "rp/indexed_model.hpp"
 #include "rp/plunger.hpp"
 #include "rp/item_that_speaks.hpp"
 
@@ -21,7 +24,6 @@
 
 #include "engine/item_brick/item_with_input_listener.hpp"
 #include "engine/item_brick/item_with_toggle.hpp"
-#include "engine/model.hpp"
 #include "engine/base_item.hpp"
 #include "engine/export.hpp"
 #include "visual/animation.hpp"
@@ -49,17 +51,20 @@ namespace rp
    * \author Sebastien Angibaud
    */
   class cart :
-    public bear::engine::model
+    public indexed_model
   < bear::engine::item_with_input_listener
     < bear::engine::item_with_toggle
       < item_that_speaks
         < bear::engine::base_item > > > >
   {
     DECLARE_BASE_ITEM(cart);
+
+    // The benchmark replays its inputs through the input handlers.
+    friend class input_script;
     
   public:
     /** \brief The type of the parent class. */
-    typedef bear::engine::model
+    typedef indexed_model
     < bear::engine::item_with_input_listener
       < bear::engine::item_with_toggle
       < item_that_speaks
@@ -232,10 +237,19 @@ namespace rp
     void create_smoke( double elapsed_time );
     void update_bottom_contact();
     void update_status_informations();
+    void update_action_score();
     bool test_in_sky();
     bear::universe::position_type compute_gun_position() const;
     bear::universe::position_type compute_fire_position() const;
 
+    static collision_dispatcher<cart> create_collision_dispatcher();
+    static collision_dispatcher<cart> create_painter_collision_dispatcher();
+
+    bool collision_with_switching( bear::engine::base_item& that );
+    bool collision_with_hole
+    ( bear::engine::base_item& that, bear::universe::collision_info& info );
+    bool forward_collision
+    ( bear::engine::base_item& that, bear::universe::collision_info& info );
     bool collision_with_tar( bear::engine::base_item& that );
     bool collision_with_bonus( bear::engine::base_item& that );
     bool collision_with_explosion
@@ -384,6 +398,9 @@ namespace rp
     boost::signals2::scoped_connection m_ad_connection;
     bool m_cannon_enabled;
     bool m_action_snapshot_done;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
     
     /** \brief The score. */
     static unsigned int s_score;
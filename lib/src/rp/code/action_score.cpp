@@ -0,0 +1,189 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::action_score class.
+ * \author Julien Jorge
+ */
+#include "rp/action_score.hpp"
+
+#include "universe/physical_item.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+/*----------------------------------------------------------------------------*/
+unsigned int rp::action_score::s_total( 0 );
+std::multiset<unsigned int> rp::action_score::s_counted_once;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param counted_once Tells if only the greatest contribution of the instances
+ *        having this flag is counted in the score.
+ */
+rp::action_score::action_score( bool counted_once )
+  : m_owner( NULL ), m_in_camera( false ), m_value( 0 ),
+    m_counted_once( counted_once )
+{
+
+} // action_score::action_score()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy constructor. The copy is not attached, since the copied item is
+ *        not its owner.
+ * \param that The instance to copy from.
+ */
+rp::action_score::action_score( const action_score& that )
+  : m_owner( NULL ), m_in_camera( false ), m_value( that.m_value ),
+    m_counted_once( that.m_counted_once )
+{
+
+} // action_score::action_score()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. Removes the contribution of the item from the score.
+ */
+rp::action_score::~action_score()
+{
+  leave_camera();
+} // action_score::~action_score()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Assignment. The contribution is copied, the owner is kept.
+ * \param that The instance to copy from.
+ */
+rp::action_score& rp::action_score::operator=( const action_score& that )
+{
+  if ( m_in_camera )
+    {
+      leave_camera();
+      m_value = that.m_value;
+      m_counted_once = that.m_counted_once;
+      enter_camera();
+    }
+  else
+    {
+      m_value = that.m_value;
+      m_counted_once = that.m_counted_once;
+    }
+
+  return *this;
+} // action_score::operator=()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the item whose position in the camera tells if the contribution
+ *        is counted.
+ * \param owner The item owning this instance.
+ */
+void rp::action_score::attach( const bear::universe::physical_item& owner )
+{
+  m_owner = &owner;
+} // action_score::attach()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count the contribution in the total if the owner has entered the
+ *        camera, or remove it if the owner has left the camera.
+ * \param camera The area visible in the camera.
+ */
+void rp::action_score::update_camera
+( const bear::universe::rectangle_type& camera )
+{
+  if ( m_owner == NULL )
+    return;
+
+  const bool in_camera( camera.intersects( m_owner->get_bounding_box() ) );
+
+  if ( in_camera == m_in_camera )
+    return;
+
+  if ( in_camera )
+    enter_camera();
+  else
+    leave_camera();
+} // action_score::update_camera()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the contribution of the item.
+ * \param value The new contribution.
+ */
+void rp::action_score::set( unsigned int value )
+{
+  if ( value == m_value )
+    return;
+
+  if ( m_in_camera )
+    {
+      leave_camera();
+      m_value = value;
+      enter_camera();
+    }
+  else
+    m_value = value;
+} // action_score::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the contribution of the item.
+ */
+unsigned int rp::action_score::get() const
+{
+  return m_value;
+} // action_score::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sum of the contributions of the items in the camera.
+ */
+unsigned int rp::action_score::get_total()
+{
+  if ( s_counted_once.empty() )
+    return s_total;
+  else
+    return s_total + *s_counted_once.rbegin();
+} // action_score::get_total()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the contribution in the total.
+ */
+void rp::action_score::enter_camera()
+{
+  assert( !m_in_camera );
+
+  m_in_camera = true;
+
+  if ( m_counted_once )
+    s_counted_once.insert( m_value );
+  else
+    s_total += m_value;
+} // action_score::enter_camera()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the contribution from the total.
+ */
+void rp::action_score::leave_camera()
+{
+  if ( !m_in_camera )
+    return;
+
+  m_in_camera = false;
+
+  if ( m_counted_once )
+    s_counted_once.erase( s_counted_once.find( m_value ) );
+  else
+    s_total -= m_value;
+} // action_score::leave_camera()
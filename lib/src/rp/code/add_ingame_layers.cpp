@@ -13,11 +13,21 @@
  */
 #include "rp/add_ingame_layers.hpp"
 
+#include "rp/background_loader.hpp"
+#include "rp/balloon.hpp"
 #include "rp/best_action_observer.hpp"
+#include "rp/cannonball.hpp"
 #include "rp/cart.hpp"
 #include "rp/defines.hpp"
+#include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/hover_manager.hpp"
+#include "rp/item_pool.hpp"
+#include "rp/particle_system.hpp"
+#include "rp/plunger.hpp"
+#include "rp/population_manager.hpp"
 #include "rp/rp_gettext.hpp" 
+#include "rp/sound_bank.hpp"
 #include "rp/transition_effect/level_starting_effect.hpp"
 
 #include "engine/comic/layer/balloon_layer.hpp"
@@ -74,71 +84,34 @@ void rp::add_ingame_layers::pre_cache()
   globals.load_sound( "sound/medal/bronze.ogg" );
   globals.load_sound( "sound/medal/silver.ogg" );
   globals.load_sound( "sound/medal/gold.ogg" );
+  sound_bank::load_samples( globals );
 
   globals.load_font( "font/FrancoisOne.ttf" );
   globals.load_font( "font/LuckiestGuy.ttf" );
+
+  // The particles.
+  globals.load_animation( "animation/effect/steam.canim" );
+  globals.load_animation( "animation/explosion.canim" );
+  globals.load_image( "gfx/bird/bird.png" );
+
+  // The memory of the projectiles and of the balloons lost by the cart, such
+  // that the first shots do not allocate it.
+  item_pool<cannonball>::get_instance().reserve( 8 );
+  item_pool<plunger>::get_instance().reserve( 4 );
+  item_pool<explosion>::get_instance().reserve( 16 );
+  item_pool<balloon>::get_instance().reserve( 16 );
   
-  // These may be optional for each level. We still load them everytime in order
-  // for the user to endure the loading time at the beginning of the game.
-  globals.load_model("model/balloon.cm");
-  globals.load_model("model/bomb.cm");
-  globals.load_model("model/tar.cm");
-  globals.load_model("model/switching.cm");
-  globals.load_model("model/wall.cm");
-  globals.load_model("model/tnt.cm");
-  globals.load_model("model/zeppelin/zeppelin.cm");
-  globals.load_model("model/zeppelin/zeppelin-mirror.cm");
-
-  globals.load_image( "gfx/aquatic/ground/ground-1.png" );
-  globals.load_image( "gfx/aquatic/ground/ground-2.png" );
-  globals.load_image( "gfx/aquatic/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/aquatic/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/aquatic/wall-fill-2.png" );
-
-  globals.load_image( "gfx/cake/ground/ground-1.png" );
-  globals.load_image( "gfx/cake/ground/ground-2.png" );
-  globals.load_image( "gfx/cake/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/cake/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/cake/wall-fill-2.png" );
-  globals.load_image( "gfx/wall-fill/cake/wall-fill-3.png" );
-
-  globals.load_image( "gfx/death/ground/ground-1.png" );
-  globals.load_image( "gfx/death/ground/ground-2.png" );
-  globals.load_image( "gfx/death/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/death/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/death/wall-fill-2.png" );
-  globals.load_image( "gfx/wall-fill/death/wall-fill-3.png" );
-
-  globals.load_image( "gfx/garden/ground/ground-1.png" );
-  globals.load_image( "gfx/garden/ground/ground-2.png" );
-  globals.load_image( "gfx/garden/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/garden/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/garden/wall-fill-2.png" );
-  globals.load_image( "gfx/wall-fill/garden/wall-fill-3.png" );
-
-  globals.load_image( "gfx/space/ground/ground-1.png" );
-  globals.load_image( "gfx/space/ground/ground-2.png" );
-  globals.load_image( "gfx/space/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/space/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/space/wall-fill-2.png" );
-  globals.load_image( "gfx/wall-fill/space/wall-fill-3.png" );
-
-  globals.load_image( "gfx/western/ground/ground-1.png" );
-  globals.load_image( "gfx/western/ground/ground-2.png" );
-  globals.load_image( "gfx/western/ground/ground-3.png" );
-  globals.load_image( "gfx/wall-fill/western/wall-fill-1.png" );
-  globals.load_image( "gfx/wall-fill/western/wall-fill-2.png" );
-  globals.load_image( "gfx/wall-fill/western/wall-fill-3.png" );
-
-  static const std::array< unsigned int, 4 > digit_font_sizes
-      {{ 25, 32, 40, 64 }};
+  // The glyphs used by the digit_writing instances of the score components
+  // and of the level ending effect.
+  static const std::array< unsigned int, 5 > digit_font_sizes
+      {{ 25, 30, 32, 40, 64 }};
   
   for ( unsigned int size : digit_font_sizes )
     {
       const bear::visual::font font
         ( globals.get_font( "font/LuckiestGuy.ttf", size ) );
 
-      for ( char c : "0123456789" )
+      for ( char c : "0123456789-" )
         font.get_sprite( c );
     }
 
@@ -156,6 +129,11 @@ void rp::add_ingame_layers::pre_cache()
 void rp::add_ingame_layers::build()
 {
   new_item( *( new callback_queue() ) );
+  new_item( *( new background_loader() ) );
+  new_item( *( new particle_system() ) );
+  new_item( *( new sound_bank() ) );
+  new_item( *( new hover_manager() ) );
+  new_item( *( new population_manager() ) );
 
   bear::engine::transition_layer* transition
     ( new bear::engine::transition_layer
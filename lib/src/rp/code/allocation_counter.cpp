@@ -0,0 +1,98 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::allocation_counter class.
+ * \author Julien Jorge
+ */
+#include "rp/allocation_counter.hpp"
+
+#ifdef RP_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/** \brief The count of calls to the global operator new. */
+static std::atomic<std::size_t> g_rp_allocation_count( 0 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate some memory and count the allocation.
+ * \param size The size of the memory to allocate.
+ */
+void* operator new( std::size_t size )
+{
+  g_rp_allocation_count.fetch_add( 1, std::memory_order_relaxed );
+
+  void* const result( std::malloc( (size == 0) ? 1 : size ) );
+
+  if ( result == NULL )
+    throw std::bad_alloc();
+
+  return result;
+} // operator new()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate some memory for an array and count the allocation.
+ * \param size The size of the memory to allocate.
+ */
+void* operator new[]( std::size_t size )
+{
+  return operator new( size );
+} // operator new[]()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release some memory allocated with operator new.
+ * \param p The memory to release.
+ */
+void operator delete( void* p ) noexcept
+{
+  std::free( p );
+} // operator delete()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release some memory allocated with operator new[].
+ * \param p The memory to release.
+ */
+void operator delete[]( void* p ) noexcept
+{
+  std::free( p );
+} // operator delete[]()
+
+#endif // RP_COUNT_ALLOCATIONS
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the allocations are counted.
+ */
+bool rp::allocation_counter::is_enabled()
+{
+#ifdef RP_COUNT_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+} // allocation_counter::is_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of allocations since the start of the program.
+ */
+std::size_t rp::allocation_counter::get_count()
+{
+#ifdef RP_COUNT_ALLOCATIONS
+  return g_rp_allocation_count.load( std::memory_order_relaxed );
+#else
+  return 0;
+#endif
+} // allocation_counter::get_count()
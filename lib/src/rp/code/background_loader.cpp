@@ -0,0 +1,147 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::background_loader class.
+ * \author Julien Jorge
+ */
+#include "rp/background_loader.hpp"
+
+#include "rp/game_variables.hpp"
+
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <claw/logger.hpp>
+
+#include <algorithm>
+
+BASE_ITEM_EXPORT( background_loader, rp )
+
+/*----------------------------------------------------------------------------*/
+const rp::preload_plan::duration_type
+rp::background_loader::s_time_budget( 4 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::background_loader::background_loader()
+  : m_plan_created( false ),
+    m_time_credit( preload_plan::duration_type::zero() )
+{
+  set_global( true );
+} // background_loader::background_loader()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::background_loader::progress( bear::universe::time_type elapsed_time )
+{
+  super::progress( elapsed_time );
+
+  // The plan is created here, when the level settings have been built.
+  if ( !m_plan_created )
+    {
+      create_plan();
+      m_plan_created = true;
+      return;
+    }
+
+  // The budget not consumed in the previous iterations is not kept, but the
+  // time spent over the budget is repaid in the next iterations.
+  m_time_credit = std::min( m_time_credit + s_time_budget, s_time_budget );
+
+  while ( !m_plan.empty()
+          && ( m_time_credit > preload_plan::duration_type::zero() ) )
+    {
+      const preload_plan::duration_type start
+        ( m_plan.get_loading_duration() );
+
+      // The next image is still being decoded.
+      if ( !m_plan.load_next( get_level_globals() ) )
+        break;
+
+      m_time_credit -= m_plan.get_loading_duration() - start;
+    }
+
+  if ( m_plan.empty() )
+    {
+      report();
+      kill();
+    }
+} // background_loader::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief List the resources to load.
+ */
+void rp::background_loader::create_plan()
+{
+  // The models of the classes used by the level have been loaded by their
+  // items.
+  std::set<std::string> level_classes;
+  get_level_classes( level_classes );
+
+  for ( const std::string& c : preload_plan::get_item_classes() )
+    if ( level_classes.find( c ) == level_classes.end() )
+      m_plan.add_item_class( c );
+
+  const std::string current_theme( game_variables::get_level_theme() );
+
+  for ( const std::string& theme : preload_plan::get_themes() )
+    if ( theme != current_theme )
+      m_plan.add_theme( theme );
+
+  m_plan.start_decoding();
+} // background_loader::create_plan()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the names of the classes of the items of the level.
+ * \param classes (out) The names of the classes.
+ */
+void
+rp::background_loader::get_level_classes( std::set<std::string>& classes ) const
+{
+  const bear::universe::size_box_type size( get_level().get_size() );
+  bear::universe::world::item_list items;
+
+  get_world().pick_items_in_rectangle
+    ( items, bear::universe::rectangle_type( 0, 0, size.x, size.y ) );
+
+  for ( bear::universe::world::item_list::const_iterator it( items.begin() );
+        it != items.end(); ++it )
+    {
+      const bear::engine::base_item* const item
+        ( dynamic_cast<const bear::engine::base_item*>( *it ) );
+
+      if ( item != NULL )
+        classes.insert( item->get_class_name() );
+    }
+} // background_loader::get_level_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Log the resources loaded out of the loading of the level.
+ */
+void rp::background_loader::report() const
+{
+  claw::logger << claw::log_verbose << "Preload: level '"
+               << get_level().get_name() << "': "
+               << m_plan.get_loaded_count() << " resources, "
+               << m_plan.get_loaded_bytes() << " bytes, "
+               << m_plan.get_loading_duration().count()
+               << " ms in the game thread and "
+               << m_plan.get_decoding_duration().count()
+               << " ms in the decoder removed from the loading of the level."
+               << std::endl;
+} // background_loader::report()
@@ -17,9 +17,15 @@
 #include "rp/cart.hpp"
 #include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/item_pool.hpp"
 #include "rp/plank.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/tar.hpp"
 
+#include "engine/level.hpp"
 #include "generic_items/decorative_item.hpp"
 #include "generic_items/decorative_effect.hpp"
 
@@ -27,6 +33,9 @@
 
 #include <claw/tween/easing/easing_linear.hpp>
 
+#include <limits>
+#include <utility>
+
 BASE_ITEM_EXPORT( balloon, rp )
 
 /*----------------------------------------------------------------------------*/
@@ -35,7 +44,7 @@ BASE_ITEM_EXPORT( balloon, rp )
  */
 rp::balloon::balloon()
 : m_color( get_random_color() ),
-  m_shape( rand() % 3 + 1 ),
+  m_shape( random::gameplay().integer(3) + 1 ),
   m_hit(false), m_fly(false), m_cart(NULL)
 {
   set_phantom(true);
@@ -44,19 +53,55 @@ rp::balloon::balloon()
   set_density(0.001);
 } // balloon::balloon()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the memory of an instance from the pool of the class.
+ * \param size The size of the memory.
+ */
+void* rp::balloon::operator new( std::size_t size )
+{
+  return item_pool<balloon>::get_instance().allocate( size );
+} // balloon::operator new()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Give back the memory of an instance to the pool of the class.
+ * \param p The memory of the instance.
+ * \param size The size of the memory.
+ */
+void rp::balloon::operator delete( void* p, std::size_t size )
+{
+  item_pool<balloon>::get_instance().release( p, size );
+} // balloon::operator delete()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Returns a random valid color for a balloon
  */
 std::string rp::balloon::get_random_color()
 {
-  static std::array< std::string, 6 > colors =
+  static const std::array< std::string, 6 > initial_colors =
     {{ "blue", "green", "orange", "purple", "red", "yellow" }};
-  static std::size_t index( colors.size() );
+  static std::array< std::string, 6 > colors;
+  static std::size_t index( 0 );
+  static std::size_t level_serial( std::numeric_limits<std::size_t>::max() );
+
+  // The sequence restarts in each level, such that the colors depend only on
+  // the seed of the level.
+  if ( level_serial != random::get_level_serial() )
+    {
+      level_serial = random::get_level_serial();
+      index = colors.size();
+      colors = initial_colors;
+    }
 
   if ( index == colors.size() )
     {
-      std::random_shuffle( colors.begin(), colors.end() );
+      // Fisher-Yates, such that the order does not depend on the
+      // implementation of the standard library.
+      for ( std::size_t i( colors.size() - 1 ); i != 0; --i )
+        std::swap( colors[ i ], colors[ random::gameplay().integer( i + 1 ) ] );
+
       index = 0;
     }
 
@@ -89,6 +134,10 @@ void rp::balloon::pre_cache()
   super::pre_cache();
   
   get_level_globals().load_model("model/balloon.cm");
+  get_level_globals().load_sound("sound/balloon/burst-1.ogg");
+  get_level_globals().load_sound("sound/balloon/burst-2.ogg");
+  get_level_globals().load_sound("sound/balloon/burst-3.ogg");
+  get_level_globals().load_sound("sound/balloon/burst-4.ogg");
 
   get_level_globals().load_animation
     ( "animation/balloon/balloon-blue-1.canim" );
@@ -145,6 +194,9 @@ void rp::balloon::on_enters_layer()
   start_model_action("idle");
 
   create_interactive_item(*this, 1, 0);
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
   
   bear::engine::model_mark_placement mark;
       
@@ -168,7 +220,10 @@ void rp::balloon::on_enters_layer()
  */
 void rp::balloon::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/balloon" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   if ( m_fly )
     m_tweener_y_position.update(elapsed_time);
@@ -206,12 +261,10 @@ void rp::balloon::collision
 {
   super::collision(that, info);
 
-  if ( ! collision_with_balloon(that,info) )
-    if ( ! collision_with_cannonball(that) )
-      if ( ! collision_with_cable(that) )
-        if ( ! collision_with_plank(that) )
-          if ( ! collision_with_tar(that) )
-            collision_with_explosion(that,info);
+  static const collision_dispatcher<balloon> dispatcher
+    ( create_collision_dispatcher() );
+
+  dispatcher.dispatch( *this, that, info );
 } // balloon::collision()
 
 /*----------------------------------------------------------------------------*/
@@ -226,6 +279,9 @@ void rp::balloon::explose(bool counted)
   m_hit = true;
   m_fly = false;
   start_model_action("explose");
+  sound_bank::play_random
+    ( get_level_globals(), sound_bank::balloon_burst_1_sample, 4,
+      bear::audio::sound_effect( get_center_of_mass() ) );
   create_decorations();
   if ( counted )
     game_variables::set_bad_balloon_number
@@ -233,6 +289,8 @@ void rp::balloon::explose(bool counted)
 
   if ( get_attracted_state() )
     leave();
+
+  m_action_score.set( 10 );
 } // balloon::explose()
 
 /*----------------------------------------------------------------------------*/
@@ -255,6 +313,7 @@ void rp::balloon::attract(plunger* p)
   super::attract(p);
 
   m_fly = false;
+  m_action_score.set( 20 );
 } // balloon::attract()
 
 /*----------------------------------------------------------------------------*/
@@ -294,6 +353,24 @@ bear::universe::position_type rp::balloon::get_attack_point() const
   return get_center_of_mass();
 } // balloon::get_attack_point()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the collision handlers, by type of the other item.
+ */
+rp::collision_dispatcher<rp::balloon> rp::balloon::create_collision_dispatcher()
+{
+  collision_dispatcher<balloon> result;
+
+  result.add<&balloon::collision_with_balloon>( item_type::balloon );
+  result.add<&balloon::collision_with_cannonball>( item_type::cannonball );
+  result.add<&balloon::collision_with_cable>( item_type::cable );
+  result.add<&balloon::collision_with_plank>( item_type::plank );
+  result.add<&balloon::collision_with_tar>( item_type::tar );
+  result.add<&balloon::collision_with_explosion>( item_type::explosion );
+
+  return result;
+} // balloon::create_collision_dispatcher()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with a cannonbal.
@@ -302,34 +379,29 @@ bear::universe::position_type rp::balloon::get_attack_point() const
  */
 bool rp::balloon::collision_with_cannonball( bear::engine::base_item& that )
 { 
-  bool result = false;
-  cannonball* c = dynamic_cast<cannonball*>(&that);
-  
-  if ( c != NULL ) 
+  cannonball* c = static_cast<cannonball*>(&that);
+
+  if ( ! m_hit )
     {
-      if ( ! m_hit )
+      bool hit = true;
+
+      if ( c->get_cart() != NULL && get_attracted_state() )
+        { 
+          bear::engine::model_mark_placement plunger_mark;      
+          if ( c->get_cart()->get_mark_placement
+               ( model_mark_id::plunger, plunger_mark ) )
+            hit = plunger_mark.get_position().distance
+              ( c->get_center_of_mass() ) > 200 ;
+        }
+
+      if ( hit )
         {
-          bool hit = true;
-          
-          if ( c->get_cart() != NULL && get_attracted_state() )
-            { 
-              bear::engine::model_mark_placement plunger_mark;      
-              if ( c->get_cart()->get_mark_placement("plunger", plunger_mark) )
-                hit = plunger_mark.get_position().distance
-                  ( c->get_center_of_mass() ) > 200 ;
-            }
-
-          if ( hit )
-            {
-              explose();
-              c->kill();
-            }
+          explose();
+          c->kill();
         }
-      
-      result = true;
     }
-  
-  return result;
+
+  return true;
 } // balloon::collision_with_cannonball()
 
 /*----------------------------------------------------------------------------*/
@@ -341,21 +413,16 @@ bool rp::balloon::collision_with_cannonball( bear::engine::base_item& that )
 bool rp::balloon::collision_with_cable
 ( bear::engine::base_item& that )
 { 
-  bool result = false;
-  cable* c = dynamic_cast<cable*>(&that);
-  
-  if ( c != NULL ) 
+  cable* c = static_cast<cable*>(&that);
+
+  if ( ! m_hit && ( c->is_ejected() ) )
     {
-      if ( ! m_hit && ( c->is_ejected() ) )
-        {
-          if ( c->get_combo_value() != 0 )
-            set_combo_value(c->get_combo_value()+1);          
-          explose();
-        }
-      result = true;
+      if ( c->get_combo_value() != 0 )
+        set_combo_value(c->get_combo_value()+1);          
+      explose();
     }
-  
-  return result;
+
+  return true;
 } // balloon::collision_with_cable()
 
 /*----------------------------------------------------------------------------*/
@@ -367,18 +434,12 @@ bool rp::balloon::collision_with_cable
 bool rp::balloon::collision_with_explosion
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  explosion* e = dynamic_cast<explosion*>(&that);
-  
-  if ( e != NULL ) 
-    {
-      if ( ! m_hit && e->test_in_explosion(info) )
-        explose();
-      
-      result = true;
-    }
-  
-  return result;
+  explosion* e = static_cast<explosion*>(&that);
+
+  if ( ! m_hit && e->test_in_explosion(info) )
+    explose();
+
+  return true;
 } // balloon::collision_with_explosion()
 
 /*----------------------------------------------------------------------------*/
@@ -391,16 +452,9 @@ bool rp::balloon::collision_with_explosion
 bool rp::balloon::collision_with_balloon
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  balloon* b = dynamic_cast<balloon*>(&that);
-  
-  if ( b != NULL ) 
-    {
-      default_collision(info); 
-      result = true;
-    }
-  
-  return result;
+  default_collision(info); 
+
+  return true;
 } // balloon::collision_with_balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -411,18 +465,10 @@ bool rp::balloon::collision_with_balloon
  */
 bool rp::balloon::collision_with_plank( bear::engine::base_item& that )
 { 
-  bool result = false;
-  plank* p = dynamic_cast<plank*>(&that);
-  
-  if ( p != NULL ) 
-    {
-      if ( ! m_hit )
-        explose();
+  if ( ! m_hit )
+    explose();
 
-      result = true;
-    }
-  
-  return result;
+  return true;
 } // balloon::collision_with_plank()
 
 /*----------------------------------------------------------------------------*/
@@ -433,24 +479,18 @@ bool rp::balloon::collision_with_plank( bear::engine::base_item& that )
  */
 bool rp::balloon::collision_with_tar( bear::engine::base_item& that )
 { 
-  bool result = false;
-  tar* t = dynamic_cast<tar*>(&that);
-  
-  if ( t != NULL ) 
+  tar* t = static_cast<tar*>(&that);
+
+  if ( ! m_hit && t->get_current_action_name() != "on_rail" )
     {
-      if ( ! m_hit && t->get_current_action_name() != "on_rail" )
-        {
-          create_tar_balloon();
-          t->kill();
-          if ( get_attracted_state() )
-            leave();
-          kill();
-        }
-            
-      result = true;
+      create_tar_balloon();
+      t->kill();
+      if ( get_attracted_state() )
+        leave();
+      kill();
     }
-  
-  return result;
+
+  return true;
 } // balloon::collision_with_tar()
 
 /*----------------------------------------------------------------------------*/
@@ -469,8 +509,8 @@ void rp::balloon::finish_explose()
  */
 void rp::balloon::create_decorations()
 {
-  unsigned int a = (unsigned int)(6.0 * rand() / RAND_MAX);
-  int b = (int)(2.0 * rand() / RAND_MAX);
+  unsigned int a = random::effects().integer(6);
+  int b = random::effects().integer(2);
   if ( b == 0 )
     b = -1;
 
@@ -487,7 +527,7 @@ void rp::balloon::create_decorations()
   create_decorative_blast("balloon piece 2", speeds[(a+1)%6]);
   create_decorative_blast("balloon piece 3", speeds[(a+2)%6]);
 
-  unsigned int nb = (unsigned int)(4.0 * rand() / RAND_MAX);
+  unsigned int nb = random::effects().integer(4);
   if ( nb > 1 ) 
     {
       create_decorative_blast("balloon piece 4", speeds[(a+3)%6]);
@@ -506,6 +546,10 @@ void rp::balloon::create_decorations()
  */
 void rp::balloon::create_tar_balloon()
 {
+  if ( !population_manager::can_spawn
+       ( population_manager::decoration_debris ) )
+    return;
+
   bear::decorative_item* item = new bear::decorative_item;
 
   std::ostringstream oss;
@@ -524,6 +568,8 @@ void rp::balloon::create_tar_balloon()
   item->set_center_of_mass(get_center_of_mass());
 
   new_item( *item );
+  population_manager::add_decoration
+    ( population_manager::decoration_debris, *item );
 
   CLAW_ASSERT( item->is_valid(),
          "The decoration of balloon isn't correctly initialized" );
@@ -538,6 +584,10 @@ void rp::balloon::create_tar_balloon()
 void rp::balloon::create_decorative_blast
 (const std::string& sprite_name, const bear::universe::speed_type& speed)
 {
+  if ( !population_manager::can_spawn
+       ( population_manager::decoration_debris ) )
+    return;
+
   bear::decorative_item* item = new bear::decorative_item;
 
   item->set_animation
@@ -554,6 +604,8 @@ void rp::balloon::create_decorative_blast
   item->set_center_of_mass(get_center_of_mass());
 
   new_item( *item );
+  population_manager::add_decoration
+    ( population_manager::decoration_debris, *item );
 
   CLAW_ASSERT( item->is_valid(),
          "The decoration of balloon isn't correctly initialized" );
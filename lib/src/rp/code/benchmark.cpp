@@ -0,0 +1,320 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::benchmark class.
+ * \author Julien Jorge
+ */
+#include "rp/benchmark.hpp"
+
+#include "rp/allocation_counter.hpp"
+#include "rp/cart.hpp"
+#include "rp/game_variables.hpp"
+#include "rp/item_pool.hpp"
+#include "rp/music_player.hpp"
+#include "rp/random.hpp"
+#include "rp/layer/benchmark_layer.hpp"
+
+#include "engine/game.hpp"
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <claw/logger.hpp>
+
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+BASE_ITEM_EXPORT( benchmark, rp )
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::benchmark::benchmark()
+  : m_frame_limit( 0 ), m_layer_pushed( false ), m_frame_update_start( 0 ),
+    m_frame_cpu_time( 0 ), m_frame_allocations( 0 ),
+    m_frame_pool_allocations( 0 )
+{
+  set_global( true );
+} // benchmark::benchmark()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the cart receiving the inputs of the script.
+ * \param c The cart.
+ */
+void rp::benchmark::set_cart( cart& c )
+{
+  m_cart = c;
+} // benchmark::set_cart()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do post creation actions.
+ */
+void rp::benchmark::on_enters_layer()
+{
+  super::on_enters_layer();
+
+  // The benchmark measures the game loop, not the audio.
+  bear::engine::game::get_instance().set_sound_muted( true );
+  bear::engine::game::get_instance().set_music_muted( true );
+  music_player::get_instance().update_volume();
+
+  const std::string input( game_variables::get_benchmark_input() );
+
+  if ( !input.empty() )
+    m_script.load( input );
+
+  m_frame_limit = game_variables::get_benchmark_frames();
+  m_frames.reserve( m_frame_limit );
+
+  claw::logger << claw::log_verbose << "Benchmark: level '"
+               << get_level().get_name() << "', "
+               << m_script.get_event_count() << " inputs, "
+               << m_frame_limit << " frames." << std::endl;
+
+  start_frame();
+} // benchmark::on_enters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::benchmark::progress( bear::universe::time_type elapsed_time )
+{
+  super::progress( elapsed_time );
+
+  // All the layers of the level have been pushed when the items are
+  // progressed, thus this one is the last.
+  if ( !m_layer_pushed )
+    {
+      get_level().push_layer( new benchmark_layer( *this ) );
+      m_layer_pushed = true;
+    }
+
+  if ( m_cart != NULL )
+    m_script.apply( m_frames.size(), *m_cart );
+} // benchmark::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Inform the benchmark that the progress of the level is done for the
+ *        current iteration.
+ */
+void rp::benchmark::end_update()
+{
+  if ( m_frames.size() >= m_frame_limit )
+    return;
+
+  record_frame();
+
+  if ( m_frames.size() >= m_frame_limit )
+    {
+      write_report();
+      kill();
+      bear::engine::game::get_instance().end();
+    }
+  else
+    start_frame();
+} // benchmark::end_update()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Inform the benchmark that the rendering of the current frame is
+ *        done.
+ */
+void rp::benchmark::end_render()
+{
+  // The waiting of the engine between the frames is not processor time, thus
+  // the next update is measured from here.
+  m_frame_update_start = get_thread_cpu_time();
+} // benchmark::end_render()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Store the measures of the frame ending now.
+ *
+ * The update time covers the whole iteration: the inputs, the progress of the
+ * world and of the items, the collisions and the progress of the layers,
+ * excluding the rendering. The processor time covers the whole frame. Both are
+ * the processor time of the game thread only.
+ */
+void rp::benchmark::record_frame()
+{
+  const double cpu_time( get_thread_cpu_time() );
+  const std::size_t allocations( allocation_counter::get_count() );
+
+  frame_record r;
+  r.update_time = cpu_time - m_frame_update_start;
+  r.cpu_time = cpu_time - m_frame_cpu_time;
+  r.allocation_count = allocations - m_frame_allocations;
+  r.pool_allocation_count =
+    item_pool_base::get_heap_allocation_count() - m_frame_pool_allocations;
+  r.item_count = count_items();
+
+  m_frames.push_back( r );
+} // benchmark::record_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Store the measures at the beginning of a new frame.
+ */
+void rp::benchmark::start_frame()
+{
+  m_frame_cpu_time = get_thread_cpu_time();
+  m_frame_update_start = m_frame_cpu_time;
+  m_frame_allocations = allocation_counter::get_count();
+  m_frame_pool_allocations = item_pool_base::get_heap_allocation_count();
+} // benchmark::start_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of items in the world.
+ */
+std::size_t rp::benchmark::count_items() const
+{
+  const bear::universe::size_box_type size( get_level().get_size() );
+  bear::universe::world::item_list items;
+
+  get_world().pick_items_in_rectangle
+    ( items, bear::universe::rectangle_type( 0, 0, size.x, size.y ) );
+
+  return items.size();
+} // benchmark::count_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the measures in the output file.
+ */
+void rp::benchmark::write_report() const
+{
+  const std::string path( game_variables::get_benchmark_output() );
+  std::ofstream f( path.c_str() );
+
+  if ( !f )
+    {
+      claw::logger << claw::log_error << "Benchmark: cannot write '" << path
+                   << "'." << std::endl;
+      return;
+    }
+
+  const std::string json_extension( ".json" );
+
+  if ( (path.size() >= json_extension.size())
+       && (path.compare
+           ( path.size() - json_extension.size(), json_extension.size(),
+             json_extension ) == 0) )
+    write_json( f );
+  else
+    write_csv( f );
+
+  claw::logger << claw::log_verbose << "Benchmark: " << m_frames.size()
+               << " frames written in '" << path << "'." << std::endl;
+
+  // The pools are filled during the first shots, then the projectiles must
+  // not allocate their memory anymore.
+  std::size_t pool_allocations( 0 );
+
+  for ( std::size_t i( m_frames.size() / 2 ); i < m_frames.size(); ++i )
+    pool_allocations += m_frames[i].pool_allocation_count;
+
+  if ( pool_allocations != 0 )
+    claw::logger << claw::log_warning << "Benchmark: the pools of items "
+                 << "allocated " << pool_allocations
+                 << " blocks in the second half of the run." << std::endl;
+} // benchmark::write_report()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the measures as comma separated values.
+ * \param os The stream in which the measures are written.
+ */
+void rp::benchmark::write_csv( std::ostream& os ) const
+{
+  os << "frame,update_ms,cpu_ms,items,allocations,pool_allocations\n";
+
+  for ( std::size_t i(0); i != m_frames.size(); ++i )
+    os << i << ',' << m_frames[i].update_time << ',' << m_frames[i].cpu_time
+       << ',' << m_frames[i].item_count << ','
+       << m_frames[i].allocation_count << ','
+       << m_frames[i].pool_allocation_count << '\n';
+} // benchmark::write_csv()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the measures as a JSON document.
+ * \param os The stream in which the measures are written.
+ */
+void rp::benchmark::write_json( std::ostream& os ) const
+{
+  os << "{\n  \"level\": \"" << get_level().get_name() << "\",\n"
+     << "  \"seed\": " << random::get_seed() << ",\n"
+     << "  \"allocations_counted\": "
+     << ( allocation_counter::is_enabled() ? "true" : "false" ) << ",\n"
+     << "  \"frames\": [";
+
+  for ( std::size_t i(0); i != m_frames.size(); ++i )
+    {
+      if ( i != 0 )
+        os << ',';
+
+      os << "\n    { \"frame\": " << i
+         << ", \"update_ms\": " << m_frames[i].update_time
+         << ", \"cpu_ms\": " << m_frames[i].cpu_time
+         << ", \"items\": " << m_frames[i].item_count
+         << ", \"allocations\": " << m_frames[i].allocation_count
+         << ", \"pool_allocations\": " << m_frames[i].pool_allocation_count
+         << " }";
+    }
+
+  os << "\n  ]\n}\n";
+} // benchmark::write_json()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the processor time spent by the calling thread, in
+ *        milliseconds.
+ */
+double rp::benchmark::get_thread_cpu_time()
+{
+#ifdef _WIN32
+  FILETIME creation;
+  FILETIME exit;
+  FILETIME kernel;
+  FILETIME user;
+
+  if ( !GetThreadTimes( GetCurrentThread(), &creation, &exit, &kernel, &user ) )
+    return 0;
+
+  ULARGE_INTEGER kernel_time;
+  kernel_time.LowPart = kernel.dwLowDateTime;
+  kernel_time.HighPart = kernel.dwHighDateTime;
+
+  ULARGE_INTEGER user_time;
+  user_time.LowPart = user.dwLowDateTime;
+  user_time.HighPart = user.dwHighDateTime;
+
+  // The times are counted in units of 100 nanoseconds.
+  return ( kernel_time.QuadPart + user_time.QuadPart ) * 1e-4;
+#else
+  timespec t;
+
+  if ( clock_gettime( CLOCK_THREAD_CPUTIME_ID, &t ) != 0 )
+    return 0;
+
+  return t.tv_sec * 1e3 + t.tv_nsec * 1e-6;
+#endif
+} // benchmark::get_thread_cpu_time()
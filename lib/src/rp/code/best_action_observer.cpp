@@ -1,20 +1,8 @@
 #include "rp/best_action_observer.hpp"
 
-#include "rp/balloon.hpp"
-#include "rp/bird.hpp"
-#include "rp/bomb.hpp"
-#include "rp/cable.hpp"
-#include "rp/cannonball.hpp"
-#include "rp/cart.hpp"
-#include "rp/crate.hpp"
-#include "rp/explosion.hpp"
+#include "rp/action_score.hpp"
+#include "rp/capture_writer.hpp"
 #include "rp/game_variables.hpp"
-#include "rp/plunger.hpp"
-#include "rp/switching.hpp"
-#include "rp/tar.hpp"
-#include "rp/tnt.hpp"
-#include "rp/wall.hpp"
-#include "rp/zeppelin.hpp"
 #include "rp/message/level_capture_progress_message.hpp"
 #include "rp/message/level_capture_ready_message.hpp"
 #include "rp/transition_effect/level_ending_effect_default_name.hpp"
@@ -22,81 +10,26 @@
 #include "engine/export.hpp"
 #include "engine/game.hpp"
 #include "engine/system/game_filesystem.hpp"
-#include "universe/world.hpp"
 
-#include <claw/png.hpp>
+#include <claw/logger.hpp>
 
 #include <boost/bind.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/signals2/signal.hpp>
-#include <boost/thread.hpp>
 
-#include <memory>
-#include <unordered_map>
+#include <algorithm>
 
 BASE_ITEM_EXPORT( best_action_observer, rp )
 
-namespace rp
-{
-  namespace detail
-  {
-    struct writer
-    {
-      std::string file_name;
-      claw::graphic::image image;
-      boost::signals2::signal
-      <
-        void( const std::string& save_path, const claw::graphic::image& image )
-        > signal;
-    };
-
-    class bucket_base
-    {
-    public:
-      virtual void insert( bear::universe::physical_item* item ) = 0;
-    };
-      
-    template< typename T >
-    struct bucket:
-      public bucket_base
-    {
-      void insert( bear::universe::physical_item* item ) override
-      {
-        T* casted( dynamic_cast< T* >( item ) );
-        assert( casted != nullptr );
-        items.push_back( casted );
-      }
-      
-      std::vector< T* > items;
-    };
-    
-    struct scan_result
-    {
-      bucket< balloon > balloons;
-      bucket< bird > birds;
-      bucket< bomb > bombs;
-      bucket< cable > cables;
-      bucket< cannonball > cannonballs;
-      bucket< cart > carts;
-      bucket< crate > crates;
-      bucket< explosion > explosions;
-      bucket< plunger > plungers;
-      bucket< switching > switchings;
-      bucket< tar > tars;
-      bucket< tnt > tnts;
-      bucket< wall > walls;
-      bucket< zeppelin > zeppelins;
-    };
-
-    static void fill_buckets
-    ( scan_result& result, const bear::universe::world::item_list& items );
-
-    static unsigned int get_score( const scan_result& items );
-  }
-}
-  
+const bear::universe::time_type
+rp::best_action_observer::s_min_capture_interval( 0.5 );
+
 rp::best_action_observer::best_action_observer()
-: m_best_score( 0 )
+: m_best_score( 0 ),
+  m_pending_score( 0 ),
+  m_time_since_capture( s_min_capture_interval ),
+  m_capture_count( 0 ),
+  m_coalesced_count( 0 ),
+  m_dropped_count( 0 )
 {
   set_global( true );
   set_phantom( true );
@@ -148,6 +81,23 @@ rp::best_action_observer::progress( bear::universe::time_type elapsed_time )
 {
   super::progress( elapsed_time );
 
+  m_time_since_capture += elapsed_time;
+
+  if ( ( m_pending_score != 0 )
+       && ( m_time_since_capture >= s_min_capture_interval ) )
+    {
+      // The scene of the pending score is gone, thus the current scene is
+      // captured with its own score, if it is still the best one.
+      const unsigned int score( action_score::get_total() );
+
+      m_pending_score = 0;
+
+      if ( score > m_best_score )
+        capture( score );
+      else
+        ++m_dropped_count;
+    }
+
   boost::function< void() > f;
 
   {
@@ -162,17 +112,27 @@ rp::best_action_observer::progress( bear::universe::time_type elapsed_time )
 
 void rp::best_action_observer::scan()
 {
-  bear::universe::world::item_list items;
-  get_owner().pick_items_in_rectangle
-    ( items, get_level().get_camera_focus() );
+  const unsigned int score( action_score::get_total() );
 
-  detail::scan_result result;
-  detail::fill_buckets( result, items );
+  if ( score <= std::max( m_best_score, m_pending_score ) )
+    return;
 
-  const double score( detail::get_score( result ) );
+  if ( m_time_since_capture >= s_min_capture_interval )
+    capture( score );
+  else
+    {
+      if ( m_pending_score != 0 )
+        ++m_coalesced_count;
 
-  if ( score <= m_best_score )
-    return;
+      m_pending_score = score;
+    }
+}
+
+void rp::best_action_observer::capture( unsigned int score )
+{
+  ++m_capture_count;
+  m_pending_score = 0;
+  m_time_since_capture = 0;
 
   m_best_score = score;
   m_best_scene = bear::engine::game::get_instance().screen_capture();
@@ -180,6 +140,18 @@ void rp::best_action_observer::scan()
 
 void rp::best_action_observer::render_capture()
 {
+  if ( m_pending_score != 0 )
+    {
+      ++m_dropped_count;
+      m_pending_score = 0;
+    }
+
+  claw::logger << claw::log_verbose << "Best action: " << m_capture_count
+               << " captures, " << m_coalesced_count << " coalesced, "
+               << m_dropped_count << " dropped, "
+               << capture_writer::get_instance().get_coalesced_count()
+               << " coalesced by the writer." << std::endl;
+
   if ( m_best_score == 0 )
     return;
   
@@ -203,24 +175,14 @@ rp::best_action_observer::store_capture( const claw::graphic::image& image )
   boost::system::error_code error;
   boost::filesystem::create_directories( path.parent_path(), error );
     
-  std::shared_ptr< detail::writer > w( new detail::writer() );
+  capture_writer& writer( capture_writer::get_instance() );
 
-  w->file_name = path.string();
-  w->image = image;
-  
+  m_saved_connection.disconnect();
   m_saved_connection =
-    w->signal.connect
+    writer.connect_saved
     ( boost::bind( &best_action_observer::saved, this, _1, _2 ) );
 
-  auto save
-    ( [ this, w ]() -> void
-      {
-        std::ofstream f( w->file_name );
-        claw::graphic::png::writer( w->image, f );
-        w->signal( w->file_name, w->image );
-      } );
-
-  boost::thread( boost::bind< void >( save ) );
+  writer.write( path.string(), image );
 }
 
 void rp::best_action_observer::saved
@@ -253,96 +215,3 @@ void rp::best_action_observer::dispatch_progress( double p )
   get_level_globals().send_message
     ( get_level_ending_effect_default_name(), msg );
 }
-
-void rp::detail::fill_buckets
-( scan_result& result, const bear::universe::world::item_list& items )
-{
-  std::unordered_map< std::string, detail::bucket_base* > buckets;
-  
-  buckets[ balloon::static_class_name() ] = &result.balloons;
-  buckets[ bird::static_class_name() ] = &result.birds;
-  buckets[ bomb::static_class_name() ] = &result.bombs;
-  buckets[ cable::static_class_name() ] = &result.cables;
-  buckets[ cannonball::static_class_name() ] = &result.cannonballs;
-  buckets[ cart::static_class_name() ] = &result.carts;
-  buckets[ crate::static_class_name() ] = &result.crates;
-  buckets[ explosion::static_class_name() ] = &result.explosions;
-  buckets[ plunger::static_class_name() ] = &result.plungers;
-  buckets[ switching::static_class_name() ] = &result.walls;
-  buckets[ tar::static_class_name() ] = &result.tars;
-  buckets[ tnt::static_class_name() ] = &result.tnts;
-  buckets[ wall::static_class_name() ] = &result.walls;
-  buckets[ zeppelin::static_class_name() ] = &result.zeppelins;
-
-  const auto end( buckets.end() );
-  
-  for ( bear::universe::physical_item* item : items )
-    {
-      const std::string class_name
-        ( dynamic_cast< bear::engine::base_item* >( item )->get_class_name() );
-
-      const auto it( buckets.find( class_name ) );
-
-      if ( it != end )
-        it->second->insert( item );
-    }
-}
-
-unsigned int rp::detail::get_score( const scan_result& items )
-{
-  static constexpr unsigned int combo_bonus( 10 );
-  
-  unsigned int result( 0 );
-
-  for ( const auto item : items.balloons.items )
-    result += 10 + 10 * item->has_forced_movement();
-
-  for ( const auto item : items.birds.items )
-    {
-      const bool afraid( item->is_afraid() );
-      const bool dying( item->is_dying() );
-
-      result +=
-        10
-        + 20 * afraid
-        + 10 * item->is_flying()
-        + 10 * dying
-        + combo_bonus * item->get_combo_value() * ( afraid || dying );
-    }
-
-  for ( const auto item : items.bombs.items )
-    result += 10 + 10 * item->has_bottom_contact();
-
-  for ( const auto item : items.cables.items )
-    result += 10 + 10 * item->is_ejected();
-  
-  result += 20 * items.cannonballs.items.size();
-  
-  for ( const auto item : items.carts.items )
-    result +=
-      20 * item->is_jumping()
-      + 30 * item->is_dying()
-      + 10 * item->is_speeding()
-      + 30 * item->is_covered_with_tar()
-      + item->attached_balloon_count();
-
-  result += 10 * items.crates.items.size();
-
-  if ( !items.explosions.items.empty() )
-    result += 30;
-  
-  result += 20 * items.plungers.items.size();
-  result += 10 * items.switchings.items.size();
-  result += 10 * items.tars.items.size();
-  
-  for ( const auto item : items.walls.items )
-    result += 10 + 10 * item->impact_count() / 3;
-  
-  for ( const auto item : items.zeppelins.items )
-    result += 10 + 10 * ( item->get_drop_item() != nullptr );
-
-  result += 10 * items.tnts.items.size();
-    
-  return result;
-}
-
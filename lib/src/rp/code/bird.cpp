@@ -19,13 +19,18 @@
 #include "rp/crate.hpp"
 #include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/particle_system.hpp"
 #include "rp/cable.hpp"
 #include "rp/plank.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
 #include "rp/wall.hpp"
 #include "rp/zeppelin.hpp"
 
+#include "engine/level.hpp"
 #include "generic_items/explosion_effect_item.hpp"
 #include "universe/collision_info.hpp"
 #include "universe/zone.hpp"
@@ -68,8 +73,24 @@ void rp::bird::on_enters_layer()
   start_model_action("idle");
 
   create_interactive_item(*this);
+
+  m_action_score.attach( *this );
+  update_action_score();
 } // rp::bird::on_enters_layer()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one iteration in the progression of the item.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void rp::bird::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/bird" );
+
+  super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
+} // rp::bird::progress()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with an other item.
@@ -81,17 +102,10 @@ void rp::bird::collision
 {
   super::collision(that, info);
 
-  if ( ! collision_with_cannonball(that) )
-    if ( ! collision_with_explosion(that,info) )
-      if ( ! collision_with_cart(that) )
-        if ( ! collision_with_cable(that) )
-          if ( ! collision_with_wall(that) )
-            if ( ! collision_with_tar(that) )
-              if ( ! collision_with_balloon(that) )
-                  if ( ! collision_with_crate(that, info) )
-                    if ( ! collision_with_bird(that,info) )
-                      if ( ! collision_with_zeppelin(that,info) )
-                        collision_with_plank(that);
+  static const collision_dispatcher<bird> dispatcher
+    ( create_collision_dispatcher() );
+
+  dispatcher.dispatch( *this, that, info );
 } // bird::collision()
 
 /*----------------------------------------------------------------------------*/
@@ -101,8 +115,8 @@ void rp::bird::collision
  */
 void rp::bird::afraid(bool give_points)
 {
-  if ( get_current_action_name() != "hit" && 
-       get_current_action_name() != "dead" )
+  if ( get_current_action_id() != model_action_id::hit && 
+       get_current_action_id() != model_action_id::dead )
     {
       if ( give_points )
         util::create_floating_score(*this,50);
@@ -112,8 +126,9 @@ void rp::bird::afraid(bool give_points)
       
       set_speed(bear::universe::speed_type(0,0));
       
-      game_variables::set_action_snapshot();
       start_model_action("afraid");
+      update_action_score();
+      game_variables::set_action_snapshot();
     }
 } // bird::afraid()
 
@@ -123,8 +138,8 @@ void rp::bird::afraid(bool give_points)
  */
 void rp::bird::plunger_collision()
 {
-  if ( get_current_action_name() != "hit" && 
-       get_current_action_name() != "dead" )
+  if ( get_current_action_id() != model_action_id::hit && 
+       get_current_action_id() != model_action_id::dead )
     {
       if ( get_combo_value() == 0 )
         set_combo_value(1);
@@ -139,19 +154,20 @@ void rp::bird::plunger_collision()
 
 bool rp::bird::is_afraid() const
 {
-  const std::string& action( get_current_action_name() );
+  const model_action_id::value_type action( get_current_action_id() );
   
-  return ( action == "afraid" ) || ( action == "hit" );
+  return ( action == model_action_id::afraid )
+    || ( action == model_action_id::hit );
 }
 
 bool rp::bird::is_dying() const
 {
-  return get_current_action_name() == "dead";
+  return get_current_action_id() == model_action_id::dead;
 }
 
 bool rp::bird::is_flying() const
 {
-  return get_current_action_name() == "fly";
+  return get_current_action_id() == model_action_id::fly;
 }
 
 /*----------------------------------------------------------------------------*/
@@ -166,6 +182,29 @@ void rp::bird::populate_loader_map( bear::engine::item_loader_map& m )
   m.insert( entity::loader( *this ) );
 } // bird::populate_loader_map()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the collision handlers, by type of the other item.
+ */
+rp::collision_dispatcher<rp::bird> rp::bird::create_collision_dispatcher()
+{
+  collision_dispatcher<bird> result;
+
+  result.add<&bird::collision_with_cannonball>( item_type::cannonball );
+  result.add<&bird::collision_with_explosion>( item_type::explosion );
+  result.add<&bird::collision_with_cart>( item_type::cart );
+  result.add<&bird::collision_with_cable>( item_type::cable );
+  result.add<&bird::collision_with_wall>( item_type::wall );
+  result.add<&bird::collision_with_tar>( item_type::tar );
+  result.add<&bird::collision_with_balloon>( item_type::balloon );
+  result.add<&bird::collision_with_crate>( item_type::crate );
+  result.add<&bird::collision_with_bird>( item_type::bird );
+  result.add<&bird::collision_with_zeppelin>( item_type::zeppelin );
+  result.add<&bird::collision_with_plank>( item_type::plank );
+
+  return result;
+} // bird::create_collision_dispatcher()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with a cannonbal.
@@ -174,25 +213,19 @@ void rp::bird::populate_loader_map( bear::engine::item_loader_map& m )
  */
 bool rp::bird::collision_with_cannonball( bear::engine::base_item& that )
 { 
-  bool result = false;
-  cannonball* c = dynamic_cast<cannonball*>(&that);
-  
-  if ( c != NULL ) 
-    {
-      if ( get_current_action_name() != "hit" && 
-           get_current_action_name() != "dead" )
-        {
-          set_combo_value( c->get_combo_value() );
-          start_model_action("hit");
-          game_variables::set_action_snapshot();
-        }
+  cannonball* c = static_cast<cannonball*>(&that);
 
-      c->kill();
-      
-      result = true;
+  if ( get_current_action_id() != model_action_id::hit && 
+       get_current_action_id() != model_action_id::dead )
+    {
+      set_combo_value( c->get_combo_value() );
+      start_model_action("hit");
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+
+  c->kill();
+
+  return true;
 } // bird::collision_with_cannonball()
 
 /*----------------------------------------------------------------------------*/
@@ -205,25 +238,19 @@ bool rp::bird::collision_with_cannonball( bear::engine::base_item& that )
 bool rp::bird::collision_with_explosion
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  explosion* e = dynamic_cast<explosion*>(&that);
-  
-  if ( e != NULL ) 
+  explosion* e = static_cast<explosion*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) && 
+       e->test_in_explosion(info) )
     {
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) && 
-           e->test_in_explosion(info) )
-        {
-          if ( e->get_combo_value() != 0 )
-            set_combo_value(e->get_combo_value()+1);
-          start_model_action("hit");
-          game_variables::set_action_snapshot();
-        }
-      
-      result = true;
+      if ( e->get_combo_value() != 0 )
+        set_combo_value(e->get_combo_value()+1);
+      start_model_action("hit");
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_explosion()
 
 /*----------------------------------------------------------------------------*/
@@ -234,24 +261,18 @@ bool rp::bird::collision_with_explosion
  */
 bool rp::bird::collision_with_cart( bear::engine::base_item& that )
 { 
-  bool result = false;
-  cart* c = dynamic_cast<cart*>(&that);
-  
-  if ( c != NULL ) 
+  cart* c = static_cast<cart*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) )
     {
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) )
-        {
-          set_combo_value(0);
-          start_model_action("hit");
-          c->is_hit();
-          game_variables::set_action_snapshot();
-        }
-         
-      result = true;
+      set_combo_value(0);
+      start_model_action("hit");
+      c->is_hit();
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_cart()
 
 /*----------------------------------------------------------------------------*/
@@ -262,24 +283,18 @@ bool rp::bird::collision_with_cart( bear::engine::base_item& that )
  */
 bool rp::bird::collision_with_cable( bear::engine::base_item& that )
 { 
-  bool result = false;
-  cable* c = dynamic_cast<cable*>(&that);
-  
-  if ( c != NULL ) 
+  cable* c = static_cast<cable*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) )
     {
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) )
-        {
-          if ( c->is_ejected() && ( c->get_combo_value() != 0 ) )
-            set_combo_value(c->get_combo_value()+1);
-          start_model_action("hit");
-          game_variables::set_action_snapshot();
-        }
-      
-      result = true;
+      if ( c->is_ejected() && ( c->get_combo_value() != 0 ) )
+        set_combo_value(c->get_combo_value()+1);
+      start_model_action("hit");
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_cable()
 
 /*----------------------------------------------------------------------------*/
@@ -292,31 +307,25 @@ bool rp::bird::collision_with_cable( bear::engine::base_item& that )
 bool rp::bird::collision_with_crate
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  crate* c = dynamic_cast<crate*>(&that);
-  
-  if ( c != NULL ) 
+  crate* c = static_cast<crate*>(&that);
+
+  if ( get_current_action_id() != model_action_id::hit && 
+       get_current_action_id() != model_action_id::dead && 
+       c->get_current_action_name() != "explose"  &&
+       info.get_collision_side() != bear::universe::zone::middle_zone )
     {
-      if ( get_current_action_name() != "hit" && 
-           get_current_action_name() != "dead" && 
-           c->get_current_action_name() != "explose"  &&
-           info.get_collision_side() != bear::universe::zone::middle_zone )
-        {
-          bool mirror = get_horizontal_middle() < c->get_horizontal_middle();
-          
-          get_rendering_attributes().mirror( mirror );
-          afraid();
+      bool mirror = get_horizontal_middle() < c->get_horizontal_middle();
 
-          if ( mirror )
-            set_speed(bear::universe::speed_type(-10,0));
-          else
-            set_speed(bear::universe::speed_type(10,0));
-        }
-      
-      result = true;
+      get_rendering_attributes().mirror( mirror );
+      afraid();
+
+      if ( mirror )
+        set_speed(bear::universe::speed_type(-10,0));
+      else
+        set_speed(bear::universe::speed_type(10,0));
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_crate()
 
 /*----------------------------------------------------------------------------*/
@@ -327,24 +336,18 @@ bool rp::bird::collision_with_crate
  */
 bool rp::bird::collision_with_plank( bear::engine::base_item& that )
 { 
-  bool result = false;
-  plank* p = dynamic_cast<plank*>(&that);
-  
-  if ( p != NULL ) 
+  plank* p = static_cast<plank*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) )
     {
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) )
-        {
-          if ( p->get_combo_value() != 0 )
-            set_combo_value(p->get_combo_value()+1);
-          start_model_action("hit");
-          game_variables::set_action_snapshot();
-        }
-      
-      result = true;
+      if ( p->get_combo_value() != 0 )
+        set_combo_value(p->get_combo_value()+1);
+      start_model_action("hit");
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_plank()
 
 /*----------------------------------------------------------------------------*/
@@ -355,21 +358,13 @@ bool rp::bird::collision_with_plank( bear::engine::base_item& that )
  */
 bool rp::bird::collision_with_wall( bear::engine::base_item& that )
 { 
-  bool result = false;
-  wall* w = dynamic_cast<wall*>(&that);
-  
-  if ( w != NULL ) 
-    {
-      get_rendering_attributes().mirror
-        (! get_rendering_attributes().is_mirrored());
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) )
-        start_fly();
+  get_rendering_attributes().mirror
+    (! get_rendering_attributes().is_mirrored());
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) )
+    start_fly();
 
-      result = true;
-    }
-  
-  return result;
+  return true;
 } // bird::collision_with_wall()
 
 /*----------------------------------------------------------------------------*/
@@ -380,32 +375,26 @@ bool rp::bird::collision_with_wall( bear::engine::base_item& that )
  */
 bool rp::bird::collision_with_tar( bear::engine::base_item& that )
 { 
-  bool result = false;
-  tar* t = dynamic_cast<tar*>(&that);
-  
-  if ( t != NULL ) 
-    {     
-      if ( ( get_current_action_name() != "hit" ) && 
-           ( get_current_action_name() != "dead" ) )
+  tar* t = static_cast<tar*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) && 
+       ( get_current_action_id() != model_action_id::dead ) )
+    {
+      if ( t->get_current_action_name() == "idle" )
         {
-          if ( t->get_current_action_name() == "idle" )
-            {
-              if ( get_combo_value() != 0 )
-                t->set_combo_value(get_combo_value()+1);
-            }
-          else if ( t->get_combo_value() != 0 )
-            set_combo_value(t->get_combo_value()+1);
-          
-          start_model_action("hit");
-          game_variables::set_action_snapshot();
+          if ( get_combo_value() != 0 )
+            t->set_combo_value(get_combo_value()+1);
         }
-      make_dirty();
-      t->kill();
+      else if ( t->get_combo_value() != 0 )
+        set_combo_value(t->get_combo_value()+1);
 
-      result = true;
+      start_model_action("hit");
+      game_variables::set_action_snapshot();
     }
-  
-  return result;
+  make_dirty();
+  t->kill();
+
+  return true;
 } // bird::collision_with_tar()
 
 /*----------------------------------------------------------------------------*/
@@ -416,24 +405,18 @@ bool rp::bird::collision_with_tar( bear::engine::base_item& that )
  */
 bool rp::bird::collision_with_balloon( bear::engine::base_item& that )
 { 
-  bool result = false;
-  balloon* b = dynamic_cast<balloon*>(&that);
-  
-  if ( b != NULL )
-    {     
-      if ( (get_current_action_name() != "dead")
-           && (get_current_action_name() != "afraid") )
-        {
-          if ( b->get_current_action_name() != "explose" )
-            b->explose();
+  balloon* b = static_cast<balloon*>(&that);
 
-          afraid(false);
-        }
+  if ( (get_current_action_id() != model_action_id::dead)
+       && (get_current_action_id() != model_action_id::afraid) )
+    {
+      if ( b->get_current_action_name() != "explose" )
+        b->explose();
 
-      result = true;
+      afraid(false);
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -446,31 +429,25 @@ bool rp::bird::collision_with_balloon( bear::engine::base_item& that )
 bool rp::bird::collision_with_bird
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  bird* b = dynamic_cast<bird*>(&that);
-  
-  if ( b != NULL ) 
-    {     
-      if ( ( get_current_action_name() != "hit" ) &&
-           ( get_current_action_name() != "dead" ) &&
-           ( info.get_collision_side() != bear::universe::zone::middle_zone) )
-        {
-          update_combo_value(b);
-          bool mirror = get_horizontal_middle() < b->get_horizontal_middle();
-          
-          get_rendering_attributes().mirror( mirror );
-          afraid();
+  bird* b = static_cast<bird*>(&that);
 
-          if ( mirror )
-            set_speed(bear::universe::speed_type(-10,0));
-          else
-            set_speed(bear::universe::speed_type(10,0));
-        }
+  if ( ( get_current_action_id() != model_action_id::hit ) &&
+       ( get_current_action_id() != model_action_id::dead ) &&
+       ( info.get_collision_side() != bear::universe::zone::middle_zone) )
+    {
+      update_combo_value(b);
+      bool mirror = get_horizontal_middle() < b->get_horizontal_middle();
+
+      get_rendering_attributes().mirror( mirror );
+      afraid();
 
-      result = true;
+      if ( mirror )
+        set_speed(bear::universe::speed_type(-10,0));
+      else
+        set_speed(bear::universe::speed_type(10,0));
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_bird()
 
 /*----------------------------------------------------------------------------*/
@@ -483,46 +460,40 @@ bool rp::bird::collision_with_bird
 bool rp::bird::collision_with_zeppelin
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  zeppelin* z = dynamic_cast<zeppelin*>(&that);
-  
-  if ( z != NULL ) 
-    {     
-      if ( ( get_current_action_name() != "hit" ) &&
-           ( get_current_action_name() != "dead" ) )
+  zeppelin* z = static_cast<zeppelin*>(&that);
+
+  if ( ( get_current_action_id() != model_action_id::hit ) &&
+       ( get_current_action_id() != model_action_id::dead ) )
+    {
+      if ( z->has_forced_movement() )
         {
-          if ( z->has_forced_movement() )
-            {
-              z->explose();
-              if ( z->get_combo_value() > 0 )
-                set_combo_value(z->get_combo_value()+1);
-
-              game_variables::set_action_snapshot();
-              start_model_action("hit");
-            }
-          else if ( info.get_collision_side() != 
-                    bear::universe::zone::middle_zone )
-            {
-              if ( z->get_combo_value() <= get_combo_value() )
-                z->set_combo_value( get_combo_value() + 1 );
-              z->drop();
-              bool mirror = 
-                get_horizontal_middle() < z->get_horizontal_middle();
-          
-              get_rendering_attributes().mirror( mirror );
-              afraid();
-              
-              if ( mirror )
-                set_speed(bear::universe::speed_type(-10,0));
-              else
-                set_speed(bear::universe::speed_type(10,0));
-            }
+          z->explose();
+          if ( z->get_combo_value() > 0 )
+            set_combo_value(z->get_combo_value()+1);
+
+          game_variables::set_action_snapshot();
+          start_model_action("hit");
         }
+      else if ( info.get_collision_side() != 
+                bear::universe::zone::middle_zone )
+        {
+          if ( z->get_combo_value() <= get_combo_value() )
+            z->set_combo_value( get_combo_value() + 1 );
+          z->drop();
+          bool mirror = 
+            get_horizontal_middle() < z->get_horizontal_middle();
+
+          get_rendering_attributes().mirror( mirror );
+          afraid();
 
-      result = true;
+          if ( mirror )
+            set_speed(bear::universe::speed_type(-10,0));
+          else
+            set_speed(bear::universe::speed_type(10,0));
+        }
     }
-  
-  return result;
+
+  return true;
 } // bird::collision_with_zeppelin()
 
 /*----------------------------------------------------------------------------*/
@@ -539,6 +510,8 @@ void rp::bird::start_fly()
   
   mvt.set_speed(speed);  
   set_forced_movement( mvt );
+
+  update_action_score();
 } // rp::bird::start_fly()
 
 /*----------------------------------------------------------------------------*/
@@ -562,6 +535,8 @@ void rp::bird::start_hit()
     set_angular_speed( -4 );
   else
     set_angular_speed( 4 );
+
+  update_action_score();
 } // rp::bird::start_hit()
 
 /*----------------------------------------------------------------------------*/
@@ -573,6 +548,26 @@ void rp::bird::make_dirty()
   get_rendering_attributes().set_intensity(0,0,0);
 } // bird::make_dirty()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the contribution of the bird to the score of the action.
+ *
+ * The hit action goes to the dead action without calling the bird, thus the
+ * bird is counted as dying as soon as it is hit.
+ */
+void rp::bird::update_action_score()
+{
+  static const unsigned int combo_bonus( 10 );
+
+  const bool dying
+    ( is_dying() || ( get_current_action_id() == model_action_id::hit ) );
+  const bool afraid( !dying && is_afraid() );
+
+  m_action_score.set
+    ( 10 + 20 * afraid + 10 * is_flying() + 10 * dying
+      + combo_bonus * get_combo_value() * ( afraid || dying ) );
+} // bird::update_action_score()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with the beak.
@@ -597,6 +592,17 @@ void rp::bird::on_beak_collision
  */
 void rp::bird::create_explosion_feathers()
 {
+  particle_system* const particles( particle_system::get_instance() );
+
+  if ( particles != NULL )
+    {
+      for ( std::size_t i(0); i != 20; ++i )
+        particles->add_flying_feather
+          ( get_center_of_mass(), get_z_position() + 1 );
+
+      return;
+    }
+
   bear::explosion_effect_item* explo = new bear::explosion_effect_item;
 
   explo->set_size( get_size() );
@@ -621,8 +627,19 @@ void rp::bird::create_explosion_feathers()
  */
 void rp::bird::create_feathers()
 {
+  particle_system* const particles( particle_system::get_instance() );
+
   for ( unsigned int i = 0; i != 5; ++i )
-    create_feather();
+    if ( particles == NULL )
+      {
+        if ( population_manager::can_spawn
+             ( population_manager::decoration_feather ) )
+          create_feather();
+      }
+    else
+      particles->add_floating_feather
+        ( get_center_of_mass() + bear::universe::position_type(0, 50),
+          get_z_position() + 1 );
 } // bird::create_explosion_feathers()
 
 /*----------------------------------------------------------------------------*/
@@ -660,6 +677,8 @@ void rp::bird::create_feather()
   bear::decorative_item* item = new bear::decorative_item;
   set_feather(item);
   new_item( *item );
+  population_manager::add_decoration
+    ( population_manager::decoration_feather, *item );
   CLAW_ASSERT( item->is_valid(),
                  "The feather of bird isn't correctly initialized" );
 
@@ -667,7 +686,7 @@ void rp::bird::create_feather()
   bear::universe::forced_rotation mvt2;
   mvt2.set_radius( 50.0 );
   mvt2.set_acceleration_time(0.2);
-  double alea = (double)rand() / RAND_MAX;
+  double alea = random::effects().real();
   mvt2.set_start_angle( -2.17 + alea * 0.3);
   mvt2.set_end_angle( -0.97 - alea * 0.3);
   mvt2.set_loop_back(true);
@@ -692,11 +711,11 @@ void rp::bird::set_feather_anchor_reference
   ref->set_artificial(true);
   ref->set_can_move_items(true);
   ref->set_mass(0.001);
-  double alea = (double)rand() / RAND_MAX;
+  double alea = random::effects().real();
   ref->set_friction(0.6 + alea * 0.2);
 
-  double r1=(double)rand()/(double)RAND_MAX;
-  double r2=(double)rand()/(double)RAND_MAX;
+  double r1 = random::effects().real();
+  double r2 = random::effects().real();
   bear::universe::force_type force(300*(r1-0.5), 250*(r2-0.5));
   ref->add_external_force(force);
 
@@ -734,7 +753,7 @@ void rp::bird::set_feather(bear::decorative_item* item)
 
   item->set_friction(0.7);
 
-  double r = 2* ((double)rand() / (double)RAND_MAX);
+  double r = 2 * random::effects().real();
   if ( r >= 1 )
     item->set_sprite
       (glob.auto_sprite("gfx/bird/bird.png", "feather, brown"));
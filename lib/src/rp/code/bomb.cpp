@@ -19,11 +19,14 @@
 #include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
 #include "rp/obstacle.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
 #include "rp/wall.hpp"
 #include "rp/zeppelin.hpp"
 
+#include "engine/level.hpp"
 #include "universe/forced_movement/forced_stay_around.hpp"
 #include "universe/forced_movement/forced_tracking.hpp"
 
@@ -41,7 +44,7 @@ const double rp::bomb::s_initial_mass = 1;
  * \brief Constructor.
  */
 rp::bomb::bomb()
-: m_explosed(false)
+: m_explosed(false), m_bottom_contact(false)
 {
   set_mass(s_initial_mass);
   set_density(0.002);
@@ -49,7 +52,7 @@ rp::bomb::bomb()
   
   set_system_angle
     ( -boost::math::constants::pi<double>() / 3
-      + (double)rand() / RAND_MAX * boost::math::constants::pi<double>() / 6 );
+      + random::gameplay().real() * boost::math::constants::pi<double>() / 6 );
 
   set_system_angle_as_visual_angle( true );
 } // rp::bomb::bomb()
@@ -77,6 +80,9 @@ void rp::bomb::on_enters_layer()
   set_model_actor( get_level_globals().get_model("model/bomb.cm") );
   start_model_action("idle");
   create_interactive_item(*this);
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::bomb::on_enters_layer()
 
 /*---------------------------------------------------------------------------*/
@@ -86,7 +92,10 @@ void rp::bomb::on_enters_layer()
  */
 void rp::bomb::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/bomb" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   if ( has_bottom_contact() )
     { 
@@ -98,6 +107,14 @@ void rp::bomb::progress( bear::universe::time_type elapsed_time )
       else
         clear_forced_movement();
     }
+
+  // The world sets the contacts without notifying the bomb, thus the
+  // contribution is updated when the contact differs from the previous one.
+  if ( has_bottom_contact() != m_bottom_contact )
+    {
+      m_bottom_contact = !m_bottom_contact;
+      m_action_score.set( 10 + 10 * m_bottom_contact );
+    }
 } // bomb::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -14,6 +14,7 @@
 #include "rp/bonus.hpp"
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/profiler.hpp"
 
 #include "universe/collision_info.hpp"
 #include "engine/level_globals.hpp"
@@ -76,6 +77,8 @@ void rp::bonus::on_enters_layer()
  */
 void rp::bonus::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/bonus" );
+
   super::progress( elapsed_time );
 
   if ( m_bonus_is_given )
@@ -158,8 +161,8 @@ void rp::bonus::collision
   cart* c = dynamic_cast<cart*>(&that);
   
   if ( c != NULL )
-    if ( c->get_current_action_name() != "dead" && 
-         c->get_current_action_name() != "takeoff" )
+    if ( c->get_current_action_id() != model_action_id::dead && 
+         c->get_current_action_id() != model_action_id::takeoff )
       {
         m_bonus_is_given = true;
         give_bonus(c);
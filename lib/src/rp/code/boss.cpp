@@ -20,6 +20,9 @@
 #include "rp/game_variables.hpp"
 #include "rp/interactive_item.hpp"
 #include "rp/plunger.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
 #include "rp/transition_effect/level_ending_effect.hpp"
 #include "rp/util.hpp"
 #include "rp/zeppelin.hpp"
@@ -138,6 +141,8 @@ void rp::boss::on_enters_layer()
  */
 void rp::boss::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/boss" );
+
   super::progress( elapsed_time );
   
   remove_drop_items();
@@ -359,7 +364,7 @@ void rp::boss::progress_injured_state()
 {
   if ( game_variables::is_boss_transition() && m_module_serial == 6 )
     {
-      double d = (double)rand() / RAND_MAX;
+      double d = random::effects().real();
       
       if ( d < 0.5 )
         util::create_smoke( *get_model_mark_item("cabin 2"), 1, 0.3, 0.8, -1 );
@@ -386,12 +391,12 @@ void rp::boss::progress_end( bear::universe::time_type elapsed_time )
   if ( m_cart != NULL )
     if ( ! m_cart->can_finish() )
       {
-        double d = (double)rand() / RAND_MAX;
+        double d = random::effects().real();
         
         if ( d < 0.3 )
           {
-            double width = (double)rand() * get_width() / RAND_MAX;
-            double height = (double)rand() * get_height() / RAND_MAX;
+            double width = random::effects().real() * get_width();
+            double height = random::effects().real() * get_height();
             
             explosion* item = new explosion(2,0,0.2,true);
             item->set_z_position(get_z_position() + 10);
@@ -407,7 +412,7 @@ void rp::boss::progress_end( bear::universe::time_type elapsed_time )
             
             if ( d < 0.05 )
               {
-                unsigned int alea = rand() % 5 + 1;
+                unsigned int alea = random::sounds().integer(5) + 1;
                 std::ostringstream stream;
                 stream << "sound/explosion/explosion-" << alea << ".ogg";
                 get_level_globals().play_sound
@@ -1778,6 +1783,10 @@ void rp::boss::create_help_item( const bear::visual::animation& animation )
  */
 void rp::boss::create_hit_star()
 {
+  if ( !population_manager::can_spawn
+       ( population_manager::decoration_hit_star ) )
+    return;
+
   bear::star* s =
     new bear::star
     ( 30, 0.9, bear::visual::color_type("#E0E0E0"), 3,
@@ -1790,6 +1799,8 @@ void rp::boss::create_hit_star()
   s->set_z_position( get_z_position() - 1 );
   
   new_item(*s);
+  population_manager::add_decoration
+    ( population_manager::decoration_hit_star, *s );
 
   s->set_center_of_mass(get_center_of_mass());
   
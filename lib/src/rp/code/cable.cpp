@@ -15,8 +15,11 @@
 #include "rp/cart.hpp"
 #include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/profiler.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/util.hpp"
 
+#include "engine/level.hpp"
 #include "universe/collision_info.hpp"
 #include "universe/zone.hpp"
 
@@ -55,6 +58,9 @@ void rp::cable::on_enters_layer()
   set_mass(100);
   set_model_actor( get_level_globals().get_model("model/cable.cm") );
   start_model_action("idle");
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::cable::on_enters_layer()
 
 /*---------------------------------------------------------------------------*/
@@ -64,7 +70,10 @@ void rp::cable::on_enters_layer()
  */
 void rp::cable::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/cable" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   if ( m_is_ejected )
     set_weak_collisions(true);
@@ -79,10 +88,11 @@ void rp::cable::progress( bear::universe::time_type elapsed_time )
 void rp::cable::collision
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 {
-  if ( ! collision_with_cart(that, info) )
-    if ( ! collision_with_explosion(that, info) )
-      if ( ! collision_with_cable(that, info) )
-        super::collision(that, info);
+  static const collision_dispatcher<cable> dispatcher
+    ( create_collision_dispatcher() );
+
+  if ( ! dispatcher.dispatch( *this, that, info ) )
+    super::collision(that, info);
 } // cable::collision()
 
 /*----------------------------------------------------------------------------*/
@@ -94,6 +104,21 @@ bool rp::cable::is_ejected() const
   return m_is_ejected;
 } // cable::is_ejected()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the collision handlers, by type of the other item.
+ */
+rp::collision_dispatcher<rp::cable> rp::cable::create_collision_dispatcher()
+{
+  collision_dispatcher<cable> result;
+
+  result.add<&cable::collision_with_cart>( item_type::cart );
+  result.add<&cable::collision_with_explosion>( item_type::explosion );
+  result.add<&cable::collision_with_cable>( item_type::cable );
+
+  return result;
+} // cable::create_collision_dispatcher()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with a cart.
@@ -104,36 +129,31 @@ bool rp::cable::is_ejected() const
 bool rp::cable::collision_with_cart
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  cart* c = dynamic_cast<cart*>(&that);
-  
-  if ( c != NULL ) 
+  cart* c = static_cast<cart*>(&that);
+
+  if ( ( info.get_collision_side() == bear::universe::zone::top_zone ) &&
+       c->get_current_action_id() != model_action_id::jump && 
+        ! m_is_ejected )
+    c->jump();
+  else if (info.get_collision_side() != bear::universe::zone::middle_zone)
     {
-      if ( ( info.get_collision_side() == bear::universe::zone::top_zone ) &&
-           c->get_current_action_name() != "jump" && 
-            ! m_is_ejected )
-        c->jump();
-      else if (info.get_collision_side() != bear::universe::zone::middle_zone)
+      if ( ! m_is_ejected )
         {
-          if ( ! m_is_ejected )
-            {
-              set_combo_value(0);          
-              eject
-                ( c->get_horizontal_middle() < get_horizontal_middle(), false );
-            }
-          
-          if ( ! m_has_hit )
-            {
-              m_has_hit = true;
-              c->is_hit();
-            }
+          set_combo_value(0);          
+          eject
+            ( c->get_horizontal_middle() < get_horizontal_middle(), false );
         }
 
-      game_variables::set_action_snapshot();
-      result = true;
+      if ( ! m_has_hit )
+        {
+          m_has_hit = true;
+          c->is_hit();
+        }
     }
-  
-  return result;
+
+  game_variables::set_action_snapshot();
+
+  return true;
 } // cable::collision_with_cart()
 
 /*----------------------------------------------------------------------------*/
@@ -146,23 +166,18 @@ bool rp::cable::collision_with_cart
 bool rp::cable::collision_with_cable
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  cable* c = dynamic_cast<cable*>(&that);
-  
-  if ( c != NULL ) 
+  cable* c = static_cast<cable*>(&that);
+
+  if ( c->is_ejected() && ! m_is_ejected )
     {
-      if ( c->is_ejected() && ! m_is_ejected )
-        {
-          if ( c->get_combo_value() != 0 )
-            set_combo_value(c->get_combo_value()+1);            
-          eject( c->get_horizontal_middle() < get_horizontal_middle() );
-        }
-      super::collision(that, info);
-      result = true;
-      game_variables::set_action_snapshot();
+      if ( c->get_combo_value() != 0 )
+        set_combo_value(c->get_combo_value()+1);            
+      eject( c->get_horizontal_middle() < get_horizontal_middle() );
     }
-  
-  return result;
+  super::collision(that, info);
+  game_variables::set_action_snapshot();
+
+  return true;
 } // cable::collision_with_cable()
 
 /*----------------------------------------------------------------------------*/
@@ -175,23 +190,18 @@ bool rp::cable::collision_with_cable
 bool rp::cable::collision_with_explosion
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 { 
-  bool result = false;
-  explosion* e = dynamic_cast<explosion*>(&that);
-  
-  if ( e != NULL ) 
+  explosion* e = static_cast<explosion*>(&that);
+
+  if ( ! m_is_ejected && e->test_in_explosion(info) )
     {
-      if ( ! m_is_ejected && e->test_in_explosion(info) )
-        {
-          if ( e->get_combo_value() != 0 )
-            set_combo_value(e->get_combo_value()+1);          
-          eject( e->get_horizontal_middle() < get_horizontal_middle() );
-        }
-  
-      game_variables::set_action_snapshot();
-      result = true;
+      if ( e->get_combo_value() != 0 )
+        set_combo_value(e->get_combo_value()+1);          
+      eject( e->get_horizontal_middle() < get_horizontal_middle() );
     }
-  
-  return result;
+
+  game_variables::set_action_snapshot();
+
+  return true;
 } // cable::collision_with_explosion()
 
 /*----------------------------------------------------------------------------*/
@@ -209,6 +219,7 @@ void rp::cable::eject(bool on_right, bool give_score)
 
   set_phantom(true);
   m_is_ejected = true;
+  m_action_score.set( 20 );
 
   if ( on_right )
     {
@@ -223,6 +234,7 @@ void rp::cable::eject(bool on_right, bool give_score)
 
   set_system_angle_as_visual_angle(true);
   
-  get_level_globals().play_sound
-    ( "sound/boing.ogg", bear::audio::sound_effect( get_center_of_mass() ) );
+  sound_bank::play
+    ( get_level_globals(), sound_bank::boing_sample,
+      bear::audio::sound_effect( get_center_of_mass() ) );
 } // cable::eject()
@@ -15,6 +15,9 @@
 #include "rp/cable.hpp" 
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/item_pool.hpp"
+#include "rp/profiler.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
 
@@ -39,6 +42,27 @@ rp::cannonball::cannonball()
   set_system_angle_as_visual_angle( true );
 } // rp::cannonball()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the memory of an instance from the pool of the class.
+ * \param size The size of the memory.
+ */
+void* rp::cannonball::operator new( std::size_t size )
+{
+  return item_pool<cannonball>::get_instance().allocate( size );
+} // rp::cannonball::operator new()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Give back the memory of an instance to the pool of the class.
+ * \param p The memory of the instance.
+ * \param size The size of the memory.
+ */
+void rp::cannonball::operator delete( void* p, std::size_t size )
+{
+  item_pool<cannonball>::get_instance().release( p, size );
+} // rp::cannonball::operator delete()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Load the media required by this class.
@@ -62,6 +86,8 @@ void rp::cannonball::on_enters_layer()
   set_model_actor( get_level_globals().get_model("model/cannonball.cm") );
   start_model_action("idle");
   m_sight_position = NULL;
+  m_action_score.attach( *this );
+  m_action_score.set( 20 );
 
   create_trace();
 } // rp::cannonball::on_enters_layer()
@@ -73,7 +99,10 @@ void rp::cannonball::on_enters_layer()
  */
 void rp::cannonball::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/cannonball" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
   
   if ( ( get_center_of_mass().distance
          (m_sight_position->get_center_of_mass()) <= 30 ) ||
@@ -223,8 +252,8 @@ bool rp::cannonball::collision_with_cable
 
       result = true;
 
-      get_level_globals().play_sound
-        ( "sound/hit-2.ogg",
+      sound_bank::play
+        ( get_level_globals(), sound_bank::hit_sample,
           bear::audio::sound_effect( get_center_of_mass() ) );
     }
   
@@ -0,0 +1,104 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+#include "rp/capture_writer.hpp"
+
+#include <claw/png.hpp>
+
+#include <boost/bind.hpp>
+
+#include <utility>
+#include <fstream>
+
+rp::capture_writer& rp::capture_writer::get_instance()
+{
+  static capture_writer result;
+  return result;
+}
+
+boost::signals2::connection
+rp::capture_writer::connect_saved( const signal_type::slot_type& f )
+{
+  return m_saved.connect( f );
+}
+
+void rp::capture_writer::write
+( const std::string& file_name, const claw::graphic::image& image )
+{
+  {
+    const boost::unique_lock< boost::mutex > lock( m_mutex );
+
+    if ( m_pending )
+      ++m_coalesced;
+
+    m_pending = true;
+    m_pending_file_name = file_name;
+
+    // The assignment keeps the storage of the buffer, swapped with the one of
+    // the worker, when the size of the captures does not change.
+    m_pending_image = image;
+
+    if ( m_thread.get_id() == boost::thread::id() )
+      m_thread = boost::thread( boost::bind( &capture_writer::run, this ) );
+  }
+
+  m_condition.notify_one();
+}
+
+std::size_t rp::capture_writer::get_coalesced_count() const
+{
+  const boost::unique_lock< boost::mutex > lock( m_mutex );
+  return m_coalesced;
+}
+
+rp::capture_writer::capture_writer()
+  : m_quit( false ), m_pending( false ), m_coalesced( 0 )
+{
+
+}
+
+rp::capture_writer::~capture_writer()
+{
+  {
+    const boost::unique_lock< boost::mutex > lock( m_mutex );
+    m_quit = true;
+  }
+
+  m_condition.notify_one();
+
+  if ( m_thread.joinable() )
+    m_thread.join();
+}
+
+void rp::capture_writer::run()
+{
+  while ( true )
+    {
+      {
+        boost::unique_lock< boost::mutex > lock( m_mutex );
+
+        while ( !m_pending && !m_quit )
+          m_condition.wait( lock );
+
+        // The pending capture is written even if the worker must stop.
+        if ( !m_pending )
+          return;
+
+        m_pending = false;
+        m_file_name.swap( m_pending_file_name );
+        std::swap( m_image, m_pending_image );
+      }
+
+      {
+        std::ofstream f( m_file_name.c_str(), std::ios::binary );
+        claw::graphic::png::writer( m_image, f );
+      }
+
+      m_saved( m_file_name, m_image );
+    }
+}
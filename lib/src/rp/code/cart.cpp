@@ -26,8 +26,13 @@
 #include "rp/explosion.hpp"
 #include "rp/hole.hpp"
 #include "rp/level_exit.hpp"
+#include "rp/music_player.hpp"
 #include "rp/obstacle.hpp"
 #include "rp/plunger.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/switching.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
@@ -148,6 +153,7 @@ void rp::cart::pre_cache()
 {
   super::pre_cache();
 
+  get_level_globals().load_model("model/balloon.cm");
   get_level_globals().load_model("model/cannonball.cm");
   get_level_globals().load_model("model/cart.cm");
   get_level_globals().load_model("model/plunger.cm");
@@ -229,6 +235,7 @@ void rp::cart::on_enters_layer()
   save_position();
   init_elements(); 
   create_cursor();
+  m_action_score.attach( *this );
 
   if ( game_variables::interstitial_scheduled() )
     {
@@ -245,10 +252,13 @@ void rp::cart::on_enters_layer()
  */
 void rp::cart::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/cart" );
+
   if ( ! game_variables::is_level_ending() ) 
     progress_spot( elapsed_time );
 
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   if ( !m_passive )
     m_cursor->set_center_of_mass
@@ -266,13 +276,14 @@ void rp::cart::progress( bear::universe::time_type elapsed_time )
       if ( m_progress != NULL )
         (this->*m_progress)(elapsed_time);
       
-      if ( get_current_action_name() != "with_tar" )
+      if ( get_current_action_id() != model_action_id::with_tar )
         {
           progress_arm_angle();
           progress_cannon();
           progress_plunger();
           progress_fire();
-          set_mark_position_in_action("gun", compute_gun_position());
+          set_mark_position_in_action
+            ( model_mark_id::gun, compute_gun_position() );
         }
     }
 
@@ -311,6 +322,8 @@ void rp::cart::progress( bear::universe::time_type elapsed_time )
 void
 rp::cart::get_visual( std::list<bear::engine::scene_visual>& visuals ) const
 {
+  RP_PROFILE_ZONE( "render/cart" );
+
    super::get_visual(visuals);
 
    #if 0
@@ -401,7 +414,7 @@ void rp::cart::create_cannon_fire()
 {
   bear::engine::model_mark_placement mark_fire;
   
-  if ( get_mark_placement("fire", mark_fire) )
+  if ( get_mark_placement(model_mark_id::fire, mark_fire) )
     set_global_substitute
       ( "fire",
         new bear::visual::animation
@@ -440,8 +453,8 @@ void rp::cart::finish_plunger
 {
   if ( attracted_item != plunger::handle_type(NULL) )
     {
-      if ( get_current_action_name() != "takeoff" && 
-           get_current_action_name() != "dead")
+      if ( get_current_action_id() != model_action_id::takeoff && 
+           get_current_action_id() != model_action_id::dead)
         {
           if ( attracted_item->get_type() == "balloon" )
             add_balloon(attracted_item.get());
@@ -544,6 +557,7 @@ void rp::cart::die( bool right, bool left )
     add_external_force(bear::universe::force_type(4000000,5000000));
 
   get_level_globals().stop_all_musics( 0.5 );
+  music_player::get_instance().stop( 0.5 );
   get_level_globals().play_sound( "music/cart/dead.ogg" );
 
   get_level_globals().play_sound
@@ -556,7 +570,7 @@ void rp::cart::die( bool right, bool left )
  */
 void rp::cart::jump()
 {
-  if ( get_current_action_name() != "dead" )
+  if ( get_current_action_id() != model_action_id::dead )
     {
       bear::universe::speed_type speed(get_speed());
       speed.y = 0;
@@ -625,8 +639,8 @@ void rp::cart::set_looping(bool looping )
  */
 void rp::cart::apply_takeoff()
 {
-  if ( ( get_current_action_name() != "dead" ) && 
-       ( get_current_action_name() != "takeoff" ) )
+  if ( ( get_current_action_id() != model_action_id::dead ) && 
+       ( get_current_action_id() != model_action_id::takeoff ) )
     {
       if ( game_variables::is_boss_level() )
         game_variables::set_balloons_number(20);
@@ -759,22 +773,22 @@ const bear::timer* rp::cart::get_level_timer() const
 
 bool rp::cart::is_jumping() const
 {
-  return get_current_action_name() == "jump";
+  return get_current_action_id() == model_action_id::jump;
 }
 
 bool rp::cart::is_dying() const
 {
-  return get_current_action_name() == "dead";
+  return get_current_action_id() == model_action_id::dead;
 }
   
 bool rp::cart::is_speeding() const
 {
-  return get_current_action_name() == "crouch";
+  return get_current_action_id() == model_action_id::crouch;
 }
 
 bool rp::cart::is_covered_with_tar() const
 {
-  return get_current_action_name() == "with_tar";
+  return get_current_action_id() == model_action_id::with_tar;
 }
 
 unsigned int rp::cart::attached_balloon_count() const
@@ -842,6 +856,8 @@ void rp::cart::add_balloon(attractable_item* attracted_item)
 
   create_link_on_balloon
     (item,stream.str(),game_variables::get_balloons_number());
+
+  update_action_score();
 } // cart::add_balloon()
 
 /*---------------------------------------------------------------------------*/
@@ -898,6 +914,7 @@ void rp::cart::lose_balloons(unsigned int nb)
 
           m_balloons.front()->kill();
           m_balloons.pop_front();
+          update_action_score();
         }
       
       game_variables::set_balloons_number
@@ -922,7 +939,7 @@ void rp::cart::add_plunger_link
     {
        bear::engine::model_mark_placement mark_gun;
        
-       if ( get_mark_placement("gun", mark_gun) )
+       if ( get_mark_placement(model_mark_id::gun, mark_gun) )
          {
            std::vector<bear::universe::position_type>v;
            v.push_back(mark_gun.get_position());
@@ -952,10 +969,10 @@ void rp::cart::add_bad_plunger_zone
       bear::engine::model_mark_placement mark;
       bear::engine::model_mark_placement arm_mark;
       
-      if ( ( get_current_action_name() != "with_tar" ) && 
-           ( get_current_action_name() != "takeoff" ) && 
-           ( get_current_action_name() != "dead" ) &&
-           ( get_current_action_name() != "crouch" ) &&
+      if ( ( get_current_action_id() != model_action_id::with_tar ) && 
+           ( get_current_action_id() != model_action_id::takeoff ) && 
+           ( get_current_action_id() != model_action_id::dead ) &&
+           ( get_current_action_id() != model_action_id::crouch ) &&
            ! game_variables::is_level_ending() )
         {
           std::vector<bear::visual::position_type> p(4);
@@ -1006,6 +1023,10 @@ void rp::cart::break_element
   if ( get_mark_placement(asset, element) )
     {
       set_global_substitute(asset, new bear::visual::animation());
+
+      if ( !population_manager::can_spawn
+           ( population_manager::decoration_debris ) )
+        return;
       
       bear::decorative_item* item = new bear::decorative_item;
       item->set_animation
@@ -1024,6 +1045,8 @@ void rp::cart::break_element
       item->set_center_of_mass(element.get_position());
       
       new_item( *item );
+      population_manager::add_decoration
+        ( population_manager::decoration_debris, *item );
       
       CLAW_ASSERT( item->is_valid(),
                    "The decoration of cart isn't correctly initialized" );
@@ -1136,7 +1159,7 @@ void rp::cart::progress_spot( bear::universe::time_type elapsed_time )
   bool balance_x(true);
   bool balance_y(true);
 
-  if ( get_current_action_name() == "dead" ) 
+  if ( get_current_action_id() == model_action_id::dead ) 
     {
       balance_y = false;
       
@@ -1303,10 +1326,10 @@ bool rp::cart::can_throw_cannonball()
   if ( m_fire_duration >= s_fire_duration )
     if ( get_current_local_mark_placement("cannon", m) )
       {    
-        if ( ( get_current_action_name() != "dead" ) && 
-             ( get_current_action_name() != "crouch" ) &&
-             ( get_current_action_name() != "with_tar" ) &&
-             ( get_current_action_name() != "takeoff" ) &&
+        if ( ( get_current_action_id() != model_action_id::dead ) && 
+             ( get_current_action_id() != model_action_id::crouch ) &&
+             ( get_current_action_id() != model_action_id::with_tar ) &&
+             ( get_current_action_id() != model_action_id::takeoff ) &&
              game_variables::level_has_started() )
           result = true;
       }
@@ -1324,13 +1347,13 @@ bool rp::cart::can_throw_plunger()
   
   bear::engine::model_mark_placement m;
 
-  if ( get_mark_placement("plunger", m) )
+  if ( get_mark_placement(model_mark_id::plunger, m) )
     {  
       if ( ( m_plungers.size() < game_variables::get_plunger_total_number()) &&
-           ( get_current_action_name() != "dead" ) && 
-           ( get_current_action_name() != "crouch" ) &&
-           ( get_current_action_name() != "with_tar" ) &&
-           ( get_current_action_name() != "takeoff" )  &&
+           ( get_current_action_id() != model_action_id::dead ) && 
+           ( get_current_action_id() != model_action_id::crouch ) &&
+           ( get_current_action_id() != model_action_id::with_tar ) &&
+           ( get_current_action_id() != model_action_id::takeoff )  &&
            game_variables::level_has_started() )
         result = true;
     }
@@ -1392,8 +1415,8 @@ void rp::cart::throw_plunger()
   bear::engine::model_mark_placement mark_arm;
   bear::engine::model_mark_placement mark_plunger;
   
-  if ( get_mark_placement("arm", mark_arm) )
-    if ( get_mark_placement("plunger", mark_plunger) )
+  if ( get_mark_placement(model_mark_id::arm, mark_arm) )
+    if ( get_mark_placement(model_mark_id::plunger, mark_plunger) )
       {
         plunger * p;
         p = new plunger;
@@ -1452,6 +1475,7 @@ void rp::cart::clear_balloons()
     (*it)->kill();
 
   m_balloons.clear();
+  update_action_score();
 } // cart::clear_balloons()
 
 /*----------------------------------------------------------------------------*/
@@ -1477,7 +1501,7 @@ void rp::cart::give_force_movement()
   bear::universe::force_type force
     ( m_ground_force * (1 + force_factor * std::sin(angle)) );
 
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     {
       double crouch_factor( 1 );
 
@@ -1497,7 +1521,7 @@ void rp::cart::give_force_movement()
   // check minimal speed 
   bear::universe::coordinate_type min_length( s_min_speed_length );
   
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     min_length *= 2;
 
   if ( ( get_speed().length() < min_length ) && 
@@ -1595,8 +1619,8 @@ void rp::cart::progress_arm_angle()
   bear::engine::model_mark_placement m;
 
   if ( ( m_cursor != NULL ) &&
-       get_mark_placement("arm", m) && 
-       ( get_current_action_name() != "dead" ) )
+       get_mark_placement(model_mark_id::arm, m) && 
+       ( get_current_action_id() != model_action_id::dead ) )
     {
       bear::universe::position_type sight = m_cursor->get_target();
       bear::universe::position_type pos =
@@ -1628,14 +1652,15 @@ void rp::cart::progress_plunger()
   bear::engine::model_mark_placement arm_mark;
   bear::engine::model_mark_placement plunger_mark;
 
-  if ( get_mark_placement("plunger", plunger_mark) && 
-       get_mark_placement("arm", arm_mark) )
+  if ( get_mark_placement(model_mark_id::plunger, plunger_mark) && 
+       get_mark_placement(model_mark_id::arm, arm_mark) )
     {
       set_mark_visibility_in_action
         ("plunger", 
          (m_plungers.size() < game_variables::get_plunger_total_number() ) && 
-         (get_current_action_name() != "crouch" ) );
-      set_mark_position_in_action("plunger", get_plunger_position());
+         (get_current_action_id() != model_action_id::crouch ) );
+      set_mark_position_in_action
+        ( model_mark_id::plunger, get_plunger_position() );
       set_mark_angle_in_action("plunger", m_arm_angle);
     }
 } // cart::progress_plunger()
@@ -1649,8 +1674,8 @@ void rp::cart::progress_cannon()
   bear::engine::model_mark_placement m;
 
   if ( ( m_cursor != NULL ) &&
-       get_mark_placement("cannon", m) && 
-       get_current_action_name() != "dead" )
+       get_mark_placement(model_mark_id::cannon, m) && 
+       get_current_action_id() != model_action_id::dead )
     {
       bear::universe::position_type pos =
         get_mark_world_position("cannon");
@@ -1841,7 +1866,7 @@ void rp::cart::check_crouch()
 {
   if ( m_want_crouch ) 
     start_model_action("crouch");
-  else if ( get_current_action_name() != "move" )
+  else if ( get_current_action_id() != model_action_id::move )
     start_model_action("move");
 } // cart::check_crouch()
 
@@ -1852,6 +1877,7 @@ void rp::cart::check_crouch()
 void rp::cart::start_idle()
 {
   m_progress = &rp::cart::progress_idle;
+  update_action_score();
 } // cart::start_idle()
 
 /*----------------------------------------------------------------------------*/
@@ -1861,6 +1887,7 @@ void rp::cart::start_idle()
 void rp::cart::start_move()
 {
   m_progress = &rp::cart::progress_move;
+  update_action_score();
 } // cart::start_move()
 
 /*----------------------------------------------------------------------------*/
@@ -1870,6 +1897,7 @@ void rp::cart::start_move()
 void rp::cart::start_jump()
 {
   m_progress = &rp::cart::progress_jump;
+  update_action_score();
 } // cart::start_jump()
 
 /*----------------------------------------------------------------------------*/
@@ -1879,6 +1907,7 @@ void rp::cart::start_jump()
 void rp::cart::start_fall()
 {
   m_progress = &rp::cart::progress_fall;
+  update_action_score();
 } // cart::start_fall()
 
 /*----------------------------------------------------------------------------*/
@@ -1888,6 +1917,7 @@ void rp::cart::start_fall()
 void rp::cart::start_crouch()
 {
   m_progress = &rp::cart::progress_crouch;
+  update_action_score();
 } // cart::start_crouch()
 
 /*----------------------------------------------------------------------------*/
@@ -1897,6 +1927,7 @@ void rp::cart::start_crouch()
 void rp::cart::start_dead()
 {
   m_progress = &rp::cart::progress_dead;
+  update_action_score();
 } // cart::start_dead()
 
 /*----------------------------------------------------------------------------*/
@@ -1921,11 +1952,12 @@ void rp::cart::start_takeoff()
       m_balloons.push_front(item);
       
       item->fly
-        ( (double)rand() * 3 / RAND_MAX, 
-          50 + (double)rand() * 200 / RAND_MAX,true);
+        ( random::effects().real() * 3,
+          50 + random::effects().real() * 200, true );
     }
 
   m_takeoff_duration = 0;
+  update_action_score();
 } // cart::start_takeoff()
 
 /*----------------------------------------------------------------------------*/
@@ -1935,6 +1967,7 @@ void rp::cart::start_takeoff()
 void rp::cart::start_with_tar()
 {
   m_progress = &rp::cart::progress_with_tar;
+  update_action_score();
 } // cart::start_with_tar()
 
 /*----------------------------------------------------------------------------*/
@@ -1980,8 +2013,8 @@ void rp::cart::apply_crouch()
 {
   m_want_crouch = true;
 
-  if ( ( ( get_current_action_name() == "idle" ) ||
-         ( get_current_action_name() == "move" ) ) && 
+  if ( ( ( get_current_action_id() == model_action_id::idle ) ||
+         ( get_current_action_id() == model_action_id::move ) ) && 
        m_plungers.empty() )
     start_model_action("crouch");
 } // player::apply_crouch()
@@ -1994,7 +2027,7 @@ void rp::cart::apply_stop_crouch()
 {
   m_want_crouch = false;
 
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     start_model_action("move");
 } // player::apply_crouch()
 
@@ -2017,8 +2050,8 @@ bool rp::cart::key_pressed( const bear::input::key_info& key )
       if ( game_variables::level_has_started() &&
            ! game_variables::is_level_ending() &&
            m_can_jump && 
-           ( ( get_current_action_name() == "move" ) ||
-             ( get_current_action_name() == "crouch" ) ) )
+           ( ( get_current_action_id() == model_action_id::move ) ||
+             ( get_current_action_id() == model_action_id::crouch ) ) )
         apply_impulse_jump();
     }
   else if ( game_variables::level_has_started() && 
@@ -2178,7 +2211,7 @@ bool rp::cart::finger_action( const bear::input::finger_event& event )
  */
 void rp::cart::input_handle_cannonball()
 {
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     apply_stop_crouch();
   else if ( can_throw_cannonball() )
     throw_cannonball();
@@ -2195,7 +2228,7 @@ void rp::cart::input_handle_cannonball()
  */
 void rp::cart::input_handle_plunger()
 {
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     apply_stop_crouch();
   else if ( can_throw_plunger() )
     throw_plunger();
@@ -2212,11 +2245,11 @@ void rp::cart::input_handle_plunger()
  */
 void rp::cart::input_handle_jump()
 {
-  if ( get_current_action_name() == "crouch" )
+  if ( get_current_action_id() == model_action_id::crouch )
     apply_stop_crouch();
   else if ( !game_variables::is_level_ending() && m_can_jump && 
-            ( ( get_current_action_name() == "move" ) ||
-              ( get_current_action_name() == "crouch" ) ) )
+            ( ( get_current_action_id() == model_action_id::move ) ||
+              ( get_current_action_id() == model_action_id::crouch ) ) )
     apply_impulse_jump();
 } // cart::input_handle_jump()
 
@@ -2263,7 +2296,7 @@ void rp::cart::on_toggle_on
 {
   super::on_toggle_on(activator);
 
-  if ( get_current_action_name() == "idle" )
+  if ( get_current_action_id() == model_action_id::idle )
     start_model_action("move");
 } // cart::on_toggle_on()
 
@@ -2278,44 +2311,11 @@ void rp::cart::on_painter_collision
 ( bear::engine::base_item& mark, bear::engine::base_item& that,
   bear::universe::collision_info& info )
 {
-  if ( get_current_action_name() != "dead" ) 
-    {
-      hole* p = dynamic_cast<hole*>(&that);
-
-      if ( p != NULL )
-	die( info.get_collision_side() == 
-             bear::universe::zone::middle_right_zone,
-             info.get_collision_side() == 
-             bear::universe::zone::middle_left_zone );
-      else if ( ! collision_with_tar(that) )
-        {
-          bird* b = dynamic_cast<bird*>(&that);
-
-          if ( b != NULL )
-            b->collision(*this,info);
-          else
-             {
-               obstacle* o = dynamic_cast<obstacle*>(&that);
-               
-               if ( o != NULL )
-                 o->collision(*this,info);
-               else
-                 {
-                   bomb* bo = dynamic_cast<bomb*>(&that);
-                   
-                   if ( bo != NULL )
-                     bo->collision(*this,info);
-                   else
-                     {
-                       zeppelin* z = dynamic_cast<zeppelin*>(&that);
-                       
-                       if ( z != NULL )
-                         z->collision(*this,info);
-                     }
-                 }
-             }
-        }
-    }
+  static const collision_dispatcher<cart> dispatcher
+    ( create_painter_collision_dispatcher() );
+
+  if ( get_current_action_id() != model_action_id::dead ) 
+    dispatcher.dispatch( *this, that, info );
 } // cart::on_painter_collision()
 
 /*----------------------------------------------------------------------------*/
@@ -2331,12 +2331,10 @@ void rp::cart::collision
 
   m_speed_on_contact = get_speed();
 
-  switching* s = dynamic_cast<switching*>(&that);
-  if ( s != NULL ) 
-    m_on_switching = true;
-  else if ( ! collision_with_tar(that) )
-    if ( !collision_with_explosion(that, info) )
-      collision_with_cannonball(that);
+  static const collision_dispatcher<cart> dispatcher
+    ( create_collision_dispatcher() );
+
+  dispatcher.dispatch( *this, that, info );
 } // cart::collision()
 
 /*----------------------------------------------------------------------------*/
@@ -2346,7 +2344,9 @@ void rp::cart::collision
  */
 void rp::cart::create_wave( bool double_wave )
 {
-  if ( ! game_variables::is_boss_transition() )
+  if ( ! game_variables::is_boss_transition()
+       && population_manager::can_spawn
+       ( population_manager::decoration_wave ) )
     {
       bear::decorative_item* item = new bear::decorative_item;
       if ( double_wave )
@@ -2375,6 +2375,8 @@ void rp::cart::create_wave( bool double_wave )
       item->set_center_of_mass(m_cursor->get_center_of_mass());
       
       new_item( *item );
+      population_manager::add_decoration
+        ( population_manager::decoration_wave, *item );
       
       CLAW_ASSERT
         ( item->is_valid(),
@@ -2425,15 +2427,18 @@ void rp::cart::update_bottom_contact()
        ( !m_previous_top_contact && has_top_contact() 
 	 && (m_speed_on_contact.y > 0) ) )
     {
-      const double sound_selector = (double)rand() / RAND_MAX;
+      const double sound_selector = random::sounds().real();
       const bear::audio::sound_effect e(get_center_of_mass());;
 
       if ( sound_selector < 1.0 / 3.0 )
-        get_level_globals().play_sound("sound/metal-2.ogg", e);
+        sound_bank::play
+          ( get_level_globals(), sound_bank::metal_2_sample, e );
       else if ( sound_selector < 2.0 / 3.0 )
-        get_level_globals().play_sound("sound/metal-3.ogg", e);
+        sound_bank::play
+          ( get_level_globals(), sound_bank::metal_3_sample, e );
       else
-        get_level_globals().play_sound("sound/metal-4.ogg", e);
+        sound_bank::play
+          ( get_level_globals(), sound_bank::metal_4_sample, e );
     }
 
   m_previous_bottom_contact = has_bottom_contact();
@@ -2470,6 +2475,19 @@ void rp::cart::update_status_informations()
         game_variables::set_plunger_validity( plunger_validity ); 
 } // cart::update_status_information()
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Update the contribution of the cart to the score of the action. This
+ *        method is called when an action starts and when the count of
+ *        balloons changes.
+ */
+void rp::cart::update_action_score()
+{
+  m_action_score.set
+    ( 20 * is_jumping() + 30 * is_dying() + 10 * is_speeding()
+      + 30 * is_covered_with_tar() + attached_balloon_count() );
+} // cart::update_action_score()
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief Test if rp::cart is in the sky and change state thereof.
@@ -2533,6 +2551,87 @@ bear::universe::position_type rp::cart::compute_fire_position() const
     return bear::universe::position_type();
 } // cart::compute_fire_position()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the handlers of the collisions of the body of the
+ *        cart, by type of the other item.
+ */
+rp::collision_dispatcher<rp::cart> rp::cart::create_collision_dispatcher()
+{
+  collision_dispatcher<cart> result;
+
+  result.add<&cart::collision_with_switching>( item_type::switching );
+  result.add<&cart::collision_with_tar>( item_type::tar );
+  result.add<&cart::collision_with_explosion>( item_type::explosion );
+  result.add<&cart::collision_with_cannonball>( item_type::cannonball );
+
+  return result;
+} // cart::create_collision_dispatcher()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the handlers of the collisions of the painter
+ *        mark, by type of the other item.
+ */
+rp::collision_dispatcher<rp::cart>
+rp::cart::create_painter_collision_dispatcher()
+{
+  collision_dispatcher<cart> result;
+
+  result.add<&cart::collision_with_hole>( item_type::hole );
+  result.add<&cart::collision_with_tar>( item_type::tar );
+  result.add<&cart::forward_collision>( item_type::bird );
+  result.add<&cart::forward_collision>( item_type::obstacle );
+  result.add<&cart::forward_collision>( item_type::cable );
+  result.add<&cart::forward_collision>( item_type::crate );
+  result.add<&cart::forward_collision>( item_type::tnt );
+  result.add<&cart::forward_collision>( item_type::bomb );
+  result.add<&cart::forward_collision>( item_type::zeppelin );
+
+  return result;
+} // cart::create_painter_collision_dispatcher()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Process a collision with a switching.
+ * \param that The other item of the collision.
+ * \return Return True if the collision is with a switching.
+ */
+bool rp::cart::collision_with_switching( bear::engine::base_item& that )
+{
+  m_on_switching = true;
+  return true;
+} // cart::collision_with_switching()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Process a collision of the painter with a hole.
+ * \param that The other item of the collision.
+ * \param info Some informations about the collision.
+ * \return Return True if the collision is with a hole.
+ */
+bool rp::cart::collision_with_hole
+( bear::engine::base_item& that, bear::universe::collision_info& info )
+{
+  die( info.get_collision_side() == bear::universe::zone::middle_right_zone,
+       info.get_collision_side() == bear::universe::zone::middle_left_zone );
+  return true;
+} // cart::collision_with_hole()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Let the other item process a collision with the painter.
+ * \param that The other item of the collision.
+ * \param info Some informations about the collision.
+ * \return Always true.
+ */
+bool rp::cart::forward_collision
+( bear::engine::base_item& that, bear::universe::collision_info& info )
+{
+  that.collision( *this, info );
+  return true;
+} // cart::forward_collision()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with a tar.
@@ -2541,28 +2640,22 @@ bear::universe::position_type rp::cart::compute_fire_position() const
  */
 bool rp::cart::collision_with_tar( bear::engine::base_item& that )
 { 
-  bool result = false;
-  tar* t = dynamic_cast<tar*>(&that);
-  
-  if ( t != NULL ) 
-    {
-      if ( ( get_current_action_name() != "with_tar" )  && 
-           ( ( t->get_current_action_name() == "idle" ) || 
-             ( t->get_current_action_name() == "fall" ) ) )
-        {
-          game_variables::set_action_snapshot();
-          start_model_action("with_tar");
-          get_level_globals().play_sound
-            ( "sound/tar/splash.ogg",
-              bear::audio::sound_effect( t->get_center_of_mass() ) );
+  tar* t = static_cast<tar*>(&that);
 
-          t->kill();
-        }
+  if ( ( get_current_action_id() != model_action_id::with_tar )  && 
+       ( ( t->get_current_action_name() == "idle" ) || 
+         ( t->get_current_action_name() == "fall" ) ) )
+    {
+      game_variables::set_action_snapshot();
+      start_model_action("with_tar");
+      get_level_globals().play_sound
+        ( "sound/tar/splash.ogg",
+          bear::audio::sound_effect( t->get_center_of_mass() ) );
 
-      result = true;
+      t->kill();
     }
-  
-  return result;
+
+  return true;
 } // cart::collision_with_tar()
 
 /*----------------------------------------------------------------------------*/
@@ -2575,18 +2668,12 @@ bool rp::cart::collision_with_tar( bear::engine::base_item& that )
 bool rp::cart::collision_with_explosion
 ( bear::engine::base_item& that, bear::universe::collision_info& info  )
 { 
-  bool result = false;
-  explosion* e = dynamic_cast<explosion*>(&that);
-  
-  if ( e != NULL ) 
-    {
-      if ( e->test_in_explosion(info) )
-        is_hit();
+  explosion* e = static_cast<explosion*>(&that);
 
-      result = true;
-    }
-  
-  return result;
+  if ( e->test_in_explosion(info) )
+    is_hit();
+
+  return true;
 } // cart::collision_with_explosion()
 
 /*----------------------------------------------------------------------------*/
@@ -2597,23 +2684,14 @@ bool rp::cart::collision_with_explosion
  */
 bool rp::cart::collision_with_cannonball( bear::engine::base_item& that )
 { 
-  bool result = false;
-
-  cannonball* c = dynamic_cast<cannonball*>(&that);
-  
-  if ( c != NULL )
+  if ( m_passive && !m_is_injured )
     {
-      if ( m_passive && !m_is_injured )
-        {
-          is_hit();
-          give_impulse_force();
-          create_balloons( 10 );
-        }
-
-      result = true;
+      is_hit();
+      give_impulse_force();
+      create_balloons( 10 );
     }
-  
-  return result;
+
+  return true;
 } // cart::collision_with_cannonball()
 
 /*----------------------------------------------------------------------------*/
@@ -2630,8 +2708,8 @@ void rp::cart::create_balloons( std::size_t count ) const
       item->set_artificial( true );
 
       const bear::universe::force_type f
-        ( ((double)rand() / RAND_MAX + 1) * 5000,
-          ((double)rand() / RAND_MAX + 1) * 2000 );
+        ( (random::gameplay().real() + 1) * 5000,
+          (random::gameplay().real() + 1) * 2000 );
 
       item->add_internal_force( f );
 
@@ -2664,6 +2742,7 @@ void rp::cart::check_takeoff()
       m_takeoff_duration = 0;
       
       get_level_globals().stop_all_musics(0.5);
+      music_player::get_instance().stop( 0.5 );
       
       if ( game_variables::get_balloons_number() >= 
            game_variables::get_required_balloons_number())
@@ -2739,7 +2818,7 @@ void rp::cart::on_combo_changed(unsigned int combo)
 std::string rp::cart::get_combo_sample_name( unsigned int combo ) const
 {
   std::string result;
-  const double sound_selector = (double)rand() / RAND_MAX;
+  const double sound_selector = random::sounds().real();
  
   if ( combo == 3 )
     {
@@ -0,0 +1,101 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::collision_dispatcher_statistics and
+ *        rp::collision_table classes.
+ * \author Julien Jorge
+ */
+#include "rp/collision_dispatcher.hpp"
+
+#include "rp/profiler.hpp"
+
+/*----------------------------------------------------------------------------*/
+std::size_t rp::collision_dispatcher_statistics::s_dispatch_count( 0 );
+std::vector<rp::collision_table::row> rp::collision_table::s_handlers;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count a collision dispatched by a dispatcher.
+ */
+void rp::collision_dispatcher_statistics::add_dispatch()
+{
+  ++s_dispatch_count;
+} // collision_dispatcher_statistics::add_dispatch()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of collisions dispatched since the last reset.
+ */
+std::size_t rp::collision_dispatcher_statistics::get_dispatch_count()
+{
+  return s_dispatch_count;
+} // collision_dispatcher_statistics::get_dispatch_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Reset the statistics.
+ */
+void rp::collision_dispatcher_statistics::reset()
+{
+  s_dispatch_count = 0;
+} // collision_dispatcher_statistics::reset()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a row without handler in the table, for a new dispatcher.
+ * \return The index of the row.
+ */
+std::size_t rp::collision_table::add_row()
+{
+  row r;
+  r.fill( NULL );
+  s_handlers.push_back( r );
+
+  return s_handlers.size() - 1;
+} // collision_table::add_row()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the handler of a dispatcher for a type of the other item.
+ * \param self The row of the dispatcher.
+ * \param that The type of the other item.
+ * \param h The handler.
+ */
+void rp::collision_table::set
+( std::size_t self, item_type::value_type that, handler h )
+{
+  s_handlers[ self ][ that ] = h;
+} // collision_table::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Call the handler of a dispatcher for the type of the other item of a
+ *        collision.
+ * \param self The row of the dispatcher.
+ * \param item The item receiving the collision.
+ * \param that The other item.
+ * \param info Some informations about the collision.
+ * \return true if a handler has been called.
+ */
+bool rp::collision_table::dispatch
+( std::size_t self, bear::engine::base_item& item,
+  bear::engine::base_item& that, bear::universe::collision_info& info )
+{
+  RP_PROFILE_ZONE( "collision" );
+
+  collision_dispatcher_statistics::add_dispatch();
+
+  const handler h( s_handlers[ self ][ item_type::get( that ) ] );
+
+  if ( h == NULL )
+    return false;
+
+  return h( item, that, info );
+} // collision_table::dispatch()
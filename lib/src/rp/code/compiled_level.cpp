@@ -0,0 +1,469 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::compiled_level class.
+ * \author Julien Jorge
+ */
+#include "rp/compiled_level.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+/*----------------------------------------------------------------------------*/
+const char rp::compiled_level::s_magic[4] = { 'R', 'P', 'C', 'L' };
+const uint32_t rp::compiled_level::s_version( 1 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of a section, including the padding up to the next
+ *        multiple of eight bytes.
+ * \param size The size of the data of the section.
+ */
+static std::size_t rp_compiled_level_align( std::size_t size )
+{
+  return ( size + 7 ) & ~std::size_t( 7 );
+} // rp_compiled_level_align()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor. Maps the file and checks its sections.
+ * \param file_name The path to the file of the level.
+ */
+rp::compiled_level::compiled_level( const std::string& file_name )
+  : m_file( file_name ), m_value_count( 0 ), m_string_count( 0 ),
+    m_item_count( 0 ), m_strings( NULL ), m_characters( NULL ),
+    m_kinds( NULL ), m_values( NULL ), m_items( NULL ), m_position( 0 ),
+    m_good( false )
+{
+  m_good = m_file.is_open() && read_header();
+} // compiled_level::compiled_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the file has been mapped and is a valid level.
+ */
+bool rp::compiled_level::is_open() const
+{
+  return m_items != NULL;
+} // compiled_level::is_open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of values in the level.
+ */
+std::size_t rp::compiled_level::get_value_count() const
+{
+  return m_value_count;
+} // compiled_level::get_value_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of distinct strings in the level.
+ */
+std::size_t rp::compiled_level::get_string_count() const
+{
+  return m_string_count;
+} // compiled_level::get_string_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of items defined in the level.
+ */
+std::size_t rp::compiled_level::get_item_count() const
+{
+  return m_item_count;
+} // compiled_level::get_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a string of the table.
+ * \param i The index of the string.
+ */
+std::string rp::compiled_level::get_string( std::size_t i ) const
+{
+  assert( i < m_string_count );
+
+  const char* const entry( m_strings + 8 * i );
+
+  return std::string
+    ( m_characters + read_uint32( entry ), read_uint32( entry + 4 ) );
+} // compiled_level::get_string()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the kind of a value.
+ * \param i The index of the value.
+ */
+rp::compiled_level::value_kind
+rp::compiled_level::get_kind( std::size_t i ) const
+{
+  assert( i < m_value_count );
+
+  return value_kind( m_kinds[i] );
+} // compiled_level::get_kind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Continue the reading at the first value of an item.
+ * \param i The index of the item.
+ */
+void rp::compiled_level::seek_item( std::size_t i )
+{
+  assert( i < m_item_count );
+
+  m_position = read_uint32( m_items + 4 * i );
+} // compiled_level::seek_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the next value to read.
+ */
+std::size_t rp::compiled_level::get_position() const
+{
+  return m_position;
+} // compiled_level::get_position()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next value as a string.
+ * \param v (out) The value.
+ */
+rp::compiled_level& rp::compiled_level::operator>>( std::string& v )
+{
+  std::size_t i;
+
+  if ( !next_value( i ) )
+    return *this;
+
+  switch ( get_kind( i ) )
+    {
+    case integer_value:
+      {
+        char buffer[32];
+        std::sprintf( buffer, "%lld", (long long)get_integer( i ) );
+        v = buffer;
+        break;
+      }
+    case real_value:
+      v = format_real( get_real( i ) );
+      break;
+    case string_value:
+      v = get_string( get_integer( i ) );
+      break;
+    }
+
+  return *this;
+} // compiled_level::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next value as a signed integer.
+ * \param v (out) The value.
+ */
+rp::compiled_level& rp::compiled_level::operator>>( int& v )
+{
+  std::size_t i;
+
+  if ( !next_value( i ) )
+    return *this;
+
+  int64_t value;
+
+  if ( !get_integer_value( i, value )
+       || ( value < std::numeric_limits<int>::min() )
+       || ( value > std::numeric_limits<int>::max() ) )
+    m_good = false;
+  else
+    v = value;
+
+  return *this;
+} // compiled_level::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next value as an unsigned integer.
+ * \param v (out) The value.
+ */
+rp::compiled_level& rp::compiled_level::operator>>( unsigned int& v )
+{
+  std::size_t i;
+
+  if ( !next_value( i ) )
+    return *this;
+
+  int64_t value;
+
+  if ( !get_integer_value( i, value ) || ( value < 0 )
+       || ( value > std::numeric_limits<unsigned int>::max() ) )
+    m_good = false;
+  else
+    v = value;
+
+  return *this;
+} // compiled_level::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next value as a real number.
+ * \param v (out) The value.
+ */
+rp::compiled_level& rp::compiled_level::operator>>( double& v )
+{
+  std::size_t i;
+
+  if ( !next_value( i ) )
+    return *this;
+
+  switch ( get_kind( i ) )
+    {
+    case integer_value:
+      v = get_integer( i );
+      break;
+    case real_value:
+      v = get_real( i );
+      break;
+    case string_value:
+      {
+        // The numbers whose text is not the shortest one are stored as
+        // strings.
+        const std::string text( get_string( get_integer( i ) ) );
+        char* end;
+        v = std::strtod( text.c_str(), &end );
+        m_good = !text.empty() && ( *end == '\0' );
+        break;
+      }
+    }
+
+  return *this;
+} // compiled_level::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the next value as a boolean, stored as an integer.
+ * \param v (out) The value.
+ */
+rp::compiled_level& rp::compiled_level::operator>>( bool& v )
+{
+  std::size_t i;
+
+  if ( !next_value( i ) )
+    return *this;
+
+  int64_t value;
+
+  if ( !get_integer_value( i, value ) )
+    m_good = false;
+  else
+    v = ( value != 0 );
+
+  return *this;
+} // compiled_level::operator>>()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the file is valid and if all the values have been read
+ *        successfully.
+ */
+rp::compiled_level::operator bool() const
+{
+  return m_good;
+} // compiled_level::operator bool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the shortest text representation of a real number that is read
+ *        as the same number.
+ * \param v The number.
+ */
+std::string rp::compiled_level::format_real( double v )
+{
+  char buffer[32];
+
+  for ( int precision( 1 ); precision <= 17; ++precision )
+    {
+      std::sprintf( buffer, "%.*g", precision, v );
+
+      if ( std::strtod( buffer, NULL ) == v )
+        break;
+    }
+
+  return buffer;
+} // compiled_level::format_real()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the header of the file and find the sections. The size of each
+ *        section is checked against the size of the file.
+ */
+bool rp::compiled_level::read_header()
+{
+  const std::size_t header_size( rp_compiled_level_align( 24 ) );
+  const char* const data( m_file.data() );
+  const std::size_t size( m_file.size() );
+
+  if ( ( size < header_size )
+       || ( std::memcmp( data, s_magic, sizeof( s_magic ) ) != 0 )
+       || ( read_uint32( data + 4 ) != s_version ) )
+    return false;
+
+  const std::size_t value_count( read_uint32( data + 8 ) );
+  const std::size_t string_count( read_uint32( data + 12 ) );
+  const std::size_t item_count( read_uint32( data + 16 ) );
+  const std::size_t characters_size( read_uint32( data + 20 ) );
+
+  // The counts are on 32 bits, thus the sum of the sizes can not overflow.
+  const std::size_t strings_offset( header_size );
+  const std::size_t characters_offset( strings_offset + 8 * string_count );
+  const std::size_t kinds_offset
+    ( characters_offset + rp_compiled_level_align( characters_size ) );
+  const std::size_t values_offset
+    ( kinds_offset + rp_compiled_level_align( value_count ) );
+  const std::size_t items_offset( values_offset + 8 * value_count );
+
+  if ( items_offset + 4 * item_count != size )
+    return false;
+
+  for ( std::size_t i(0); i != string_count; ++i )
+    {
+      const char* const entry( data + strings_offset + 8 * i );
+      const std::size_t offset( read_uint32( entry ) );
+
+      if ( ( offset > characters_size )
+           || ( read_uint32( entry + 4 ) > characters_size - offset ) )
+        return false;
+    }
+
+  for ( std::size_t i(0); i != value_count; ++i )
+    {
+      const char kind( data[ kinds_offset + i ] );
+
+      if ( ( kind == string_value )
+           && ( read_uint64( data + values_offset + 8 * i ) >= string_count ) )
+        return false;
+      else if ( ( kind != integer_value ) && ( kind != real_value )
+                && ( kind != string_value ) )
+        return false;
+    }
+
+  for ( std::size_t i(0); i != item_count; ++i )
+    if ( read_uint32( data + items_offset + 4 * i ) >= value_count )
+      return false;
+
+  m_value_count = value_count;
+  m_string_count = string_count;
+  m_item_count = item_count;
+  m_strings = data + strings_offset;
+  m_characters = data + characters_offset;
+  m_kinds = data + kinds_offset;
+  m_values = data + values_offset;
+  m_items = data + items_offset;
+
+  return true;
+} // compiled_level::read_header()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the next value and move to the following one.
+ * \param i (out) The index of the value.
+ * \return false if there is no value left or if a previous read failed.
+ */
+bool rp::compiled_level::next_value( std::size_t& i )
+{
+  if ( !m_good || ( m_position == m_value_count ) )
+    {
+      m_good = false;
+      return false;
+    }
+
+  i = m_position;
+  ++m_position;
+
+  return true;
+} // compiled_level::next_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a value stored as an integer.
+ * \param i The index of the value.
+ */
+int64_t rp::compiled_level::get_integer( std::size_t i ) const
+{
+  return int64_t( read_uint64( m_values + 8 * i ) );
+} // compiled_level::get_integer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a value to be read as an integer. The integers whose text is not
+ *        the shortest one, like "007", are stored as strings and are parsed
+ *        here.
+ * \param i The index of the value.
+ * \param v (out) The integer.
+ * \return false if the value is not an integer.
+ */
+bool rp::compiled_level::get_integer_value( std::size_t i, int64_t& v ) const
+{
+  switch ( get_kind( i ) )
+    {
+    case integer_value:
+      v = get_integer( i );
+      return true;
+    case string_value:
+      {
+        const std::string text( get_string( get_integer( i ) ) );
+        char* end;
+        v = std::strtoll( text.c_str(), &end, 10 );
+        return !text.empty() && ( *end == '\0' );
+      }
+    default:
+      return false;
+    }
+} // compiled_level::get_integer_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a value stored as a real number.
+ * \param i The index of the value.
+ */
+double rp::compiled_level::get_real( std::size_t i ) const
+{
+  const uint64_t bits( read_uint64( m_values + 8 * i ) );
+  double result;
+
+  std::memcpy( &result, &bits, sizeof( result ) );
+
+  return result;
+} // compiled_level::get_real()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a 32 bits unsigned integer stored in little endian.
+ * \param p The bytes of the integer.
+ */
+uint32_t rp::compiled_level::read_uint32( const char* p )
+{
+  const unsigned char* const b( reinterpret_cast<const unsigned char*>( p ) );
+
+  return uint32_t( b[0] ) | ( uint32_t( b[1] ) << 8 )
+    | ( uint32_t( b[2] ) << 16 ) | ( uint32_t( b[3] ) << 24 );
+} // compiled_level::read_uint32()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a 64 bits unsigned integer stored in little endian.
+ * \param p The bytes of the integer.
+ */
+uint64_t rp::compiled_level::read_uint64( const char* p )
+{
+  return uint64_t( read_uint32( p ) )
+    | ( uint64_t( read_uint32( p + 4 ) ) << 32 );
+} // compiled_level::read_uint64()
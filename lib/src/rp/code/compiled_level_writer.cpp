@@ -0,0 +1,332 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::compiled_level_writer class.
+ * \author Julien Jorge
+ */
+#include "rp/compiled_level_writer.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::compiled_level_writer::compiled_level_writer()
+{
+
+} // compiled_level_writer::compiled_level_writer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a level in the text format.
+ * \param is The stream containing the level.
+ */
+bool rp::compiled_level_writer::read_text( std::istream& is )
+{
+  std::string line;
+
+  while ( std::getline( is, line ) )
+    add_value( line );
+
+  if ( !is.eof() )
+    return false;
+
+  index_items();
+
+  return true;
+} // compiled_level_writer::read_text()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the level in the binary format.
+ * \param os The stream in which the level is written.
+ */
+void rp::compiled_level_writer::write( std::ostream& os ) const
+{
+  std::size_t characters_size( 0 );
+
+  for ( std::size_t i(0); i != m_strings.size(); ++i )
+    characters_size += m_strings[i].size();
+
+  os.write( compiled_level::s_magic, sizeof( compiled_level::s_magic ) );
+  write_uint32( os, compiled_level::s_version );
+  write_uint32( os, m_values.size() );
+  write_uint32( os, m_strings.size() );
+  write_uint32( os, m_items.size() );
+  write_uint32( os, characters_size );
+  write_padding( os, 24 );
+
+  std::size_t offset( 0 );
+
+  for ( std::size_t i(0); i != m_strings.size(); ++i )
+    {
+      write_uint32( os, offset );
+      write_uint32( os, m_strings[i].size() );
+      offset += m_strings[i].size();
+    }
+
+  for ( std::size_t i(0); i != m_strings.size(); ++i )
+    os.write( m_strings[i].data(), m_strings[i].size() );
+
+  write_padding( os, characters_size );
+
+  os.write( m_kinds.data(), m_kinds.size() );
+  write_padding( os, m_kinds.size() );
+
+  for ( std::size_t i(0); i != m_values.size(); ++i )
+    write_uint64( os, m_values[i] );
+
+  for ( std::size_t i(0); i != m_items.size(); ++i )
+    write_uint32( os, m_items[i] );
+} // compiled_level_writer::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of values in the level.
+ */
+std::size_t rp::compiled_level_writer::get_value_count() const
+{
+  return m_values.size();
+} // compiled_level_writer::get_value_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of distinct strings in the level.
+ */
+std::size_t rp::compiled_level_writer::get_string_count() const
+{
+  return m_strings.size();
+} // compiled_level_writer::get_string_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of items found in the level.
+ */
+std::size_t rp::compiled_level_writer::get_item_count() const
+{
+  return m_items.size();
+} // compiled_level_writer::get_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of items announced by the header of the level, after
+ *        its version, name, size and music.
+ */
+std::size_t rp::compiled_level_writer::get_declared_item_count() const
+{
+  const std::size_t index( 7 );
+
+  if ( ( m_values.size() <= index )
+       || ( m_kinds[ index ] != compiled_level::integer_value ) )
+    return 0;
+  else
+    return m_values[ index ];
+} // compiled_level_writer::get_declared_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the kind of a value.
+ * \param i The index of the value.
+ */
+rp::compiled_level::value_kind
+rp::compiled_level_writer::get_kind( std::size_t i ) const
+{
+  return compiled_level::value_kind( m_kinds[i] );
+} // compiled_level_writer::get_kind()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a value at the end of the level.
+ * \param text The text of the value.
+ */
+void rp::compiled_level_writer::add_value( const std::string& text )
+{
+  int64_t integer;
+  double real;
+
+  if ( parse_integer( text, integer ) )
+    {
+      m_kinds.push_back( compiled_level::integer_value );
+      m_values.push_back( integer );
+    }
+  else if ( parse_real( text, real ) )
+    {
+      uint64_t bits;
+      std::memcpy( &bits, &real, sizeof( bits ) );
+
+      m_kinds.push_back( compiled_level::real_value );
+      m_values.push_back( bits );
+    }
+  else
+    {
+      const auto it
+        ( m_string_index.insert
+          ( std::make_pair( text, m_strings.size() ) ).first );
+
+      if ( it->second == m_strings.size() )
+        m_strings.push_back( text );
+
+      m_kinds.push_back( compiled_level::string_value );
+      m_values.push_back( it->second );
+    }
+} // compiled_level_writer::add_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the first value of the definition of each item.
+ */
+void rp::compiled_level_writer::index_items()
+{
+  m_items.clear();
+
+  for ( std::size_t i(0); i + 3 < m_values.size(); ++i )
+    if ( is_integer( i, 32 ) && is_class_name( i + 1 ) )
+      m_items.push_back( i );
+    else if ( is_integer( i, 31 )
+              && ( is_integer( i + 1, 0 ) || is_integer( i + 1, 1 ) )
+              && ( m_kinds[ i + 2 ] == compiled_level::integer_value )
+              && ( m_values[ i + 2 ] >= 40 ) && ( m_values[ i + 2 ] < 60 )
+              && is_field_name( i + 3 ) )
+      m_items.push_back( i );
+} // compiled_level_writer::index_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a value is a given integer.
+ * \param i The index of the value.
+ * \param v The integer.
+ */
+bool rp::compiled_level_writer::is_integer( std::size_t i, int64_t v ) const
+{
+  return ( m_kinds[i] == compiled_level::integer_value )
+    && ( int64_t( m_values[i] ) == v );
+} // compiled_level_writer::is_integer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a value is the name of a class, like "rp::balloon".
+ * \param i The index of the value.
+ */
+bool rp::compiled_level_writer::is_class_name( std::size_t i ) const
+{
+  return ( m_kinds[i] == compiled_level::string_value )
+    && ( m_strings[ m_values[i] ].find( "::" ) != std::string::npos );
+} // compiled_level_writer::is_class_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a value is the name of a field, like "base_item.global".
+ * \param i The index of the value.
+ */
+bool rp::compiled_level_writer::is_field_name( std::size_t i ) const
+{
+  if ( m_kinds[i] != compiled_level::string_value )
+    return false;
+
+  const std::string& s( m_strings[ m_values[i] ] );
+
+  return ( s.find( '.' ) != std::string::npos )
+    && ( s.find( '/' ) == std::string::npos );
+} // compiled_level_writer::is_field_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse an integer written in its shortest form.
+ * \param text The text to parse.
+ * \param v (out) The integer.
+ */
+bool rp::compiled_level_writer::parse_integer
+( const std::string& text, int64_t& v )
+{
+  const std::size_t first( ( !text.empty() && ( text[0] == '-' ) ) ? 1 : 0 );
+
+  if ( ( text.size() == first ) || ( text.size() - first > 18 ) )
+    return false;
+
+  // No leading zero, nor "-0".
+  if ( ( text[ first ] == '0' ) && ( text.size() != 1 ) )
+    return false;
+
+  for ( std::size_t i( first ); i != text.size(); ++i )
+    if ( ( text[i] < '0' ) || ( text[i] > '9' ) )
+      return false;
+
+  v = std::strtoll( text.c_str(), NULL, 10 );
+  return true;
+} // compiled_level_writer::parse_integer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse a real number written in its shortest form.
+ * \param text The text to parse.
+ * \param v (out) The number.
+ */
+bool rp::compiled_level_writer::parse_real
+( const std::string& text, double& v )
+{
+  if ( text.empty() )
+    return false;
+
+  char* end;
+  errno = 0;
+  v = std::strtod( text.c_str(), &end );
+
+  return ( *end == '\0' ) && ( errno == 0 )
+    && ( compiled_level::format_real( v ) == text );
+} // compiled_level_writer::parse_real()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 32 bits unsigned integer in little endian.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::compiled_level_writer::write_uint32
+( std::ostream& os, uint32_t value )
+{
+  const char bytes[4] =
+    { char( value & 0xff ), char( ( value >> 8 ) & 0xff ),
+      char( ( value >> 16 ) & 0xff ), char( ( value >> 24 ) & 0xff ) };
+
+  os.write( bytes, sizeof( bytes ) );
+} // compiled_level_writer::write_uint32()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 64 bits unsigned integer in little endian.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::compiled_level_writer::write_uint64
+( std::ostream& os, uint64_t value )
+{
+  write_uint32( os, value & 0xffffffff );
+  write_uint32( os, value >> 32 );
+} // compiled_level_writer::write_uint64()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the zeros needed after a section to reach the next multiple of
+ *        eight bytes.
+ * \param os The stream in which the zeros are written.
+ * \param size The size of the section.
+ */
+void rp::compiled_level_writer::write_padding
+( std::ostream& os, std::size_t size )
+{
+  const char zeros[8] = { 0 };
+
+  os.write( zeros, ( 8 - size % 8 ) % 8 );
+} // compiled_level_writer::write_padding()
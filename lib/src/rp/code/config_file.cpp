@@ -12,6 +12,9 @@
  */
 #include "rp/config_file.hpp"
 
+#include "rp/music_player.hpp"
+#include "rp/save_service.hpp"
+
 #include <claw/configuration_file.hpp>
 #include <sstream>
 #include <fstream>
@@ -68,6 +71,7 @@ void rp::config_file::apply() const
   bear::engine::game::get_instance().set_music_muted( !m_music_on );
   bear::engine::game::get_instance().set_sound_volume( m_sound_volume );
   bear::engine::game::get_instance().set_music_volume( m_music_volume );
+  music_player::get_instance().update_volume();
 } // config_file::apply()
 
 /*----------------------------------------------------------------------------*/
@@ -86,7 +90,7 @@ void rp::config_file::update()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Save the configuration.
+ * \brief Save the configuration. The file is written in the background.
  */
 void rp::config_file::save() const
 {
@@ -94,7 +98,7 @@ void rp::config_file::save() const
 
   std::string full_config_path
     ( g.get_game_filesystem().get_custom_config_file_name(m_config_name) );
-  std::ofstream f( full_config_path.c_str() );
+  std::ostringstream f;
 
   f << "# Configuration of the screen.\n"
     << "[Video]\n"
@@ -115,6 +119,8 @@ void rp::config_file::save() const
     << "# The volume of the music music\n"
     << "music_volume = " << m_music_volume << '\n'
     << std::endl;
+
+  save_service::get_instance().save_file( full_config_path, f.str() );
 } // config_file::save()
 
 /*----------------------------------------------------------------------------*/
@@ -17,8 +17,11 @@
 #include "rp/cart.hpp"
 #include "rp/explosion.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/profiler.hpp"
 #include "rp/util.hpp"
 
+#include "engine/level.hpp"
+
 BASE_ITEM_EXPORT( crate, rp )
 
 /*----------------------------------------------------------------------------*/
@@ -52,8 +55,24 @@ void rp::crate::on_enters_layer()
 
   set_model_actor( get_level_globals().get_model("model/crate.cm") );
   start_model_action("idle");
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::crate::on_enters_layer()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one iteration in the progression of the item.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void rp::crate::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/crate" );
+
+  super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
+} // rp::crate::progress()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with an other item.
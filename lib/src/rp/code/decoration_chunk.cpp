@@ -0,0 +1,130 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::decoration_chunk class.
+ * \author Julien Jorge
+ */
+#include "rp/decoration_chunk.hpp"
+
+#include "rp/profiler.hpp"
+
+#include "engine/scene_visual.hpp"
+#include "visual/scene_sprite.hpp"
+
+BASE_ITEM_EXPORT( decoration_chunk, rp )
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::decoration_chunk::decoration_chunk()
+{
+  set_phantom( true );
+  set_can_move_items( false );
+  set_artificial( true );
+} // decoration_chunk::decoration_chunk()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set a field of type list of visual::sprite.
+ * \param name The name of the field.
+ * \param value The new value of the field.
+ * \return false if the field "name" is unknow, true otherwise.
+ */
+bool rp::decoration_chunk::set_sprite_list_field
+( const std::string& name, const std::vector<bear::visual::sprite>& value )
+{
+  bool result(true);
+
+  if ( name == "decoration_chunk.sprites" )
+    m_sprites = value;
+  else
+    result = super::set_sprite_list_field( name, value );
+
+  return result;
+} // decoration_chunk::set_sprite_list_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set a field of type list of real.
+ * \param name The name of the field.
+ * \param value The new value of the field.
+ * \return false if the field "name" is unknow, true otherwise.
+ */
+bool rp::decoration_chunk::set_real_list_field
+( const std::string& name, const std::vector<double>& value )
+{
+  bool result(true);
+
+  if ( name == "decoration_chunk.left" )
+    m_left = value;
+  else if ( name == "decoration_chunk.bottom" )
+    m_bottom = value;
+  else
+    result = super::set_real_list_field( name, value );
+
+  return result;
+} // decoration_chunk::set_real_list_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set a field of type list of integer.
+ * \param name The name of the field.
+ * \param value The new value of the field.
+ * \return false if the field "name" is unknow, true otherwise.
+ */
+bool rp::decoration_chunk::set_integer_list_field
+( const std::string& name, const std::vector<int>& value )
+{
+  bool result(true);
+
+  if ( name == "decoration_chunk.depth" )
+    m_depth = value;
+  else
+    result = super::set_integer_list_field( name, value );
+
+  return result;
+} // decoration_chunk::set_integer_list_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the item is correctly initialized.
+ */
+bool rp::decoration_chunk::is_valid() const
+{
+  return ( m_left.size() == m_sprites.size() )
+    && ( m_bottom.size() == m_sprites.size() )
+    && ( m_depth.size() == m_sprites.size() )
+    && super::is_valid();
+} // decoration_chunk::is_valid()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sprites of the decorations of the chunk.
+ * \param visuals (out) The sprites of the item, and their positions.
+ */
+void rp::decoration_chunk::get_visual
+( std::list<bear::engine::scene_visual>& visuals ) const
+{
+  RP_PROFILE_ZONE( "render/decoration_chunk" );
+
+  const double left( get_left() );
+  const double bottom( get_bottom() );
+
+  for ( std::size_t i(0); i != m_sprites.size(); ++i )
+    {
+      bear::engine::scene_visual v
+        ( bear::visual::scene_sprite
+          ( left + m_left[i], bottom + m_bottom[i], m_sprites[i] ) );
+      v.z_position = m_depth[i];
+
+      visuals.push_back( v );
+    }
+} // decoration_chunk::get_visual()
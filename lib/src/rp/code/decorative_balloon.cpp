@@ -15,6 +15,7 @@
 
 #include "rp/balloon.hpp"
 #include "rp/cart.hpp"
+#include "rp/profiler.hpp"
 
 #include "engine/scene_visual.hpp"
 #include "visual/scene_line.hpp"
@@ -74,6 +75,8 @@ void rp::decorative_balloon::on_enters_layer()
  */
 void rp::decorative_balloon::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/decorative_balloon" );
+
   super::progress( elapsed_time );
 
   update_angle();
@@ -123,6 +126,8 @@ void rp::decorative_balloon::progress( bear::universe::time_type elapsed_time )
 void rp::decorative_balloon::get_visual
 ( std::list<bear::engine::scene_visual>& visuals ) const
 {
+  RP_PROFILE_ZONE( "render/decorative_balloon" );
+
    super::get_visual(visuals);
    
    if ( ( m_cart != NULL ) && m_is_linked )
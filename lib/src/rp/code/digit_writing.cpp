@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::digit_writing class.
+ * \author Julien Jorge
+ */
+#include "rp/digit_writing.hpp"
+
+#include "visual/scene_sprite.hpp"
+
+#include <algorithm>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an empty writing without glyphs.
+ */
+rp::digit_writing::digit_writing()
+  : m_width( 0 ), m_height( 0 )
+{
+  for ( glyph& g : m_glyphs )
+    g.advance = 0;
+} // digit_writing::digit_writing()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an empty writing.
+ * \param f The font of the glyphs.
+ */
+rp::digit_writing::digit_writing( const bear::visual::font& f )
+  : m_width( 0 ), m_height( f.get_line_spacing() )
+{
+  static const char characters[] = "0123456789-";
+
+  for ( std::size_t i( 0 ); i != m_glyphs.size(); ++i )
+    {
+      const bear::visual::glyph_metrics m( f.get_metrics( characters[ i ] ) );
+
+      m_glyphs[ i ].sprite = f.get_sprite( characters[ i ] );
+      m_glyphs[ i ].bearing = m.get_bearing();
+      m_glyphs[ i ].advance = m.get_advance().x;
+    }
+
+  // An int has at most ten digits and a sign.
+  m_text.reserve( 11 );
+} // digit_writing::digit_writing()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value displayed by the writing.
+ * \param value The value.
+ */
+void rp::digit_writing::set_value( int value )
+{
+  m_text.clear();
+
+  // The digits are computed on an unsigned value to handle the minimum int.
+  unsigned int v
+    ( value < 0 ? -(unsigned int)value : (unsigned int)value );
+
+  do
+    {
+      m_text.push_back( v % 10 );
+      v /= 10;
+    }
+  while ( v != 0 );
+
+  if ( value < 0 )
+    m_text.push_back( s_minus_index );
+
+  std::reverse( m_text.begin(), m_text.end() );
+
+  m_width = 0;
+
+  for ( std::size_t i : m_text )
+    m_width += m_glyphs[ i ].advance;
+} // digit_writing::set_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the value displayed by the writing.
+ */
+void rp::digit_writing::clear()
+{
+  m_text.clear();
+  m_width = 0;
+} // digit_writing::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the width of the displayed value.
+ */
+bear::visual::size_type rp::digit_writing::get_width() const
+{
+  return m_width;
+} // digit_writing::get_width()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the height of the writing.
+ */
+bear::visual::size_type rp::digit_writing::get_height() const
+{
+  return m_height;
+} // digit_writing::get_height()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the scene element displaying the writing.
+ * \param x The x-position of the left of the writing.
+ * \param y The y-position of the bottom of the writing.
+ * \param scale The scale factor applied to the writing.
+ */
+bear::visual::scene_element_sequence rp::digit_writing::get_scene_element
+( bear::visual::coordinate_type x, bear::visual::coordinate_type y,
+  double scale ) const
+{
+  bear::visual::scene_element_sequence result;
+  bear::visual::coordinate_type pen( x );
+
+  for ( std::size_t i : m_text )
+    {
+      const glyph& g( m_glyphs[ i ] );
+      bear::visual::scene_sprite s
+        ( pen + g.bearing.x * scale, y + g.bearing.y * scale, g.sprite );
+
+      s.set_scale_factor( scale, scale );
+      result.push_back( s );
+
+      pen += g.advance * scale;
+    }
+
+  return result;
+} // digit_writing::get_scene_element()
@@ -12,6 +12,7 @@
  */
 #include "rp/end.hpp"
 
+#include "rp/save_service.hpp"
 #include "rp/util.hpp"
 
 #include "engine/game_initializer.hpp"
@@ -22,4 +23,7 @@ void end_super_great_park()
 {
   rp::util::save_config();
   rp::util::save_game_variables();
+
+  // The game is about to quit, the files must be complete before.
+  rp::save_service::get_instance().flush();
 } // end_super_great_park()
@@ -14,9 +14,15 @@
 #include "rp/explosion.hpp"
 
 #include "rp/game_variables.hpp"
+#include "rp/item_pool.hpp"
+#include "rp/particle_system.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
 #include "rp/util.hpp" 
 #include "rp/zeppelin.hpp" 
 
+#include "engine/level.hpp"
 #include "universe/forced_movement/forced_tracking.hpp"
 #include "generic_items/decorative_item.hpp"
 #include "universe/collision_info.hpp"
@@ -28,7 +34,7 @@ BASE_ITEM_EXPORT( explosion, rp )
  * \brief Constructor.
  */
 rp::explosion::explosion()
-:  m_nb_explosions(1), m_radius(10), m_duration(0)
+:  m_nb_explosions(1), m_radius(10), m_duration(0), m_action_score(true)
 {
 
 } // rp::explosion::explosion()
@@ -44,11 +50,32 @@ rp::explosion::explosion
 ( unsigned int nb_explosions, bear::universe::coordinate_type radius, 
   double duration, bool decoration )
   : m_nb_explosions(nb_explosions), m_radius(radius), m_duration(0),
-    m_explosion_duration(duration)
+    m_explosion_duration(duration), m_action_score(true)
 {
   set_artificial(decoration);
 } // rp::explosion::explosion()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the memory of an instance from the pool of the class.
+ * \param size The size of the memory.
+ */
+void* rp::explosion::operator new( std::size_t size )
+{
+  return item_pool<explosion>::get_instance().allocate( size );
+} // explosion::operator new()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Give back the memory of an instance to the pool of the class.
+ * \param p The memory of the instance.
+ * \param size The size of the memory.
+ */
+void rp::explosion::operator delete( void* p, std::size_t size )
+{
+  item_pool<explosion>::get_instance().release( p, size );
+} // explosion::operator delete()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Load the media required by this class.
@@ -69,6 +96,8 @@ void rp::explosion::on_enters_layer()
 {
   super::on_enters_layer();
 
+  m_action_score.attach( *this );
+  m_action_score.set( 30 );
   game_variables::set_action_snapshot();
   
   set_phantom(true);
@@ -86,7 +115,10 @@ void rp::explosion::on_enters_layer()
  */
 void rp::explosion::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/explosion" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   const unsigned int nb_previous_explosions = 
     m_duration * m_nb_explosions / m_explosion_duration;
@@ -173,13 +205,29 @@ bool rp::explosion::collision_with_zeppelin
  */
 void rp::explosion::create_explosion()
 {
+  bear::universe::coordinate_type width = 64 + 64.0 * random::effects().real();
+  particle_system* const particles( particle_system::get_instance() );
+
+  if ( particles != NULL )
+    {
+      particles->add_explosion
+        ( get_center_of_mass()
+          + pick_random_position_in_annulus
+          ( get_width() / std::sqrt(6.0), get_width() / 2 ),
+          width, get_z_position() );
+      return;
+    }
+
+  if ( !population_manager::can_spawn
+       ( population_manager::decoration_debris ) )
+    return;
+
   bear::decorative_item* item = new bear::decorative_item;
-  bear::universe::coordinate_type width = 64 + 64.0 * rand() / RAND_MAX;
     
   item->set_size(width,width);
   bear::visual::animation anim
     ( get_level_globals().get_animation("animation/explosion.canim") );
-  anim.set_time_factor( 1 + 3 * (double)rand() / RAND_MAX);
+  anim.set_time_factor( 1 + 3 * random::effects().real());
   anim.set_size(width,width);
   
   item->set_animation(anim);
@@ -188,7 +236,7 @@ void rp::explosion::create_explosion()
   item->set_phantom(true);
   item->set_kill_when_leaving(true);
   item->set_kill_when_finished(true);
-  item->get_rendering_attributes().set_angle(6.29 * rand() / RAND_MAX);
+  item->get_rendering_attributes().set_angle(6.29 * random::effects().real());
   
   bear::universe::position_type pos =
     pick_random_position_in_annulus
@@ -197,6 +245,8 @@ void rp::explosion::create_explosion()
   item->set_center_of_mass(get_center_of_mass() + pos);
   
   new_item( *item );
+  population_manager::add_decoration
+    ( population_manager::decoration_debris, *item );
   
   CLAW_ASSERT( item->is_valid(),
                "The decoration of explosion isn't correctly initialized" );
@@ -238,9 +288,9 @@ rp::explosion::pick_random_position_in_annulus
 ( bear::universe::coordinate_type r_min,
   bear::universe::coordinate_type r_max ) const
 {
-  const double a = 2 * 3.14159 * (double)rand() / RAND_MAX;
+  const double a = 2 * 3.14159 * random::effects().real();
   const double r =
-    std::sqrt( r_min + (r_max - r_min) * (double)rand() / RAND_MAX );
+    std::sqrt( r_min + (r_max - r_min) * random::effects().real() );
 
   return bear::universe::position_type( r * std::cos(a), r * std::sin(a) );
 } // explosion::pick_random_position_in_annulus()
@@ -0,0 +1,215 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::game_variable_table class.
+ * \author Julien Jorge
+ */
+#include "rp/game_variable_table.hpp"
+
+#include "engine/game.hpp"
+#include "engine/variable/variable.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the instance of the table.
+ */
+rp::game_variable_table& rp::game_variable_table::get_instance()
+{
+  static game_variable_table result;
+  return result;
+} // game_variable_table::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read again all the slots from the variables of the engine. This must
+ *        be called when the variables are replaced without notification, like
+ *        when the save is loaded.
+ */
+void rp::game_variable_table::refresh()
+{
+  refresh( m_bool );
+  refresh( m_int );
+  refresh( m_uint );
+  refresh( m_double );
+  refresh( m_string );
+} // game_variable_table::refresh()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the persistent variables modified since the last call in a
+ *        snapshot.
+ * \param s The snapshot receiving the variables.
+ */
+void rp::game_variable_table::collect_dirty_persistent( save_snapshot& s )
+{
+  collect_dirty( m_bool, s );
+  collect_dirty( m_int, s );
+  collect_dirty( m_uint, s );
+  collect_dirty( m_double, s );
+  collect_dirty( m_string, s );
+} // game_variable_table::collect_dirty_persistent()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Consider that all the persistent variables are saved, for example
+ *        when they have just been loaded.
+ */
+void rp::game_variable_table::clear_dirty()
+{
+  clear_dirty( m_bool );
+  clear_dirty( m_int );
+  clear_dirty( m_uint );
+  clear_dirty( m_double );
+  clear_dirty( m_string );
+} // game_variable_table::clear_dirty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::game_variable_table::game_variable_table()
+{
+
+} // game_variable_table::game_variable_table()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::game_variable_table::~game_variable_table()
+{
+  disconnect( m_bool );
+  disconnect( m_int );
+  disconnect( m_uint );
+  disconnect( m_double );
+  disconnect( m_string );
+} // game_variable_table::~game_variable_table()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value of a game variable from the engine.
+ * \param name The name of the variable.
+ * \param value (out) The value of the variable.
+ * \return true if the variable exists in the engine.
+ */
+template<typename T>
+bool
+rp::game_variable_table::read_engine( const std::string& name, T& value )
+{
+  bear::engine::variable<T> var(name);
+
+  if ( !bear::engine::game::get_instance().game_variable_exists(var) )
+    return false;
+
+  bear::engine::game::get_instance().get_game_variable(var);
+  value = var.get_value();
+  return true;
+} // game_variable_table::read_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a game variable in the engine.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+template<typename T>
+void rp::game_variable_table::write_engine
+( const std::string& name, const T& value )
+{
+  bear::engine::game::get_instance().set_game_variable
+    ( bear::engine::variable<T>( name, value ) );
+} // game_variable_table::write_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of a boolean variable in the engine.
+ * \param name The name of the variable.
+ * \param f The function to call with the new value.
+ */
+boost::signals2::connection rp::game_variable_table::listen_engine
+( const std::string& name, const boost::function<void (bool)>& f )
+{
+  return bear::engine::game::get_instance().listen_bool_variable_change
+    ( name, f );
+} // game_variable_table::listen_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of a signed integer variable in the engine.
+ * \param name The name of the variable.
+ * \param f The function to call with the new value.
+ */
+boost::signals2::connection rp::game_variable_table::listen_engine
+( const std::string& name, const boost::function<void (int)>& f )
+{
+  return bear::engine::game::get_instance().listen_int_variable_change
+    ( name, f );
+} // game_variable_table::listen_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of an unsigned integer variable in the engine.
+ * \param name The name of the variable.
+ * \param f The function to call with the new value.
+ */
+boost::signals2::connection rp::game_variable_table::listen_engine
+( const std::string& name, const boost::function<void (unsigned int)>& f )
+{
+  return bear::engine::game::get_instance().listen_uint_variable_change
+    ( name, f );
+} // game_variable_table::listen_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of a real variable in the engine.
+ * \param name The name of the variable.
+ * \param f The function to call with the new value.
+ */
+boost::signals2::connection rp::game_variable_table::listen_engine
+( const std::string& name, const boost::function<void (double)>& f )
+{
+  return bear::engine::game::get_instance().listen_double_variable_change
+    ( name, f );
+} // game_variable_table::listen_engine()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of a string variable in the engine.
+ * \param name The name of the variable.
+ * \param f The function to call with the new value.
+ */
+boost::signals2::connection rp::game_variable_table::listen_engine
+( const std::string& name, const boost::function<void (std::string)>& f )
+{
+  return bear::engine::game::get_instance().listen_string_variable_change
+    ( name, f );
+} // game_variable_table::listen_engine()
+
+template bool rp::game_variable_table::read_engine<bool>
+( const std::string& name, bool& value );
+template bool rp::game_variable_table::read_engine<int>
+( const std::string& name, int& value );
+template bool rp::game_variable_table::read_engine<unsigned int>
+( const std::string& name, unsigned int& value );
+template bool rp::game_variable_table::read_engine<double>
+( const std::string& name, double& value );
+template bool rp::game_variable_table::read_engine<std::string>
+( const std::string& name, std::string& value );
+
+template void rp::game_variable_table::write_engine<bool>
+( const std::string& name, const bool& value );
+template void rp::game_variable_table::write_engine<int>
+( const std::string& name, const int& value );
+template void rp::game_variable_table::write_engine<unsigned int>
+( const std::string& name, const unsigned int& value );
+template void rp::game_variable_table::write_engine<double>
+( const std::string& name, const double& value );
+template void rp::game_variable_table::write_engine<std::string>
+( const std::string& name, const std::string& value );
@@ -13,29 +13,130 @@
  */
 #include "rp/game_variables.hpp"
 #include "rp/defines.hpp"
+#include "rp/game_variable_table.hpp"
 
-#include "engine/game.hpp"
-#include "engine/variable/variable.hpp"
+#include <sstream>
+#include <vector>
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief A function that gets a game variable.
+ * \brief A function that declares the slot of a game variable.
  * \param n The name of the variable.
  * \param def The default value to return if the variable is not set.
  */
 template<typename T>
-static T rp_game_variables_get_value( const std::string& n, const T& def )
+static rp::game_variable_slot<T>
+rp_game_variables_declare( const std::string& n, const T& def )
 {
-  bear::engine::variable<T> var(n);
+  return rp::game_variable_table::get_instance().declare( n, def );
+} // rp_game_variables_declare()
 
-  if ( bear::engine::game::get_instance().game_variable_exists(var) )
-    {
-      bear::engine::game::get_instance().get_game_variable(var);
-      return var.get_value();
-    }
-  else
-    return def;
-} // rp_game_variables_get_value()
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief A function that gets the slot of a game variable defined for each
+ *        level of each serial, declaring it on the first access.
+ * \param slots The slots already declared for this variable, indexed by serial
+ *        then by level number.
+ * \param name The function that builds the name of the variable.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ */
+static rp::game_variable_slot<unsigned int> rp_game_variables_get_level_slot
+( std::vector< std::vector< rp::game_variable_slot<unsigned int> > >& slots,
+  std::string (*name)( unsigned int, unsigned int ),
+  unsigned int serial, unsigned int number )
+{
+  if ( serial >= slots.size() )
+    slots.resize( serial + 1 );
+
+  std::vector< rp::game_variable_slot<unsigned int> >& serial_slots
+    ( slots[ serial ] );
+
+  if ( number >= serial_slots.size() )
+    serial_slots.resize( number + 1 );
+
+  if ( !serial_slots[ number ].is_valid() )
+    serial_slots[ number ] =
+      rp_game_variables_declare( name( serial, number ), (unsigned int)0 );
+
+  return serial_slots[ number ];
+} // rp_game_variables_get_level_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the slot of the persistent score of a given level.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ */
+static rp::game_variable_slot<unsigned int>
+rp_game_variables_get_persistent_score_slot
+( unsigned int serial, unsigned int number )
+{
+  static std::vector< std::vector< rp::game_variable_slot<unsigned int> > >
+    slots;
+
+  return rp_game_variables_get_level_slot
+    ( slots, &rp::game_variables::get_persistent_score_variable_name, serial,
+      number );
+} // rp_game_variables_get_persistent_score_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the slot of the state of a given level.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ */
+static rp::game_variable_slot<unsigned int>
+rp_game_variables_get_level_state_slot
+( unsigned int serial, unsigned int number )
+{
+  static std::vector< std::vector< rp::game_variable_slot<unsigned int> > >
+    slots;
+
+  return rp_game_variables_get_level_slot
+    ( slots, &rp::game_variables::get_level_state_variable_name, serial,
+      number );
+} // rp_game_variables_get_level_state_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the slot of the persistent balloon count of a given level.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ */
+static rp::game_variable_slot<unsigned int>
+rp_game_variables_get_persistent_balloon_slot
+( unsigned int serial, unsigned int number )
+{
+  static std::vector< std::vector< rp::game_variable_slot<unsigned int> > >
+    slots;
+
+  return rp_game_variables_get_level_slot
+    ( slots, &rp::game_variables::get_persistent_balloon_variable_name, serial,
+      number );
+} // rp_game_variables_get_persistent_balloon_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the slot of the number of elements of a given cart.
+ * \param id The identifier of the cart.
+ */
+static rp::game_variable_slot<unsigned int>
+rp_game_variables_get_cart_elements_number_slot( unsigned int id )
+{
+  static std::vector< rp::game_variable_slot<unsigned int> > slots;
+
+  if ( id >= slots.size() )
+    slots.resize( id + 1 );
+
+  if ( !slots[ id ].is_valid() )
+    slots[ id ] =
+      rp_game_variables_declare
+      ( rp::game_variables::get_cart_elements_number_variable_name( id ),
+        (unsigned int)0 );
+
+  return slots[ id ];
+} // rp_game_variables_get_cart_elements_number_slot()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -43,9 +144,12 @@ static T rp_game_variables_get_value( const std::string& n, const T& def )
  */
 unsigned int rp::game_variables::get_level_number()
 {
-  return 
-    rp_game_variables_get_value
-    ( make_persistent_variable_name("scenario/level_number"), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/level_number"),
+        (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_level_number()
 
 /*----------------------------------------------------------------------------*/
@@ -55,9 +159,12 @@ unsigned int rp::game_variables::get_level_number()
  */
 void rp::game_variables::set_level_number( unsigned int n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( make_persistent_variable_name("scenario/level_number"), n ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/level_number"),
+        (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_level_number()
 
 /*----------------------------------------------------------------------------*/
@@ -66,10 +173,12 @@ void rp::game_variables::set_level_number( unsigned int n )
  */
 unsigned int rp::game_variables::get_serial_number()
 {
-  return 
-    rp_game_variables_get_value
-    ( make_persistent_variable_name("scenario/serial_number"), 
-      (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/serial_number"),
+        (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_serial_number()
 
 /*----------------------------------------------------------------------------*/
@@ -79,9 +188,12 @@ unsigned int rp::game_variables::get_serial_number()
  */
 void rp::game_variables::set_serial_number( unsigned int n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( make_persistent_variable_name("scenario/serial_number"), n ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/serial_number"),
+        (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_serial_number()
 
 /*----------------------------------------------------------------------------*/
@@ -90,10 +202,12 @@ void rp::game_variables::set_serial_number( unsigned int n )
  */
 unsigned int rp::game_variables::get_unlocked_serial()
 {
-  return 
-    rp_game_variables_get_value
-    ( make_persistent_variable_name("scenario/unlocked_serial"), 
-      (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/unlocked_serial"),
+        (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_unlocked_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -103,9 +217,12 @@ unsigned int rp::game_variables::get_unlocked_serial()
  */
 void rp::game_variables::set_unlocked_serial( unsigned int n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( make_persistent_variable_name("scenario/unlocked_serial"), n ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/unlocked_serial"),
+        (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_unlocked_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -114,10 +231,12 @@ void rp::game_variables::set_unlocked_serial( unsigned int n )
  */
 unsigned int rp::game_variables::get_last_serial()
 {
-  return 
-    rp_game_variables_get_value
-    ( make_persistent_variable_name("scenario/last_serial"), 
-      (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/last_serial"),
+        (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_last_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -127,9 +246,12 @@ unsigned int rp::game_variables::get_last_serial()
  */
 void rp::game_variables::set_last_serial( unsigned int n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( make_persistent_variable_name("scenario/last_serial"), n ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/last_serial"),
+        (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_last_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -138,10 +260,12 @@ void rp::game_variables::set_last_serial( unsigned int n )
  */
 unsigned int rp::game_variables::get_selected_serial()
 {
-  return 
-    rp_game_variables_get_value
-    ( make_persistent_variable_name("scenario/selected_serial"), 
-      (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/selected_serial"),
+        (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_selected_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -151,9 +275,12 @@ unsigned int rp::game_variables::get_selected_serial()
  */
 void rp::game_variables::set_selected_serial( unsigned int n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( make_persistent_variable_name("scenario/selected_serial"), n ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( make_persistent_variable_name("scenario/selected_serial"),
+        (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_selected_serial()
 
 /*----------------------------------------------------------------------------*/
@@ -162,7 +289,10 @@ void rp::game_variables::set_selected_serial( unsigned int n )
  */
 std::string rp::game_variables::get_level_info()
 {
-  return rp_game_variables_get_value( "level_info", std::string() );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_info", std::string() ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_level_info()
 
 /*----------------------------------------------------------------------------*/
@@ -172,8 +302,10 @@ std::string rp::game_variables::get_level_info()
  */
 void rp::game_variables::set_level_info( const std::string& n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<std::string>( "level_info", n ) );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_info", std::string() ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_level_info()
 
 /*----------------------------------------------------------------------------*/
@@ -182,7 +314,10 @@ void rp::game_variables::set_level_info( const std::string& n )
  */
 std::string rp::game_variables::get_level_name()
 {
-  return rp_game_variables_get_value( "level_name", std::string() );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_name", std::string() ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_level_name()
 
 /*----------------------------------------------------------------------------*/
@@ -192,8 +327,10 @@ std::string rp::game_variables::get_level_name()
  */
 void rp::game_variables::set_level_name( const std::string& n )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<std::string>( "level_name", n ) );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_name", std::string() ) );
+
+  game_variable_table::get_instance().set( slot, n );
 } // game_variables::set_level_name()
 
 /*----------------------------------------------------------------------------*/
@@ -202,7 +339,10 @@ void rp::game_variables::set_level_name( const std::string& n )
  */
 std::string rp::game_variables::get_level_theme()
 {
-  return rp_game_variables_get_value( "level_theme", std::string("western") );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_theme", std::string("western") ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_level_theme()
 
 /*----------------------------------------------------------------------------*/
@@ -212,8 +352,10 @@ std::string rp::game_variables::get_level_theme()
  */
 void rp::game_variables::set_level_theme( const std::string& t )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<std::string>( "level_theme", t ) );
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "level_theme", std::string("western") ) );
+
+  game_variable_table::get_instance().set( slot, t );
 } // game_variables::set_level_theme()
 
 /*----------------------------------------------------------------------------*/
@@ -222,7 +364,10 @@ void rp::game_variables::set_level_theme( const std::string& t )
  */
 bool rp::game_variables::is_demo_version()
 {
-  return rp_game_variables_get_value( "demo_version", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "demo_version", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::is_demo_version()
 
 /*----------------------------------------------------------------------------*/
@@ -232,8 +377,10 @@ bool rp::game_variables::is_demo_version()
  */
 void rp::game_variables::set_demo_version(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "demo_version", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "demo_version", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_demo_version()
 
 /*----------------------------------------------------------------------------*/
@@ -242,7 +389,10 @@ void rp::game_variables::set_demo_version(bool value)
  */
 bool rp::game_variables::is_level_ending()
 {
-  return rp_game_variables_get_value( "level_ending", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "level_ending", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::is_level_ending()
 
 /*----------------------------------------------------------------------------*/
@@ -252,8 +402,10 @@ bool rp::game_variables::is_level_ending()
  */
 void rp::game_variables::set_level_ending(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "level_ending", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "level_ending", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_level_ending()
 
 std::string rp::game_variables::get_ending_effect_variable_name()
@@ -267,8 +419,10 @@ std::string rp::game_variables::get_ending_effect_variable_name()
  */
 bool rp::game_variables::get_ending_effect()
 {
-  return
-    rp_game_variables_get_value( get_ending_effect_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( get_ending_effect_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_ending_effect()
 
 /*----------------------------------------------------------------------------*/
@@ -278,8 +432,10 @@ bool rp::game_variables::get_ending_effect()
  */
 void rp::game_variables::set_ending_effect(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( get_ending_effect_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( get_ending_effect_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_ending_effect()
 
 /*----------------------------------------------------------------------------*/
@@ -288,7 +444,10 @@ void rp::game_variables::set_ending_effect(bool value)
  */
 bool rp::game_variables::selected_level_exist()
 {
-  return rp_game_variables_get_value( "selected_level", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "selected_level", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::selected_level_exist()
 
 /*----------------------------------------------------------------------------*/
@@ -298,8 +457,10 @@ bool rp::game_variables::selected_level_exist()
  */
 void rp::game_variables::select_level(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "selected_level", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "selected_level", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::select_level()
 
 /*----------------------------------------------------------------------------*/
@@ -308,7 +469,10 @@ void rp::game_variables::select_level(bool value)
  */
 bool rp::game_variables::get_go_order_status()
 {
-  return rp_game_variables_get_value( "go_order", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "go_order", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_go_order_status()
 
 /*----------------------------------------------------------------------------*/
@@ -318,8 +482,10 @@ bool rp::game_variables::get_go_order_status()
  */
 void rp::game_variables::set_go_order_status(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "go_order", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "go_order", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_go_order_status()
 
 /*----------------------------------------------------------------------------*/
@@ -328,7 +494,10 @@ void rp::game_variables::set_go_order_status(bool value)
  */
 bool rp::game_variables::get_back_order_status()
 {
-  return rp_game_variables_get_value( "back_order", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "back_order", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_back_order_status()
 
 /*----------------------------------------------------------------------------*/
@@ -338,8 +507,10 @@ bool rp::game_variables::get_back_order_status()
  */
 void rp::game_variables::set_back_order_status(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "back_order", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "back_order", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_back_order_status()
 
 /*----------------------------------------------------------------------------*/
@@ -348,7 +519,10 @@ void rp::game_variables::set_back_order_status(bool value)
  */
 bool rp::game_variables::get_movement_order_status()
 {
-  return rp_game_variables_get_value( "movement_order", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "movement_order", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_movement_order_status()
 
 /*----------------------------------------------------------------------------*/
@@ -358,8 +532,10 @@ bool rp::game_variables::get_movement_order_status()
  */
 void rp::game_variables::set_movement_order_status(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "movement_order", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "movement_order", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_movement_order_status()
 
 
@@ -369,7 +545,10 @@ void rp::game_variables::set_movement_order_status(bool value)
  */
 bool rp::game_variables::get_in_loading()
 {
-  return rp_game_variables_get_value( "in_loading", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "in_loading", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_in_loading()
 
 /*----------------------------------------------------------------------------*/
@@ -379,8 +558,10 @@ bool rp::game_variables::get_in_loading()
  */
 void rp::game_variables::set_in_loading(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "in_loading", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "in_loading", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_in_loading()
 
 /*----------------------------------------------------------------------------*/
@@ -389,7 +570,10 @@ void rp::game_variables::set_in_loading(bool value)
  */
 bool rp::game_variables::is_boss_level()
 {
-  return rp_game_variables_get_value( "boss_level", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "boss_level", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::is_boss_level()
 
 /*----------------------------------------------------------------------------*/
@@ -399,8 +583,10 @@ bool rp::game_variables::is_boss_level()
  */
 void rp::game_variables::set_boss_level(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "boss_level", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "boss_level", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_boss_level()
 
 /*----------------------------------------------------------------------------*/
@@ -409,7 +595,10 @@ void rp::game_variables::set_boss_level(bool value)
  */
 bool rp::game_variables::is_boss_transition()
 {
-  return rp_game_variables_get_value( "boss_transition", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "boss_transition", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::is_boss_transition()
 
 /*----------------------------------------------------------------------------*/
@@ -419,8 +608,10 @@ bool rp::game_variables::is_boss_transition()
  */
 void rp::game_variables::set_boss_transition(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "boss_transition", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "boss_transition", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_boss_transition()
     
 /*----------------------------------------------------------------------------*/
@@ -429,7 +620,10 @@ void rp::game_variables::set_boss_transition(bool value)
  */
 bool rp::game_variables::level_has_started()
 {
-  return rp_game_variables_get_value( "level_starting", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "level_starting", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::level_has_started()
 
 /*----------------------------------------------------------------------------*/
@@ -439,8 +633,10 @@ bool rp::game_variables::level_has_started()
  */
 void rp::game_variables::set_level_starting(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( "level_starting", value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "level_starting", false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_level_starting()
 
 /*----------------------------------------------------------------------------*/
@@ -464,8 +660,8 @@ std::string rp::game_variables::get_cart_elements_number_variable_name
  */
 unsigned int rp::game_variables::get_cart_elements_number(unsigned int id)
 {
-  return rp_game_variables_get_value
-    ( get_cart_elements_number_variable_name(id), (unsigned int)0 );
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_cart_elements_number_slot( id ) );
 } // game_variables::get_cart_elements_number()
 
 /*----------------------------------------------------------------------------*/
@@ -477,9 +673,8 @@ unsigned int rp::game_variables::get_cart_elements_number(unsigned int id)
 void rp::game_variables::set_cart_elements_number
 (unsigned int id, unsigned int value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_cart_elements_number_variable_name(id), value) );
+  game_variable_table::get_instance().set
+    ( rp_game_variables_get_cart_elements_number_slot( id ), value );
 } // game_variables::set_cart_elements_number()
 
 /*----------------------------------------------------------------------------*/
@@ -497,8 +692,11 @@ std::string rp::game_variables::get_plunger_total_number_variable_name()
  */
 unsigned int rp::game_variables::get_plunger_total_number()
 {
-  return rp_game_variables_get_value
-    ( get_plunger_total_number_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_plunger_total_number_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_plunger_total_number()
 
 /*----------------------------------------------------------------------------*/
@@ -508,9 +706,11 @@ unsigned int rp::game_variables::get_plunger_total_number()
  */
 void rp::game_variables::set_plunger_total_number(unsigned int value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_plunger_total_number_variable_name(), value) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_plunger_total_number_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_plunger_total_number()
 
 /*----------------------------------------------------------------------------*/
@@ -528,8 +728,11 @@ std::string rp::game_variables::get_plunger_number_variable_name()
  */
 unsigned int rp::game_variables::get_plunger_number()
 {
-  return rp_game_variables_get_value
-    ( get_plunger_number_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_plunger_number_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_plunger_number()
 
 /*----------------------------------------------------------------------------*/
@@ -539,9 +742,11 @@ unsigned int rp::game_variables::get_plunger_number()
  */
 void rp::game_variables::set_plunger_number(unsigned int value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_plunger_number_variable_name(), value) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_plunger_number_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_plunger_number()
 
 /*----------------------------------------------------------------------------*/
@@ -559,8 +764,11 @@ std::string rp::game_variables::get_plunger_activation_variable_name()
  */
 bool rp::game_variables::get_plunger_activation()
 {
-  return rp_game_variables_get_value
-    ( get_plunger_activation_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_plunger_activation_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_plunger_activation()
 
 /*----------------------------------------------------------------------------*/
@@ -570,9 +778,11 @@ bool rp::game_variables::get_plunger_activation()
  */
 void rp::game_variables::set_plunger_activation(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( get_plunger_activation_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_plunger_activation_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_plunger_activation()
 
 /*----------------------------------------------------------------------------*/
@@ -590,8 +800,11 @@ std::string rp::game_variables::get_plunger_validity_variable_name()
  */
 bool rp::game_variables::get_plunger_validity()
 {
-  return rp_game_variables_get_value
-    ( get_plunger_validity_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_plunger_validity_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_plunger_validity()
 
 /*----------------------------------------------------------------------------*/
@@ -601,9 +814,11 @@ bool rp::game_variables::get_plunger_validity()
  */
 void rp::game_variables::set_plunger_validity(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( get_plunger_validity_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_plunger_validity_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_plunger_validity()
 
 /*----------------------------------------------------------------------------*/
@@ -621,8 +836,11 @@ std::string rp::game_variables::get_cannonball_activation_variable_name()
  */
 bool rp::game_variables::get_cannonball_activation()
 {
-  return rp_game_variables_get_value
-    ( get_cannonball_activation_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_cannonball_activation_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_cannonball_activation()
 
 /*----------------------------------------------------------------------------*/
@@ -632,9 +850,11 @@ bool rp::game_variables::get_cannonball_activation()
  */
 void rp::game_variables::set_cannonball_activation(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( get_cannonball_activation_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_cannonball_activation_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_cannonball_activation()
 
 /*----------------------------------------------------------------------------*/
@@ -652,8 +872,11 @@ std::string rp::game_variables::get_cannonball_validity_variable_name()
  */
 bool rp::game_variables::get_cannonball_validity()
 {
-  return rp_game_variables_get_value
-    ( get_cannonball_validity_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_cannonball_validity_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_cannonball_validity()
 
 /*----------------------------------------------------------------------------*/
@@ -663,9 +886,11 @@ bool rp::game_variables::get_cannonball_validity()
  */
 void rp::game_variables::set_cannonball_validity(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( get_cannonball_validity_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_cannonball_validity_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_cannonball_validity()
 
 /*----------------------------------------------------------------------------*/
@@ -683,8 +908,11 @@ std::string rp::game_variables::get_status_visibility_variable_name()
  */
 bool rp::game_variables::get_status_visibility()
 {
-  return rp_game_variables_get_value
-    ( get_status_visibility_variable_name(), false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_status_visibility_variable_name(), false ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_status_visibility()
 
 /*----------------------------------------------------------------------------*/
@@ -694,9 +922,11 @@ bool rp::game_variables::get_status_visibility()
  */
 void rp::game_variables::set_status_visibility(bool value)
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( get_status_visibility_variable_name(), value) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare
+      ( get_status_visibility_variable_name(), false ) );
+
+  game_variable_table::get_instance().set( slot, value );
 } // game_variables::set_status_visibility()
 
 
@@ -730,11 +960,10 @@ std::string rp::game_variables::get_score_variable_name()
  */
 unsigned int rp::game_variables::get_persistent_score()
 {
-  return rp_game_variables_get_value
-    ( get_persistent_score_variable_name
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_persistent_score_slot
       ( game_variables::get_serial_number(),
-        game_variables::get_level_number() ),
-      (unsigned int)0 );
+        game_variables::get_level_number() ) );
 } // game_variables::get_persistent_score()
 
 /*----------------------------------------------------------------------------*/
@@ -746,8 +975,8 @@ unsigned int rp::game_variables::get_persistent_score()
 unsigned int rp::game_variables::get_persistent_score
 (unsigned int serial, unsigned int number)
 {
-  return rp_game_variables_get_value
-    ( get_persistent_score_variable_name( serial,number ), (unsigned int)0 );
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_persistent_score_slot( serial, number ) );
 } // game_variables::get_persistent_score()
 
 /*----------------------------------------------------------------------------*/
@@ -757,21 +986,37 @@ unsigned int rp::game_variables::get_persistent_score
  */
 void rp::game_variables::set_persistent_score( unsigned int c )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_persistent_score_variable_name
-         ( game_variables::get_serial_number(),
-           game_variables::get_level_number() ) , c ) );
+  game_variable_table::get_instance().set
+    ( rp_game_variables_get_persistent_score_slot
+      ( game_variables::get_serial_number(),
+        game_variables::get_level_number() ), c );
 } // game_variables::set_persistent_score()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of the persistent score of a given level.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ * \param f The function called with the new score.
+ */
+boost::signals2::connection rp::game_variables::listen_persistent_score
+( unsigned int serial, unsigned int number,
+  const boost::function<void (unsigned int)>& f )
+{
+  return game_variable_table::get_instance().listen
+    ( rp_game_variables_get_persistent_score_slot( serial, number ), f );
+} // game_variables::listen_persistent_score()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the score.
  */
 unsigned int rp::game_variables::get_score()
 {
-  return rp_game_variables_get_value
-    ( get_score_variable_name() , (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( get_score_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_score()
 
 /*----------------------------------------------------------------------------*/
@@ -781,9 +1026,10 @@ unsigned int rp::game_variables::get_score()
  */
 void rp::game_variables::set_score( unsigned int c )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_score_variable_name() , c ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( get_score_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, c );
 } // game_variables::set_score()
 
 /*----------------------------------------------------------------------------*/
@@ -827,11 +1073,11 @@ std::string rp::game_variables::get_new_score_variable_name()
  */
 void rp::game_variables::set_new_score()
 {
-  static const std::string name( get_new_score_variable_name() );
-  const bool value( rp_game_variables_get_value( name, false ) );
-  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( name, !value ) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( get_new_score_variable_name(), false ) );
+  game_variable_table& table( game_variable_table::get_instance() );
+
+  table.set( slot, !table.get( slot ) );
 } // game_variables::set_new_score()
 
 /*----------------------------------------------------------------------------*/
@@ -849,8 +1095,11 @@ std::string rp::game_variables::get_last_combo_variable_name()
  */
 unsigned int rp::game_variables::get_last_combo()
 {
-  return rp_game_variables_get_value
-    ( get_last_combo_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_last_combo_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_combo()
 
 /*----------------------------------------------------------------------------*/
@@ -860,9 +1109,11 @@ unsigned int rp::game_variables::get_last_combo()
  */
 void rp::game_variables::set_last_combo( unsigned int last_combo )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_last_combo_variable_name(), last_combo ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_last_combo_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, last_combo );
 } // game_variables::set_last_combo()
 
 /*----------------------------------------------------------------------------*/
@@ -889,8 +1140,8 @@ std::string rp::game_variables::get_level_state_variable_name
 unsigned int rp::game_variables::get_level_state
 (unsigned int serial, unsigned int number)
 {
-  return rp_game_variables_get_value
-    ( get_level_state_variable_name( serial,number ), (unsigned int)0 );
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_level_state_slot( serial, number ) );
 } // game_variables::get_level_state()
 
 /*----------------------------------------------------------------------------*/
@@ -903,18 +1154,35 @@ unsigned int rp::game_variables::get_level_state
 void rp::game_variables::set_level_state
 ( unsigned int serial, unsigned int number, unsigned int c )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_level_state_variable_name( serial, number ) , c ) );
+  game_variable_table::get_instance().set
+    ( rp_game_variables_get_level_state_slot( serial, number ), c );
 } // game_variables::set_level_state()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of the level state of a given level.
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ * \param f The function called with the new state.
+ */
+boost::signals2::connection rp::game_variables::listen_level_state
+( unsigned int serial, unsigned int number,
+  const boost::function<void (unsigned int)>& f )
+{
+  return game_variable_table::get_instance().listen
+    ( rp_game_variables_get_level_state_slot( serial, number ), f );
+} // game_variables::listen_level_state()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the bronze threshold.
  */
 unsigned int rp::game_variables::get_last_medal()
 {
-  return rp_game_variables_get_value( "medal/last", (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/last", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_last_medal()
 
 /*----------------------------------------------------------------------------*/
@@ -924,8 +1192,10 @@ unsigned int rp::game_variables::get_last_medal()
  */
 void rp::game_variables::set_last_medal( unsigned int threshold )
 {  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>( "medal/last" , threshold ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/last", (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, threshold );
 } // game_variables::set_last_medal()
 
 /*----------------------------------------------------------------------------*/
@@ -934,8 +1204,10 @@ void rp::game_variables::set_last_medal( unsigned int threshold )
  */
 unsigned int rp::game_variables::get_bronze_threshold()
 {
-  return rp_game_variables_get_value
-    ( "medal/bronze/threshold", (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/bronze/threshold", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_bronze_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -945,9 +1217,10 @@ unsigned int rp::game_variables::get_bronze_threshold()
  */
 void rp::game_variables::set_bronze_threshold( unsigned int threshold )
 {  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( "medal/bronze/threshold" , threshold ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/bronze/threshold", (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, threshold );
 } // game_variables::set_bronze_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -956,8 +1229,10 @@ void rp::game_variables::set_bronze_threshold( unsigned int threshold )
  */
 unsigned int rp::game_variables::get_silver_threshold()
 {
-  return rp_game_variables_get_value
-    ( "medal/silver/threshold", (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/silver/threshold", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_silver_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -967,9 +1242,10 @@ unsigned int rp::game_variables::get_silver_threshold()
  */
 void rp::game_variables::set_silver_threshold( unsigned int threshold )
 {  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( "medal/silver/threshold" , threshold ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/silver/threshold", (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, threshold );
 } // game_variables::set_silver_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -978,8 +1254,10 @@ void rp::game_variables::set_silver_threshold( unsigned int threshold )
  */
 unsigned int rp::game_variables::get_gold_threshold()
 {
-  return rp_game_variables_get_value
-    ( "medal/gold/threshold", (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/gold/threshold", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_gold_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -989,9 +1267,10 @@ unsigned int rp::game_variables::get_gold_threshold()
  */
 void rp::game_variables::set_gold_threshold( unsigned int threshold )
 {  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( "medal/gold/threshold" , threshold ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "medal/gold/threshold", (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, threshold );
 } // game_variables::set_gold_threshold()
 
 /*----------------------------------------------------------------------------*/
@@ -1009,8 +1288,10 @@ std::string rp::game_variables::get_combo_variable_name()
  */
 unsigned int rp::game_variables::get_combo()
 {
-  return rp_game_variables_get_value
-    ( get_combo_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( get_combo_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_combo()
 
 /*----------------------------------------------------------------------------*/
@@ -1020,9 +1301,10 @@ unsigned int rp::game_variables::get_combo()
  */
 void rp::game_variables::set_combo( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_combo_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( get_combo_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_combo()
 
 /*----------------------------------------------------------------------------*/
@@ -1040,8 +1322,10 @@ std::string rp::game_variables::get_points_variable_name()
  */
 int rp::game_variables::get_points()
 {
-  return rp_game_variables_get_value
-    ( get_points_variable_name(), (int)0 );
+  static const game_variable_slot<int> slot
+    ( rp_game_variables_declare( get_points_variable_name(), (int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_points()
 
 /*----------------------------------------------------------------------------*/
@@ -1051,9 +1335,10 @@ int rp::game_variables::get_points()
  */
 void rp::game_variables::set_points( int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<int>
-      (  get_points_variable_name(), nb ) );
+  static const game_variable_slot<int> slot
+    ( rp_game_variables_declare( get_points_variable_name(), (int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_points()
 
 /*----------------------------------------------------------------------------*/
@@ -1062,7 +1347,10 @@ void rp::game_variables::set_points( int nb )
  */
 double rp::game_variables::get_score_rate_x()
 {
-  return rp_game_variables_get_value( "score_rate_x", (double)0 );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "score_rate_x", (double)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_score_rate_x()
 
 /*----------------------------------------------------------------------------*/
@@ -1072,9 +1360,10 @@ double rp::game_variables::get_score_rate_x()
  */
 void rp::game_variables::set_score_rate_x(double x)
 {
-   bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<double>
-      ( "score_rate_x", x ) );
+   static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "score_rate_x", (double)0 ) );
+
+  game_variable_table::get_instance().set( slot, x );
 } // game_variables::set_score_rate_x()
 
 /*----------------------------------------------------------------------------*/
@@ -1083,7 +1372,10 @@ void rp::game_variables::set_score_rate_x(double x)
  */
 double rp::game_variables::get_score_rate_y()
 {
-  return rp_game_variables_get_value( "score_rate_y", (double)0 );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "score_rate_y", (double)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_score_rate_y()
 
 /*----------------------------------------------------------------------------*/
@@ -1093,9 +1385,10 @@ double rp::game_variables::get_score_rate_y()
  */
 void rp::game_variables::set_score_rate_y(double y)
 {
-   bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<double>
-      ( "score_rate_y", y ) );
+   static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "score_rate_y", (double)0 ) );
+
+  game_variable_table::get_instance().set( slot, y );
 } // game_variables::set_score_rate_y()
 
 /*----------------------------------------------------------------------------*/
@@ -1113,8 +1406,11 @@ std::string rp::game_variables::get_boss_hits_variable_name()
  */
 unsigned int rp::game_variables::get_boss_hits()
 {
-  return rp_game_variables_get_value
-    ( get_boss_hits_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_boss_hits_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_boss_hits()
 
 /*----------------------------------------------------------------------------*/
@@ -1124,9 +1420,11 @@ unsigned int rp::game_variables::get_boss_hits()
  */
 void rp::game_variables::set_boss_hits( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_boss_hits_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_boss_hits_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_boss_hits()
 
 /*----------------------------------------------------------------------------*/
@@ -1150,11 +1448,10 @@ std::string rp::game_variables::get_persistent_balloon_variable_name
  */
 unsigned int rp::game_variables::get_persistent_balloon()
 {
-  return rp_game_variables_get_value
-    ( get_persistent_balloon_variable_name
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_persistent_balloon_slot
       ( game_variables::get_serial_number(),
-        game_variables::get_level_number() ),
-      (unsigned int)0 );
+        game_variables::get_level_number() ) );
 } // game_variables::get_persistent_balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -1166,8 +1463,8 @@ unsigned int rp::game_variables::get_persistent_balloon()
 unsigned int rp::game_variables::get_persistent_balloon
 (unsigned int serial, unsigned int number)
 {
-  return rp_game_variables_get_value
-    ( get_persistent_balloon_variable_name( serial, number ), (unsigned int)0 );
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_get_persistent_balloon_slot( serial, number ) );
 } // game_variables::get_persistent_balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -1177,11 +1474,10 @@ unsigned int rp::game_variables::get_persistent_balloon
  */
 void rp::game_variables::set_persistent_balloon( unsigned int b )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      ( get_persistent_balloon_variable_name
-         ( game_variables::get_serial_number(),
-           game_variables::get_level_number() ) , b ) );
+  game_variable_table::get_instance().set
+    ( rp_game_variables_get_persistent_balloon_slot
+      ( game_variables::get_serial_number(),
+        game_variables::get_level_number() ), b );
 } // game_variables::set_persistent_balloon()
 
 /*----------------------------------------------------------------------------*/
@@ -1199,8 +1495,11 @@ std::string rp::game_variables::get_balloon_variable_name()
  */
 unsigned int rp::game_variables::get_balloons_number()
 {
-  return rp_game_variables_get_value
-    ( get_balloon_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_balloon_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_balloons_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1210,9 +1509,11 @@ unsigned int rp::game_variables::get_balloons_number()
  */
 void rp::game_variables::set_balloons_number( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_balloon_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_balloon_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_balloons_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1222,8 +1523,11 @@ void rp::game_variables::set_balloons_number( unsigned int nb )
 unsigned int
 rp::game_variables::get_required_balloons_number()
 {
-  return rp_game_variables_get_value
-    ( "required_balloons_number", (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( "required_balloons_number", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_required_balloons_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1233,8 +1537,11 @@ rp::game_variables::get_required_balloons_number()
  */
 void rp::game_variables::set_required_balloons_number( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>( "required_balloons_number", nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( "required_balloons_number", (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_required_balloons_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1252,8 +1559,11 @@ std::string rp::game_variables::get_bad_balloon_variable_name()
  */
 unsigned int rp::game_variables::get_bad_balloon_number()
 {
-  return rp_game_variables_get_value
-    ( get_bad_balloon_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_balloon_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_bad_balloon_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1263,9 +1573,11 @@ unsigned int rp::game_variables::get_bad_balloon_number()
  */
 void rp::game_variables::set_bad_balloon_number( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_bad_balloon_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_balloon_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_bad_balloon_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1283,8 +1595,11 @@ std::string rp::game_variables::get_bad_plunger_variable_name()
  */
 unsigned int rp::game_variables::get_bad_plunger_number()
 {
-  return rp_game_variables_get_value
-    ( get_bad_plunger_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_plunger_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_bad_plunger_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1294,9 +1609,11 @@ unsigned int rp::game_variables::get_bad_plunger_number()
  */
 void rp::game_variables::set_bad_plunger_number( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_bad_plunger_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_plunger_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_bad_plunger_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1314,8 +1631,11 @@ std::string rp::game_variables::get_bad_cannonball_variable_name()
  */
 unsigned int rp::game_variables::get_bad_cannonball_number()
 {
-  return rp_game_variables_get_value
-    ( get_bad_cannonball_variable_name(), (unsigned int)0 );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_cannonball_variable_name(), (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_bad_cannonball_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1325,9 +1645,11 @@ unsigned int rp::game_variables::get_bad_cannonball_number()
  */
 void rp::game_variables::set_bad_cannonball_number( unsigned int nb )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<unsigned int>
-      (  get_bad_cannonball_variable_name(), nb ) );
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare
+      ( get_bad_cannonball_variable_name(), (unsigned int)0 ) );
+
+  game_variable_table::get_instance().set( slot, nb );
 } // game_variables::set_bad_cannonball_number()
 
 /*----------------------------------------------------------------------------*/
@@ -1336,8 +1658,10 @@ void rp::game_variables::set_bad_cannonball_number( unsigned int nb )
  */
 double rp::game_variables::get_balloon_red_intensity()
 {
-  return rp_game_variables_get_value
-    ( "balloon_red_intensity", (double)1 );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_red_intensity", (double)1 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_balloon_red_intensity()
 
 /*----------------------------------------------------------------------------*/
@@ -1347,9 +1671,10 @@ double rp::game_variables::get_balloon_red_intensity()
  */
 void rp::game_variables::set_balloon_red_intensity( double red )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<double>
-      ( "balloon_red_intensity", red ) );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_red_intensity", (double)1 ) );
+
+  game_variable_table::get_instance().set( slot, red );
 } // game_variables::set_balloon_red_intensity()
 
 /*----------------------------------------------------------------------------*/
@@ -1358,8 +1683,10 @@ void rp::game_variables::set_balloon_red_intensity( double red )
  */
 double rp::game_variables::get_balloon_green_intensity()
 {
-  return rp_game_variables_get_value
-    ( "balloon_green_intensity", (double)1 );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_green_intensity", (double)1 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_balloon_green_intensity()
 
 /*----------------------------------------------------------------------------*/
@@ -1369,9 +1696,10 @@ double rp::game_variables::get_balloon_green_intensity()
  */
 void rp::game_variables::set_balloon_green_intensity( double green )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<double>
-      ( "balloon_green_intensity", green ) );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_green_intensity", (double)1 ) );
+
+  game_variable_table::get_instance().set( slot, green );
 } // game_variables::set_balloon_green_intensity()
 
 /*----------------------------------------------------------------------------*/
@@ -1380,8 +1708,10 @@ void rp::game_variables::set_balloon_green_intensity( double green )
  */
 double rp::game_variables::get_balloon_blue_intensity()
 {
-  return rp_game_variables_get_value
-    ( "balloon_blue_intensity", (double)1 );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_blue_intensity", (double)1 ) );
+
+  return game_variable_table::get_instance().get( slot );
 } // game_variables::get_balloon_blue_intensity()
 
 /*----------------------------------------------------------------------------*/
@@ -1391,23 +1721,119 @@ double rp::game_variables::get_balloon_blue_intensity()
  */
 void rp::game_variables::set_balloon_blue_intensity( double blue )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<double>
-      ( "balloon_blue_intensity", blue ) );
+  static const game_variable_slot<double> slot
+    ( rp_game_variables_declare( "balloon_blue_intensity", (double)1 ) );
+
+  game_variable_table::get_instance().set( slot, blue );
 } // game_variables::set_balloon_blue_intensity()
 
 void rp::game_variables::schedule_interstitial( bool b )
 {
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>
-      ( "interstitial_scheduled", b ) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "interstitial_scheduled", false ) );
+
+  game_variable_table::get_instance().set( slot, b );
 }
 
 bool rp::game_variables::interstitial_scheduled()
 {
-  return rp_game_variables_get_value( "interstitial_scheduled", false );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "interstitial_scheduled", false ) );
+
+  return game_variable_table::get_instance().get( slot );
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path of the input script played by the benchmark.
+ */
+std::string rp::game_variables::get_benchmark_input()
+{
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "benchmark/input", std::string() ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_benchmark_input()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path of the file where the benchmark writes its report. The
+ *        benchmark is disabled if this path is empty.
+ */
+std::string rp::game_variables::get_benchmark_output()
+{
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "benchmark/output", std::string() ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_benchmark_output()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of frames measured by the benchmark.
+ */
+unsigned int rp::game_variables::get_benchmark_frames()
+{
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "benchmark/frames", (unsigned int)3600 ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_benchmark_frames()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the format of the images of the screenshot
+ *        sequence.
+ */
+std::string rp::game_variables::get_capture_format()
+{
+  static const game_variable_slot<std::string> slot
+    ( rp_game_variables_declare( "capture/format", std::string( "bmp" ) ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_capture_format()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of threads encoding the images of the screenshot
+ *        sequence. Zero means that the number is chosen from the number of
+ *        processors.
+ */
+unsigned int rp::game_variables::get_capture_threads()
+{
+  static const game_variable_slot<unsigned int> slot
+    ( rp_game_variables_declare( "capture/threads", (unsigned int)0 ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_capture_threads()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the items of the levels are counted at each iteration.
+ */
+bool rp::game_variables::get_population_census()
+{
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( "population/census", false ) );
+
+  return game_variable_table::get_instance().get( slot );
+} // game_variables::get_population_census()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the maximum count of live decorations of a given category in a
+ *        level. Zero means that the count is not limited.
+ * \param category The name of the category of the decorations.
+ * \param default_value The budget if the variable is not set.
+ */
+unsigned int rp::game_variables::get_decoration_budget
+( const std::string& category, unsigned int default_value )
+{
+  return game_variable_table::get_instance().get
+    ( rp_game_variables_declare
+      ( "population/budget/" + category, default_value ) );
+} // game_variables::get_decoration_budget()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get a variable name prefixed with persistent option prefix.
@@ -1444,10 +1870,10 @@ std::string rp::game_variables::get_action_snapshot_variable_name()
 
 void rp::game_variables::set_action_snapshot()
 {
-  static const std::string name( get_action_snapshot_variable_name() );
-  const bool value( rp_game_variables_get_value( name, false ) );
-  
-  bear::engine::game::get_instance().set_game_variable
-    ( bear::engine::variable<bool>( name, !value ) );
+  static const game_variable_slot<bool> slot
+    ( rp_game_variables_declare( get_action_snapshot_variable_name(), false ) );
+  game_variable_table& table( game_variable_table::get_instance() );
+
+  table.set( slot, !table.get( slot ) );
 }
 
@@ -40,7 +40,7 @@ void rp::hole::collision
 	     bear::universe::zone::middle_left_zone ) )
 	default_collision(info);
       
-      if ( p->get_current_action_name() != "dead" )
+      if ( p->get_current_action_id() != model_action_id::dead )
         {
           if ( get_width() < 100 )
             {
@@ -0,0 +1,217 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::hover_manager class.
+ * \author Julien Jorge
+ */
+#include "rp/hover_manager.hpp"
+
+#include "rp/cursor.hpp"
+#include "rp/game_variables.hpp"
+#include "rp/interactive_item.hpp"
+#include "rp/profiler.hpp"
+
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <algorithm>
+
+BASE_ITEM_EXPORT( hover_manager, rp )
+
+/*----------------------------------------------------------------------------*/
+rp::hover_manager* rp::hover_manager::s_instance( NULL );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::hover_manager::hover_manager()
+  : m_cannonball_ready( false ), m_plunger_ready( false )
+{
+  set_global( true );
+  set_phantom( true );
+  set_artificial( true );
+  set_can_move_items( false );
+} // hover_manager::hover_manager()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::hover_manager::~hover_manager()
+{
+  if ( s_instance == this )
+    s_instance = NULL;
+} // hover_manager::~hover_manager()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the manager of the current level, if any.
+ */
+rp::hover_manager* rp::hover_manager::get_instance()
+{
+  return s_instance;
+} // hover_manager::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do post creation actions.
+ */
+void rp::hover_manager::on_enters_layer()
+{
+  super::on_enters_layer();
+
+  s_instance = this;
+} // hover_manager::on_enters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::hover_manager::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/hover_manager" );
+
+  super::progress( elapsed_time );
+
+  find_cursor();
+  update_weapons();
+  remove_dead_items();
+  find_hovered_items();
+  update_items();
+} // hover_manager::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an item to activate when the cursor is over it.
+ * \param item The item.
+ */
+void rp::hover_manager::add_item( interactive_item& item )
+{
+  m_items.push_back( item_handle( item ) );
+  m_hovered.push_back( false );
+} // hover_manager::add_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the cannon is activated and can fire.
+ */
+bool rp::hover_manager::is_cannonball_ready() const
+{
+  return m_cannonball_ready;
+} // hover_manager::is_cannonball_ready()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the plunger is activated and can be thrown.
+ */
+bool rp::hover_manager::is_plunger_ready() const
+{
+  return m_plunger_ready;
+} // hover_manager::is_plunger_ready()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Finds the cursor.
+ */
+void rp::hover_manager::find_cursor()
+{
+  if ( ( m_cursor != (cursor*)NULL ) || !has_world() )
+    return;
+
+  bear::universe::item_picking_filter filter;
+  filter.set_artificial_value( false );
+  filter.set_phantom_value( true );
+  filter.set_can_move_items_value( false );
+  filter.set_fixed_value( false );
+
+  typedef bear::universe::world::item_list item_list;
+  item_list items;
+
+  get_world().pick_items_in_rectangle
+    ( items, get_level().get_camera_focus(), filter );
+
+  for ( item_list::const_iterator it( items.begin() );
+        ( it != items.end() ) && ( m_cursor == (cursor*)NULL );
+        ++it )
+    m_cursor = dynamic_cast<cursor*>(*it);
+} // hover_manager::find_cursor()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the state of the weapons for all the items.
+ */
+void rp::hover_manager::update_weapons()
+{
+  m_cannonball_ready =
+    game_variables::get_cannonball_activation()
+    && game_variables::get_cannonball_validity();
+
+  m_plunger_ready =
+    game_variables::get_plunger_activation()
+    && game_variables::get_plunger_validity();
+} // hover_manager::update_weapons()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the items that have been deleted.
+ */
+void rp::hover_manager::remove_dead_items()
+{
+  std::size_t i( 0 );
+
+  while ( i != m_items.size() )
+    if ( m_items[i] == (interactive_item*)NULL )
+      {
+        m_items[i] = m_items.back();
+        m_hovered[i] = m_hovered.back();
+
+        m_items.pop_back();
+        m_hovered.pop_back();
+      }
+    else
+      ++i;
+} // hover_manager::remove_dead_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Test the items against the cursor.
+ */
+void rp::hover_manager::find_hovered_items()
+{
+  if ( m_cursor == (cursor*)NULL )
+    {
+      std::fill( m_hovered.begin(), m_hovered.end(), false );
+      return;
+    }
+
+  const bear::universe::rectangle_type box( m_cursor->get_bounding_box() );
+
+  for ( std::size_t i(0); i != m_items.size(); ++i )
+    m_hovered[i] = m_items[i]->is_hovered_by( box );
+} // hover_manager::find_hovered_items()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Activate the items newly under the cursor and deactivate those it
+ *        has left.
+ */
+void rp::hover_manager::update_items()
+{
+  for ( std::size_t i(0); i != m_items.size(); ++i )
+    if ( m_hovered[i] != m_items[i]->is_activated() )
+      {
+        if ( m_hovered[i] )
+          m_items[i]->activate();
+        else
+          m_items[i]->deactivate();
+      }
+} // hover_manager::update_items()
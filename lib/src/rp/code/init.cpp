@@ -16,6 +16,7 @@
 #include "rp/client_config.hpp"
 #include "rp/config_file.hpp"
 #include "rp/game_key.hpp"
+#include "rp/random.hpp"
 #include "rp/util.hpp"
 
 #include "engine/game.hpp"
@@ -24,9 +25,6 @@
 #include "engine/i18n/android_gettext_translator.hpp"
 #include "engine/i18n/translator.hpp"
 
-#include <cstdlib>
-#include <ctime>
-
 BEAR_ENGINE_GAME_INIT_FUNCTION( init_straining_coasters )
 
 void init_straining_coasters()
@@ -47,7 +45,7 @@ void init_straining_coasters()
     ( bear::engine::gettext_translator( translation_domain_name ) );
 #endif
 
-  std::srand(time(NULL));
+  rp::random::initialize();
   rp::util::load_game_variables();
   rp::util::send_version();
   rp::util::send_device_info();
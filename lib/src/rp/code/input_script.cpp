@@ -0,0 +1,165 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::input_script class.
+ * \author Julien Jorge
+ */
+#include "rp/input_script.hpp"
+
+#include "rp/cart.hpp"
+
+#include <claw/logger.hpp>
+
+#include <fstream>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::input_script::input_script()
+  : m_next( 0 )
+{
+
+} // input_script::input_script()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the inputs from a file.
+ * \param path The path of the file.
+ * \return false if the file cannot be read or is malformed.
+ */
+bool rp::input_script::load( const std::string& path )
+{
+  m_events.clear();
+  m_next = 0;
+
+  std::ifstream f( path.c_str() );
+
+  if ( !f )
+    {
+      claw::logger << claw::log_error << "Cannot open the input script '"
+                   << path << "'." << std::endl;
+      return false;
+    }
+
+  std::string line;
+  std::size_t line_number(0);
+
+  while ( std::getline( f, line ) )
+    {
+      ++line_number;
+
+      if ( line.empty() || (line[0] == '#') )
+        continue;
+
+      std::istringstream iss( line );
+      std::string action_name;
+      event e;
+
+      bool ok( (iss >> e.frame >> action_name)
+               && parse_action( action_name, e.action ) );
+
+      if ( ok && (e.action == action_cursor) )
+        ok = !( iss >> e.position.x >> e.position.y ).fail();
+
+      if ( ok && !m_events.empty() )
+        ok = ( e.frame >= m_events.back().frame );
+
+      if ( !ok )
+        {
+          claw::logger << claw::log_error << "Invalid input in '" << path
+                       << "' at line " << line_number << ": '" << line << "'."
+                       << std::endl;
+          m_events.clear();
+          return false;
+        }
+
+      m_events.push_back( e );
+    }
+
+  return true;
+} // input_script::load()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of inputs in the script.
+ */
+std::size_t rp::input_script::get_event_count() const
+{
+  return m_events.size();
+} // input_script::get_event_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if all the inputs have been applied.
+ */
+bool rp::input_script::is_finished() const
+{
+  return m_next == m_events.size();
+} // input_script::is_finished()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Apply to the cart the inputs of a given frame.
+ * \param frame The current frame.
+ * \param c The cart receiving the inputs.
+ */
+void rp::input_script::apply( std::size_t frame, cart& c )
+{
+  for ( ; (m_next != m_events.size()) && (m_events[m_next].frame <= frame);
+        ++m_next )
+    switch( m_events[m_next].action )
+      {
+      case action_jump:
+        c.input_handle_jump();
+        break;
+      case action_crouch:
+        c.input_handle_crouch();
+        break;
+      case action_cannonball:
+        c.input_handle_cannonball();
+        break;
+      case action_plunger:
+        c.input_handle_plunger();
+        break;
+      case action_cursor:
+        c.update_cursor_position( m_events[m_next].position );
+        break;
+      }
+} // input_script::apply()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the action corresponding to a name in the script.
+ * \param name The name of the action.
+ * \param action (out) The action.
+ * \return false if the name is not a valid action.
+ */
+bool rp::input_script::parse_action
+( const std::string& name, action_type& action )
+{
+  bool result( true );
+
+  if ( name == "jump" )
+    action = action_jump;
+  else if ( name == "crouch" )
+    action = action_crouch;
+  else if ( name == "cannonball" )
+    action = action_cannonball;
+  else if ( name == "plunger" )
+    action = action_plunger;
+  else if ( name == "cursor" )
+    action = action_cursor;
+  else
+    result = false;
+
+  return result;
+} // input_script::parse_action()
@@ -12,9 +12,10 @@
  * \author Sebastien Angibaud
  */
 #include "rp/interactive_item.hpp"
-#include "rp/cursor.hpp"
 #include "rp/entity.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/hover_manager.hpp"
+#include "rp/sound_bank.hpp"
 
 #include "engine/level.hpp"
 #include "engine/item_brick/with_rendering_attributes.hpp"
@@ -25,8 +26,6 @@
 #include "visual/scene_sprite.hpp"
 #include "visual/scene_writing.hpp"
 
-#include "engine/world.hpp"
-
 #include <boost/bind.hpp>
 #include <claw/tween/tweener_sequence.hpp>
 #include <claw/tween/single_tweener.hpp>
@@ -39,7 +38,7 @@ BASE_ITEM_EXPORT( interactive_item, rp )
  * \brief Contructor.
  */
 rp::interactive_item::interactive_item()
-: m_item(NULL), m_sprite_factor(1), m_area_factor(0.5)
+: m_item(NULL), m_sprite_factor(1), m_area_factor(0.5), m_registered(false)
 {
   set_artificial(true);
   set_phantom(true);
@@ -58,7 +57,7 @@ rp::interactive_item::interactive_item
 ( bear::engine::base_item* item, double sprite_factor, double area_factor,
   bear::universe::position_type gap, const bear::visual::animation& help )
   : m_item( item ), m_sprite_factor(sprite_factor), m_area_factor(area_factor),
-    m_gap(gap)
+    m_gap(gap), m_registered(false)
 {
   set_artificial( true );
   set_phantom( true );
@@ -102,8 +101,6 @@ void rp::interactive_item::on_enters_layer()
       m.set_distance(m_gap); 
       set_forced_movement(m);
     }
-
-  find_cursor();
 } // interactive_item::on_enters_layer()
 
 /*---------------------------------------------------------------------------*/
@@ -122,26 +119,26 @@ void rp::interactive_item::progress( bear::universe::time_type elapsed_time )
       m_cannonball_sprite.set_opacity(0);
       m_plunger_sprite.set_opacity(0);
 
-      find_cursor();
-      const bool cursor_in_collision( is_colliding_with_cursor() );
+      hover_manager* const manager( hover_manager::get_instance() );
 
-      if ( cursor_in_collision && ! m_activated )
-        activate();
-      else if ( ! cursor_in_collision && m_activated )
-        deactivate();      
+      // The activation is done by the manager, from the position of the cursor
+      // in the previous iteration.
+      if ( !m_registered && (manager != NULL) )
+        {
+          manager->add_item( *this );
+          m_registered = true;
+        }
 
       bool visible = true;
-      if ( m_activated )
+      if ( m_activated && (manager != NULL) )
         {
-          if ( game_variables::get_cannonball_activation() && 
-               game_variables::get_cannonball_validity() )
+          if ( manager->is_cannonball_ready() )
             {
               visible = false;
               m_cannonball_sprite.set_opacity(1);
             }
           
-          if ( game_variables::get_plunger_activation() && 
-               game_variables::get_plunger_validity() )
+          if ( manager->is_plunger_ready() )
             {
               visible = false;
               m_plunger_sprite.set_opacity(1);
@@ -210,8 +207,8 @@ void rp::interactive_item::get_visual
  */
 void rp::interactive_item::activate()
 {
-  get_level_globals().play_sound
-    ( "sound/effect/over.ogg",
+  sound_bank::play
+    ( get_level_globals(), sound_bank::over_sample,
       bear::audio::sound_effect( get_center_of_mass() ) );
 
   m_activated = true;
@@ -303,48 +300,27 @@ void rp::interactive_item::update_item()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Finds the cursor.
+ * \brief Tells if the item is activated.
  */
-void rp::interactive_item::find_cursor()
+bool rp::interactive_item::is_activated() const
 {
-  if ( ( m_cursor != handle_type(NULL) ) || !has_world() )
-    return;
-  
-  bear::universe::item_picking_filter filter;
-  filter.set_artificial_value( false );
-  filter.set_phantom_value( true );
-  filter.set_can_move_items_value( false );
-  filter.set_fixed_value( false );
-
-  typedef bear::universe::world::item_list item_list;
-  item_list items;
-
-  get_world().pick_items_in_rectangle
-    ( items, get_level().get_camera_focus(), filter );
-
-  for ( item_list::const_iterator it( items.begin() );
-        ( it != items.end() ) && ( m_cursor == handle_type(NULL) );
-        ++it )
-        m_cursor = dynamic_cast<cursor*>(*it);
-} // interactive_item::find_cursor()
+  return m_activated;
+} // interactive_item::is_activated()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Tells if the decorative item is colliding the cursor.
+ * \brief Tells if a box covers enough of the item to activate it.
+ * \param box The bounding box of the cursor.
  */
-bool rp::interactive_item::is_colliding_with_cursor() const
+bool rp::interactive_item::is_hovered_by
+( const bear::universe::rectangle_type& box ) const
 {
-  if ( m_cursor == handle_type(NULL) )
-    return false;
-
-  if ( !m_cursor->get_bounding_box().intersects( get_bounding_box() ) )
+  if ( !box.intersects( get_bounding_box() ) )
     return false;
 
   const bear::universe::coordinate_type min_area =
-    std::min
-    ( m_cursor->get_bounding_box().area(), get_bounding_box().area() );
+    std::min( box.area(), get_bounding_box().area() );
 
   return
-    m_cursor->get_bounding_box().intersection( get_bounding_box() ).area()
-    >  min_area * m_area_factor;
-} // interactive_item::is_colliding_with_cursor()
+    box.intersection( get_bounding_box() ).area() > min_area * m_area_factor;
+} // interactive_item::is_hovered_by()
@@ -0,0 +1,36 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::item_pool_base class.
+ * \author Julien Jorge
+ */
+#include "rp/item_pool.hpp"
+
+/*----------------------------------------------------------------------------*/
+std::atomic<std::size_t> rp::item_pool_base::s_heap_allocation_count( 0 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of blocks allocated on the heap by all the pools since
+ *        the start of the program.
+ */
+std::size_t rp::item_pool_base::get_heap_allocation_count()
+{
+  return s_heap_allocation_count.load( std::memory_order_relaxed );
+} // item_pool_base::get_heap_allocation_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count a block allocated on the heap by a pool.
+ */
+void rp::item_pool_base::count_heap_allocation()
+{
+  s_heap_allocation_count.fetch_add( 1, std::memory_order_relaxed );
+} // item_pool_base::count_heap_allocation()
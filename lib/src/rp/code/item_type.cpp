@@ -0,0 +1,110 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::item_type class.
+ * \author Julien Jorge
+ */
+#include "rp/item_type.hpp"
+
+#include "rp/balloon.hpp"
+#include "rp/bird.hpp"
+#include "rp/bomb.hpp"
+#include "rp/boss.hpp"
+#include "rp/cable.hpp"
+#include "rp/cannonball.hpp"
+#include "rp/cart.hpp"
+#include "rp/crate.hpp"
+#include "rp/explosion.hpp"
+#include "rp/hole.hpp"
+#include "rp/obstacle.hpp"
+#include "rp/plank.hpp"
+#include "rp/plunger.hpp"
+#include "rp/switching.hpp"
+#include "rp/tar.hpp"
+#include "rp/tnt.hpp"
+#include "rp/wall.hpp"
+#include "rp/zeppelin.hpp"
+
+/*----------------------------------------------------------------------------*/
+rp::item_type::type_map rp::item_type::s_types;
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the type of an item. This method must be
+ *        called by the game thread.
+ * \param item The item.
+ */
+rp::item_type::value_type
+rp::item_type::get( const bear::engine::base_item& item )
+{
+  const std::type_info& type( typeid( item ) );
+  const type_map::const_iterator it( s_types.find( &type ) );
+
+  if ( it != s_types.end() )
+    return it->second;
+
+  // The same type may be described by several std::type_info in different
+  // libraries, in which case each one is compared once.
+  const value_type result( find( type ) );
+  s_types[ &type ] = result;
+
+  return result;
+} // item_type::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the identifier of a type if it is the type of an item.
+ * \param type The dynamic type of the item.
+ * \param result (out) The identifier of T, if type is T.
+ * \return true if type is T.
+ *
+ * The types are compared for equality, thus an item of a class derived from T
+ * is not identified as a T.
+ */
+template<typename T>
+bool rp::item_type::test( const std::type_info& type, value_type& result )
+{
+  if ( type != typeid( T ) )
+    return false;
+
+  result = of<T>::value;
+  return true;
+} // item_type::test()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compare a type with the types of the items of the game.
+ * \param type The type.
+ */
+rp::item_type::value_type rp::item_type::find( const std::type_info& type )
+{
+  value_type result( unknown );
+
+  test<rp::balloon>( type, result )
+    || test<rp::bird>( type, result )
+    || test<rp::bomb>( type, result )
+    || test<rp::boss>( type, result )
+    || test<rp::cable>( type, result )
+    || test<rp::cannonball>( type, result )
+    || test<rp::cart>( type, result )
+    || test<rp::crate>( type, result )
+    || test<rp::explosion>( type, result )
+    || test<rp::hole>( type, result )
+    || test<rp::obstacle>( type, result )
+    || test<rp::plank>( type, result )
+    || test<rp::plunger>( type, result )
+    || test<rp::switching>( type, result )
+    || test<rp::tar>( type, result )
+    || test<rp::tnt>( type, result )
+    || test<rp::wall>( type, result )
+    || test<rp::zeppelin>( type, result );
+
+  return result;
+} // item_type::find()
@@ -8,16 +8,50 @@
 */
 /**
  * \file
- * \brief Implementation of the target class.
+ * \brief Implementation of the level_generator class.
  * \author Sebastien Angibaud
  */
 #include "rp/level_generator.hpp"
+#include "rp/balloon.hpp"
 #include "rp/hole.hpp"
-#include "rp/target.hpp"
+#include "rp/random.hpp"
 #include "rp/bonus.hpp"
+#include "rp/profiler.hpp"
+
+#include "engine/level.hpp"
+
+#include <claw/logger.hpp>
+
+#include <limits>
 
 BASE_ITEM_EXPORT( level_generator, rp )
 
+/*----------------------------------------------------------------------------*/
+const bear::universe::coordinate_type
+rp::level_generator::s_generation_distance( 2000 );
+
+/*----------------------------------------------------------------------------*/
+const bear::universe::coordinate_type
+rp::level_generator::s_retire_distance( 1000 );
+
+/*----------------------------------------------------------------------------*/
+const std::size_t rp::level_generator::s_segments_per_iteration( 2 );
+
+/*----------------------------------------------------------------------------*/
+const std::size_t rp::level_generator::s_report_period( 100 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::level_generator::level_generator()
+  : m_previous_is_slope( false ), m_segment_count( 0 ), m_last_bonus( 0 ),
+    m_generation_duration( 0 )
+{
+  // The generator must progress wherever the camera is.
+  set_global( true );
+} // level_generator::level_generator()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Do post creation actions.
@@ -26,10 +60,29 @@ void rp::level_generator::on_enters_layer()
 {
   super::on_enters_layer();
 
-  srand(time(NULL));
-  create_level();
+  random::start_level( get_level().get_name() );
+
+  m_position = get_top_left();
+
+  // The first window is filled at once such that the track is ready when the
+  // level starts.
+  update_window( std::numeric_limits<std::size_t>::max() );
 } // rp::level_generator::on_enters_layer()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::level_generator::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/level_generator" );
+
+  super::progress( elapsed_time );
+
+  update_window( s_segments_per_iteration );
+} // level_generator::progress()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set a field of type item.
@@ -81,63 +134,172 @@ void rp::level_generator::on_enters_layer()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Create the level.
+ * \brief Tell if the item is correctly initialized. The generator picks the
+ *        items in its lists, thus none of them can be empty.
+ */
+bool rp::level_generator::is_valid() const
+{
+  return !m_slopes.empty() && !m_straight_slopes.empty()
+    && !m_obstacles.empty() && super::is_valid();
+} // level_generator::is_valid()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of the generated items still in the level.
+ */
+std::size_t rp::level_generator::get_live_item_count() const
+{
+  std::size_t result(0);
+
+  for ( const segment& s : m_segments )
+    for ( const item_handle& item : s.items )
+      if ( item != NULL )
+        ++result;
+
+  return result;
+} // level_generator::get_live_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the total time spent generating the segments.
  */
-void rp::level_generator::create_level()
+rp::level_generator::duration_type
+rp::level_generator::get_generation_duration() const
 {
-  bear::universe::position_type pos(get_top_left());
-  bool previous_is_slope(false);
-  unsigned int last_paint = 0;
+  return m_generation_duration;
+} // level_generator::get_generation_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Generate the segments ahead of the camera and remove those behind
+ *        it.
+ * \param max_segments The maximum count of segments to generate.
+ */
+void rp::level_generator::update_window( std::size_t max_segments )
+{
+  const bear::universe::rectangle_type camera
+    ( get_level().get_camera_focus() );
+
+  retire_segments( camera.left() - s_retire_distance );
+
+  const bear::universe::coordinate_type limit
+    ( camera.right() + s_generation_distance );
 
-  for(unsigned int i = 0; i != 100; i++ )
+  if ( m_position.x >= limit )
+    return;
+
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
+  for ( std::size_t i(0); (i != max_segments) && (m_position.x < limit); ++i )
     {
-      const double selector = (double)rand() / RAND_MAX;
-
-      if ( ( ( selector < 0.9 ) && previous_is_slope ) ||
-	   ( ( selector < 0.5 ) && ! previous_is_slope ) )
-	{
-	  previous_is_slope = true;
-	  add_slope(pos);
-	}
-      else
-	{
-	  previous_is_slope = false;
-	  add_ground(pos);
-	}
-
-      create_target(pos);
-      
-      if ( ( ((double)rand() / RAND_MAX) < 0.1 ) && 
-	   ( i - last_paint > 50 ) )
-	{
-	  last_paint = i;
-	  create_bonus(pos);
-	}
-    }  
-} // rp::level_generator::create_level()
+      create_segment();
+
+      if ( m_segment_count % s_report_period == 0 )
+        report();
+    }
+
+  m_generation_duration += std::chrono::steady_clock::now() - start;
+} // level_generator::update_window()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Add a slope.
+ * \brief Remove the segments ending on the left of a given position.
+ * \param limit The position on the left of which the segments are removed.
+ */
+void rp::level_generator::retire_segments
+( bear::universe::coordinate_type limit )
+{
+  while ( !m_segments.empty() && (m_segments.front().right < limit) )
+    {
+      // The items that have moved near the camera, like a balloon taken by
+      // the cart, are left to the level.
+      for ( const item_handle& item : m_segments.front().items )
+        if ( (item != NULL)
+             && (item->get_right() < limit) )
+          item->kill();
+
+      m_segments.pop_front();
+    }
+} // level_generator::retire_segments()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the next segment of the track.
  */
-void rp::level_generator::create_target(bear::universe::position_type& pos)
+void rp::level_generator::create_segment()
 {
-  target* new_target = new target();
+  m_segments.push_back( segment() );
+
+  const double selector = random::level_generation().real();
+
+  if ( ( ( selector < 0.9 ) && m_previous_is_slope ) ||
+       ( ( selector < 0.5 ) && ! m_previous_is_slope ) )
+    {
+      m_previous_is_slope = true;
+      add_slope(m_position);
+    }
+  else
+    {
+      m_previous_is_slope = false;
+      add_ground(m_position);
+    }
+
+  create_balloon(m_position);
 
-  new_target->set_center_of_mass
+  if ( ( random::level_generation().real() < 0.1 ) && 
+       ( m_segment_count - m_last_bonus > 50 ) )
+    {
+      m_last_bonus = m_segment_count;
+      create_bonus(m_position);
+    }
+
+  m_segments.back().right = m_position.x;
+  ++m_segment_count;
+} // rp::level_generator::create_segment()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an item in the level and in the current segment.
+ * \param item The item to add.
+ */
+void rp::level_generator::add_generated_item( bear::engine::base_item& item )
+{
+  new_item( item );
+  m_segments.back().items.push_back( item_handle(item) );
+} // level_generator::add_generated_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Log the counters of the generator.
+ */
+void rp::level_generator::report() const
+{
+  claw::logger << claw::log_verbose << "Generator: "
+               << m_segment_count << " segments, "
+               << m_segments.size() << " live segments, "
+               << get_live_item_count() << " live items, "
+               << m_generation_duration.count() << " ms generating."
+               << std::endl;
+} // level_generator::report()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a balloon near a given position.
+ */
+void rp::level_generator::create_balloon(bear::universe::position_type& pos)
+{
+  balloon* new_balloon = new balloon();
+
+  new_balloon->set_center_of_mass
     ( pos + 
       bear::universe::position_type
-      ( (rand() % 600) - 200,
-	(rand() % 400) - 200) );
-  new_target->set_z_position(get_z_position()+10000);
-  
-  if ( ( (double)rand() / RAND_MAX ) < 0.5 ) 
-    new_target->set_color("yellow");
-  else
-    new_target->set_color("red");
+      ( (int)random::level_generation().integer(600) - 200,
+	(int)random::level_generation().integer(400) - 200) );
+  new_balloon->set_z_position(get_z_position()+10000);
 
-  new_item( *new_target );
-} // level_generator::create_target()
+  add_generated_item( *new_balloon );
+} // level_generator::create_balloon()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -148,12 +310,13 @@ void rp::level_generator::create_bonus(bear::universe::position_type& pos)
   add_straight_slope(pos);
 
   bonus* new_bonus = new bonus();
+  new_bonus->set_string_field( "bonus.type", "plunger" );
   new_bonus->set_center_of_mass
     ( pos + bear::universe::position_type(0,100));
   
   new_bonus->set_z_position(get_z_position()+11000);
   
-  new_item( *new_bonus );
+  add_generated_item( *new_bonus );
 
   add_straight_slope(pos);
 } // level_generator::create_bonus()
@@ -164,7 +327,7 @@ void rp::level_generator::create_bonus(bear::universe::position_type& pos)
  */
 void rp::level_generator::add_slope(bear::universe::position_type& pos)
 {
-  unsigned int ind = rand() % m_slopes.size();
+  unsigned int ind = random::level_generation().integer( m_slopes.size() );
 
   bear::slope* new_slope;
 
@@ -173,7 +336,7 @@ void rp::level_generator::add_slope(bear::universe::position_type& pos)
   if ( new_slope->get_steepness() < 0 ) 
     {
       new_slope->set_top_left(pos);
-      new_item( *new_slope );
+      add_generated_item( *new_slope );
       
       pos.x += new_slope->get_width();
       pos.y += new_slope->get_steepness();
@@ -183,7 +346,7 @@ void rp::level_generator::add_slope(bear::universe::position_type& pos)
       pos.y += new_slope->get_steepness();
 
       new_slope->set_top_left(pos);
-      new_item( *new_slope );
+      add_generated_item( *new_slope );
       
       pos.x += new_slope->get_width();      
     }
@@ -195,7 +358,7 @@ void rp::level_generator::add_slope(bear::universe::position_type& pos)
  */
 void rp::level_generator::add_ground(bear::universe::position_type& pos)
 {
-  const double selector = (double)rand() / RAND_MAX;
+  const double selector = random::level_generation().real();
 
   if ( selector < 0.5 )
     add_straight_slope(pos);
@@ -219,7 +382,7 @@ void rp::level_generator::add_hole
   bear::universe::position_type p1(pos);
   p1.y += 5;
   new_straight_slope_1= new bear::straight_slope( *(m_left_hole) );
-  new_item( *new_straight_slope_1 );
+  add_generated_item( *new_straight_slope_1 );
   new_straight_slope_1->set_top_left(p1);  
   pos.x += new_straight_slope_1->get_width();
   
@@ -227,7 +390,7 @@ void rp::level_generator::add_hole
   hole* new_hole = new hole();
   new_hole->set_size(400,50);
   new_hole->set_top_left(pos + bear::universe::position_type(-100,-50));
-  new_item( *new_hole );
+  add_generated_item( *new_hole );
   
   pos.x += 200;
   
@@ -236,7 +399,7 @@ void rp::level_generator::add_hole
   bear::universe::position_type p2(pos);
   p2.y += 5;
   new_straight_slope_2 = new bear::straight_slope( *(m_right_hole) );
-  new_item( *new_straight_slope_2 );
+  add_generated_item( *new_straight_slope_2 );
   new_straight_slope_2->set_top_left(p2);  
   pos.x += new_straight_slope_2->get_width();
   
@@ -252,11 +415,11 @@ void rp::level_generator::add_obstacle(bear::universe::position_type& pos)
   add_straight_slope(pos);
   add_straight_slope(pos);
 
-  unsigned int ind = rand() % m_obstacles.size();
+  unsigned int ind = random::level_generation().integer( m_obstacles.size() );
   
   obstacle* new_obstacle = new obstacle(*(m_obstacles[ind]));
   new_obstacle->set_bottom_middle(pos);
-  new_item( *new_obstacle );
+  add_generated_item( *new_obstacle );
 
   add_straight_slope(pos);
 } // level_generator::add_obstacle()
@@ -268,7 +431,8 @@ void rp::level_generator::add_obstacle(bear::universe::position_type& pos)
 void rp::level_generator::add_straight_slope
 (bear::universe::position_type& pos)
 {
-  unsigned int ind = rand() % m_straight_slopes.size();
+  unsigned int ind =
+    random::level_generation().integer( m_straight_slopes.size() );
 
   bear::straight_slope* new_straight_slope;
 
@@ -277,7 +441,7 @@ void rp::level_generator::add_straight_slope
 
   new_straight_slope= new bear::straight_slope( *(m_straight_slopes[ind]) );
 
-  new_item( *new_straight_slope );
+  add_generated_item( *new_straight_slope );
   new_straight_slope->set_top_left(p);  
     
   pos.x += new_straight_slope->get_width();
@@ -16,6 +16,8 @@
 #include "rp/defines.hpp"
 #include "rp/game_variables.hpp"
 #include "rp/level_state.hpp"
+#include "rp/music_player.hpp"
+#include "rp/profiler.hpp"
 #include "rp/show_rate_dialog.hpp"
 #include "rp/util.hpp"
 
@@ -34,7 +36,6 @@
 #include "generic_items/star.hpp"
 
 #include "visual/scene_sprite.hpp"
-#include "visual/scene_writing.hpp"
 
 #include "universe/forced_movement/forced_tracking.hpp"
 
@@ -51,6 +52,7 @@
 BASE_ITEM_EXPORT( level_selector, rp )
 
 bool rp::level_selector::s_selection = false;
+unsigned int rp::level_selector::s_state_generation = 0;
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -64,7 +66,7 @@ rp::level_selector::level_selector()
   m_mouse_in(false), m_rectangle(NULL),
   m_decorative_level_name(NULL), m_load(false), m_rectangle_opacity(0),
   m_medal_movement(1), m_cursor(NULL),
-  m_animate_unlock( false )
+  m_animate_unlock( false ), m_state_generation( 0 ), m_displayed_score( 0 )
 {
   set_artificial( true );
   set_phantom( true );
@@ -160,7 +162,18 @@ void rp::level_selector::on_enters_layer()
 
   game_variables::select_level( false );
   util::load_game_variables(); 
+
+  m_score_connection =
+    game_variables::listen_persistent_score
+    ( m_serial_number, m_level_number,
+      boost::bind( &rp::level_selector::invalidate_state, this ) );
+  m_state_connection =
+    game_variables::listen_level_state
+    ( m_serial_number, m_level_number,
+      boost::bind( &rp::level_selector::invalidate_state, this ) );
+
   update_medal(get_state());
+  m_points = digit_writing( m_font );
   update_state();  
   m_initial_position = get_center_of_mass();
 
@@ -189,6 +202,8 @@ void rp::level_selector::on_enters_layer()
  */
 void rp::level_selector::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/level_selector" );
+
   if ( m_ad_connection.connected() )
     return;
   
@@ -196,7 +211,9 @@ void rp::level_selector::progress( bear::universe::time_type elapsed_time )
 
   if ( game_variables::get_selected_serial() != m_serial_number )
     {
-      update_state();
+      if ( ! is_state_valid() )
+        update_state();
+
       return;
     }
   
@@ -221,7 +238,8 @@ void rp::level_selector::progress( bear::universe::time_type elapsed_time )
 
   if ( ! m_updated && ( ! s_selection || is_selected_level() ) )
     {
-      update_state();
+      if ( ! is_state_valid() )
+        update_state();
 
       if ( m_animate_unlock )
         animate_unlock();
@@ -506,7 +524,11 @@ void rp::level_selector::load_level()
           &claw::tween::easing_linear::ease_in_out );
     }
 
+  // The music of the level starts during the fade, such that it plays while
+  // the level is loading.
   get_level().stop_music( fade_duration );
+  music_player::get_instance().play_level_music
+    ( get_level_path(), fade_duration );
 
   claw::tween::tweener_sequence t;
   t.insert
@@ -549,6 +571,9 @@ void rp::level_selector::update_visibility()
  */
 void rp::level_selector::update_state()
 {
+  // Set before the update since it may change the state of the level.
+  m_state_generation = s_state_generation;
+
   unsigned int state = m_level_state;
   unsigned int new_state = get_new_state();
 
@@ -582,16 +607,39 @@ void rp::level_selector::update_state()
    */
 void rp::level_selector::update_score()
 {
-  std::ostringstream oss;
   unsigned int score = 
     game_variables::get_persistent_score(m_serial_number,m_level_number);
-  
+
+  if ( score == m_displayed_score )
+    return;
+
   if ( score > 0 ) 
-    oss << score;
-  
-  m_points.create(m_font, oss.str() );
+    m_points.set_value( score );
+  else
+    m_points.clear();
+
+  m_displayed_score = score;
 } // level_selector::update_score()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell all the selectors to update their state at the next iteration.
+ */
+void rp::level_selector::invalidate_state()
+{
+  ++s_state_generation;
+} // level_selector::invalidate_state()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the state has been updated since the last change of the
+ *        score or of the state of a level.
+ */
+bool rp::level_selector::is_state_valid() const
+{
+  return m_state_generation == s_state_generation;
+} // level_selector::is_state_valid()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Check if previous level requires conditions.
@@ -774,11 +822,9 @@ void rp::level_selector::render_points
       get_bottom() + m_level_factor * m_score_factor * 
       ( -60 - (double)m_points.get_height() ));
   
-  bear::visual::scene_writing s( pos.x, pos.y, m_points );
-  s.set_scale_factor
-    (m_level_factor * m_score_factor, m_level_factor * m_score_factor); 
-
-  visuals.push_back( s );
+  visuals.push_back
+    ( m_points.get_scene_element
+      ( pos.x, pos.y, m_level_factor * m_score_factor ) );
 } // level_selector::render_points
   
 /*----------------------------------------------------------------------------*/
@@ -1008,11 +1054,20 @@ void rp::level_selector::push_level()
   util::save_game_variables();
 
   game_variables::set_level_theme( m_theme );
+  bear::engine::game::get_instance().push_level( get_level_path() );
+} // level_selector::push_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path of the level.
+ */
+std::string rp::level_selector::get_level_path() const
+{
   std::ostringstream stream;
   stream << "level/" << m_serial_number << "/level-" << m_level_number << ".cl";
-  
-  bear::engine::game::get_instance().push_level( stream.str() );
-} // level_selector::push_level()
+
+  return stream.str();
+} // level_selector::get_level_path()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -1427,6 +1482,7 @@ void rp::level_selector::resume()
       get_level().get_camera_size().y / 2 );
   m_load = false;
 
+  music_player::get_instance().stop( 1 );
   get_level().play_music();
 
   if ( ! check_fall_medal() )
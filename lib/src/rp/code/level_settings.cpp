@@ -13,13 +13,19 @@
  */
 #include "rp/level_settings.hpp"
 #include "rp/add_ingame_layers.hpp"
+#include "rp/benchmark.hpp"
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/music_player.hpp"
+#include "rp/preload_plan.hpp"
+#include "rp/random.hpp"
 #include "rp/power_up/has_extra_plungers.hpp"
 
 #include "engine/level.hpp"
 #include "generic_items/timer.hpp"
 
+#include <claw/logger.hpp>
+
 BASE_ITEM_EXPORT( level_settings, rp )
 
 /*----------------------------------------------------------------------------*/
@@ -33,6 +39,26 @@ rp::level_settings::level_settings()
 {
 } // level_settings::level_settings()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load the media required by this class.
+ */
+void rp::level_settings::pre_cache()
+{
+  super::pre_cache();
+
+  // Only the theme of the level is loaded here. The other themes are loaded
+  // during the game by the background_loader.
+  preload_plan plan;
+  plan.add_theme( m_level_theme );
+  plan.load_all( get_level_globals() );
+
+  claw::logger << claw::log_verbose << "Preload: theme '" << m_level_theme
+               << "': " << plan.get_loaded_count() << " resources, "
+               << plan.get_loaded_bytes() << " bytes, "
+               << plan.get_loading_duration().count() << " ms." << std::endl;
+} // level_settings::pre_cache()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Initialize the item.
@@ -41,6 +67,7 @@ void rp::level_settings::build()
 {
   super::build();
 
+  random::start_level( get_level().get_name() );
   game_variables::load_variables(get_level().get_name());
   game_variables::set_bad_plunger_number(0);
   game_variables::set_bad_cannonball_number(0);
@@ -62,6 +89,11 @@ void rp::level_settings::build()
   game_variables::set_ending_effect(false);
   game_variables::set_last_combo( 0 );
 
+  // The music is already playing if the level has been loaded by the level
+  // selector, in which case this call changes nothing.
+  music_player::get_instance().play_level_music
+    ( get_level().get_filename(), 1 );
+
   const int plunger_count( 3 + 3 * has_extra_plungers() );
   game_variables::set_plunger_total_number( plunger_count );
   game_variables::set_plunger_number( plunger_count );
@@ -95,6 +127,13 @@ void rp::level_settings::on_enters_layer()
       if ( m_add_ingame_layers != NULL )
         m_add_ingame_layers->set_level_timer(item);
     }
+
+  if ( (m_cart != NULL) && !game_variables::get_benchmark_output().empty() )
+    {
+      benchmark* item = new benchmark();
+      item->set_cart( *m_cart );
+      new_item( *item );
+    }
 } // rp::level_settings::on_enters_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -0,0 +1,147 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::mapped_file class.
+ * \author Julien Jorge
+ */
+#include "rp/mapped_file.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param file_name The name of the file to map.
+ */
+rp::mapped_file::mapped_file( const std::string& file_name )
+  : m_data( NULL ), m_size( 0 ), m_open( false )
+{
+#ifdef _WIN32
+  m_mapping = NULL;
+  m_file =
+    CreateFileA
+    ( file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL, NULL );
+
+  if ( m_file == INVALID_HANDLE_VALUE )
+    return;
+
+  LARGE_INTEGER size;
+
+  if ( !GetFileSizeEx( m_file, &size ) )
+    return;
+
+  m_open = true;
+  m_size = size.QuadPart;
+
+  // An empty file cannot be mapped.
+  if ( m_size == 0 )
+    return;
+
+  m_mapping = CreateFileMappingA( m_file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+  if ( m_mapping != NULL )
+    m_data =
+      static_cast<const char*>
+      ( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+
+  if ( m_data == NULL )
+    {
+      m_open = false;
+      m_size = 0;
+    }
+#else
+  const int fd( open( file_name.c_str(), O_RDONLY ) );
+
+  if ( fd == -1 )
+    return;
+
+  struct stat status;
+
+  if ( fstat( fd, &status ) == 0 )
+    {
+      m_open = true;
+      m_size = status.st_size;
+
+      // An empty file cannot be mapped.
+      if ( m_size != 0 )
+        {
+          void* const p
+            ( mmap( NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0 ) );
+
+          if ( p == MAP_FAILED )
+            {
+              m_open = false;
+              m_size = 0;
+            }
+          else
+            m_data = static_cast<const char*>( p );
+        }
+    }
+
+  // The mapping stays valid after the file is closed.
+  close( fd );
+#endif
+} // mapped_file::mapped_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::mapped_file::~mapped_file()
+{
+#ifdef _WIN32
+  if ( m_data != NULL )
+    UnmapViewOfFile( m_data );
+
+  if ( m_mapping != NULL )
+    CloseHandle( m_mapping );
+
+  if ( m_file != INVALID_HANDLE_VALUE )
+    CloseHandle( m_file );
+#else
+  if ( m_data != NULL )
+    munmap( const_cast<char*>( m_data ), m_size );
+#endif
+} // mapped_file::~mapped_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the file has been opened.
+ */
+bool rp::mapped_file::is_open() const
+{
+  return m_open;
+} // mapped_file::is_open()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the content of the file. The result is NULL if the file is empty.
+ */
+const char* rp::mapped_file::data() const
+{
+  return m_data;
+} // mapped_file::data()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the file.
+ */
+std::size_t rp::mapped_file::size() const
+{
+  return m_size;
+} // mapped_file::size()
@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::model_action_id and rp::model_mark_id
+ *        classes.
+ * \author Julien Jorge
+ */
+#include "rp/model_id.hpp"
+
+#include <cassert>
+#include <unordered_map>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of an action from its name.
+ * \param name The name of the action.
+ */
+rp::model_action_id::value_type
+rp::model_action_id::get( const std::string& name )
+{
+  static const std::unordered_map<std::string, value_type> actions
+    {
+      { "afraid", afraid },
+      { "crouch", crouch },
+      { "dead", dead },
+      { "fly", fly },
+      { "hit", hit },
+      { "idle", idle },
+      { "jump", jump },
+      { "move", move },
+      { "takeoff", takeoff },
+      { "with_tar", with_tar }
+    };
+
+  const auto it( actions.find( name ) );
+
+  if ( it == actions.end() )
+    return unknown;
+  else
+    return it->second;
+} // model_action_id::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of a mark from its identifier.
+ * \param id The identifier of the mark.
+ */
+const std::string& rp::model_mark_id::get_name( value_type id )
+{
+  static const std::string names[ count ] =
+    {
+      "arm",
+      "cannon",
+      "fire",
+      "gun",
+      "plunger"
+    };
+
+  assert( (std::size_t)id < count );
+
+  return names[ id ];
+} // model_mark_id::get_name()
@@ -0,0 +1,834 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::music_player class.
+ * \author Julien Jorge
+ */
+#include "rp/music_player.hpp"
+
+#include "rp/profiler.hpp"
+
+#include "engine/game.hpp"
+#include "engine/resource_pool.hpp"
+
+#include <SDL2/SDL_mixer.h>
+
+#ifdef RP_STREAM_MUSIC
+#include <vorbis/vorbisfile.h>
+#endif
+
+#include <boost/bind.hpp>
+#include <claw/logger.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t rp::music_player::s_ring_frames( 32768 );
+const unsigned int rp::music_player::s_poll_delay( 50 );
+
+/*----------------------------------------------------------------------------*/
+#ifdef RP_STREAM_MUSIC
+namespace
+{
+  /** \brief A compressed track and its decoder. */
+  struct rp_music_track
+  {
+    /** \brief The decoder of the track. */
+    OggVorbis_File decoder;
+
+    /** \brief The compressed track. */
+    std::string data;
+
+    /** \brief The position of the decoder in the compressed track. */
+    std::size_t position;
+
+  }; // struct rp_music_track
+} // namespace
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the compressed track, for the decoder.
+ * \param ptr (out) The buffer receiving the bytes.
+ * \param size The size of the elements to read.
+ * \param count The count of elements to read.
+ * \param source The track.
+ */
+static std::size_t rp_music_track_read
+( void* ptr, std::size_t size, std::size_t count, void* source )
+{
+  rp_music_track& track( *static_cast<rp_music_track*>( source ) );
+  const std::size_t result
+    ( std::min( count, ( track.data.size() - track.position ) / size ) );
+
+  std::memcpy( ptr, track.data.data() + track.position, result * size );
+  track.position += result * size;
+
+  return result;
+} // rp_music_track_read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move in the compressed track, for the decoder.
+ * \param source The track.
+ * \param offset The position relative to the origin.
+ * \param origin The origin of the move.
+ */
+static int rp_music_track_seek( void* source, ogg_int64_t offset, int origin )
+{
+  rp_music_track& track( *static_cast<rp_music_track*>( source ) );
+  ogg_int64_t result( offset );
+
+  if ( origin == SEEK_CUR )
+    result += track.position;
+  else if ( origin == SEEK_END )
+    result += track.data.size();
+
+  if ( ( result < 0 ) || ( result > (ogg_int64_t)track.data.size() ) )
+    return -1;
+
+  track.position = result;
+  return 0;
+} // rp_music_track_seek()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position in the compressed track, for the decoder.
+ * \param source The track.
+ */
+static long rp_music_track_tell( void* source )
+{
+  return static_cast<rp_music_track*>( source )->position;
+} // rp_music_track_tell()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::music_player::deck::deck()
+  : generation( 0 ), decoded_generation( 0 ), track( NULL ), rate( 0 ),
+    frame_position( 0 ), read_count( 0 ), write_count( 0 ), ready( false ),
+    mixing( false ), mixed_generation( 0 ), gain( 0 ),
+    fade( fade_command() ), decoded_size( 0 ), decoding_duration( 0 )
+{
+
+} // music_player::deck::deck()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the instance of the player.
+ */
+rp::music_player& rp::music_player::get_instance()
+{
+  static music_player result;
+  return result;
+} // music_player::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Play the music of a level, if it has been removed from the level at
+ *        build time, or stop the music otherwise.
+ * \param level The path of the level.
+ * \param fade The duration of the crossfade with the current music.
+ * \return true if the music of the level is played by the player.
+ */
+bool rp::music_player::play_level_music
+( const std::string& level, double fade )
+{
+  std::string name;
+
+  if ( !find_level_music( level, name ) )
+    {
+      stop( fade );
+      return false;
+    }
+
+  play( name, fade );
+  return true;
+} // music_player::play_level_music()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Play a track in loop, crossfaded with the current track. If the
+ *        track is not decoded yet, its volume starts increasing when its
+ *        first frames are decoded.
+ * \param name The path of the track.
+ * \param fade The duration of the crossfade.
+ */
+void rp::music_player::play( const std::string& name, double fade )
+{
+  RP_PROFILE_ZONE( "music/play" );
+
+  const clock_type::time_point start( clock_type::now() );
+
+  if ( !open_mixer() )
+    return;
+
+  update_volume();
+
+  const std::size_t index( prepare_deck( name ) );
+
+  for ( std::size_t i(0); i != 2; ++i )
+    fade_deck( m_decks[i], ( i == index ) ? 1 : 0, fade );
+
+  log_request( name, start );
+} // music_player::play()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Fade out the tracks being played.
+ * \param fade The duration of the fade.
+ */
+void rp::music_player::stop( double fade )
+{
+  if ( !m_mixer_open )
+    return;
+
+  for ( std::size_t i(0); i != 2; ++i )
+    fade_deck( m_decks[i], 0, fade );
+} // music_player::stop()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Apply the volume of the music set in the game.
+ */
+void rp::music_player::update_volume()
+{
+  const bear::engine::game& g( bear::engine::game::get_instance() );
+
+  // The music is also muted with the sounds, as in the pause menu.
+  if ( g.get_music_muted() || g.get_sound_muted() )
+    m_volume = 0;
+  else
+    m_volume = g.get_music_volume();
+} // music_player::update_volume()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::music_player::music_player()
+  : m_quit( false ), m_level_musics_loaded( false ), m_mixer_open( false ),
+    m_mixer_rate( 0 ), m_volume( 1 ), m_underrun_count( 0 )
+{
+  for ( std::size_t i(0); i != 2; ++i )
+    m_decks[i].ring.resize( 2 * s_ring_frames );
+} // music_player::music_player()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::music_player::~music_player()
+{
+  if ( m_mixer_open )
+    Mix_HookMusic( NULL, NULL );
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+    m_quit = true;
+  }
+
+  m_request_condition.notify_one();
+
+  if ( m_thread.joinable() )
+    m_thread.join();
+
+  for ( std::size_t i(0); i != 2; ++i )
+    close_track( m_decks[i] );
+} // music_player::~music_player()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Connect the player to the mixer opened by the engine, if it is not
+ *        done yet.
+ * \return false if the format of the mixer is not supported.
+ */
+bool rp::music_player::open_mixer()
+{
+  if ( m_mixer_open )
+    return true;
+
+  int rate;
+  Uint16 format;
+  int channels;
+
+  if ( Mix_QuerySpec( &rate, &format, &channels ) == 0 )
+    {
+      claw::logger << claw::log_error << "Music: the mixer is not open."
+                   << std::endl;
+      return false;
+    }
+
+  if ( ( format != AUDIO_S16SYS ) || ( channels != 2 ) )
+    {
+      claw::logger << claw::log_error << "Music: unsupported mixer format "
+                   << format << " with " << channels << " channels."
+                   << std::endl;
+      return false;
+    }
+
+  m_mixer_rate = rate;
+  m_mixer_open = true;
+  Mix_HookMusic( &music_player::mix_callback, this );
+
+  return true;
+} // music_player::open_mixer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the file listing the music of the levels, if it is not done
+ *        yet.
+ */
+void rp::music_player::load_level_musics()
+{
+  if ( m_level_musics_loaded )
+    return;
+
+  m_level_musics_loaded = true;
+
+  const std::string file_name( "level/music.txt" );
+  bear::engine::resource_pool& pool
+    ( bear::engine::resource_pool::get_instance() );
+
+  if ( !pool.exists( file_name ) )
+    return;
+
+  std::stringstream file;
+  pool.get_file( file_name, file );
+
+  std::string level;
+  std::string music;
+
+  while ( file >> level >> music )
+    m_level_musics[ level ] = music;
+
+  claw::logger << claw::log_verbose << "Music: " << m_level_musics.size()
+               << " levels with streamed music." << std::endl;
+} // music_player::load_level_musics()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the music of a level, if it has been removed from the level at
+ *        build time.
+ * \param level The path of the level.
+ * \param name (out) The path of the music.
+ * \return true if the music of the level is played by the player.
+ */
+bool rp::music_player::find_level_music
+( const std::string& level, std::string& name )
+{
+  load_level_musics();
+
+  const std::map<std::string, std::string>::const_iterator it
+    ( m_level_musics.find( level ) );
+
+  if ( it == m_level_musics.end() )
+    return false;
+
+  name = it->second;
+  return true;
+} // music_player::find_level_music()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a deck decoding a given track. If no deck decodes the track, it
+ *        is decoded in the deck having the lowest volume.
+ * \param name The path of the track.
+ * \return The index of the deck in m_decks.
+ */
+std::size_t rp::music_player::prepare_deck( const std::string& name )
+{
+  const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+  std::size_t result( 2 );
+
+  for ( std::size_t i(0); ( result == 2 ) && ( i != 2 ); ++i )
+    if ( m_decks[i].name == name )
+      result = i;
+
+  if ( result == 2 )
+    {
+      if ( !is_audible( m_decks[0] ) )
+        result = 0;
+      else if ( !is_audible( m_decks[1] ) )
+        result = 1;
+      else if ( m_decks[0].gain < m_decks[1].gain )
+        result = 0;
+      else
+        result = 1;
+
+      deck& d( m_decks[result] );
+
+      // The mixer does not read a deck which is not ready and starts the new
+      // generation of the deck with a null volume. The deck must be marked as
+      // not ready before the generation changes, such that the worker does
+      // not reset the ring buffer while the mixer reads it.
+      d.ready = false;
+      d.fade = fade_command();
+      d.name = name;
+      ++d.generation;
+
+      start_worker();
+    }
+
+  m_request_condition.notify_one();
+
+  return result;
+} // music_player::prepare_deck()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Change progressively the volume of a deck. The change is applied by
+ *        the mixer.
+ * \param d The deck.
+ * \param gain The final volume of the deck.
+ * \param fade The duration of a change of the volume from zero to one.
+ */
+void rp::music_player::fade_deck( deck& d, float gain, double fade )
+{
+  const double frames( fade * m_mixer_rate );
+  fade_command command;
+
+  command.gain = gain;
+
+  if ( frames < 1 )
+    command.step = 0;
+  else
+    command.step = 1 / frames;
+
+  d.fade = command;
+} // music_player::fade_deck()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a deck is heard or will be heard.
+ * \param d The deck.
+ */
+bool rp::music_player::is_audible( const deck& d )
+{
+  return ( d.gain != 0 ) || ( d.fade.load().gain != 0 );
+} // music_player::is_audible()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start the worker thread if it is not running. The mutex must be
+ *        locked.
+ */
+void rp::music_player::start_worker()
+{
+  if ( m_thread.get_id() == boost::thread::id() )
+    m_thread = boost::thread( boost::bind( &music_player::run, this ) );
+} // music_player::start_worker()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the worker thread.
+ */
+void rp::music_player::run()
+{
+  while ( true )
+    {
+      const bool busy( fill_decks() );
+
+      boost::unique_lock<boost::mutex> lock( m_mutex );
+
+      if ( m_quit )
+        return;
+
+      if ( !busy )
+        m_request_condition.timed_wait
+          ( lock, boost::posix_time::milliseconds( s_poll_delay ) );
+    }
+} // music_player::run()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Open the tracks requested in the decks and decode the tracks in the
+ *        free space of the ring buffers. Called by the worker thread.
+ * \return true if a track has been opened.
+ */
+bool rp::music_player::fill_decks()
+{
+  bool result( false );
+
+  for ( std::size_t i(0); i != 2; ++i )
+    {
+      deck& d( m_decks[i] );
+      std::string name;
+      std::size_t generation;
+
+      {
+        const boost::unique_lock<boost::mutex> lock( m_mutex );
+        name = d.name;
+        generation = d.generation;
+      }
+
+      if ( generation != d.decoded_generation )
+        {
+          result = true;
+
+          // The deck is not ready since its generation has changed. Wait for
+          // the mixer to leave the ring buffer before resetting it.
+          while ( d.mixing )
+            boost::this_thread::yield();
+
+          if ( d.track != NULL )
+            log_decoding( d );
+
+          close_track( d );
+          d.decoded_generation = generation;
+
+          if ( open_track( d, name ) && decode( d, s_ring_frames ) )
+            {
+              const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+              // The track may have been replaced while it was opened.
+              d.ready = ( d.generation == generation );
+            }
+        }
+      else if ( d.track != NULL )
+        {
+          const std::size_t free_frames
+            ( s_ring_frames - ( d.write_count - d.read_count ) );
+
+          if ( free_frames >= s_ring_frames / 4 )
+            decode( d, free_frames );
+        }
+    }
+
+  return result;
+} // music_player::fill_decks()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a track and prepare its decoding. Called by the worker thread.
+ * \param d The deck in which the track is decoded.
+ * \param name The path of the track.
+ */
+#ifdef RP_STREAM_MUSIC
+bool rp::music_player::open_track( deck& d, const std::string& name )
+{
+  const clock_type::time_point start( clock_type::now() );
+  bear::engine::resource_pool& pool
+    ( bear::engine::resource_pool::get_instance() );
+
+  if ( !pool.exists( name ) )
+    {
+      claw::logger << claw::log_error << "Music: can't find '" << name << "'."
+                   << std::endl;
+      return false;
+    }
+
+  rp_music_track* const track( new rp_music_track );
+  std::stringstream file;
+  pool.get_file( name, file );
+  track->data = file.str();
+  track->position = 0;
+
+  const ov_callbacks callbacks =
+    { &rp_music_track_read, &rp_music_track_seek, NULL,
+      &rp_music_track_tell };
+
+  if ( ov_open_callbacks( track, &track->decoder, NULL, 0, callbacks ) != 0 )
+    {
+      claw::logger << claw::log_error << "Music: can't decode '" << name
+                   << "'." << std::endl;
+      delete track;
+      return false;
+    }
+
+  const vorbis_info* const info( ov_info( &track->decoder, -1 ) );
+
+  d.track = track;
+  d.rate = info->rate;
+  d.frame_position = 0;
+  d.pending.clear();
+  d.read_count = 0;
+  d.write_count = 0;
+  d.decoded_size =
+    ov_pcm_total( &track->decoder, -1 ) * info->channels * sizeof( Sint16 );
+  d.decoding_duration = clock_type::now() - start;
+
+  claw::logger << claw::log_verbose << "Music: '" << name << "' streamed with "
+               << ( track->data.size() + d.ring.size() * sizeof( float ) )
+                  / 1024
+               << " KiB resident instead of " << d.decoded_size / 1024
+               << " KiB decoded." << std::endl;
+
+  return true;
+} // music_player::open_track()
+#else
+bool rp::music_player::open_track( deck& d, const std::string& name )
+{
+  claw::logger << claw::log_error << "Music: can't decode '" << name
+               << "', the game is built without RP_STREAM_MUSIC." << std::endl;
+  return false;
+} // music_player::open_track()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Release the decoder of a deck. Called by the worker thread.
+ * \param d The deck.
+ */
+#ifdef RP_STREAM_MUSIC
+void rp::music_player::close_track( deck& d )
+{
+  if ( d.track == NULL )
+    return;
+
+  rp_music_track* const track( static_cast<rp_music_track*>( d.track ) );
+
+  ov_clear( &track->decoder );
+  delete track;
+  d.track = NULL;
+} // music_player::close_track()
+#else
+void rp::music_player::close_track( deck& d )
+{
+  d.track = NULL;
+} // music_player::close_track()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode frames of the track of a deck in its ring buffer, resampled
+ *        at the rate of the mixer. Called by the worker thread.
+ * \param d The deck.
+ * \param frame_count The count of frames to write in the ring buffer.
+ */
+bool rp::music_player::decode( deck& d, std::size_t frame_count )
+{
+  const clock_type::time_point start( clock_type::now() );
+  const double step( d.rate / m_mixer_rate );
+  std::size_t write_count( d.write_count );
+  bool result( true );
+
+  for ( std::size_t n(0); result && ( n != frame_count ); )
+    {
+      const std::size_t i( d.frame_position );
+
+      if ( 2 * ( i + 1 ) >= d.pending.size() )
+        result = read_frames( d );
+      else
+        {
+          const float t( d.frame_position - i );
+          const std::size_t j( 2 * ( write_count % s_ring_frames ) );
+
+          d.ring[ j ] =
+            d.pending[ 2 * i ] * ( 1 - t ) + d.pending[ 2 * i + 2 ] * t;
+          d.ring[ j + 1 ] =
+            d.pending[ 2 * i + 1 ] * ( 1 - t ) + d.pending[ 2 * i + 3 ] * t;
+
+          d.frame_position += step;
+          ++write_count;
+          ++n;
+        }
+    }
+
+  d.write_count = write_count;
+  d.decoding_duration += clock_type::now() - start;
+
+  return result;
+} // music_player::decode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the next frames of the track of a deck, and append them to
+ *        the frames not yet resampled. The track restarts at the beginning
+ *        when its end is reached. Called by the worker thread.
+ * \param d The deck.
+ */
+#ifdef RP_STREAM_MUSIC
+bool rp::music_player::read_frames( deck& d )
+{
+  OggVorbis_File* const file_decoder
+    ( &static_cast<rp_music_track*>( d.track )->decoder );
+
+  // Keep the last frame, needed to interpolate with the new frames.
+  const std::size_t consumed
+    ( std::min( std::size_t( d.frame_position ), d.pending.size() / 2 ) );
+
+  d.pending.erase( d.pending.begin(), d.pending.begin() + 2 * consumed );
+  d.frame_position -= consumed;
+
+  float** pcm;
+  int section;
+  const long count( ov_read_float( file_decoder, &pcm, 4096, &section ) );
+
+  // The track restarts at the end, unless it is empty.
+  if ( count == 0 )
+    return ( ov_pcm_tell( file_decoder ) != 0 )
+      && ( ov_pcm_seek( file_decoder, 0 ) == 0 );
+
+  // A negative count is a hole in the data, the decoding continues after it.
+  if ( count < 0 )
+    return true;
+
+  const int channels( ov_info( file_decoder, section )->channels );
+  const float* const right( ( channels > 1 ) ? pcm[1] : pcm[0] );
+
+  for ( long i(0); i != count; ++i )
+    {
+      d.pending.push_back( pcm[0][i] );
+      d.pending.push_back( right[i] );
+    }
+
+  return true;
+} // music_player::read_frames()
+#else
+bool rp::music_player::read_frames( deck& d )
+{
+  return false;
+} // music_player::read_frames()
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the frames of the decks, mixed at their volume, in the buffer
+ *        of the mixer. Called by the audio thread.
+ * \param stream (out) The buffer of the mixer.
+ * \param length The size of the buffer, in bytes.
+ */
+void rp::music_player::mix( unsigned char* stream, int length )
+{
+  const std::size_t block_frames( 256 );
+  float block[ 2 * block_frames ];
+  Sint16* output( reinterpret_cast<Sint16*>( stream ) );
+  std::size_t frame_count( length / ( 2 * sizeof( Sint16 ) ) );
+  const float volume( m_volume );
+
+  while ( frame_count != 0 )
+    {
+      const std::size_t n( std::min( frame_count, block_frames ) );
+      std::fill( block, block + 2 * n, 0.0f );
+
+      for ( std::size_t i(0); i != 2; ++i )
+        {
+          deck& d( m_decks[i] );
+          d.mixing = true;
+
+          if ( d.generation != d.mixed_generation )
+            {
+              d.mixed_generation = d.generation;
+              d.gain = 0;
+            }
+
+          // The worker resets the counts of a deck which is not ready, and
+          // the volume of such a deck is kept until its first frames are
+          // decoded.
+          if ( d.ready )
+            mix_deck( d, block, n );
+
+          d.mixing = false;
+        }
+
+      for ( std::size_t j(0); j != 2 * n; ++j )
+        output[j] =
+          std::max( -1.0f, std::min( 1.0f, block[j] * volume ) ) * 32767;
+
+      output += 2 * n;
+      frame_count -= n;
+    }
+} // music_player::mix()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the frames of a deck, at its volume, to a block of frames.
+ *        Called by the audio thread.
+ * \param d The deck, which must be ready.
+ * \param block (in/out) The frames to which the frames of the deck are added.
+ * \param n The count of frames in the block.
+ */
+void rp::music_player::mix_deck( deck& d, float* block, std::size_t n )
+{
+  const fade_command fade( d.fade );
+  float gain( d.gain );
+
+  if ( ( gain == 0 ) && ( fade.gain == 0 ) )
+    return;
+
+  std::size_t read_count( d.read_count );
+  const std::size_t available( std::min( n, d.write_count - read_count ) );
+
+  if ( available != n )
+    m_underrun_count += n - available;
+
+  for ( std::size_t j(0); j != n; ++j )
+    {
+      if ( j < available )
+        {
+          const std::size_t k( 2 * ( read_count % s_ring_frames ) );
+          block[ 2 * j ] += d.ring[ k ] * gain;
+          block[ 2 * j + 1 ] += d.ring[ k + 1 ] * gain;
+          ++read_count;
+        }
+
+      if ( fade.step == 0 )
+        gain = fade.gain;
+      else if ( gain < fade.gain )
+        gain = std::min( fade.gain, gain + fade.step );
+      else
+        gain = std::max( fade.gain, gain - fade.step );
+    }
+
+  d.read_count = read_count;
+  d.gain = gain;
+} // music_player::mix_deck()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The function called by the mixer to get the frames of the music.
+ * \param player The player.
+ * \param stream (out) The buffer of the mixer.
+ * \param length The size of the buffer, in bytes.
+ */
+void rp::music_player::mix_callback
+( void* player, unsigned char* stream, int length )
+{
+  static_cast<music_player*>( player )->mix( stream, length );
+} // music_player::mix_callback()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Log the time spent by the worker decoding the track of a deck, and
+ *        the count of frames the mixer could not read. Called by the worker
+ *        thread.
+ * \param d The deck.
+ */
+void rp::music_player::log_decoding( const deck& d )
+{
+  const std::chrono::duration<double, std::milli> duration
+    ( d.decoding_duration );
+
+  claw::logger << claw::log_verbose << "Music: track decoded by the worker in "
+               << duration.count() << " ms, " << m_underrun_count.exchange( 0 )
+               << " frames missed by the mixer." << std::endl;
+} // music_player::log_decoding()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Log the time spent by the game thread to request a track.
+ * \param name The path of the track.
+ * \param start The date at which the request started.
+ */
+void rp::music_player::log_request
+( const std::string& name, clock_type::time_point start ) const
+{
+  const std::chrono::duration<double, std::milli> duration
+    ( clock_type::now() - start );
+
+  claw::logger << claw::log_verbose << "Music: '" << name
+               << "' requested in " << duration.count()
+               << " ms by the game thread." << std::endl;
+} // music_player::log_request()
@@ -15,6 +15,8 @@
 
 #include "rp/cart.hpp"
 #include "rp/plank.hpp" 
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
 
@@ -53,6 +55,8 @@ void rp::obstacle::on_enters_layer()
  */
 void rp::obstacle::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/obstacle" );
+
   super::progress( elapsed_time );
 
   update_items();
@@ -155,8 +159,8 @@ void rp::obstacle::create_random_planks(const std::string& mark_name)
       stream << mark_name << " " << i;
       
       bear::universe::force_type force;
-      force.x = -100000 + 200000 * (double)rand() / RAND_MAX;
-      force.y = 100000 + 100000 * (double)rand() / RAND_MAX;
+      force.x = -100000 + 200000 * random::effects().real();
+      force.y = 100000 + 100000 * random::effects().real();
 
       create_plank(stream.str(),force);      
     }
@@ -254,7 +258,7 @@ void rp::obstacle::create_plank
       p->set_system_angle(mark.get_angle());
       p->get_rendering_attributes().combine(get_rendering_attributes());
 
-      const double angular_speed = 1 + 20 * (double)rand() / RAND_MAX;
+      const double angular_speed = 1 + 20 * random::effects().real();
 
       if ( force.x < 0 )
         p->set_angular_speed( -angular_speed );
@@ -0,0 +1,574 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::particle_system class.
+ * \author Julien Jorge
+ */
+#include "rp/particle_system.hpp"
+
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
+
+#include "engine/level.hpp"
+#include "engine/level_globals.hpp"
+#include "engine/scene_visual.hpp"
+#include "visual/animation.hpp"
+#include "visual/scene_sprite.hpp"
+
+#include <boost/math/constants/constants.hpp>
+
+#include <cmath>
+
+BASE_ITEM_EXPORT( particle_system, rp )
+
+/*----------------------------------------------------------------------------*/
+rp::particle_system* rp::particle_system::s_instance( NULL );
+
+/*----------------------------------------------------------------------------*/
+const std::size_t rp::particle_system::s_capacity( 2048 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::particle_system::particle_system()
+  : m_count( 0 ), m_dropped( 0 ), m_update_duration( 0 ),
+    m_x( s_capacity ), m_y( s_capacity ), m_speed_x( s_capacity ),
+    m_speed_y( s_capacity ), m_acceleration_y( s_capacity ),
+    m_friction( s_capacity ), m_angle( s_capacity ),
+    m_angular_speed( s_capacity ), m_scale( s_capacity ),
+    m_scale_speed( s_capacity ), m_intensity( s_capacity ),
+    m_intensity_speed( s_capacity ), m_opacity( s_capacity ),
+    m_opacity_speed( s_capacity ), m_swing_amplitude( s_capacity ),
+    m_swing_angle( s_capacity ), m_swing_speed( s_capacity ),
+    m_age( s_capacity ), m_life( s_capacity ), m_time_factor( s_capacity ),
+    m_z( s_capacity ), m_appearance_index( s_capacity )
+{
+  set_global( true );
+  set_phantom( true );
+  set_artificial( true );
+  set_can_move_items( false );
+} // particle_system::particle_system()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::particle_system::~particle_system()
+{
+  if ( s_instance == this )
+    s_instance = NULL;
+} // particle_system::~particle_system()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the particle system of the current level, if any.
+ */
+rp::particle_system* rp::particle_system::get_instance()
+{
+  return s_instance;
+} // particle_system::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do post creation actions.
+ */
+void rp::particle_system::on_enters_layer()
+{
+  super::on_enters_layer();
+
+  s_instance = this;
+
+  bear::engine::level_globals& glob( get_level_globals() );
+
+  // The durations and the loops are those of the animation files.
+  const bear::visual::animation steam
+    ( glob.get_animation( "animation/effect/steam.canim" ) );
+
+  for ( std::size_t i(0); i != steam.frames_count(); ++i )
+    m_appearance[ smoke_appearance ].frames.push_back( steam.get_sprite(i) );
+
+  m_appearance[ smoke_appearance ].frame_duration = 0.06;
+  m_appearance[ smoke_appearance ].loop_back = true;
+
+  const bear::visual::animation explosion
+    ( glob.get_animation( "animation/explosion.canim" ) );
+
+  for ( std::size_t i(0); i != explosion.frames_count(); ++i )
+    m_appearance[ explosion_appearance ].frames.push_back
+      ( explosion.get_sprite(i) );
+
+  m_appearance[ explosion_appearance ].frame_duration = 0.08;
+  m_appearance[ explosion_appearance ].loop_back = false;
+
+  m_appearance[ brown_feather_appearance ].frames.push_back
+    ( glob.auto_sprite( "gfx/bird/bird.png", "feather, brown" ) );
+  m_appearance[ white_feather_appearance ].frames.push_back
+    ( glob.auto_sprite( "gfx/bird/bird.png", "feather, white" ) );
+
+  follow_camera();
+} // particle_system::on_enters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::particle_system::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/particle_system" );
+
+  super::progress( elapsed_time );
+
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
+  integrate( elapsed_time );
+  remove_dead_particles();
+
+  m_update_duration = std::chrono::steady_clock::now() - start;
+
+  follow_camera();
+} // particle_system::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sprites representing the particles.
+ * \param visuals (out) The sprites of the item, and their positions.
+ */
+void rp::particle_system::get_visual
+( std::list<bear::engine::scene_visual>& visuals ) const
+{
+  RP_PROFILE_ZONE( "render/particle_system" );
+
+  for ( std::size_t i(0); i != m_count; ++i )
+    {
+      bear::visual::sprite s( get_sprite(i) );
+
+      s.set_size( s.get_size() * m_scale[i] );
+      s.set_angle( m_angle[i] );
+      s.set_intensity( m_intensity[i], m_intensity[i], m_intensity[i] );
+      s.set_opacity( std::max( 0.0f, m_opacity[i] ) );
+
+      const float x
+        ( m_x[i] + m_swing_amplitude[i] * std::sin( m_swing_angle[i] ) );
+
+      bear::engine::scene_visual v
+        ( bear::visual::scene_sprite
+          ( x - s.width() / 2, m_y[i] - s.height() / 2, s ) );
+      v.z_position = m_z[i];
+
+      visuals.push_back( v );
+    }
+} // particle_system::get_visual()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a cloud of smoke somewhere on an item.
+ * \param ref The item on which the smoke is created.
+ * \param min_intensity The minimum intensity of the color of the smoke.
+ * \param max_intensity The maximum intensity of the color of the smoke.
+ * \param z_shift The depth of the smoke relatively to the item.
+ */
+void rp::particle_system::add_smoke
+( const bear::engine::base_item& ref, double min_intensity,
+  double max_intensity, int z_shift )
+{
+  random_stream& r( random::effects() );
+
+  const float time_factor( 1 + 3 * r.real() );
+  const float intensity
+    ( min_intensity + (max_intensity - min_intensity) * r.real() );
+
+  // The smoke disappears when its animation is finished, the remaining of the
+  // effect on the size and the opacity being lost.
+  const appearance& a( m_appearance[ smoke_appearance ] );
+  const float life
+    ( a.frame_duration * ( 2 * a.frames.size() - 1 ) / time_factor );
+
+#if defined( __ANDROID__ )
+  const float effect_duration( 1 );
+#else
+  const float effect_duration( 2 );
+#endif
+
+  const float density_factor( r.real() );
+  const float angle( 6.29 * r.real() );
+  const float size_end( 0.2 + 0.5 * r.real() );
+  const float opacity_start( 0.8 + 0.2 * r.real() );
+  const float opacity_end( 0.8 * r.real() );
+
+  const bear::universe::position_type pos
+    ( ref.get_width() * r.real(), ref.get_height() * r.real() );
+
+  const std::size_t i
+    ( create_particle
+      ( smoke_appearance, ref.get_bottom_left() + pos,
+        ref.get_z_position() + z_shift, life ) );
+
+  if ( i == s_capacity )
+    return;
+
+  // The lighter clouds go up faster.
+  m_acceleration_y[i] = 150 + 50 * (1 - density_factor);
+  m_angle[i] = angle;
+  m_time_factor[i] = time_factor;
+  m_intensity[i] = intensity;
+  m_scale_speed[i] = (size_end - 1) / effect_duration;
+  m_opacity[i] = opacity_start;
+  m_opacity_speed[i] = (opacity_end - opacity_start) / effect_duration;
+} // particle_system::add_smoke()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a spark of explosion.
+ * \param center The position of the center of the spark.
+ * \param size The size of the spark.
+ * \param z The depth of the spark.
+ */
+void rp::particle_system::add_explosion
+( const bear::universe::position_type& center,
+  bear::universe::coordinate_type size, int z )
+{
+  random_stream& r( random::effects() );
+
+  const float time_factor( 1 + 3 * r.real() );
+  const float angle( 6.29 * r.real() );
+
+  const appearance& a( m_appearance[ explosion_appearance ] );
+  const float life( a.frame_duration * a.frames.size() / time_factor );
+
+  const std::size_t i
+    ( create_particle( explosion_appearance, center, z, life ) );
+
+  if ( i == s_capacity )
+    return;
+
+  m_angle[i] = angle;
+  m_time_factor[i] = time_factor;
+
+  if ( !a.frames.empty() )
+    m_scale[i] = size / a.frames.front().width();
+} // particle_system::add_explosion()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a feather slowly falling while swinging.
+ * \param center The position where the feather is created.
+ * \param z The depth of the feather.
+ */
+void rp::particle_system::add_floating_feather
+( const bear::universe::position_type& center, int z )
+{
+  random_stream& r( random::effects() );
+
+  const appearance_index a( (appearance_index)pick_feather() );
+  const float swing( r.real() );
+  const float speed_x( 300 * (r.real() - 0.5) );
+  const float speed_y( 250 * (r.real() - 0.5) );
+  const float friction( 0.6 + r.real() * 0.2 );
+
+  const std::size_t i( create_particle( a, center, z, 3 ) );
+
+  if ( i == s_capacity )
+    return;
+
+  m_speed_x[i] = speed_x;
+  m_speed_y[i] = speed_y;
+  m_acceleration_y[i] = -40;
+  m_friction[i] = friction;
+  m_angle[i] = -0.5;
+  m_opacity_speed[i] = -1.0 / 3;
+  m_swing_amplitude[i] = 50;
+  m_swing_speed[i] =
+    boost::math::constants::pi<float>() / ( 1.0 + swing * 0.3 );
+} // particle_system::add_floating_feather()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a feather thrown away by an explosion.
+ * \param center The position of the center of the explosion.
+ * \param z The depth of the feather.
+ */
+void rp::particle_system::add_flying_feather
+( const bear::universe::position_type& center, int z )
+{
+  random_stream& r( random::effects() );
+
+  const appearance_index a( (appearance_index)pick_feather() );
+  const float direction( 2 * boost::math::constants::pi<float>() * r.real() );
+  const float speed( 300 + 300 * r.real() );
+  const float angular_speed( 12 * (r.real() - 0.5) );
+
+  const std::size_t i( create_particle( a, center, z, 1.5 ) );
+
+  if ( i == s_capacity )
+    return;
+
+  m_speed_x[i] = speed * std::cos( direction );
+  m_speed_y[i] = speed * std::sin( direction );
+  m_acceleration_y[i] = -600;
+  m_angular_speed[i] = angular_speed;
+  m_opacity_speed[i] = -1.0 / 1.5;
+} // particle_system::add_flying_feather()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of live particles.
+ */
+std::size_t rp::particle_system::get_particle_count() const
+{
+  return m_count;
+} // particle_system::get_particle_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of particles not created because there was no room
+ *        left.
+ */
+std::size_t rp::particle_system::get_dropped_count() const
+{
+  return m_dropped;
+} // particle_system::get_dropped_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the time spent in the last update of the particles.
+ */
+rp::particle_system::duration_type
+rp::particle_system::get_update_duration() const
+{
+  return m_update_duration;
+} // particle_system::get_update_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a particle with the default values of its attributes.
+ * \param a The appearance of the particle.
+ * \param center The position of the center of the particle.
+ * \param z The depth of the particle.
+ * \param life The duration of the life of the particle.
+ * \return The index of the particle, or s_capacity if there is no room left.
+ */
+std::size_t rp::particle_system::create_particle
+( appearance_index a, const bear::universe::position_type& center, int z,
+  float life )
+{
+  if ( m_appearance[ a ].frames.empty() )
+    return s_capacity;
+
+  if ( m_count == s_capacity )
+    {
+      ++m_dropped;
+      return s_capacity;
+    }
+
+  const std::size_t i( m_count );
+  ++m_count;
+
+  m_x[i] = center.x;
+  m_y[i] = center.y;
+  m_speed_x[i] = 0;
+  m_speed_y[i] = 0;
+  m_acceleration_y[i] = 0;
+  m_friction[i] = 0;
+  m_angle[i] = 0;
+  m_angular_speed[i] = 0;
+  m_scale[i] = 1;
+  m_scale_speed[i] = 0;
+  m_intensity[i] = 1;
+  m_intensity_speed[i] = 0;
+  m_opacity[i] = 1;
+  m_opacity_speed[i] = 0;
+  m_swing_amplitude[i] = 0;
+  m_swing_angle[i] = 0;
+  m_swing_speed[i] = 0;
+  m_age[i] = 0;
+  m_life[i] = life;
+  m_time_factor[i] = 1;
+  m_z[i] = z;
+  m_appearance_index[i] = a;
+
+  return i;
+} // particle_system::create_particle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update the attributes of the particles.
+ * \param dt The elapsed time since the last update.
+ *
+ * Each attribute is updated in its own loop, without branches, such that the
+ * compiler can vectorize them.
+ */
+void rp::particle_system::integrate( float dt )
+{
+  const std::size_t n( m_count );
+
+  float* const x( m_x.data() );
+  float* const y( m_y.data() );
+  float* const speed_x( m_speed_x.data() );
+  float* const speed_y( m_speed_y.data() );
+  const float* const acceleration_y( m_acceleration_y.data() );
+  const float* const friction( m_friction.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    {
+      const float f( 1 - friction[i] * dt );
+      speed_x[i] *= f;
+      speed_y[i] = speed_y[i] * f + acceleration_y[i] * dt;
+    }
+
+  for ( std::size_t i = 0; i < n; ++i )
+    x[i] += speed_x[i] * dt;
+
+  for ( std::size_t i = 0; i < n; ++i )
+    y[i] += speed_y[i] * dt;
+
+  float* const angle( m_angle.data() );
+  const float* const angular_speed( m_angular_speed.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    angle[i] += angular_speed[i] * dt;
+
+  float* const swing_angle( m_swing_angle.data() );
+  const float* const swing_speed( m_swing_speed.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    swing_angle[i] += swing_speed[i] * dt;
+
+  float* const scale( m_scale.data() );
+  const float* const scale_speed( m_scale_speed.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    scale[i] += scale_speed[i] * dt;
+
+  float* const intensity( m_intensity.data() );
+  const float* const intensity_speed( m_intensity_speed.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    intensity[i] += intensity_speed[i] * dt;
+
+  float* const opacity( m_opacity.data() );
+  const float* const opacity_speed( m_opacity_speed.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    opacity[i] += opacity_speed[i] * dt;
+
+  float* const age( m_age.data() );
+
+  for ( std::size_t i = 0; i < n; ++i )
+    age[i] += dt;
+} // particle_system::integrate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the particles whose life is over. The last particles are moved
+ *        in the holes, such that the live particles stay at the beginning of
+ *        the arrays.
+ */
+void rp::particle_system::remove_dead_particles()
+{
+  std::size_t i( 0 );
+
+  while ( i != m_count )
+    if ( m_age[i] >= m_life[i] )
+      {
+        --m_count;
+        move_particle( m_count, i );
+      }
+    else
+      ++i;
+} // particle_system::remove_dead_particles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the attributes of a particle over those of another one.
+ * \param from The index of the particle to copy.
+ * \param to The index of the particle to replace.
+ */
+void rp::particle_system::move_particle( std::size_t from, std::size_t to )
+{
+  m_x[to] = m_x[from];
+  m_y[to] = m_y[from];
+  m_speed_x[to] = m_speed_x[from];
+  m_speed_y[to] = m_speed_y[from];
+  m_acceleration_y[to] = m_acceleration_y[from];
+  m_friction[to] = m_friction[from];
+  m_angle[to] = m_angle[from];
+  m_angular_speed[to] = m_angular_speed[from];
+  m_scale[to] = m_scale[from];
+  m_scale_speed[to] = m_scale_speed[from];
+  m_intensity[to] = m_intensity[from];
+  m_intensity_speed[to] = m_intensity_speed[from];
+  m_opacity[to] = m_opacity[from];
+  m_opacity_speed[to] = m_opacity_speed[from];
+  m_swing_amplitude[to] = m_swing_amplitude[from];
+  m_swing_angle[to] = m_swing_angle[from];
+  m_swing_speed[to] = m_swing_speed[from];
+  m_age[to] = m_age[from];
+  m_life[to] = m_life[from];
+  m_time_factor[to] = m_time_factor[from];
+  m_z[to] = m_z[from];
+  m_appearance_index[to] = m_appearance_index[from];
+} // particle_system::move_particle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Place the item on the camera, such that it is always rendered.
+ */
+void rp::particle_system::follow_camera()
+{
+  const bear::universe::rectangle_type camera
+    ( get_level().get_camera_focus() );
+
+  set_size( camera.size() );
+  set_bottom_left( camera.bottom_left() );
+} // particle_system::follow_camera()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the sprite of a particle in its current state.
+ * \param i The index of the particle.
+ */
+const bear::visual::sprite&
+rp::particle_system::get_sprite( std::size_t i ) const
+{
+  const appearance& a( m_appearance[ m_appearance_index[i] ] );
+  const std::size_t count( a.frames.size() );
+
+  if ( count == 1 )
+    return a.frames.front();
+
+  std::size_t frame( m_age[i] * m_time_factor[i] / a.frame_duration );
+
+  if ( a.loop_back )
+    {
+      frame %= 2 * count - 1;
+
+      if ( frame >= count )
+        frame = 2 * count - 2 - frame;
+    }
+  else if ( frame >= count )
+    frame = count - 1;
+
+  return a.frames[ frame ];
+} // particle_system::get_sprite()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pick randomly the appearance of a feather.
+ */
+std::size_t rp::particle_system::pick_feather()
+{
+  if ( random::effects().real() < 0.5 )
+    return brown_feather_appearance;
+  else
+    return white_feather_appearance;
+} // particle_system::pick_feather()
@@ -16,7 +16,9 @@
 #include "rp/bird.hpp"
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/item_pool.hpp"
 #include "rp/obstacle.hpp"
+#include "rp/profiler.hpp"
 #include "rp/wall.hpp"
 #include "rp/zeppelin.hpp"
 
@@ -48,6 +50,27 @@ rp::plunger::plunger()
   set_size(36,22);
 } // rp::plunger::plunger()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the memory of an instance from the pool of the class.
+ * \param size The size of the memory.
+ */
+void* rp::plunger::operator new( std::size_t size )
+{
+  return item_pool<plunger>::get_instance().allocate( size );
+} // rp::plunger::operator new()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Give back the memory of an instance to the pool of the class.
+ * \param p The memory of the instance.
+ * \param size The size of the memory.
+ */
+void rp::plunger::operator delete( void* p, std::size_t size )
+{
+  item_pool<plunger>::get_instance().release( p, size );
+} // rp::plunger::operator delete()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Load the media required by this class.
@@ -75,6 +98,8 @@ void rp::plunger::on_enters_layer()
   set_model_actor( get_level_globals().get_model("model/plunger.cm") );
   start_model_action("idle");
   m_camera_rect = get_level().get_camera_focus();
+  m_action_score.attach( *this );
+  m_action_score.set( 20 );
 } // rp::plunger::on_enters_layer()
 
 /*---------------------------------------------------------------------------*/
@@ -84,7 +109,10 @@ void rp::plunger::on_enters_layer()
  */
 void rp::plunger::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/plunger" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
   
   update_angle();
   
@@ -92,7 +120,7 @@ void rp::plunger::progress( bear::universe::time_type elapsed_time )
     {
       bear::engine::model_mark_placement plunger_mark;
 
-      if ( m_cart->get_mark_placement("plunger", plunger_mark) )
+      if ( m_cart->get_mark_placement(model_mark_id::plunger, plunger_mark) )
          {
            bear::universe::vector_type vect
              ( get_tail_position() - plunger_mark.get_position() );
@@ -216,13 +244,33 @@ bool rp::plunger::come_back() const
 void rp::plunger::collision
 ( bear::engine::base_item& that, bear::universe::collision_info& info )
 {
- if ( ! collision_with_attractable(that) )
-    if ( ! collision_with_zeppelin(that) )
-      if ( ! collision_with_bird(that) )
-        if ( ! collision_with_wall(that) )
-          collision_with_obstacle(that);
+  static const collision_dispatcher<plunger> dispatcher
+    ( create_collision_dispatcher() );
+
+  dispatcher.dispatch( *this, that, info );
 } // plunger::collision()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create the table of the collision handlers, by type of the other item.
+ */
+rp::collision_dispatcher<rp::plunger> rp::plunger::create_collision_dispatcher()
+{
+  collision_dispatcher<plunger> result;
+
+  result.add<&plunger::collision_with_attractable>( item_type::balloon );
+  result.add<&plunger::collision_with_attractable>( item_type::bomb );
+  result.add<&plunger::collision_with_zeppelin>( item_type::zeppelin );
+  result.add<&plunger::collision_with_bird>( item_type::bird );
+  result.add<&plunger::collision_with_wall>( item_type::wall );
+  result.add<&plunger::collision_with_obstacle>( item_type::obstacle );
+  result.add<&plunger::collision_with_obstacle>( item_type::cable );
+  result.add<&plunger::collision_with_obstacle>( item_type::crate );
+  result.add<&plunger::collision_with_obstacle>( item_type::tnt );
+
+  return result;
+} // plunger::create_collision_dispatcher()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with an other item.
@@ -230,26 +278,20 @@ void rp::plunger::collision
  */
 bool rp::plunger::collision_with_attractable( bear::engine::base_item& that )
 {
-  bool result = false;
-  attractable_item* item = dynamic_cast<attractable_item*>(&that);
+  attractable_item* item = static_cast<attractable_item*>(&that);
 
-  if ( item != NULL ) 
+  if ( ( m_attracted_item == handle_type(NULL) ) && ! m_come_back && 
+       item->is_attractable() && ! item->get_taken_state() )
     {
-      if ( ( m_attracted_item == handle_type(NULL) ) && ! m_come_back && 
-           item->is_attractable() && ! item->get_taken_state() )
-        {
-          create_back_movement(false);
+      create_back_movement(false);
 
-          m_attracted_item = handle_type(item);
-          item->set_z_position(get_z_position() - 1); 
-          item->set_combo_value(1);
-          item->attract(this);
-        }
-      
-      result = true;
+      m_attracted_item = handle_type(item);
+      item->set_z_position(get_z_position() - 1); 
+      item->set_combo_value(1);
+      item->attract(this);
     }
 
-  return result;
+  return true;
 } // plunger::collision_with_attractable()
 
 /*----------------------------------------------------------------------------*/
@@ -261,22 +303,16 @@ bool rp::plunger::collision_with_attractable( bear::engine::base_item& that )
 bool rp::plunger::collision_with_zeppelin
 ( bear::engine::base_item& that )
 { 
-  bool result = false;
-  zeppelin* z = dynamic_cast<zeppelin*>(&that);
-  
-  if ( z != NULL ) 
-    {
-      if ( ! m_come_back && z->get_current_action_name() != "explose" )
-        {
-          create_back_movement(true);
-          z->set_combo_value(1);
-          z->drop();
-        }
+  zeppelin* z = static_cast<zeppelin*>(&that);
 
-      result = true;
+  if ( ! m_come_back && z->get_current_action_name() != "explose" )
+    {
+      create_back_movement(true);
+      z->set_combo_value(1);
+      z->drop();
     }
-  
-  return result;
+
+  return true;
 } // plunger::collision_with_zeppelin()
 
 /*----------------------------------------------------------------------------*/
@@ -287,21 +323,15 @@ bool rp::plunger::collision_with_zeppelin
  */
 bool rp::plunger::collision_with_bird( bear::engine::base_item& that )
 { 
-  bool result = false;
-  bird* b = dynamic_cast<bird*>(&that);
-  
-  if ( b != NULL ) 
-    {
-      if ( ! m_come_back )
-        {
-          create_back_movement(true);
-          b->plunger_collision();
-        }
+  bird* b = static_cast<bird*>(&that);
 
-      result = true;
+  if ( ! m_come_back )
+    {
+      create_back_movement(true);
+      b->plunger_collision();
     }
-  
-  return result;
+
+  return true;
 } // plunger::collision_with_bird()
 
 /*----------------------------------------------------------------------------*/
@@ -313,24 +343,18 @@ bool rp::plunger::collision_with_bird( bear::engine::base_item& that )
 bool rp::plunger::collision_with_obstacle
 ( bear::engine::base_item& that )
 { 
-  bool result = false;
-  obstacle* o = dynamic_cast<obstacle*>(&that);
-  
-  if ( o != NULL ) 
+  obstacle* o = static_cast<obstacle*>(&that);
+
+  if ( ! m_come_back && ( o->get_current_action_name() != "explose" ) )
     {
-      if ( ! m_come_back && ( o->get_current_action_name() != "explose" ) )
-        {
 #if 0
-          attract_cart(that);
+      attract_cart(that);
 #else
-          create_back_movement(true);
+      create_back_movement(true);
 #endif
-        }
-
-      result = true;
     }
-  
-  return result;
+
+  return true;
 } // plunger::collision_with_obstacle()
 
 /*----------------------------------------------------------------------------*/
@@ -341,22 +365,14 @@ bool rp::plunger::collision_with_obstacle
  */
 bool rp::plunger::collision_with_wall( bear::engine::base_item& that )
 { 
-  bool result = false;
-  wall* w = dynamic_cast<wall*>(&that);
-  
-  if ( w != NULL ) 
-    {
-      if ( ! m_come_back )
+  if ( ! m_come_back )
 #if 0
-        attract_cart(that);
+    attract_cart(that);
 #else
-      create_back_movement(true);
+  create_back_movement(true);
 #endif
 
-      result = true;
-    }
-  
-  return result;
+  return true;
 } // plunger::collision_with_wall()
 
 /*----------------------------------------------------------------------------*/
@@ -412,7 +428,7 @@ void rp::plunger::create_back_movement(bool bounce)
       bear::universe::forced_goto mvt2;       
       bear::universe::forced_join mvt3;
 
-      if ( m_cart->get_mark_placement("plunger", plunger_mark) )
+      if ( m_cart->get_mark_placement(model_mark_id::plunger, plunger_mark) )
         {
           bear::universe::vector_type vect
             (get_tail_position() - plunger_mark.get_position());
@@ -474,7 +490,7 @@ void rp::plunger::update_angle()
     {
       bear::engine::model_mark_placement plunger_mark;
 
-      if ( m_cart->get_mark_placement("plunger", plunger_mark) )
+      if ( m_cart->get_mark_placement(model_mark_id::plunger, plunger_mark) )
         {
           const bear::universe::vector_type vect
             (get_center_of_mass() - plunger_mark.get_position());
@@ -0,0 +1,369 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::population_manager class.
+ * \author Julien Jorge
+ */
+#include "rp/population_manager.hpp"
+
+#include "rp/game_variables.hpp"
+#include "rp/profiler.hpp"
+
+#include "engine/level.hpp"
+#include "engine/world.hpp"
+
+#include <claw/assert.hpp>
+#include <claw/logger.hpp>
+
+#include <algorithm>
+
+BASE_ITEM_EXPORT( population_manager, rp )
+
+/*----------------------------------------------------------------------------*/
+rp::population_manager* rp::population_manager::s_instance( NULL );
+
+/*----------------------------------------------------------------------------*/
+const std::size_t
+rp::population_manager::s_default_budget[ decoration_category_count ] =
+  {
+    // decoration_wave
+    8,
+    // decoration_hit_star
+    16,
+    // decoration_debris
+    96,
+    // decoration_feather
+    40
+  };
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::population_manager::population_manager()
+  : m_item_count( 0 ), m_item_peak( 0 ), m_census_enabled( false )
+{
+  set_global( true );
+  set_phantom( true );
+  set_artificial( true );
+  set_can_move_items( false );
+
+  for ( std::size_t i(0); i != decoration_category_count; ++i )
+    {
+      m_decorations[i].peak = 0;
+      m_decorations[i].budget = s_default_budget[i];
+      m_decorations[i].refused = 0;
+    }
+} // population_manager::population_manager()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::population_manager::~population_manager()
+{
+  if ( m_census_enabled )
+    write_census();
+
+  if ( s_instance == this )
+    s_instance = NULL;
+} // population_manager::~population_manager()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the manager of the current level, if any.
+ */
+rp::population_manager* rp::population_manager::get_instance()
+{
+  return s_instance;
+} // population_manager::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do post creation actions.
+ */
+void rp::population_manager::on_enters_layer()
+{
+  super::on_enters_layer();
+
+  s_instance = this;
+
+  for ( std::size_t i(0); i != decoration_category_count; ++i )
+    m_decorations[i].budget =
+      game_variables::get_decoration_budget
+      ( get_category_name( decoration_category(i) ), s_default_budget[i] );
+
+  m_census_enabled = game_variables::get_population_census();
+} // population_manager::on_enters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do an iteration.
+ * \param elapsed_time The elapsed time since the last call.
+ */
+void rp::population_manager::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/population_manager" );
+
+  super::progress( elapsed_time );
+
+  if ( m_census_enabled )
+    take_census();
+} // population_manager::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a decoration of a given category can be created in the
+ *        current level.
+ * \param c The category of the decoration.
+ */
+bool rp::population_manager::can_spawn( decoration_category c )
+{
+  if ( s_instance == NULL )
+    return true;
+  else
+    return s_instance->has_room_for( c );
+} // population_manager::can_spawn()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count a decoration in its category until it dies.
+ * \param c The category of the decoration.
+ * \param item The decoration.
+ */
+void rp::population_manager::add_decoration
+( decoration_category c, bear::engine::base_item& item )
+{
+  if ( s_instance == NULL )
+    return;
+
+  decoration_set& s( s_instance->m_decorations[c] );
+
+  // The dead decorations are removed before the highest count is updated.
+  if ( s.items.size() >= s.peak )
+    s_instance->remove_dead_decorations( s );
+
+  s.items.push_back( bear::universe::item_handle( item ) );
+  s.peak = std::max( s.peak, s.items.size() );
+} // population_manager::add_decoration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Enable or disable the census of the items at each iteration.
+ * \param b Tells if the census is enabled.
+ */
+void rp::population_manager::set_census_enabled( bool b )
+{
+  m_census_enabled = b;
+} // population_manager::set_census_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the items are counted at each iteration.
+ */
+bool rp::population_manager::is_census_enabled() const
+{
+  return m_census_enabled;
+} // population_manager::is_census_enabled()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the population of each class of items, by decreasing count of
+ *        live items.
+ */
+std::vector<rp::population_manager::class_population>
+rp::population_manager::get_census() const
+{
+  std::vector<class_population> result;
+  result.reserve( m_census.size() );
+
+  for ( const auto& c : m_census )
+    {
+      class_population p;
+      p.class_name = c.first;
+      p.count = c.second.first;
+      p.peak = c.second.second;
+
+      result.push_back( p );
+    }
+
+  std::sort
+    ( result.begin(), result.end(),
+      []( const class_population& a, const class_population& b ) -> bool
+      {
+        if ( a.count != b.count )
+          return a.count > b.count;
+        else
+          return a.peak > b.peak;
+      } );
+
+  return result;
+} // population_manager::get_census()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of items in the last census.
+ */
+std::size_t rp::population_manager::get_item_count() const
+{
+  return m_item_count;
+} // population_manager::get_item_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the highest count of items since the beginning of the level.
+ */
+std::size_t rp::population_manager::get_item_peak() const
+{
+  return m_item_peak;
+} // population_manager::get_item_peak()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the population of each category of decorations.
+ */
+std::vector<rp::population_manager::decoration_population>
+rp::population_manager::get_decorations() const
+{
+  std::vector<decoration_population> result( decoration_category_count );
+
+  for ( std::size_t i(0); i != decoration_category_count; ++i )
+    {
+      const decoration_set& s( m_decorations[i] );
+
+      result[i].name = get_category_name( decoration_category(i) );
+      result[i].count = 0;
+      result[i].peak = s.peak;
+      result[i].budget = s.budget;
+      result[i].refused = s.refused;
+
+      for ( std::size_t j(0); j != s.items.size(); ++j )
+        if ( s.items[j].get() != NULL )
+          ++result[i].count;
+    }
+
+  return result;
+} // population_manager::get_decorations()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of a category of decorations, as used in the names of
+ *        the game variables.
+ * \param c The category.
+ */
+const char*
+rp::population_manager::get_category_name( decoration_category c )
+{
+  static const char* const names[ decoration_category_count ] =
+    { "wave", "hit_star", "debris", "feather" };
+
+  CLAW_PRECOND( c < decoration_category_count );
+
+  return names[c];
+} // population_manager::get_category_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the live decorations of a given category are fewer than its
+ *        budget, and count the refusal otherwise.
+ * \param c The category of the decoration.
+ */
+bool rp::population_manager::has_room_for( decoration_category c )
+{
+  decoration_set& s( m_decorations[c] );
+
+  if ( s.budget == 0 )
+    return true;
+
+  if ( s.items.size() >= s.budget )
+    remove_dead_decorations( s );
+
+  if ( s.items.size() < s.budget )
+    return true;
+
+  ++s.refused;
+  return false;
+} // population_manager::has_room_for()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove the decorations that have been deleted.
+ * \param s The decorations to clean.
+ */
+void rp::population_manager::remove_dead_decorations( decoration_set& s )
+{
+  std::size_t i( 0 );
+
+  while ( i != s.items.size() )
+    if ( s.items[i].get() == NULL )
+      {
+        s.items[i] = s.items.back();
+        s.items.pop_back();
+      }
+    else
+      ++i;
+} // population_manager::remove_dead_decorations()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count the live items of each class and update the highest counts.
+ */
+void rp::population_manager::take_census()
+{
+  for ( auto& c : m_census )
+    c.second.first = 0;
+
+  const bear::universe::size_box_type size( get_level().get_size() );
+  bear::universe::world::item_list items;
+
+  get_world().pick_items_in_rectangle
+    ( items, bear::universe::rectangle_type( 0, 0, size.x, size.y ) );
+
+  for ( bear::universe::world::item_list::const_iterator it( items.begin() );
+        it != items.end(); ++it )
+    {
+      const bear::engine::base_item* const item
+        ( dynamic_cast<const bear::engine::base_item*>( *it ) );
+
+      if ( item != NULL )
+        ++m_census[ item->get_class_name() ].first;
+    }
+
+  for ( auto& c : m_census )
+    c.second.second = std::max( c.second.second, c.second.first );
+
+  m_item_count = items.size();
+  m_item_peak = std::max( m_item_peak, m_item_count );
+} // population_manager::take_census()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the highest counts of items and the refused decorations in the
+ *        log.
+ */
+void rp::population_manager::write_census() const
+{
+  claw::logger << claw::log_verbose << "Population: at most " << m_item_peak
+               << " items." << std::endl;
+
+  const std::vector<class_population> census( get_census() );
+
+  for ( std::size_t i(0); i != census.size(); ++i )
+    claw::logger << claw::log_verbose << "Population: " << census[i].class_name
+                 << " peak " << census[i].peak << std::endl;
+
+  const std::vector<decoration_population> decorations( get_decorations() );
+
+  for ( std::size_t i(0); i != decorations.size(); ++i )
+    claw::logger << claw::log_verbose << "Population: decoration "
+                 << decorations[i].name << " peak " << decorations[i].peak
+                 << "/" << decorations[i].budget << ", "
+                 << decorations[i].refused << " refused" << std::endl;
+} // population_manager::write_census()
@@ -0,0 +1,447 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::preload_plan class.
+ * \author Julien Jorge
+ */
+#include "rp/preload_plan.hpp"
+
+#include "rp/bomb.hpp"
+#include "rp/switching.hpp"
+#include "rp/tar.hpp"
+#include "rp/tnt.hpp"
+#include "rp/wall.hpp"
+#include "rp/zeppelin.hpp"
+
+#include "engine/resource_pool.hpp"
+#include "visual/image.hpp"
+
+#include <boost/bind.hpp>
+
+#include <cassert>
+#include <set>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param k The kind of the resource.
+ * \param n The path of the resource.
+ */
+rp::preload_plan::resource::resource( resource_kind k, const std::string& n )
+  : kind( k ), name( n )
+{
+
+} // preload_plan::resource::resource()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::preload_plan::preload_plan()
+  : m_loaded_count( 0 ), m_loaded_bytes( 0 ),
+    m_loading_duration( duration_type::zero() ), m_decoding( false ),
+    m_decoding_duration( duration_type::zero() )
+{
+
+} // preload_plan::preload_plan()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. Stops the decoding of the images.
+ */
+rp::preload_plan::~preload_plan()
+{
+  if ( m_decoder.joinable() )
+    {
+      m_decoder.interrupt();
+      m_decoder.join();
+    }
+} // preload_plan::~preload_plan()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the names of the themes of the levels.
+ */
+const std::vector<std::string>& rp::preload_plan::get_themes()
+{
+  static const std::vector<std::string> result
+    { "aquatic", "cake", "death", "garden", "space", "western" };
+
+  return result;
+} // preload_plan::get_themes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the names of the classes of the items whose resources can be
+ *        added with add_item_class().
+ */
+const std::vector<std::string>& rp::preload_plan::get_item_classes()
+{
+  static std::vector<std::string> result;
+
+  if ( result.empty() )
+    for ( const auto& c : get_item_class_models() )
+      result.push_back( c.first );
+
+  return result;
+} // preload_plan::get_item_classes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an image in the resources to load.
+ * \param name The path of the image.
+ */
+void rp::preload_plan::add_image( const std::string& name )
+{
+  m_resources.push_back( resource( image_resource, name ) );
+} // preload_plan::add_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a model in the resources to load.
+ * \param name The path of the model.
+ */
+void rp::preload_plan::add_model( const std::string& name )
+{
+  m_resources.push_back( resource( model_resource, name ) );
+} // preload_plan::add_model()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a sound in the resources to load.
+ * \param name The path of the sound.
+ */
+void rp::preload_plan::add_sound( const std::string& name )
+{
+  m_resources.push_back( resource( sound_resource, name ) );
+} // preload_plan::add_sound()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the images of the ground and of the walls of a given theme in the
+ *        resources to load.
+ * \param theme The name of the theme.
+ *
+ * When the images of the theme have been packed in an atlas at build time,
+ * the pages of the atlas are loaded instead of the packed images.
+ */
+void rp::preload_plan::add_theme( const std::string& theme )
+{
+  std::vector<std::string> images;
+
+  for ( unsigned int i=1; i<=3; ++i )
+    {
+      std::ostringstream oss;
+      oss << "gfx/" << theme << "/ground/ground-" << i << ".png";
+      images.push_back( oss.str() );
+    }
+
+  // The aquatic theme has only two images for the walls.
+  const unsigned int wall_count( theme == "aquatic" ? 2 : 3 );
+
+  for ( unsigned int i=1; i<=wall_count; ++i )
+    {
+      std::ostringstream oss;
+      oss << "gfx/wall-fill/" << theme << "/wall-fill-" << i << ".png";
+      images.push_back( oss.str() );
+    }
+
+  std::vector<std::string> pages;
+  std::set<std::string> packed;
+  read_atlas( "gfx/atlas/" + theme + ".atlas", pages, packed );
+
+  for ( std::size_t i(0); i != pages.size(); ++i )
+    add_image( pages[i] );
+
+  for ( std::size_t i(0); i != images.size(); ++i )
+    if ( packed.find( images[i] ) == packed.end() )
+      add_image( images[i] );
+} // preload_plan::add_theme()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the resources used by the items of a given class in the resources
+ *        to load.
+ * \param class_name The name of the class of the items.
+ */
+void rp::preload_plan::add_item_class( const std::string& class_name )
+{
+  const auto it( get_item_class_models().find( class_name ) );
+
+  if ( it == get_item_class_models().end() )
+    return;
+
+  for ( std::size_t i(0); i != it->second.size(); ++i )
+    add_model( it->second[i] );
+} // preload_plan::add_item_class()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if all the resources have been loaded.
+ */
+bool rp::preload_plan::empty() const
+{
+  return m_resources.empty();
+} // preload_plan::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the images of the resources to load in a worker thread.
+ */
+void rp::preload_plan::start_decoding()
+{
+  assert( !m_decoding );
+
+  std::vector<std::string> names;
+  std::set<std::string> listed;
+
+  for ( std::size_t i(0); i != m_resources.size(); ++i )
+    if ( ( m_resources[i].kind == image_resource )
+         && listed.insert( m_resources[i].name ).second )
+      names.push_back( m_resources[i].name );
+
+  m_decoding = true;
+  m_decoder =
+    boost::thread( boost::bind( &preload_plan::decode, this, names ) );
+} // preload_plan::start_decoding()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load all the remaining resources. The decoding must not have been
+ *        started.
+ * \param globals The level globals in which the resources are loaded.
+ */
+void rp::preload_plan::load_all( bear::engine::level_globals& globals )
+{
+  assert( !m_decoding );
+
+  while ( !empty() )
+    load_next( globals );
+} // preload_plan::load_all()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load the next resource.
+ * \param globals The level globals in which the resources are loaded.
+ * \return false if the next resource is an image not decoded yet.
+ */
+bool rp::preload_plan::load_next( bear::engine::level_globals& globals )
+{
+  if ( empty() )
+    return true;
+
+  std::shared_ptr<claw::graphic::image> decoded;
+
+  if ( m_decoding && ( m_resources.front().kind == image_resource ) )
+    {
+      const std::string& name( m_resources.front().name );
+
+      // An image listed twice is decoded once.
+      if ( !take_decoded( name, decoded ) && !globals.image_exists( name ) )
+        return false;
+    }
+
+  const resource r( m_resources.front() );
+  m_resources.pop_front();
+
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
+  switch ( r.kind )
+    {
+    case image_resource:
+      {
+        // The image is read from the file if it could not be decoded.
+        if ( decoded == NULL )
+          globals.load_image( r.name );
+        else if ( !globals.image_exists( r.name ) )
+          globals.add_image( r.name, bear::visual::image( *decoded ) );
+
+        const bear::visual::image& image( globals.get_image( r.name ) );
+        m_loaded_bytes += image.width() * image.height() * 4;
+        break;
+      }
+    case model_resource:
+      globals.load_model( r.name );
+      break;
+    case sound_resource:
+      globals.load_sound( r.name );
+      break;
+    }
+
+  m_loading_duration += std::chrono::steady_clock::now() - start;
+  ++m_loaded_count;
+
+  return true;
+} // preload_plan::load_next()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of resources loaded.
+ */
+std::size_t rp::preload_plan::get_loaded_count() const
+{
+  return m_loaded_count;
+} // preload_plan::get_loaded_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of the textures of the images loaded, in bytes.
+ */
+std::size_t rp::preload_plan::get_loaded_bytes() const
+{
+  return m_loaded_bytes;
+} // preload_plan::get_loaded_bytes()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the time spent loading the resources.
+ */
+rp::preload_plan::duration_type rp::preload_plan::get_loading_duration() const
+{
+  return m_loading_duration;
+} // preload_plan::get_loading_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the time spent decoding the images in the worker thread.
+ */
+rp::preload_plan::duration_type rp::preload_plan::get_decoding_duration() const
+{
+  const boost::mutex::scoped_lock lock( m_decoded_mutex );
+  return m_decoding_duration;
+} // preload_plan::get_decoding_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the models used by the items of the classes that the levels may
+ *        not contain, by class name.
+ *
+ * The balloons are not listed since their model is loaded by the cart, which
+ * creates them.
+ */
+const std::map< std::string, std::vector<std::string> >&
+rp::preload_plan::get_item_class_models()
+{
+  static const std::map< std::string, std::vector<std::string> > result
+    {
+      { rp::bomb::static_class_name(), { "model/bomb.cm" } },
+      { rp::switching::static_class_name(), { "model/switching.cm" } },
+      { rp::tar::static_class_name(), { "model/tar.cm" } },
+      { rp::tnt::static_class_name(), { "model/tnt.cm" } },
+      { rp::wall::static_class_name(), { "model/wall.cm" } },
+      { rp::zeppelin::static_class_name(),
+          { "model/zeppelin/zeppelin.cm",
+            "model/zeppelin/zeppelin-mirror.cm" } }
+    };
+
+  return result;
+} // preload_plan::get_item_class_models()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode some images. This method is executed by m_decoder.
+ * \param names The paths of the images.
+ */
+void rp::preload_plan::decode( const std::vector<std::string>& names )
+{
+  bear::engine::resource_pool& pool
+    ( bear::engine::resource_pool::get_instance() );
+
+  for ( std::size_t i(0); i != names.size(); ++i )
+    {
+      boost::this_thread::interruption_point();
+
+      const std::chrono::steady_clock::time_point start
+        ( std::chrono::steady_clock::now() );
+
+      std::shared_ptr<claw::graphic::image> image;
+
+      if ( pool.exists( names[i] ) )
+        try
+          {
+            std::stringstream file;
+            pool.get_file( names[i], file );
+            image.reset( new claw::graphic::image( file ) );
+          }
+        catch( const std::exception& )
+          {
+            // The image will be loaded by the level globals, which report the
+            // error.
+            image.reset();
+          }
+
+      const boost::mutex::scoped_lock lock( m_decoded_mutex );
+      m_decoded[ names[i] ] = image;
+      m_decoding_duration += std::chrono::steady_clock::now() - start;
+    }
+} // preload_plan::decode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Take an image from the decoded images.
+ * \param name The path of the image.
+ * \param image (out) The decoded image, null if it could not be decoded.
+ * \return false if the image has not been decoded yet.
+ */
+bool rp::preload_plan::take_decoded
+( const std::string& name, std::shared_ptr<claw::graphic::image>& image )
+{
+  const boost::mutex::scoped_lock lock( m_decoded_mutex );
+  const auto it( m_decoded.find( name ) );
+
+  if ( it == m_decoded.end() )
+    return false;
+
+  image = it->second;
+  m_decoded.erase( it );
+
+  return true;
+} // preload_plan::take_decoded()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the pages and the packed images of an atlas built by
+ *        rp-atlas-packer, if it exists.
+ * \param name The path of the description of the atlas.
+ * \param pages (out) The paths of the pages of the atlas.
+ * \param packed (out) The paths of the images packed in the atlas.
+ */
+void rp::preload_plan::read_atlas
+( const std::string& name, std::vector<std::string>& pages,
+  std::set<std::string>& packed )
+{
+  bear::engine::resource_pool& pool
+    ( bear::engine::resource_pool::get_instance() );
+
+  if ( !pool.exists( name ) )
+    return;
+
+  std::stringstream atlas;
+  pool.get_file( name, atlas );
+
+  std::string line;
+
+  while ( std::getline( atlas, line ) )
+    {
+      std::istringstream iss( line );
+      std::string kind;
+      std::string path;
+
+      if ( !( iss >> kind >> path ) )
+        continue;
+
+      if ( kind == "page" )
+        pages.push_back( path );
+      else if ( kind == "block" )
+        packed.insert( path );
+    }
+} // preload_plan::read_atlas()
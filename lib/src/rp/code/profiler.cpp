@@ -0,0 +1,435 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::profiler class.
+ * \author Julien Jorge
+ */
+#include "rp/profiler.hpp"
+
+#include <claw/logger.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+/*----------------------------------------------------------------------------*/
+const std::size_t rp::profiler::s_event_capacity( 32768 );
+const std::size_t rp::profiler::s_frame_capacity( 1024 );
+std::atomic<bool> rp::profiler::s_recording( false );
+thread_local rp::profiler::scope* rp::profiler::scope::s_current( NULL );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor. Starts the measure if the profiler is recording.
+ * \param zone The zone in which the time is measured.
+ */
+rp::profiler::scope::scope( zone_id zone )
+  : m_zone( zone ),
+    m_recording( s_recording.load( std::memory_order_relaxed ) ),
+    m_parent( m_recording ? s_current : NULL ), m_child_time( 0 )
+{
+  if ( !m_recording )
+    return;
+
+  s_current = this;
+  m_start = clock_type::now();
+} // profiler::scope::scope()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. Records the measure and adds its duration to the time
+ *        spent in the nested scopes of the parent scope.
+ */
+rp::profiler::scope::~scope()
+{
+  if ( !m_recording )
+    return;
+
+  const clock_type::time_point end( clock_type::now() );
+
+  s_current = m_parent;
+
+  if ( m_parent != NULL )
+    m_parent->m_child_time += get_duration( m_start, end );
+
+  profiler::get_instance().record( m_zone, m_start, end, m_child_time );
+} // profiler::scope::~scope()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the instance of the profiler.
+ */
+rp::profiler& rp::profiler::get_instance()
+{
+  static profiler result;
+  return result;
+} // profiler::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Enable or disable the measures. This method must be called by the
+ *        game thread.
+ * \param r Tells if the zones are measured.
+ */
+void rp::profiler::set_recording( bool r )
+{
+  if ( r && !s_recording )
+    m_frame_start = clock_type::now();
+
+  s_recording = r;
+} // profiler::set_recording()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the zones are measured.
+ */
+bool rp::profiler::is_recording() const
+{
+  return s_recording;
+} // profiler::is_recording()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of a zone, declaring it if needed.
+ * \param name The name of the zone.
+ */
+rp::profiler::zone_id rp::profiler::get_zone( const std::string& name )
+{
+  const boost::mutex::scoped_lock lock( m_zone_mutex );
+
+  const std::vector<std::string>::const_iterator it
+    ( std::find( m_zone_names.begin(), m_zone_names.end(), name ) );
+
+  if ( it != m_zone_names.end() )
+    return it - m_zone_names.begin();
+
+  if ( m_zone_names.size() == s_max_zones )
+    return s_max_zones - 1;
+
+  if ( m_zone_names.size() == s_max_zones - 1 )
+    {
+      claw::logger << claw::log_warning << "Profiler: too many zones, '"
+                   << name << "' and the next ones are measured together."
+                   << std::endl;
+      m_zone_names.push_back( "other" );
+    }
+  else
+    m_zone_names.push_back( name );
+
+  return m_zone_names.size() - 1;
+} // profiler::get_zone()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Record the measure of a zone. This method can be called from any
+ *        thread.
+ * \param zone The zone measured.
+ * \param start The date of the beginning of the measure.
+ * \param end The date of the end of the measure.
+ * \param child_time The time spent in the zones nested in this measure, in
+ *        nanoseconds. It is not counted in the time of the zone.
+ */
+void rp::profiler::record
+( zone_id zone, clock_type::time_point start, clock_type::time_point end,
+  uint64_t child_time )
+{
+  assert( zone < s_max_zones );
+
+  const uint64_t duration( get_duration( start, end ) );
+  const uint64_t self_time
+    ( duration - std::min( duration, child_time ) );
+
+  m_zone_time[ zone ].fetch_add( self_time, std::memory_order_relaxed );
+
+  // The trace keeps the whole duration, the nesting is visible in it.
+  push_event( zone, start, end );
+} // profiler::record()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Close the current frame and start a new one. This method must be
+ *        called by the game thread.
+ */
+void rp::profiler::end_frame()
+{
+  if ( !s_recording )
+    return;
+
+  const clock_type::time_point now( clock_type::now() );
+
+  frame_record& f( m_frames[ m_frame_count % s_frame_capacity ] );
+  f.duration = get_duration( m_frame_start, now );
+
+  for ( std::size_t i(0); i != s_max_zones; ++i )
+    f.zones[i] = m_zone_time[i].exchange( 0, std::memory_order_relaxed );
+
+  // The frames are written in the trace as the first zone.
+  push_event( 0, m_frame_start, now );
+
+  ++m_frame_count;
+  m_frame_start = now;
+} // profiler::end_frame()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the statistics of the last frames. This method must be called by
+ *        the game thread.
+ * \param frame_count The maximum number of frames to consider.
+ * \param zone_count The maximum number of zones in the result.
+ */
+rp::profiler::frame_statistics rp::profiler::get_statistics
+( std::size_t frame_count, std::size_t zone_count ) const
+{
+  frame_statistics result;
+  result.frame_count =
+    std::min( frame_count, std::min( m_frame_count, s_frame_capacity ) );
+  result.p50 = result.p90 = result.p99 = result.max = 0;
+
+  if ( result.frame_count == 0 )
+    return result;
+
+  std::vector<uint64_t> durations;
+  durations.reserve( result.frame_count );
+
+  std::vector<uint64_t> zone_sum( s_max_zones, 0 );
+  std::vector<uint64_t> zone_max( s_max_zones, 0 );
+
+  for ( std::size_t i( m_frame_count - result.frame_count );
+        i != m_frame_count; ++i )
+    {
+      const frame_record& f( m_frames[ i % s_frame_capacity ] );
+      durations.push_back( f.duration );
+
+      for ( std::size_t z(0); z != s_max_zones; ++z )
+        {
+          zone_sum[z] += f.zones[z];
+          zone_max[z] = std::max( zone_max[z], f.zones[z] );
+        }
+    }
+
+  std::sort( durations.begin(), durations.end() );
+
+  const std::size_t last( durations.size() - 1 );
+  const double ms( 1e-6 );
+
+  result.p50 = durations[ last / 2 ] * ms;
+  result.p90 = durations[ last * 90 / 100 ] * ms;
+  result.p99 = durations[ last * 99 / 100 ] * ms;
+  result.max = durations[ last ] * ms;
+
+  {
+    const boost::mutex::scoped_lock lock( m_zone_mutex );
+
+    // The first zone is the frame itself.
+    for ( std::size_t z(1); z < m_zone_names.size(); ++z )
+      if ( zone_sum[z] != 0 )
+        {
+          zone_statistics s;
+          s.name = m_zone_names[z];
+          s.mean = zone_sum[z] * ms / result.frame_count;
+          s.max = zone_max[z] * ms;
+          result.zones.push_back( s );
+        }
+  }
+
+  std::sort
+    ( result.zones.begin(), result.zones.end(),
+      []( const zone_statistics& a, const zone_statistics& b ) -> bool
+      {
+        return a.mean > b.mean;
+      } );
+
+  if ( result.zones.size() > zone_count )
+    result.zones.resize( zone_count );
+
+  return result;
+} // profiler::get_statistics()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the events kept in the ring buffer in the trace format of
+ *        Chrome.
+ * \param file_name The name of the file to write.
+ */
+bool rp::profiler::write_trace( const std::string& file_name ) const
+{
+  std::ofstream f( file_name.c_str() );
+  write_trace( f );
+
+  if ( !f )
+    {
+      claw::logger << claw::log_error << "Profiler: cannot write '"
+                   << file_name << "'." << std::endl;
+      return false;
+    }
+
+  claw::logger << claw::log_verbose << "Profiler: trace written in '"
+               << file_name << "'." << std::endl;
+  return true;
+} // profiler::write_trace()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::profiler::profiler()
+  : m_origin( clock_type::now() ), m_events( s_event_capacity ),
+    m_next_event( 0 ), m_frames( s_frame_capacity ), m_frame_count( 0 ),
+    m_frame_start( m_origin )
+{
+  m_zone_names.reserve( s_max_zones );
+  m_zone_names.push_back( "frame" );
+
+  for ( std::size_t i(0); i != s_max_zones; ++i )
+    m_zone_time[i].store( 0, std::memory_order_relaxed );
+} // profiler::profiler()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a measure in the ring buffer of the events. The oldest event
+ *        is overwritten.
+ * \param zone The zone measured.
+ * \param start The date of the beginning of the measure.
+ * \param end The date of the end of the measure.
+ */
+void rp::profiler::push_event
+( zone_id zone, clock_type::time_point start, clock_type::time_point end )
+{
+  const uint64_t index
+    ( m_next_event.fetch_add( 1, std::memory_order_relaxed ) );
+  event& e( m_events[ index & ( s_event_capacity - 1 ) ] );
+
+  // The sequence is odd while the event is written, such that a reader
+  // ignores the event if it sees it changing.
+  e.sequence.store( 2 * index + 1, std::memory_order_relaxed );
+  std::atomic_thread_fence( std::memory_order_release );
+
+  e.zone.store( zone, std::memory_order_relaxed );
+  e.thread.store( get_thread_index(), std::memory_order_relaxed );
+  e.start.store( get_date( start ), std::memory_order_relaxed );
+  e.duration.store( get_duration( start, end ), std::memory_order_relaxed );
+
+  e.sequence.store( 2 * index + 2, std::memory_order_release );
+} // profiler::push_event()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a date in nanoseconds since the creation of the profiler.
+ * \param date The date to convert.
+ */
+uint64_t rp::profiler::get_date( clock_type::time_point date ) const
+{
+  return get_duration( m_origin, date );
+} // profiler::get_date()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the duration between two dates, in nanoseconds.
+ * \param start The first date.
+ * \param end The second date.
+ */
+uint64_t rp::profiler::get_duration
+( clock_type::time_point start, clock_type::time_point end )
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>
+    ( end - start ).count();
+} // profiler::get_duration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the index of the calling thread, in the order in which the
+ *        threads have done their first measure.
+ */
+uint32_t rp::profiler::get_thread_index()
+{
+  static std::atomic<uint32_t> next_index( 0 );
+  static thread_local const uint32_t index
+    ( next_index.fetch_add( 1, std::memory_order_relaxed ) );
+
+  return index;
+} // profiler::get_thread_index()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the complete events of the ring buffer.
+ */
+std::vector<rp::profiler::event_record> rp::profiler::read_events() const
+{
+  const uint64_t end( m_next_event.load( std::memory_order_acquire ) );
+  const uint64_t begin
+    ( ( end > s_event_capacity ) ? end - s_event_capacity : 0 );
+
+  std::vector<event_record> result;
+  result.reserve( end - begin );
+
+  for ( uint64_t i( begin ); i != end; ++i )
+    {
+      const event& e( m_events[ i & ( s_event_capacity - 1 ) ] );
+      const uint64_t sequence( e.sequence.load( std::memory_order_acquire ) );
+
+      event_record r;
+      r.zone = e.zone.load( std::memory_order_relaxed );
+      r.thread = e.thread.load( std::memory_order_relaxed );
+      r.start = e.start.load( std::memory_order_relaxed );
+      r.duration = e.duration.load( std::memory_order_relaxed );
+
+      std::atomic_thread_fence( std::memory_order_acquire );
+
+      // The event is kept only if it was complete and has not been replaced
+      // while it was copied.
+      if ( ( sequence == 2 * i + 2 )
+           && ( e.sequence.load( std::memory_order_relaxed ) == sequence ) )
+        result.push_back( r );
+    }
+
+  return result;
+} // profiler::read_events()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the events kept in the ring buffer in the trace format of
+ *        Chrome.
+ * \param os The stream in which the trace is written.
+ */
+void rp::profiler::write_trace( std::ostream& os ) const
+{
+  const std::vector<event_record> events( read_events() );
+  std::vector<std::string> names;
+
+  {
+    const boost::mutex::scoped_lock lock( m_zone_mutex );
+    names = m_zone_names;
+  }
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  const std::streamsize precision( os.precision() );
+  os.setf( std::ios::fixed, std::ios::floatfield );
+  os.precision( 3 );
+
+  for ( std::size_t i(0); i != events.size(); ++i )
+    {
+      const event_record& e( events[i] );
+
+      if ( i != 0 )
+        os << ',';
+
+      // The dates are given in microseconds in the trace.
+      os << "\n{\"name\":\"" << names[ e.zone ]
+         << "\",\"cat\":\"rp\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread
+         << ",\"ts\":" << e.start / 1000.0
+         << ",\"dur\":" << e.duration / 1000.0 << '}';
+    }
+
+  os.unsetf( std::ios::floatfield );
+  os.precision( precision );
+
+  os << "\n]}\n";
+} // profiler::write_trace()
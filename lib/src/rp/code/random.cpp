@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::random class.
+ * \author Julien Jorge
+ */
+#include "rp/random.hpp"
+
+#include "engine/game.hpp"
+#include "engine/variable/variable.hpp"
+
+#include <claw/logger.hpp>
+
+#include <cassert>
+#include <ctime>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the next value of a splitmix64 sequence, used to initialize the
+ *        streams from a single seed.
+ * \param state (in/out) The state of the sequence.
+ */
+static std::uint64_t rp_random_splitmix( std::uint64_t& state )
+{
+  state += 0x9E3779B97F4A7C15ull;
+
+  std::uint64_t result( state );
+  result = ( result ^ ( result >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+  result = ( result ^ ( result >> 27 ) ) * 0x94D049BB133111EBull;
+
+  return result ^ ( result >> 31 );
+} // rp_random_splitmix()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::random_stream::random_stream()
+{
+  seed( 0 );
+} // random_stream::random_stream()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Restart the sequence from a given seed.
+ * \param s The seed.
+ */
+void rp::random_stream::seed( std::uint64_t s )
+{
+  m_state[0] = rp_random_splitmix( s );
+  m_state[1] = rp_random_splitmix( s );
+} // random_stream::seed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the next number of the sequence.
+ */
+std::uint64_t rp::random_stream::next()
+{
+  std::uint64_t x( m_state[0] );
+  const std::uint64_t y( m_state[1] );
+
+  m_state[0] = y;
+  x ^= x << 23;
+  m_state[1] = x ^ y ^ ( x >> 17 ) ^ ( y >> 26 );
+
+  return m_state[1] + y;
+} // random_stream::next()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a real number in [0, 1).
+ */
+double rp::random_stream::real()
+{
+  // The 53 most significant bits fill the mantissa of the double.
+  return ( next() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+} // random_stream::real()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an integer in [0, n).
+ * \param n The upper bound of the interval. Must be greater than zero.
+ */
+unsigned int rp::random_stream::integer( unsigned int n )
+{
+  assert( n != 0 );
+
+  return next() % n;
+} // random_stream::integer()
+
+/*----------------------------------------------------------------------------*/
+rp::random::seed_type rp::random::s_initial_seed( 0 );
+rp::random::seed_type rp::random::s_seed( 0 );
+std::size_t rp::random::s_level_serial( 0 );
+rp::random_stream rp::random::s_streams[ rp::random::stream_count ];
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Seed the streams at the start of the game.
+ */
+void rp::random::initialize()
+{
+  bear::engine::variable<unsigned int> var( "random_seed" );
+
+  if ( bear::engine::game::get_instance().game_variable_exists( var ) )
+    {
+      bear::engine::game::get_instance().get_game_variable( var );
+      s_initial_seed = var.get_value();
+    }
+  else
+    s_initial_seed = std::time( NULL );
+
+  claw::logger << claw::log_verbose << "Random: initial seed is "
+               << s_initial_seed << std::endl;
+
+  seed( s_initial_seed );
+} // random::initialize()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Seed the streams for a given level. The seed depends only on the
+ *        initial seed and on the name of the level.
+ * \param name The name of the level.
+ */
+void rp::random::start_level( const std::string& name )
+{
+  // FNV-1a hash of the name, starting from the initial seed.
+  std::uint32_t s( 2166136261u ^ s_initial_seed );
+
+  for ( char c : name )
+    s = ( s ^ (unsigned char)c ) * 16777619u;
+
+  claw::logger << claw::log_verbose << "Random: seed of level '" << name
+               << "' is " << s << std::endl;
+
+  seed( s );
+  ++s_level_serial;
+} // random::start_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the seed of the current streams.
+ */
+rp::random::seed_type rp::random::get_seed()
+{
+  return s_seed;
+} // random::get_seed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a number which changes each time the streams are seeded for a
+ *        level.
+ */
+std::size_t rp::random::get_level_serial()
+{
+  return s_level_serial;
+} // random::get_level_serial()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the stream used to generate the levels.
+ */
+rp::random_stream& rp::random::level_generation()
+{
+  return s_streams[ level_generation_stream ];
+} // random::level_generation()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the stream used by the items to take their decisions.
+ */
+rp::random_stream& rp::random::gameplay()
+{
+  return s_streams[ gameplay_stream ];
+} // random::gameplay()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the stream used by the decorative effects.
+ */
+rp::random_stream& rp::random::effects()
+{
+  return s_streams[ effect_stream ];
+} // random::effects()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the stream used to pick the sounds.
+ */
+rp::random_stream& rp::random::sounds()
+{
+  return s_streams[ sound_stream ];
+} // random::sounds()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Seed all the streams.
+ * \param s The seed from which the seeds of the streams are derived.
+ */
+void rp::random::seed( seed_type s )
+{
+  s_seed = s;
+
+  for ( std::size_t i( 0 ); i != stream_count; ++i )
+    s_streams[ i ].seed( ( std::uint64_t( s ) << 32 ) | i );
+} // random::seed()
@@ -0,0 +1,342 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::save_service class.
+ * \author Julien Jorge
+ */
+#include "rp/save_service.hpp"
+
+#include "rp/game_variable_table.hpp"
+
+#include <boost/bind.hpp>
+#include <claw/logger.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+const unsigned int rp::save_service::s_coalescing_delay( 500 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the instance of the service.
+ */
+rp::save_service& rp::save_service::get_instance()
+{
+  static save_service result;
+  return result;
+} // save_service::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the content of the save file of the game variables, as read by
+ *        the game. The pending requests must have been flushed before.
+ * \param file_name The name of the save file.
+ * \param variables The variables read from the save file.
+ * \param migrate Tells to write the save file as soon as possible, because
+ *        the variables have been read from another file or format.
+ */
+void rp::save_service::load_game_variables
+( const std::string& file_name, const save_snapshot& variables, bool migrate )
+{
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    assert( m_request_count == m_written_count );
+
+    m_save_file_name = file_name;
+    m_saved_variables = variables;
+
+    // The variables of the game have just been read from the file.
+    m_pending_variables.clear();
+    game_variable_table::get_instance().clear_dirty();
+
+    if ( migrate )
+      {
+        m_rewrite = true;
+        ++m_request_count;
+        start_worker();
+      }
+  }
+
+  m_request_condition.notify_one();
+} // save_service::load_game_variables()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Save the persistent game variables modified since the previous save.
+ * \param file_name The name of the save file.
+ */
+void rp::save_service::save_game_variables( const std::string& file_name )
+{
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+  std::size_t count;
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    const std::size_t initial_count( m_pending_variables.size() );
+
+    game_variable_table::get_instance().collect_dirty_persistent
+      ( m_pending_variables );
+    count = m_pending_variables.size() - initial_count;
+
+    m_save_file_name = file_name;
+
+    if ( count != 0 )
+      {
+        ++m_request_count;
+        start_worker();
+      }
+  }
+
+  m_request_condition.notify_one();
+
+  const std::chrono::duration<double, std::milli> stall
+    ( std::chrono::steady_clock::now() - start );
+
+  claw::logger << claw::log_verbose << "Save: " << count
+               << " game variables queued in " << stall.count() << " ms."
+               << std::endl;
+} // save_service::save_game_variables()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a file in the background. A previous content of the file not
+ *        yet written is replaced.
+ * \param file_name The name of the file.
+ * \param content The content of the file.
+ */
+void rp::save_service::save_file
+( const std::string& file_name, const std::string& content )
+{
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    m_pending_files[ file_name ] = content;
+    ++m_request_count;
+    start_worker();
+  }
+
+  m_request_condition.notify_one();
+
+  const std::chrono::duration<double, std::milli> stall
+    ( std::chrono::steady_clock::now() - start );
+
+  claw::logger << claw::log_verbose << "Save: '" << file_name
+               << "' queued in " << stall.count() << " ms." << std::endl;
+} // save_service::save_file()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait until all the requests have been written.
+ */
+void rp::save_service::flush()
+{
+  boost::unique_lock<boost::mutex> lock( m_mutex );
+
+  if ( m_written_count == m_request_count )
+    return;
+
+  m_flush = true;
+  m_request_condition.notify_one();
+
+  while ( m_written_count != m_request_count )
+    m_done_condition.wait( lock );
+} // save_service::flush()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::save_service::save_service()
+  : m_quit( false ), m_flush( false ), m_request_count( 0 ),
+    m_written_count( 0 ), m_rewrite( false )
+{
+
+} // save_service::save_service()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. The pending requests are written before leaving.
+ */
+rp::save_service::~save_service()
+{
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+    m_quit = true;
+  }
+
+  m_request_condition.notify_one();
+
+  if ( m_thread.joinable() )
+    m_thread.join();
+} // save_service::~save_service()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Start the worker thread if it is not running. The mutex must be
+ *        locked.
+ */
+void rp::save_service::start_worker()
+{
+  if ( m_thread.get_id() == boost::thread::id() )
+    m_thread = boost::thread( boost::bind( &save_service::run, this ) );
+} // save_service::start_worker()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the worker thread.
+ */
+void rp::save_service::run()
+{
+  while ( true )
+    {
+      {
+        boost::unique_lock<boost::mutex> lock( m_mutex );
+
+        while ( ( m_request_count == m_written_count ) && !m_quit )
+          m_request_condition.wait( lock );
+
+        if ( m_request_count == m_written_count )
+          return;
+
+        // Wait a bit for the other requests, such that saves done in a row
+        // are written once.
+        if ( !m_flush && !m_quit )
+          m_request_condition.timed_wait
+            ( lock, boost::posix_time::milliseconds( s_coalescing_delay ),
+              [this]() -> bool { return m_flush || m_quit; } );
+      }
+
+      write_pending();
+    }
+} // save_service::run()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the requests received so far. Called by the worker thread.
+ */
+void rp::save_service::write_pending()
+{
+  save_snapshot variables;
+  std::map<std::string, std::string> files;
+  std::string save_file_name;
+  std::size_t request_count;
+  bool rewrite;
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    variables = m_pending_variables;
+    m_pending_variables.clear();
+    files.swap( m_pending_files );
+    save_file_name = m_save_file_name;
+    request_count = m_request_count;
+    rewrite = m_rewrite;
+    m_rewrite = false;
+    m_flush = false;
+  }
+
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
+  if ( ( !variables.empty() || rewrite ) && !save_file_name.empty() )
+    {
+      m_saved_variables.merge( variables );
+
+      std::ostringstream oss;
+      m_saved_variables.write_binary( oss );
+      write_file( save_file_name, oss.str() );
+    }
+
+  for ( const auto& f : files )
+    write_file( f.first, f.second );
+
+  const std::chrono::duration<double, std::milli> duration
+    ( std::chrono::steady_clock::now() - start );
+
+  claw::logger << claw::log_verbose << "Save: " << variables.size()
+               << " game variables and " << files.size()
+               << " files written in " << duration.count() << " ms."
+               << std::endl;
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+    m_written_count = request_count;
+  }
+
+  m_done_condition.notify_all();
+} // save_service::write_pending()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a file in a temporary file synchronized on the disk, then
+ *        rename it with the final name.
+ * \param file_name The name of the file.
+ * \param content The content of the file.
+ */
+bool rp::save_service::write_file
+( const std::string& file_name, const std::string& content )
+{
+  const std::string temporary_name( file_name + ".tmp" );
+  std::FILE* const f( std::fopen( temporary_name.c_str(), "wb" ) );
+
+  if ( f == NULL )
+    {
+      claw::logger << claw::log_error << "Save: cannot open '"
+                   << temporary_name << "'." << std::endl;
+      return false;
+    }
+
+  bool ok =
+    ( std::fwrite( content.data(), 1, content.size(), f ) == content.size() )
+    && ( std::fflush( f ) == 0 );
+
+#ifdef _WIN32
+  ok = ok && ( _commit( _fileno( f ) ) == 0 );
+#else
+  ok = ok && ( fsync( fileno( f ) ) == 0 );
+#endif
+
+  ok = ( std::fclose( f ) == 0 ) && ok;
+
+  if ( ok )
+#ifdef _WIN32
+    ok =
+      MoveFileExA
+      ( temporary_name.c_str(), file_name.c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) != 0;
+#else
+    ok = std::rename( temporary_name.c_str(), file_name.c_str() ) == 0;
+#endif
+
+  if ( !ok )
+    {
+      claw::logger << claw::log_error << "Save: cannot write '" << file_name
+                   << "'." << std::endl;
+      std::remove( temporary_name.c_str() );
+    }
+
+  return ok;
+} // save_service::write_file()
@@ -0,0 +1,746 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::save_snapshot class.
+ * \author Julien Jorge
+ */
+#include "rp/save_snapshot.hpp"
+
+#include "rp/defines.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+const char* const rp::save_snapshot::s_level_fields[3] =
+  { "score", "level_state", "balloon" };
+const char rp::save_snapshot::s_binary_magic[4] = { 'R', 'P', 'S', 'V' };
+const uint32_t rp::save_snapshot::s_binary_version( 1 );
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a boolean variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void rp::save_snapshot::set( const std::string& name, bool value )
+{
+  m_bool[ name ] = value;
+} // save_snapshot::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a signed integer variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void rp::save_snapshot::set( const std::string& name, int value )
+{
+  m_int[ name ] = value;
+} // save_snapshot::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of an unsigned integer variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void rp::save_snapshot::set( const std::string& name, unsigned int value )
+{
+  m_uint[ name ] = value;
+} // save_snapshot::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a real variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void rp::save_snapshot::set( const std::string& name, double value )
+{
+  m_double[ name ] = value;
+} // save_snapshot::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a string variable.
+ * \param name The name of the variable.
+ * \param value The value of the variable.
+ */
+void rp::save_snapshot::set( const std::string& name, const std::string& value )
+{
+  m_string[ name ] = value;
+} // save_snapshot::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the variables of another snapshot in this one, replacing the
+ *        values of the variables already there.
+ * \param that The snapshot to copy from.
+ */
+void rp::save_snapshot::merge( const save_snapshot& that )
+{
+  merge( m_bool, that.m_bool );
+  merge( m_int, that.m_int );
+  merge( m_uint, that.m_uint );
+  merge( m_double, that.m_double );
+  merge( m_string, that.m_string );
+} // save_snapshot::merge()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove all the variables.
+ */
+void rp::save_snapshot::clear()
+{
+  m_bool.clear();
+  m_int.clear();
+  m_uint.clear();
+  m_double.clear();
+  m_string.clear();
+} // save_snapshot::clear()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if there is no variable in the snapshot.
+ */
+bool rp::save_snapshot::empty() const
+{
+  return size() == 0;
+} // save_snapshot::empty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of variables in the snapshot.
+ */
+std::size_t rp::save_snapshot::size() const
+{
+  return m_bool.size() + m_int.size() + m_uint.size() + m_double.size()
+    + m_string.size();
+} // save_snapshot::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the variables of a save file in the snapshot.
+ * \param is The stream containing the save file.
+ * \return false if the file is malformed. The variables read before the error
+ *         are kept.
+ */
+bool rp::save_snapshot::read( std::istream& is )
+{
+  std::string type;
+
+  while ( is >> type )
+    {
+      std::string name;
+      std::string value;
+      char equal;
+      char semicolon;
+
+      if ( !read_quoted( is, name ) || !( is >> equal ) || ( equal != '=' )
+           || !read_quoted( is, value ) || !( is >> semicolon )
+           || ( semicolon != ';' ) )
+        return false;
+
+      bool ok;
+
+      if ( type == "bool" )
+        ok = parse( m_bool, name, value );
+      else if ( type == "int" )
+        ok = parse( m_int, name, value );
+      else if ( type == "uint" )
+        ok = parse( m_uint, name, value );
+      else if ( type == "real" )
+        ok = parse( m_double, name, value );
+      else if ( type == "string" )
+        {
+          m_string[ name ] = value;
+          ok = true;
+        }
+      else
+        ok = false;
+
+      if ( !ok )
+        return false;
+    }
+
+  return true;
+} // save_snapshot::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the variables in the format of the save file.
+ * \param os The stream in which the variables are written.
+ */
+void rp::save_snapshot::write( std::ostream& os ) const
+{
+  const std::streamsize precision( os.precision() );
+  os.precision( std::numeric_limits<double>::digits10 + 2 );
+
+  write( os, "bool", m_bool );
+  write( os, "int", m_int );
+  write( os, "uint", m_uint );
+  write( os, "real", m_double );
+  write( os, "string", m_string );
+
+  os.precision( precision );
+} // save_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the variables of a save file in the binary format in the
+ *        snapshot.
+ * \param data The content of the file.
+ * \param size The size of the file.
+ * \return false if the file is not in the expected format or version. Some
+ *         variables may have been read before the error.
+ */
+bool rp::save_snapshot::read_binary( const char* data, std::size_t size )
+{
+  binary_input in;
+  in.position = data;
+  in.end = data + size;
+
+  if ( ( size < sizeof( s_binary_magic ) )
+       || ( std::memcmp( data, s_binary_magic, sizeof( s_binary_magic ) )
+            != 0 ) )
+    return false;
+
+  in.position += sizeof( s_binary_magic );
+
+  uint32_t version;
+
+  if ( !read_uint32( in, version ) || ( version != s_binary_version ) )
+    return false;
+
+  uint32_t level_count;
+  uint32_t bool_count;
+  uint32_t int_count;
+  uint32_t uint_count;
+  uint32_t double_count;
+  uint32_t string_count;
+
+  if ( !read_uint32( in, level_count ) || !read_uint32( in, bool_count )
+       || !read_uint32( in, int_count ) || !read_uint32( in, uint_count )
+       || !read_uint32( in, double_count ) || !read_uint32( in, string_count ) )
+    return false;
+
+  const std::size_t record_size( 6 * sizeof( uint32_t ) );
+
+  if ( level_count > std::size_t( in.end - in.position ) / record_size )
+    return false;
+
+  for ( uint32_t i( 0 ); i != level_count; ++i )
+    {
+      uint32_t serial;
+      uint32_t number;
+      uint32_t fields;
+
+      // The size of the table has been checked above.
+      read_uint32( in, serial );
+      read_uint32( in, number );
+      read_uint32( in, fields );
+
+      for ( std::size_t f( 0 ); f != 3; ++f )
+        {
+          uint32_t value;
+          read_uint32( in, value );
+
+          if ( fields & ( 1 << f ) )
+            m_uint[ make_level_name( serial, number, f ) ] = value;
+        }
+    }
+
+  return read_binary( in, bool_count, m_bool )
+    && read_binary( in, int_count, m_int )
+    && read_binary( in, uint_count, m_uint )
+    && read_binary( in, double_count, m_double )
+    && read_binary( in, string_count, m_string )
+    && ( in.position == in.end );
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the variables in the binary format.
+ * \param os The stream in which the variables are written.
+ */
+void rp::save_snapshot::write_binary( std::ostream& os ) const
+{
+  std::map< std::pair<unsigned int, unsigned int>, level_record > levels;
+  std::map<std::string, unsigned int> other_uint;
+
+  for ( const auto& v : m_uint )
+    {
+      unsigned int serial;
+      unsigned int number;
+      std::size_t field;
+
+      if ( parse_level_name( v.first, serial, number, field ) )
+        {
+          level_record& r( levels[ std::make_pair( serial, number ) ] );
+          r.serial = serial;
+          r.number = number;
+          r.fields |= 1 << field;
+          r.values[ field ] = v.second;
+        }
+      else
+        other_uint.insert( other_uint.end(), v );
+    }
+
+  os.write( s_binary_magic, sizeof( s_binary_magic ) );
+  write_uint32( os, s_binary_version );
+  write_uint32( os, levels.size() );
+  write_uint32( os, m_bool.size() );
+  write_uint32( os, m_int.size() );
+  write_uint32( os, other_uint.size() );
+  write_uint32( os, m_double.size() );
+  write_uint32( os, m_string.size() );
+
+  for ( const auto& level : levels )
+    {
+      const level_record& r( level.second );
+
+      write_uint32( os, r.serial );
+      write_uint32( os, r.number );
+      write_uint32( os, r.fields );
+
+      for ( std::size_t f( 0 ); f != 3; ++f )
+        write_uint32( os, r.values[ f ] );
+    }
+
+  write_binary( os, m_bool );
+  write_binary( os, m_int );
+  write_binary( os, other_uint );
+  write_binary( os, m_double );
+  write_binary( os, m_string );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the variables of a given type in another map.
+ * \param to The map receiving the variables.
+ * \param from The variables to copy.
+ */
+template<typename T>
+void rp::save_snapshot::merge
+( std::map<std::string, T>& to, const std::map<std::string, T>& from )
+{
+  for ( const auto& v : from )
+    to[ v.first ] = v.second;
+} // save_snapshot::merge()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the variables of a given type.
+ * \param os The stream in which the variables are written.
+ * \param type The name of the type in the save file.
+ * \param values The variables to write.
+ */
+template<typename T>
+void rp::save_snapshot::write
+( std::ostream& os, const char* type, const std::map<std::string, T>& values )
+{
+  for ( const auto& v : values )
+    {
+      std::ostringstream value;
+      value.precision( os.precision() );
+      value << v.second;
+
+      os << type << " \"" << escape( v.first ) << "\" = \""
+         << escape( value.str() ) << "\";\n";
+    }
+} // save_snapshot::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse the value of a variable and store it.
+ * \param values The map in which the variable is stored.
+ * \param name The name of the variable.
+ * \param value The text of the value.
+ */
+template<typename T>
+bool rp::save_snapshot::parse
+( std::map<std::string, T>& values, const std::string& name,
+  const std::string& value )
+{
+  std::istringstream iss( value );
+  T v;
+
+  if ( !( iss >> v ) )
+    return false;
+
+  values[ name ] = v;
+  return true;
+} // save_snapshot::parse()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a string enclosed in double quotes, in which the quotes and the
+ *        backslashes are escaped with a backslash.
+ * \param is The stream to read from.
+ * \param s (out) The unescaped string.
+ */
+bool rp::save_snapshot::read_quoted( std::istream& is, std::string& s )
+{
+  char c;
+
+  if ( !( is >> c ) || ( c != '"' ) )
+    return false;
+
+  s.clear();
+
+  while ( is.get( c ) )
+    if ( c == '"' )
+      return true;
+    else if ( ( c == '\\' ) && !is.get( c ) )
+      return false;
+    else
+      s += c;
+
+  return false;
+} // save_snapshot::read_quoted()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Escape the quotes and the backslashes of a string.
+ * \param s The string to escape.
+ */
+std::string rp::save_snapshot::escape( const std::string& s )
+{
+  std::string result;
+  result.reserve( s.size() );
+
+  for ( const char c : s )
+    {
+      if ( ( c == '"' ) || ( c == '\\' ) )
+        result += '\\';
+
+      result += c;
+    }
+
+  return result;
+} // save_snapshot::escape()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the level and the field of a persistent variable of a level.
+ * \param name The name of the variable.
+ * \param serial (out) The serial of the level.
+ * \param number (out) The number of the level.
+ * \param field (out) The index of the field in s_level_fields.
+ * \return false if the variable is not a field of a level record.
+ */
+bool rp::save_snapshot::parse_level_name
+( const std::string& name, unsigned int& serial, unsigned int& number,
+  std::size_t& field )
+{
+  static const std::string prefix( RP_PERSISTENT_PREFIX "level/" );
+
+  if ( name.compare( 0, prefix.size(), prefix ) != 0 )
+    return false;
+
+  const char* const s( name.c_str() + prefix.size() );
+  char* end;
+
+  serial = std::strtoul( s, &end, 10 );
+
+  if ( ( end == s ) || ( *end != '/' ) )
+    return false;
+
+  const char* const n( end + 1 );
+  number = std::strtoul( n, &end, 10 );
+
+  if ( ( end == n ) || ( *end != '/' ) )
+    return false;
+
+  for ( field = 0; field != 3; ++field )
+    if ( std::strcmp( end + 1, s_level_fields[ field ] ) == 0 )
+      // The name is rebuilt when read, thus it must be written in the same
+      // way, without leading zeros for example.
+      return make_level_name( serial, number, field ) == name;
+
+  return false;
+} // save_snapshot::parse_level_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the variable of a field of a level record. The names
+ *        are those of game_variables::get_persistent_score_variable_name(),
+ *        game_variables::get_level_state_variable_name() and
+ *        game_variables::get_persistent_balloon_variable_name().
+ * \param serial The serial of the level.
+ * \param number The number of the level.
+ * \param field The index of the field in s_level_fields.
+ */
+std::string rp::save_snapshot::make_level_name
+( unsigned int serial, unsigned int number, std::size_t field )
+{
+  return RP_PERSISTENT_PREFIX "level/" + std::to_string( serial ) + '/'
+    + std::to_string( number ) + '/' + s_level_fields[ field ];
+} // save_snapshot::make_level_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the variables of a given type in the binary format.
+ * \param os The stream in which the variables are written.
+ * \param values The variables to write.
+ */
+template<typename T>
+void rp::save_snapshot::write_binary
+( std::ostream& os, const std::map<std::string, T>& values )
+{
+  for ( const auto& v : values )
+    {
+      write_binary( os, v.first );
+      write_binary( os, v.second );
+    }
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the variables of a given type in the binary format.
+ * \param in The data to read.
+ * \param count The number of variables to read.
+ * \param values The map receiving the variables.
+ */
+template<typename T>
+bool rp::save_snapshot::read_binary
+( binary_input& in, std::size_t count, std::map<std::string, T>& values )
+{
+  for ( std::size_t i( 0 ); i != count; ++i )
+    {
+      std::string name;
+      T value;
+
+      if ( !read_binary( in, name ) || !read_binary( in, value ) )
+        return false;
+
+      // The variables are written in order, thus they are inserted at the end.
+      values.insert( values.end(), std::make_pair( name, value ) );
+    }
+
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a boolean value in the binary format.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_binary( std::ostream& os, bool value )
+{
+  os.put( value ? 1 : 0 );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a signed integer in the binary format.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_binary( std::ostream& os, int value )
+{
+  write_uint32( os, static_cast<uint32_t>( value ) );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an unsigned integer in the binary format.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_binary( std::ostream& os, unsigned int value )
+{
+  write_uint32( os, value );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a real value in the binary format.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_binary( std::ostream& os, double value )
+{
+  uint64_t bits;
+  std::memcpy( &bits, &value, sizeof( bits ) );
+
+  write_uint64( os, bits );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a string in the binary format.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_binary
+( std::ostream& os, const std::string& value )
+{
+  write_uint32( os, value.size() );
+  os.write( value.data(), value.size() );
+} // save_snapshot::write_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a boolean value in the binary format.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_binary( binary_input& in, bool& value )
+{
+  if ( in.position == in.end )
+    return false;
+
+  value = ( *in.position != 0 );
+  ++in.position;
+
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a signed integer in the binary format.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_binary( binary_input& in, int& value )
+{
+  uint32_t bits;
+
+  if ( !read_uint32( in, bits ) )
+    return false;
+
+  value = static_cast<int32_t>( bits );
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an unsigned integer in the binary format.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_binary( binary_input& in, unsigned int& value )
+{
+  uint32_t bits;
+
+  if ( !read_uint32( in, bits ) )
+    return false;
+
+  value = bits;
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a real value in the binary format.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_binary( binary_input& in, double& value )
+{
+  uint64_t bits;
+
+  if ( !read_uint64( in, bits ) )
+    return false;
+
+  std::memcpy( &value, &bits, sizeof( value ) );
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a string in the binary format.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_binary( binary_input& in, std::string& value )
+{
+  uint32_t size;
+
+  if ( !read_uint32( in, size )
+       || ( size > std::size_t( in.end - in.position ) ) )
+    return false;
+
+  value.assign( in.position, size );
+  in.position += size;
+
+  return true;
+} // save_snapshot::read_binary()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 32 bits unsigned integer in little endian.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_uint32( std::ostream& os, uint32_t value )
+{
+  const char bytes[4] =
+    { char( value & 0xff ), char( ( value >> 8 ) & 0xff ),
+      char( ( value >> 16 ) & 0xff ), char( ( value >> 24 ) & 0xff ) };
+
+  os.write( bytes, sizeof( bytes ) );
+} // save_snapshot::write_uint32()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write a 64 bits unsigned integer in little endian.
+ * \param os The stream in which the value is written.
+ * \param value The value to write.
+ */
+void rp::save_snapshot::write_uint64( std::ostream& os, uint64_t value )
+{
+  write_uint32( os, value & 0xffffffff );
+  write_uint32( os, value >> 32 );
+} // save_snapshot::write_uint64()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a 32 bits unsigned integer in little endian.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_uint32( binary_input& in, uint32_t& value )
+{
+  if ( in.end - in.position < 4 )
+    return false;
+
+  const unsigned char* const p
+    ( reinterpret_cast<const unsigned char*>( in.position ) );
+
+  value = uint32_t( p[0] ) | ( uint32_t( p[1] ) << 8 )
+    | ( uint32_t( p[2] ) << 16 ) | ( uint32_t( p[3] ) << 24 );
+  in.position += 4;
+
+  return true;
+} // save_snapshot::read_uint32()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a 64 bits unsigned integer in little endian.
+ * \param in The data to read.
+ * \param value (out) The value read.
+ */
+bool rp::save_snapshot::read_uint64( binary_input& in, uint64_t& value )
+{
+  uint32_t low;
+  uint32_t high;
+
+  if ( !read_uint32( in, low ) || !read_uint32( in, high ) )
+    return false;
+
+  value = uint64_t( low ) | ( uint64_t( high ) << 32 );
+  return true;
+} // save_snapshot::read_uint64()
@@ -0,0 +1,411 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::sequence_recorder class.
+ * \author Julien Jorge
+ */
+#include "rp/sequence_recorder.hpp"
+
+#include "engine/game.hpp"
+
+#include <boost/bind.hpp>
+
+#include <claw/bitmap.hpp>
+#include <claw/logger.hpp>
+#include <claw/png.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor. Starts the encoder threads.
+ * \param path_prefix The prefix of the path of the files.
+ * \param format The format of the images.
+ * \param thread_count The number of encoder threads.
+ */
+rp::sequence_recorder::sequence_recorder
+( const std::string& path_prefix, format_type format,
+  std::size_t thread_count )
+  : m_path_prefix( path_prefix ), m_format( format ),
+    m_start_date( std::chrono::steady_clock::now() ),
+    m_dropped_count( 0 ), m_failed_count( 0 ), m_quit( false )
+{
+  assert( thread_count != 0 );
+
+  // Each encoder works on a buffer while the next frames are captured in the
+  // others.
+  m_buffers.resize( 2 * thread_count + 2 );
+
+  for ( std::size_t i( m_buffers.size() ); i != 0; --i )
+    m_free_buffers.push_back( i - 1 );
+
+  for ( std::size_t i( 0 ); i != thread_count; ++i )
+    m_threads.create_thread( boost::bind( &sequence_recorder::run, this ) );
+
+  claw::logger << claw::log_verbose << "Starting screenshot sequence with "
+               << thread_count << " encoders and " << m_buffers.size()
+               << " buffers." << std::endl;
+} // sequence_recorder::sequence_recorder()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. Waits for the frames in the queue to be written, then
+ *        writes the manifest.
+ */
+rp::sequence_recorder::~sequence_recorder()
+{
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+    m_quit = true;
+  }
+
+  m_job_condition.notify_all();
+  m_threads.join_all();
+
+  write_manifest();
+} // sequence_recorder::~sequence_recorder()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Capture the screen and queue the image for the encoders. The frame
+ *        is dropped if no buffer is free.
+ */
+void rp::sequence_recorder::capture()
+{
+  const double date
+    ( std::chrono::duration<double, std::milli>
+      ( std::chrono::steady_clock::now() - m_start_date ).count() );
+
+  std::size_t buffer;
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    if ( m_free_buffers.empty() )
+      {
+        ++m_dropped_count;
+        return;
+      }
+
+    buffer = m_free_buffers.back();
+    m_free_buffers.pop_back();
+  }
+
+  // The buffer is not shared until it is queued, and the capture keeps its
+  // storage when the size of the screen does not change.
+  bear::engine::game::get_instance().screenshot( m_buffers[ buffer ] );
+
+  {
+    const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+    job j;
+    j.buffer = buffer;
+    j.frame = m_frames.size();
+    m_jobs.push_back( j );
+
+    frame_entry e;
+    e.date = date;
+    e.file_name = get_file_name( j.frame );
+    m_frames.push_back( e );
+  }
+
+  m_job_condition.notify_one();
+} // sequence_recorder::capture()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the format of the images from its name: "bmp", "png", "qoi" or
+ *        "raw". The default format is the bitmap.
+ * \param name The name of the format.
+ */
+rp::sequence_recorder::format_type
+rp::sequence_recorder::get_format( const std::string& name )
+{
+  if ( name == "png" )
+    return format_png;
+  else if ( name == "qoi" )
+    return format_qoi;
+  else if ( name == "raw" )
+    return format_raw;
+  else
+    return format_bmp;
+} // sequence_recorder::get_format()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The loop of the encoder threads.
+ */
+void rp::sequence_recorder::run()
+{
+  while ( true )
+    {
+      job j;
+      std::string file_name;
+
+      {
+        boost::unique_lock<boost::mutex> lock( m_mutex );
+
+        while ( m_jobs.empty() && !m_quit )
+          m_job_condition.wait( lock );
+
+        if ( m_jobs.empty() )
+          return;
+
+        j = m_jobs.front();
+        m_jobs.pop_front();
+        file_name = m_frames[ j.frame ].file_name;
+      }
+
+      const bool ok( encode( m_buffers[ j.buffer ], file_name ) );
+
+      const boost::unique_lock<boost::mutex> lock( m_mutex );
+
+      if ( !ok )
+        ++m_failed_count;
+
+      m_free_buffers.push_back( j.buffer );
+    }
+} // sequence_recorder::run()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an image in a file.
+ * \param image The image to write.
+ * \param file_name The name of the file.
+ */
+bool rp::sequence_recorder::encode
+( const claw::graphic::image& image, const std::string& file_name ) const
+{
+  try
+    {
+      std::ofstream f( file_name.c_str(), std::ios::binary );
+
+      switch ( m_format )
+        {
+        case format_bmp:
+          claw::graphic::bitmap::writer( image, f );
+          break;
+        case format_png:
+          claw::graphic::png::writer( image, f );
+          break;
+        case format_qoi:
+          write_qoi( f, image );
+          break;
+        case format_raw:
+          write_raw( f, image );
+          break;
+        }
+
+      if ( !f )
+        {
+          claw::logger << claw::log_error << "Screenshot: cannot write '"
+                       << file_name << "'." << std::endl;
+          return false;
+        }
+    }
+  catch( std::exception& e )
+    {
+      claw::logger << claw::log_error << "Screenshot: " << e.what()
+                   << std::endl;
+      return false;
+    }
+
+  return true;
+} // sequence_recorder::encode()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the file of a frame.
+ * \param frame The index of the frame in the sequence.
+ */
+std::string rp::sequence_recorder::get_file_name( std::size_t frame ) const
+{
+  static const char* const extension[] = { ".bmp", ".png", ".qoi", ".pam" };
+
+  std::ostringstream result;
+  result << m_path_prefix << '-' << std::setw(8) << std::setfill('0') << frame
+         << extension[ m_format ];
+
+  return result.str();
+} // sequence_recorder::get_file_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the manifest of the sequence.
+ */
+void rp::sequence_recorder::write_manifest() const
+{
+  const double duration
+    ( std::chrono::duration<double>
+      ( std::chrono::steady_clock::now() - m_start_date ).count() );
+  const unsigned int fps =
+    (unsigned int)( (double)m_frames.size() / duration + 0.5 );
+
+  const std::string file_name( m_path_prefix + ".seq" );
+  std::ofstream f( file_name.c_str() );
+
+  f << fps << " # fps\n"
+    << "# " << m_frames.size() << " frames recorded in " << duration
+    << " seconds, " << m_dropped_count << " dropped, " << m_failed_count
+    << " not written.\n"
+    << "# date (ms) file\n";
+
+  for ( std::size_t i( 0 ); i != m_frames.size(); ++i )
+    f << m_frames[i].date << ' ' << m_frames[i].file_name << '\n';
+
+  claw::logger << claw::log_verbose << "Screenshot sequence stopped. " << fps
+               << " fps during " << duration << " seconds, "
+               << m_dropped_count << " frames dropped." << std::endl;
+} // sequence_recorder::write_manifest()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an image in the QOI format.
+ * \param os The stream in which the image is written.
+ * \param image The image to write.
+ */
+void rp::sequence_recorder::write_qoi
+( std::ostream& os, const claw::graphic::image& image )
+{
+  const unsigned int width( image.width() );
+  const unsigned int height( image.height() );
+
+  std::string result;
+  result.reserve( 14 + width * height * 5 + 8 );
+
+  result += "qoif";
+
+  for ( int shift( 24 ); shift >= 0; shift -= 8 )
+    result += char( ( width >> shift ) & 0xff );
+
+  for ( int shift( 24 ); shift >= 0; shift -= 8 )
+    result += char( ( height >> shift ) & 0xff );
+
+  // Four channels, sRGB with linear alpha.
+  result += char( 4 );
+  result += char( 0 );
+
+  unsigned char index[64][4] = { { 0 } };
+  unsigned char previous[4] = { 0, 0, 0, 255 };
+  unsigned int run( 0 );
+
+  for ( unsigned int y( 0 ); y != height; ++y )
+    for ( unsigned int x( 0 ); x != width; ++x )
+      {
+        const claw::graphic::rgba_pixel& p( image[y][x] );
+        const unsigned char pixel[4] =
+          { p.components.red, p.components.green, p.components.blue,
+            p.components.alpha };
+        const bool last( ( y == height - 1 ) && ( x == width - 1 ) );
+
+        if ( std::equal( pixel, pixel + 4, previous ) )
+          {
+            ++run;
+
+            if ( ( run == 62 ) || last )
+              {
+                result += char( 0xc0 | ( run - 1 ) );
+                run = 0;
+              }
+
+            continue;
+          }
+
+        if ( run != 0 )
+          {
+            result += char( 0xc0 | ( run - 1 ) );
+            run = 0;
+          }
+
+        const unsigned int hash
+          ( ( pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11 )
+            % 64 );
+
+        if ( std::equal( pixel, pixel + 4, index[ hash ] ) )
+          result += char( hash );
+        else
+          {
+            std::copy( pixel, pixel + 4, index[ hash ] );
+
+            if ( pixel[3] == previous[3] )
+              {
+                const signed char dr( pixel[0] - previous[0] );
+                const signed char dg( pixel[1] - previous[1] );
+                const signed char db( pixel[2] - previous[2] );
+                const signed char dr_dg( dr - dg );
+                const signed char db_dg( db - dg );
+
+                if ( ( dr > -3 ) && ( dr < 2 ) && ( dg > -3 ) && ( dg < 2 )
+                     && ( db > -3 ) && ( db < 2 ) )
+                  result +=
+                    char( 0x40 | ( ( dr + 2 ) << 4 ) | ( ( dg + 2 ) << 2 )
+                          | ( db + 2 ) );
+                else if ( ( dr_dg > -9 ) && ( dr_dg < 8 ) && ( dg > -33 )
+                          && ( dg < 32 ) && ( db_dg > -9 ) && ( db_dg < 8 ) )
+                  {
+                    result += char( 0x80 | ( dg + 32 ) );
+                    result += char( ( ( dr_dg + 8 ) << 4 ) | ( db_dg + 8 ) );
+                  }
+                else
+                  {
+                    result += char( 0xfe );
+                    result.append( pixel, pixel + 3 );
+                  }
+              }
+            else
+              {
+                result += char( 0xff );
+                result.append( pixel, pixel + 4 );
+              }
+          }
+
+        std::copy( pixel, pixel + 4, previous );
+      }
+
+  // The end marker.
+  result.append( 7, char( 0 ) );
+  result += char( 1 );
+
+  os.write( result.data(), result.size() );
+} // sequence_recorder::write_qoi()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write an image in the Netpbm PAM format, without compression.
+ * \param os The stream in which the image is written.
+ * \param image The image to write.
+ */
+void rp::sequence_recorder::write_raw
+( std::ostream& os, const claw::graphic::image& image )
+{
+  os << "P7\nWIDTH " << image.width() << "\nHEIGHT " << image.height()
+     << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+
+  std::vector<char> line( 4 * image.width() );
+
+  for ( unsigned int y( 0 ); y != image.height(); ++y )
+    {
+      for ( unsigned int x( 0 ); x != image.width(); ++x )
+        {
+          const claw::graphic::rgba_pixel& p( image[y][x] );
+
+          line[ 4 * x ] = p.components.red;
+          line[ 4 * x + 1 ] = p.components.green;
+          line[ 4 * x + 2 ] = p.components.blue;
+          line[ 4 * x + 3 ] = p.components.alpha;
+        }
+
+      os.write( line.data(), line.size() );
+    }
+} // sequence_recorder::write_raw()
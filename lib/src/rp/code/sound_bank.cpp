@@ -0,0 +1,207 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::sound_bank class.
+ * \author Julien Jorge
+ */
+#include "rp/sound_bank.hpp"
+
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
+
+#include "engine/level_globals.hpp"
+
+#include <claw/logger.hpp>
+
+BASE_ITEM_EXPORT( sound_bank, rp )
+
+/*----------------------------------------------------------------------------*/
+rp::sound_bank* rp::sound_bank::s_instance( NULL );
+
+/*----------------------------------------------------------------------------*/
+const rp::sound_bank::sample_description
+rp::sound_bank::s_samples[ rp::sound_bank::sample_count ] =
+  {
+    { "sound/balloon/burst-1.ogg", 2 },
+    { "sound/balloon/burst-2.ogg", 2 },
+    { "sound/balloon/burst-3.ogg", 2 },
+    { "sound/balloon/burst-4.ogg", 2 },
+    { "sound/boing.ogg", 2 },
+    { "sound/explosion/explosion-1.ogg", 2 },
+    { "sound/explosion/explosion-2.ogg", 2 },
+    { "sound/explosion/explosion-3.ogg", 2 },
+    { "sound/explosion/explosion-4.ogg", 2 },
+    { "sound/explosion/explosion-5.ogg", 2 },
+    { "sound/hit-2.ogg", 3 },
+    { "sound/metal-2.ogg", 2 },
+    { "sound/metal-3.ogg", 2 },
+    { "sound/metal-4.ogg", 2 },
+    { "sound/effect/over.ogg", 2 },
+    { "sound/wall/break.ogg", 2 },
+    { "sound/wall/explose.ogg", 2 }
+  };
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::sound_bank::sound_bank()
+  : m_played_count( 0 ), m_stolen_count( 0 )
+{
+  set_global( true );
+  set_phantom( true );
+  set_artificial( true );
+  set_can_move_items( false );
+
+  for ( std::size_t i(0); i != sample_count + 1; ++i )
+    m_first_voice[i] = 0;
+} // sound_bank::sound_bank()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor.
+ */
+rp::sound_bank::~sound_bank()
+{
+  if ( s_instance == this )
+    s_instance = NULL;
+
+  for ( std::size_t i(0); i != m_voices.size(); ++i )
+    delete m_voices[i];
+
+  claw::logger << claw::log_verbose << "Sound bank: " << m_played_count
+               << " sounds played, " << m_stolen_count << " voices stolen."
+               << std::endl;
+} // sound_bank::~sound_bank()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Load the sounds of the bank in the level globals.
+ * \param globals The level globals in which the sounds are loaded.
+ */
+void rp::sound_bank::load_samples( bear::engine::level_globals& globals )
+{
+  for ( std::size_t i(0); i != sample_count; ++i )
+    globals.load_sound( s_samples[i].name );
+} // sound_bank::load_samples()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Play a sound of the bank.
+ * \param globals The level globals playing the sound if there is no bank in
+ *        the current level.
+ * \param id The identifier of the sound.
+ * \param effect The effect applied to the sound.
+ */
+void rp::sound_bank::play
+( bear::engine::level_globals& globals, sample_id id,
+  const bear::audio::sound_effect& effect )
+{
+  if ( s_instance == NULL )
+    globals.play_sound( s_samples[id].name, effect );
+  else
+    s_instance->play_voice( id, effect );
+} // sound_bank::play()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Play a sound picked randomly among consecutive sounds of the bank.
+ * \param globals The level globals playing the sound if there is no bank in
+ *        the current level.
+ * \param first The identifier of the first sound among which the sound is
+ *        picked.
+ * \param count The count of sounds among which the sound is picked.
+ * \param effect The effect applied to the sound.
+ */
+void rp::sound_bank::play_random
+( bear::engine::level_globals& globals, sample_id first, std::size_t count,
+  const bear::audio::sound_effect& effect )
+{
+  play
+    ( globals, sample_id( first + random::sounds().integer( count ) ),
+      effect );
+} // sound_bank::play_random()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do post creation actions.
+ */
+void rp::sound_bank::on_enters_layer()
+{
+  super::on_enters_layer();
+
+  s_instance = this;
+
+  bear::engine::level_globals& glob( get_level_globals() );
+
+  for ( std::size_t i(0); i != sample_count; ++i )
+    {
+      m_first_voice[i] = m_voices.size();
+
+      for ( std::size_t j(0); j != s_samples[i].voice_count; ++j )
+        m_voices.push_back( glob.new_sample( s_samples[i].name ) );
+    }
+
+  m_first_voice[ sample_count ] = m_voices.size();
+  m_voice_start.resize( m_voices.size(), 0 );
+} // sound_bank::on_enters_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of sounds played with the bank.
+ */
+std::size_t rp::sound_bank::get_played_count() const
+{
+  return m_played_count;
+} // sound_bank::get_played_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of voices stopped to play a new sound.
+ */
+std::size_t rp::sound_bank::get_stolen_count() const
+{
+  return m_stolen_count;
+} // sound_bank::get_stolen_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Play a sound with the first free voice of the sound, or with its
+ *        oldest voice if they are all playing.
+ * \param id The identifier of the sound.
+ * \param effect The effect applied to the sound.
+ */
+void rp::sound_bank::play_voice
+( sample_id id, const bear::audio::sound_effect& effect )
+{
+  RP_PROFILE_ZONE( "sound/sound_bank" );
+
+  const std::size_t first( m_first_voice[id] );
+  const std::size_t last( m_first_voice[id + 1] );
+  std::size_t voice( last );
+  std::size_t oldest( first );
+
+  for ( std::size_t i( first ); ( voice == last ) && ( i != last ); ++i )
+    if ( !m_voices[i]->is_playing() )
+      voice = i;
+    else if ( m_voice_start[i] < m_voice_start[oldest] )
+      oldest = i;
+
+  if ( voice == last )
+    {
+      voice = oldest;
+      m_voices[voice]->stop();
+      ++m_stolen_count;
+    }
+
+  ++m_played_count;
+  m_voice_start[voice] = m_played_count;
+  m_voices[voice]->play( effect );
+} // sound_bank::play_voice()
@@ -15,6 +15,9 @@
 #include "rp/game_variables.hpp"
 #include "rp/hole.hpp"
 #include "rp/plunger.hpp"
+#include "rp/profiler.hpp"
+
+#include "engine/level.hpp"
 
 BASE_ITEM_EXPORT( switching, rp )
 
@@ -81,8 +84,24 @@ void rp::switching::on_enters_layer()
   if ( get_mark_placement("sign", mark) )
     create_interactive_item
         (*this, 0.25, 0, mark.get_position() - get_center_of_mass() );
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::switching::on_enters_layer()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one iteration in the progression of the item.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void rp::switching::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/switching" );
+
+  super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
+} // rp::switching::progress()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Set a field of type \c string.
@@ -16,6 +16,9 @@
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
 #include "rp/plank.hpp"
+#include "rp/profiler.hpp"
+
+#include "engine/level.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -56,6 +59,9 @@ void rp::tar::on_enters_layer()
   set_model_actor( get_level_globals().get_model("model/tar.cm") );
   start_model_action("idle");
   create_interactive_item(*this);
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::tar::on_enters_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -65,7 +71,11 @@ void rp::tar::on_enters_layer()
  */
 void rp::tar::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/tar" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
+
   const std::string action_name = get_current_action_name();
 
   if ( ( action_name == "idle" ) && !has_forced_movement() )
@@ -18,10 +18,14 @@
 #include "rp/cart.hpp"
 #include "rp/game_variables.hpp"
 #include "rp/plank.hpp" 
+#include "rp/profiler.hpp"
 #include "rp/explosion.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/util.hpp"
 #include "rp/zeppelin.hpp"
 
+#include "engine/level.hpp"
+
 BASE_ITEM_EXPORT( tnt, rp )
 
 /*----------------------------------------------------------------------------*/
@@ -43,6 +47,11 @@ void rp::tnt::pre_cache()
   super::pre_cache();
   
   get_level_globals().load_model("model/tnt.cm");
+  get_level_globals().load_sound("sound/explosion/explosion-1.ogg");
+  get_level_globals().load_sound("sound/explosion/explosion-2.ogg");
+  get_level_globals().load_sound("sound/explosion/explosion-3.ogg");
+  get_level_globals().load_sound("sound/explosion/explosion-4.ogg");
+  get_level_globals().load_sound("sound/explosion/explosion-5.ogg");
   get_level_globals().load_animation("animation/explosion.canim");
 } // rp::tnt::pre_cache()
 
@@ -58,8 +67,24 @@ void rp::tnt::on_enters_layer()
   set_mass(100);
   set_model_actor( get_level_globals().get_model("model/tnt.cm") );
   start_model_action("idle");
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::tnt::on_enters_layer()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one iteration in the progression of the item.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void rp::tnt::progress( bear::universe::time_type elapsed_time )
+{
+  RP_PROFILE_ZONE( "progress/tnt" );
+
+  super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
+} // rp::tnt::progress()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Process a collision with an other item.
@@ -99,6 +124,9 @@ void rp::tnt::explose(bool give_score)
       set_can_move_items(false);
       m_explosed = true;
       start_model_action("explose");
+      sound_bank::play_random
+        ( get_level_globals(), sound_bank::explosion_1_sample, 5,
+          bear::audio::sound_effect( get_center_of_mass() ) );
       set_mass(std::numeric_limits<double>::infinity());
       
       create_explosion(3,0); 
@@ -347,6 +375,9 @@ void rp::tnt::create_second_explosion()
 void rp::tnt::create_third_explosion()
 { 
   create_explosion(6,20);
+  sound_bank::play_random
+    ( get_level_globals(), sound_bank::explosion_1_sample, 5,
+      bear::audio::sound_effect( get_center_of_mass() ) );
 } // tnt::create_third_explosion()
 
 /*----------------------------------------------------------------------------*/
@@ -16,8 +16,15 @@
 #include "rp/config_file.hpp"
 #include "rp/defines.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/game_variable_table.hpp"
 #include "rp/interactive_item.hpp"
+#include "rp/mapped_file.hpp"
+#include "rp/particle_system.hpp"
+#include "rp/population_manager.hpp"
 #include "rp/entity.hpp"
+#include "rp/random.hpp"
+#include "rp/save_service.hpp"
+#include "rp/save_snapshot.hpp"
 #include "rp/version.hpp"
 #include "rp/android/java_activity.hpp"
 
@@ -27,7 +34,6 @@
 #include "engine/system/game_filesystem.hpp"
 #include "engine/system/system_api.hpp"
 #include "engine/variable/variable.hpp"
-#include "engine/variable/variable_list_reader.hpp"
 #include "engine/variable/var_map.hpp"
 
 #include "universe/forced_movement/forced_rotation.hpp"
@@ -36,7 +42,45 @@
 #include "generic_items/delayed_kill_item.hpp"
 #include "generic_items/star.hpp"
 
-#include <boost/regex.hpp>
+#include <claw/logger.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+  /**
+   * \brief Copy the variables of a save_snapshot in a var_map.
+   */
+  struct var_map_filler
+  {
+    /**
+     * \brief Constructor.
+     * \param vars The map receiving the variables.
+     */
+    explicit var_map_filler( bear::engine::var_map& vars )
+      : m_vars( vars )
+    {
+
+    }
+
+    /**
+     * \brief Copy a variable in the map.
+     * \param name The name of the variable.
+     * \param value The value of the variable.
+     */
+    template<typename T>
+    void operator()( const std::string& name, const T& value ) const
+    {
+      m_vars.set<T>( name, value );
+    }
+
+    /** \brief The map receiving the variables. */
+    bear::engine::var_map& m_vars;
+
+  }; // struct var_map_filler
+} // namespace
  
 /*---------------------------------------------------------------------------*/
 /**
@@ -169,38 +213,106 @@ void rp::util::create_smoke
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Load game variables.
+ * \brief Load game variables. The save file in the binary format is mapped in
+ *        memory; if it cannot be read, the variables are read from the save
+ *        file in the text format, then written in the binary format.
  */
 void rp::util::load_game_variables()
 {
+  const std::chrono::steady_clock::time_point start
+    ( std::chrono::steady_clock::now() );
+
   const bear::engine::game& g( bear::engine::game::get_instance() );
+  const std::string binary_filename
+    ( g.get_game_filesystem().get_custom_config_file_name
+      ( RP_BINARY_SAVE_FILENAME ) );
+
+  save_service& service( save_service::get_instance() );
+
+  // The file must not be read while a previous save is being written.
+  service.flush();
+
+  save_snapshot variables;
+  bool loaded( false );
+  bool migrate( false );
+
+  {
+    const mapped_file f( binary_filename );
+
+    if ( f.is_open() )
+      {
+        loaded = variables.read_binary( f.data(), f.size() );
+
+        if ( !loaded )
+          {
+            claw::logger << claw::log_warning << "Save: malformed save file '"
+                         << binary_filename << "'." << std::endl;
+            variables.clear();
+          }
+      }
+  }
+
+  if ( !loaded )
+    migrate = load_text_game_variables( variables );
+
+  bear::engine::var_map vars;
+  var_map_filler filler( vars );
+  variables.for_each( filler );
+
+  bear::engine::game::get_instance().set_game_variables(vars);
+  game_variable_table::get_instance().refresh();
 
+  service.load_game_variables( binary_filename, variables, migrate );
+
+  const std::chrono::duration<double, std::milli> duration
+    ( std::chrono::steady_clock::now() - start );
+
+  claw::logger << claw::log_verbose << "Save: " << variables.size()
+               << " game variables loaded from the "
+               << ( loaded ? "binary" : "text" ) << " save file in "
+               << duration.count() << " ms." << std::endl;
+} // util::load_game_variables()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the game variables from the save file in the text format, used
+ *        before the binary format.
+ * \param variables (out) The variables read from the file.
+ * \return true if the file exists.
+ */
+bool rp::util::load_text_game_variables( save_snapshot& variables )
+{
+  const bear::engine::game& g( bear::engine::game::get_instance() );
   const std::string filename
     ( g.get_game_filesystem().get_custom_config_file_name( RP_SAVE_FILENAME ) );
- 
+
   std::ifstream f( filename.c_str() );
-  bear::engine::var_map vars;
-  bear::engine::variable_list_reader reader;
 
-  reader(f, vars);
+  if ( !f )
+    return false;
 
-  bear::engine::game::get_instance().set_game_variables(vars);
-} // util::load_game_variables()
+  if ( !variables.read( f ) )
+    claw::logger << claw::log_warning << "Save: malformed save file '"
+                 << filename << "'. The unreadable part will be lost."
+                 << std::endl;
+
+  return true;
+} // util::load_text_game_variables()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Save all game variables.
+ * \brief Save the game variables modified since the last save. The file is
+ *        written in the background.
  */
 void rp::util::save_game_variables()
 {
   const bear::engine::game& g( bear::engine::game::get_instance() );
 
   const std::string filename
-    ( g.get_game_filesystem().get_custom_config_file_name( RP_SAVE_FILENAME ) );
-
-  std::ofstream f( filename.c_str() );
+    ( g.get_game_filesystem().get_custom_config_file_name
+      ( RP_BINARY_SAVE_FILENAME ) );
 
-  bear::engine::game::get_instance().save_game_variables(f, "persistent/.*");
+  save_service::get_instance().save_game_variables( filename );
 } // util::save_game_variables()
 
 /*----------------------------------------------------------------------------*/
@@ -216,6 +328,10 @@ void rp::util::create_hit_star
   bear::visual::color_type fill_color,
   bear::universe::time_type time_to_live )
 {
+  if ( !population_manager::can_spawn
+       ( population_manager::decoration_hit_star ) )
+    return;
+
   bear::star* item = new bear::star( 30, 0.9, border_color, 3, fill_color );
 
   const bear::visual::size_type size
@@ -226,6 +342,8 @@ void rp::util::create_hit_star
   item->set_system_angle_as_visual_angle( true );
 
   ref.new_item(*item);
+  population_manager::add_decoration
+    ( population_manager::decoration_hit_star, *item );
 
   item->set_center_of_mass( ref.get_center_of_mass() );
   
@@ -415,28 +533,36 @@ void rp::util::create_smoke
 ( const bear::engine::base_item& ref, double min_intensity,
   double max_intensity, int z_shift )
 {
+  particle_system* const particles( particle_system::get_instance() );
+
+  if ( particles != NULL )
+    {
+      particles->add_smoke( ref, min_intensity, max_intensity, z_shift );
+      return;
+    }
+
   bear::visual::animation anim
     ( ref.get_level_globals().get_animation("animation/effect/steam.canim") );
-  anim.set_time_factor( 1 + 3 * (double)rand() / RAND_MAX );
+  anim.set_time_factor( 1 + 3 * random::effects().real() );
 
   const double intensity =
-    min_intensity + (max_intensity - min_intensity) * rand() / RAND_MAX;
+    min_intensity + (max_intensity - min_intensity) * random::effects().real();
   anim.set_intensity( intensity, intensity, intensity );
 
   bear::decorative_item* item = new bear::decorative_item;
 
   item->set_mass( 1 );
-  item->set_density( 0.0006 + 0.0002 * rand() / RAND_MAX );
+  item->set_density( 0.0006 + 0.0002 * random::effects().real() );
 
   item->set_animation( anim );
   item->set_z_position( ref.get_z_position() + z_shift );
   item->set_kill_when_leaving( true );
   item->set_kill_when_finished( true );
-  item->get_rendering_attributes().set_angle( 6.29 * rand() / RAND_MAX );
+  item->get_rendering_attributes().set_angle( 6.29 * random::effects().real() );
 
   const bear::universe::position_type pos
-    ( ref.get_width() * rand() / RAND_MAX,
-      ref.get_height() * rand() / RAND_MAX );
+    ( ref.get_width() * random::effects().real(),
+      ref.get_height() * random::effects().real() );
 
   item->set_center_of_mass( ref.get_bottom_left() + pos );
   
@@ -458,10 +584,10 @@ void rp::util::apply_random_smoke_effect( bear::engine::base_item& item )
 {
   bear::decorative_effect* effect = new bear::decorative_effect();
 
-  effect->set_size_factor_end( 0.2 + 0.5 * rand() / RAND_MAX );
+  effect->set_size_factor_end( 0.2 + 0.5 * random::effects().real() );
   bear::visual::color init_color, end_color;
-  init_color.set(1,1,1,0.8 + 0.2 * rand() / RAND_MAX);
-  end_color.set(1,1,1,0.8 * rand() / RAND_MAX);
+  init_color.set(1,1,1,0.8 + 0.2 * random::effects().real());
+  end_color.set(1,1,1,0.8 * random::effects().real());
   effect->set_color( init_color, end_color );
 
 #if defined( __ANDROID__ )
@@ -18,10 +18,15 @@
 #include "rp/game_variables.hpp"
 #include "rp/plank.hpp" 
 #include "rp/explosion.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/random.hpp"
+#include "rp/sound_bank.hpp"
 #include "rp/tar.hpp"
 #include "rp/tnt.hpp"
 #include "rp/util.hpp"
 
+#include "engine/level.hpp"
 #include "universe/collision_info.hpp"
 #include "universe/zone.hpp"
 
@@ -70,6 +75,9 @@ void rp::wall::on_enters_layer()
   start_model_action("idle");
   create_interactive_item(*this);
   init(get_top_left());
+
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
 } // rp::wall::on_enters_layer()
 
 /*----------------------------------------------------------------------------*/
@@ -79,7 +87,10 @@ void rp::wall::on_enters_layer()
  */
 void rp::wall::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/wall" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   update_items();
 } // rp::wall::progress()
@@ -121,8 +132,8 @@ void rp::wall::hit
   bear::engine::model_mark_placement step1;
   bear::engine::model_mark_placement step2;
 
-  get_level_globals().play_sound
-    ( "sound/wall/break.ogg",
+  sound_bank::play
+    ( get_level_globals(), sound_bank::wall_break_sample,
       bear::audio::sound_effect( get_center_of_mass() ) );
 
   game_variables::set_action_snapshot();
@@ -144,6 +155,8 @@ void rp::wall::hit
                ( bottom_y < step2.get_position().y ) ) )
           hit(& m_middle_impacts,"middle");
       }
+
+  m_action_score.set( 10 + 10 * impact_count() / 3 );
 } // wall::hit()
 
 unsigned int rp::wall::impact_count() const
@@ -217,11 +230,11 @@ bool rp::wall::collision_with_cart
       game_variables::set_action_snapshot();
       
       if ( ( info.get_collision_side() == bear::universe::zone::top_zone ) &&
-           c->get_current_action_name() != "jump" )
+           c->get_current_action_id() != model_action_id::jump )
         c->jump();
       else if ( info.get_collision_side() != 
                 bear::universe::zone::middle_zone && 
-                c->get_current_action_name() != "dead" )
+                c->get_current_action_id() != model_action_id::dead )
 	{
           c->add_internal_force(bear::universe::force_type(-3000000,2000000));
           c->die_by_wall();
@@ -341,8 +354,8 @@ bool rp::wall::collision_with_tar( bear::engine::base_item& that )
  */
 void rp::wall::explose()
 {
-  get_level_globals().play_sound
-    ( "sound/wall/explose.ogg",
+  sound_bank::play
+    ( get_level_globals(), sound_bank::wall_explose_sample,
       bear::audio::sound_effect( get_center_of_mass() ) );
 
   util::create_floating_score(*this, 1500);
@@ -389,7 +402,11 @@ void rp::wall::create_decorations
 {
   bear::engine::model_mark_placement mark;
   if ( get_mark_placement(name, mark) )
-    for ( unsigned int i = 0; i != nb_decorations; ++i )
+    for ( unsigned int i = 0;
+          ( i != nb_decorations )
+            && population_manager::can_spawn
+            ( population_manager::decoration_debris );
+          ++i )
       {
         bear::decorative_item* p = new bear::decorative_item();
         p->set_z_position( mark.get_depth_position() );
@@ -397,21 +414,23 @@ void rp::wall::create_decorations
         p->set_mass(1);
         
       std::ostringstream stream;
-      stream << "splinter " << 1 + (unsigned int)(4.0 * rand() / RAND_MAX);;
+      stream << "splinter " << 1 + random::effects().integer(4);
         p->set_sprite
           ( get_level_globals().auto_sprite( "gfx/common.png", stream.str() ) );
         
         bear::universe::force_type force;
         if ( right_orientation )
-          force.x = -50000 + 100000 * (double)rand() / RAND_MAX;
+          force.x = -50000 + 100000 * random::effects().real();
         else
-          force.x = - 100000 * (double)rand() / RAND_MAX;
-        force.y = 20000 + 50000 * (double)rand() / RAND_MAX;
+          force.x = - 100000 * random::effects().real();
+        force.y = 20000 + 50000 * random::effects().real();
         p->add_external_force(force);
         
-        const double angular_speed = 1 + 20 * (double)rand() / RAND_MAX;
+        const double angular_speed = 1 + 20 * random::effects().real();
         p->set_angular_speed( angular_speed );
         
         new_item(*p);
+        population_manager::add_decoration
+          ( population_manager::decoration_debris, *p );
       }
 } // wall::create_decorations()
@@ -19,9 +19,11 @@
 #include "rp/game_variables.hpp"
 #include "rp/plank.hpp"
 #include "rp/plunger.hpp"
+#include "rp/profiler.hpp"
 #include "rp/tar.hpp"
 #include "rp/util.hpp"
 
+#include "engine/level.hpp"
 #include "universe/forced_movement/forced_rotation.hpp"
 #include "universe/forced_movement/forced_tracking.hpp"
 #include "universe/collision_info.hpp"
@@ -100,6 +102,9 @@ void rp::zeppelin::on_enters_layer()
 
   start_model_action("idle");
 
+  m_action_score.attach( *this );
+  m_action_score.set( 10 );
+
   if ( m_item != NULL )
     create_item();
 
@@ -113,7 +118,10 @@ void rp::zeppelin::on_enters_layer()
  */
 void rp::zeppelin::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "progress/zeppelin" );
+
   super::progress( elapsed_time );
+  m_action_score.update_camera( get_level().get_camera_focus() );
 
   if ( ! has_forced_movement() && ! game_variables::is_boss_level() && 
        ! game_variables::is_boss_transition() )
@@ -250,6 +258,7 @@ void rp::zeppelin::drop()
       
       m_drop_item->clear_forced_movement();
       m_drop_item = handle_type(NULL);
+      m_action_score.set( 10 );
     }
 } // zeppelin::drop()
 
@@ -417,6 +426,7 @@ void rp::zeppelin::create_item()
   new_item( *item );
 
   m_drop_item = handle_type(item);
+  m_action_score.set( 20 );
 
   bear::universe::forced_tracking mvt
     ( item->get_center_of_mass() - get_center_of_mass() );
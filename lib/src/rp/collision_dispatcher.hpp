@@ -0,0 +1,131 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A table of collision handlers indexed by the type of the other item.
+ * \author Julien Jorge
+ */
+#ifndef __RP_COLLISION_DISPATCHER_HPP__
+#define __RP_COLLISION_DISPATCHER_HPP__
+
+#include "rp/item_type.hpp"
+
+#include "universe/collision_info.hpp"
+
+#include <array>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief Statistics about the collisions dispatched by the
+   *        collision_dispatcher instances.
+   * \author Julien Jorge
+   */
+  class collision_dispatcher_statistics
+  {
+  public:
+    static void add_dispatch();
+    static std::size_t get_dispatch_count();
+    static void reset();
+
+  private:
+    /** \brief The number of collisions dispatched since the last reset. */
+    static std::size_t s_dispatch_count;
+
+  }; // class collision_dispatcher_statistics
+
+  /**
+   * \brief The handlers of the collisions of all the dispatchers, indexed by
+   *        the dispatcher receiving the collision and by the type of the other
+   *        item.
+   * \author Julien Jorge
+   */
+  class collision_table
+  {
+  public:
+    /** \brief A handler, called with the item receiving the collision. */
+    typedef bool (*handler)
+    ( bear::engine::base_item& self, bear::engine::base_item& that,
+      bear::universe::collision_info& info );
+
+  private:
+    /** \brief The handlers of a dispatcher, by type of the other item. */
+    typedef std::array<handler, item_type::count> row;
+
+  public:
+    static std::size_t add_row();
+    static void set( std::size_t self, item_type::value_type that, handler h );
+
+    static bool dispatch
+    ( std::size_t self, bear::engine::base_item& item,
+      bear::engine::base_item& that, bear::universe::collision_info& info );
+
+  private:
+    /** \brief The handlers, by dispatcher then by type of the other item. */
+    static std::vector<row> s_handlers;
+
+  }; // class collision_table
+
+  /**
+   * \brief The collision handlers of a class, indexed by the type of the other
+   *        item.
+   *
+   * Each dispatcher owns a row of the collision_table, thus the handler of a
+   * collision is found with the row of the dispatcher and the type of the
+   * other item. The handlers are given as template arguments, such that the
+   * functions stored in the table call them without a cast.
+   *
+   * \author Julien Jorge
+   */
+  template<typename Self>
+  class collision_dispatcher
+  {
+  public:
+    /** \brief A handler receiving only the other item. */
+    typedef bool (Self::*item_handler)( bear::engine::base_item& );
+
+    /** \brief A handler receiving the other item and the collision info. */
+    typedef bool (Self::*info_handler)
+    ( bear::engine::base_item&, bear::universe::collision_info& );
+
+  public:
+    collision_dispatcher();
+
+    template<item_handler Handler>
+    void add( item_type::value_type t );
+    template<info_handler Handler>
+    void add( item_type::value_type t );
+
+    bool dispatch
+    ( Self& self, bear::engine::base_item& that,
+      bear::universe::collision_info& info ) const;
+
+  private:
+    template<item_handler Handler>
+    static bool call_item_handler
+    ( bear::engine::base_item& self, bear::engine::base_item& that,
+      bear::universe::collision_info& info );
+
+    template<info_handler Handler>
+    static bool call_info_handler
+    ( bear::engine::base_item& self, bear::engine::base_item& that,
+      bear::universe::collision_info& info );
+
+  private:
+    /** \brief The row of the handlers of this dispatcher in the collision
+        table. */
+    std::size_t m_row;
+
+  }; // class collision_dispatcher
+} // namespace rp
+
+#include "rp/impl/collision_dispatcher.tpp"
+
+#endif // __RP_COLLISION_DISPATCHER_HPP__
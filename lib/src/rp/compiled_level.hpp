@@ -0,0 +1,152 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A level compiled in the binary format, read from a file mapped in
+ *        memory.
+ * \author Julien Jorge
+ */
+#ifndef __RP_COMPILED_LEVEL_HPP__
+#define __RP_COMPILED_LEVEL_HPP__
+
+#include "rp/mapped_file.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief A level compiled in the binary format, read from a file mapped in
+   *        memory.
+   *
+   * The binary format contains the same sequence of values as the text
+   * format of the compiled levels (the .cl files), where each value is on its
+   * own line. The values are typed when the level is converted, such that
+   * they are not parsed again when the level is loaded:
+   *
+   * - the header: the magic "RPCL", the version of the format, then the count
+   *   of values, of strings and of items, and the size of the characters of
+   *   the strings,
+   * - the table of the strings: for each distinct string, its offset in the
+   *   characters and its length, then the characters,
+   * - the kind of each value, on one byte: integer, real or string,
+   * - the values, on eight bytes: a signed integer, a real, or the index of a
+   *   string in the table,
+   * - the index of the items: the index of the first value of each item
+   *   definition.
+   *
+   * The integers are stored in little endian and each section begins at a
+   * multiple of eight bytes. The values are read with the same operators as
+   * the text format, converting the value to the type requested by the
+   * reader.
+   *
+   * \author Julien Jorge
+   */
+  class compiled_level
+  {
+  public:
+    /** \brief The kinds of the values. */
+    enum value_kind
+      {
+        /** \brief A signed integer. */
+        integer_value = 0,
+
+        /** \brief A real number. */
+        real_value = 1,
+
+        /** \brief A string, stored in the table of the strings. */
+        string_value = 2
+
+      }; // enum value_kind
+
+  public:
+    explicit compiled_level( const std::string& file_name );
+    compiled_level( const compiled_level& ) = delete;
+    compiled_level& operator=( const compiled_level& ) = delete;
+
+    bool is_open() const;
+
+    std::size_t get_value_count() const;
+    std::size_t get_string_count() const;
+    std::size_t get_item_count() const;
+
+    std::string get_string( std::size_t i ) const;
+    value_kind get_kind( std::size_t i ) const;
+
+    void seek_item( std::size_t i );
+    std::size_t get_position() const;
+
+    compiled_level& operator>>( std::string& v );
+    compiled_level& operator>>( int& v );
+    compiled_level& operator>>( unsigned int& v );
+    compiled_level& operator>>( double& v );
+    compiled_level& operator>>( bool& v );
+
+    operator bool() const;
+
+    static std::string format_real( double v );
+
+  private:
+    bool read_header();
+    bool next_value( std::size_t& i );
+
+    int64_t get_integer( std::size_t i ) const;
+    bool get_integer_value( std::size_t i, int64_t& v ) const;
+    double get_real( std::size_t i ) const;
+
+    static uint32_t read_uint32( const char* p );
+    static uint64_t read_uint64( const char* p );
+
+  public:
+    /** \brief The first bytes of the files. */
+    static const char s_magic[4];
+
+    /** \brief The version of the format. */
+    static const uint32_t s_version;
+
+  private:
+    /** \brief The file containing the level. */
+    const mapped_file m_file;
+
+    /** \brief The count of values. */
+    std::size_t m_value_count;
+
+    /** \brief The count of strings in the table. */
+    std::size_t m_string_count;
+
+    /** \brief The count of items in the index. */
+    std::size_t m_item_count;
+
+    /** \brief The offsets and the lengths of the strings. */
+    const char* m_strings;
+
+    /** \brief The characters of the strings. */
+    const char* m_characters;
+
+    /** \brief The kinds of the values. */
+    const char* m_kinds;
+
+    /** \brief The values. */
+    const char* m_values;
+
+    /** \brief The index of the first value of each item. */
+    const char* m_items;
+
+    /** \brief The index of the next value to read. */
+    std::size_t m_position;
+
+    /** \brief Tells if the file is valid and if all the values have been
+        read successfully. */
+    bool m_good;
+
+  }; // class compiled_level
+} // namespace rp
+
+#endif // __RP_COMPILED_LEVEL_HPP__
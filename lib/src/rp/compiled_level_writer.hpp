@@ -0,0 +1,95 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A converter of the compiled levels from the text format to the
+ *        binary format.
+ * \author Julien Jorge
+ */
+#ifndef __RP_COMPILED_LEVEL_WRITER_HPP__
+#define __RP_COMPILED_LEVEL_WRITER_HPP__
+
+#include "rp/compiled_level.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A converter of the compiled levels from the text format to the
+   *        binary format.
+   *
+   * Each line of the text format is a value. A value is stored as an integer
+   * or as a real number if its text is the one that would be written for the
+   * number, such that the text can be found again when the value is read as a
+   * string. The other values are stored in a table of strings, once per
+   * distinct string.
+   *
+   * The items are found with the codes of the definitions in the level: 32
+   * followed by the name of the class of the item, or 31 followed by the
+   * fixed flag and the first field of an item declared in the header of the
+   * level.
+   *
+   * \author Julien Jorge
+   */
+  class compiled_level_writer
+  {
+  public:
+    compiled_level_writer();
+
+    bool read_text( std::istream& is );
+    void write( std::ostream& os ) const;
+
+    std::size_t get_value_count() const;
+    std::size_t get_string_count() const;
+    std::size_t get_item_count() const;
+    std::size_t get_declared_item_count() const;
+
+    compiled_level::value_kind get_kind( std::size_t i ) const;
+
+  private:
+    void add_value( const std::string& text );
+    void index_items();
+
+    bool is_integer( std::size_t i, int64_t v ) const;
+    bool is_class_name( std::size_t i ) const;
+    bool is_field_name( std::size_t i ) const;
+
+    static bool parse_integer( const std::string& text, int64_t& v );
+    static bool parse_real( const std::string& text, double& v );
+
+    static void write_uint32( std::ostream& os, uint32_t value );
+    static void write_uint64( std::ostream& os, uint64_t value );
+    static void write_padding( std::ostream& os, std::size_t size );
+
+  private:
+    /** \brief The kind of each value. */
+    std::vector<char> m_kinds;
+
+    /** \brief The values: the integers, the bits of the reals or the indices
+        of the strings. */
+    std::vector<uint64_t> m_values;
+
+    /** \brief The distinct strings. */
+    std::vector<std::string> m_strings;
+
+    /** \brief The index of each string in m_strings. */
+    std::unordered_map<std::string, std::size_t> m_string_index;
+
+    /** \brief The index of the first value of each item. */
+    std::vector<uint32_t> m_items;
+
+  }; // class compiled_level_writer
+} // namespace rp
+
+#endif // __RP_COMPILED_LEVEL_WRITER_HPP__
@@ -14,6 +14,7 @@
 #ifndef __RP_CRATE_HPP__
 #define __RP_CRATE_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/obstacle.hpp"
 #include "engine/export.hpp"
 
@@ -41,6 +42,7 @@ namespace rp
 
     void pre_cache();
     void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
     
     void collision
     ( bear::engine::base_item& that, bear::universe::collision_info& info );
@@ -52,6 +54,10 @@ namespace rp
     bool collision_with_explosion
     (bear::engine::base_item& that, bear::universe::collision_info& info );
     void explose(bool give_score = true);
+
+  private:
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class crate
 } // namespace rp
 
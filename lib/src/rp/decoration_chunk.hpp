@@ -0,0 +1,87 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item rendering a group of static decorations baked together.
+ * \author Julien Jorge
+ */
+#ifndef __RP_DECORATION_CHUNK_HPP__
+#define __RP_DECORATION_CHUNK_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "visual/sprite.hpp"
+
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief An item rendering a group of static decorations baked together.
+   *
+   * The chunks are created by the decoration baker (tools/decoration-baker)
+   * in place of consecutive bear::decorative_item of a decoration layer,
+   * which have a sprite and no other field than their position. The item
+   * covers the decorations of the chunk, thus the layer asks for its visuals
+   * only when the chunk is visible, and the sprites are rendered in the order
+   * of the decorations they replace.
+   *
+   * The valid fields for this item are
+   *  - decoration_chunk.sprites: (list of sprite) the sprites of the
+   *    decorations,
+   *  - decoration_chunk.left: (list of real) the distance from the left of
+   *    the chunk to the left of each sprite,
+   *  - decoration_chunk.bottom: (list of real) the distance from the bottom
+   *    of the chunk to the bottom of each sprite,
+   *  - decoration_chunk.depth: (list of integer) the depth of each sprite,
+   *  - any field supported by the parent classes.
+   *
+   * \author Julien Jorge
+   */
+  class decoration_chunk:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( decoration_chunk );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+  public:
+    decoration_chunk();
+
+    bool set_sprite_list_field
+    ( const std::string& name, const std::vector<bear::visual::sprite>& value );
+    bool set_real_list_field
+    ( const std::string& name, const std::vector<double>& value );
+    bool set_integer_list_field
+    ( const std::string& name, const std::vector<int>& value );
+    bool is_valid() const;
+
+    void get_visual( std::list<bear::engine::scene_visual>& visuals ) const;
+
+  private:
+    /** \brief The sprites of the decorations. */
+    std::vector<bear::visual::sprite> m_sprites;
+
+    /** \brief The distance from the left of the chunk to the left of each
+        sprite. */
+    std::vector<double> m_left;
+
+    /** \brief The distance from the bottom of the chunk to the bottom of each
+        sprite. */
+    std::vector<double> m_bottom;
+
+    /** \brief The depth of each sprite. */
+    std::vector<int> m_depth;
+
+  }; // class decoration_chunk
+} // namespace rp
+
+#endif // __RP_DECORATION_CHUNK_HPP__
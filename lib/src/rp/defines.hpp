@@ -38,9 +38,13 @@
 /** \brief The default orange color, used in gui layers. */
 #define RP_ORANGE_PIXEL bear::visual::color_type(254, 160, 0, 255)
 
-/** \brief The filename for player save. */
+/** \brief The filename for player save, in the text format used by the
+    previous versions. */
 #define RP_SAVE_FILENAME "game-variables.sav"
 
+/** \brief The filename for player save, in the binary format. */
+#define RP_BINARY_SAVE_FILENAME "game-variables.bin"
+
 /** \brief The name of the file containing the key of the game. */
 #define RP_KEY_FILE_NAME "key.txt"
 
@@ -0,0 +1,87 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A writing that displays an integer, built from the glyphs of the
+ *        digits without laying out the text.
+ * \author Julien Jorge
+ */
+#ifndef __RP_DIGIT_WRITING_HPP__
+#define __RP_DIGIT_WRITING_HPP__
+
+#include "visual/font/font.hpp"
+#include "visual/scene_element_sequence.hpp"
+#include "visual/sprite.hpp"
+
+#include <array>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A writing that displays an integer, built from the glyphs of the
+   *        digits without laying out the text.
+   *
+   * The sprites and the metrics of the digits and of the minus sign are taken
+   * from the font once, at the construction. Changing the value only computes
+   * the indices of the glyphs, in a buffer reused between the updates.
+   *
+   * \author Julien Jorge
+   */
+  class digit_writing
+  {
+  private:
+    /** \brief A glyph of the writing. */
+    struct glyph
+    {
+      /** \brief The sprite of the glyph. */
+      bear::visual::sprite sprite;
+
+      /** \brief The position of the sprite relatively to the pen. */
+      bear::visual::position_type bearing;
+
+      /** \brief The horizontal advance of the pen after the glyph. */
+      bear::visual::coordinate_type advance;
+
+    }; // struct glyph
+
+    /** \brief The index of the minus sign in the glyphs. */
+    static const std::size_t s_minus_index = 10;
+
+  public:
+    digit_writing();
+    explicit digit_writing( const bear::visual::font& f );
+
+    void set_value( int value );
+    void clear();
+
+    bear::visual::size_type get_width() const;
+    bear::visual::size_type get_height() const;
+
+    bear::visual::scene_element_sequence get_scene_element
+    ( bear::visual::coordinate_type x, bear::visual::coordinate_type y,
+      double scale = 1 ) const;
+
+  private:
+    /** \brief The glyphs of the digits, then of the minus sign. */
+    std::array<glyph, s_minus_index + 1> m_glyphs;
+
+    /** \brief The indices of the glyphs of the displayed value. */
+    std::vector<std::size_t> m_text;
+
+    /** \brief The width of the displayed value. */
+    bear::visual::size_type m_width;
+
+    /** \brief The height of a line of the font. */
+    bear::visual::size_type m_height;
+
+  }; // class digit_writing
+} // namespace rp
+
+#endif // __RP_DIGIT_WRITING_HPP__
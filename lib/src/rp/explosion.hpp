@@ -14,6 +14,7 @@
 #ifndef __RP_EXPLOSION_HPP__
 #define __RP_EXPLOSION_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/entity.hpp"
 
 #include "engine/base_item.hpp"
@@ -44,6 +45,9 @@ namespace rp
     explosion
     (unsigned int nb_explosions, bear::universe::coordinate_type radius,
      double duration, bool decoration = false);
+
+    static void* operator new( std::size_t size );
+    static void operator delete( void* p, std::size_t size );
     
     void pre_cache();
     void on_enters_layer();
@@ -80,6 +84,9 @@ namespace rp
     /** \brief The duration of the exlosion. */
     double m_explosion_duration;
 
+    /** \brief The contribution of the item to the score of the action,
+        counted once for all the explosions in the scene. */
+    action_score m_action_score;
   }; // class explosion
 } // namespace rp
 
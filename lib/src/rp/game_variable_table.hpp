@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A table of typed slots mirroring some game variables.
+ * \author Julien Jorge
+ */
+#ifndef __RP_GAME_VARIABLE_TABLE_HPP__
+#define __RP_GAME_VARIABLE_TABLE_HPP__
+
+#include <boost/function.hpp>
+#include <boost/signals2/connection.hpp>
+#include <boost/signals2/signal.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rp
+{
+  class game_variable_table;
+  class save_snapshot;
+
+  /**
+   * \brief The handle of a slot in the game_variable_table.
+   * \author Julien Jorge
+   */
+  template<typename T>
+  class game_variable_slot
+  {
+    friend class game_variable_table;
+
+  public:
+    game_variable_slot();
+
+    bool is_valid() const;
+
+  private:
+    explicit game_variable_slot( std::size_t index );
+
+  private:
+    /** \brief The index of the slot in the storage of its type. */
+    std::size_t m_index;
+
+  }; // class game_variable_slot
+
+  /**
+   * \brief A table of typed slots mirroring some game variables.
+   *
+   * Each slot is declared once with the name of the game variable it mirrors
+   * and is then accessed with an integer handle. The values are kept in sync
+   * with the variables of the engine, thus the persistent variables are still
+   * saved and loaded by util::save_game_variables() and
+   * util::load_game_variables(), and the signals of the engine are still
+   * emitted on changes. The persistent slots modified since the last save are
+   * marked as dirty, such that only them are copied for the next save.
+   *
+   * \author Julien Jorge
+   */
+  class game_variable_table
+  {
+  private:
+    /**
+     * \brief The data associated with a slot.
+     */
+    template<typename T>
+    struct entry
+    {
+      /** \brief The type of the signal emitted when the value changes. */
+      typedef boost::signals2::signal<void (T)> signal_type;
+
+      /** \brief The name of the game variable. */
+      std::string name;
+
+      /** \brief The value of the variable. */
+      T value;
+
+      /** \brief The value of the variable when it is not set in the engine. */
+      T default_value;
+
+      /** \brief The connection to the change signal of the engine. */
+      boost::signals2::connection engine_connection;
+
+      /** \brief The signal emitted when the value changes. */
+      std::shared_ptr<signal_type> changed;
+
+      /** \brief Tells if the variable is saved in the save file. */
+      bool persistent;
+
+      /** \brief Tells if the variable is persistent and has changed since
+          the last save. */
+      bool dirty;
+
+    }; // struct entry
+
+    /** \brief The storage of the slots of a given type. */
+    template<typename T>
+    struct storage
+    {
+      /** \brief The slots. */
+      std::vector< entry<T> > entries;
+
+      /** \brief The index of the slots, by name of variable. */
+      std::unordered_map<std::string, std::size_t> index;
+
+      /** \brief The indices of the dirty slots. */
+      std::vector<std::size_t> dirty;
+
+    }; // struct storage
+
+  public:
+    static game_variable_table& get_instance();
+
+    template<typename T>
+    game_variable_slot<T>
+    declare( const std::string& name, const T& default_value );
+
+    template<typename T>
+    const T& get( game_variable_slot<T> slot ) const;
+
+    template<typename T>
+    void set( game_variable_slot<T> slot, const T& value );
+
+    template<typename T>
+    const std::string& get_name( game_variable_slot<T> slot ) const;
+
+    template<typename T>
+    boost::signals2::connection listen
+    ( game_variable_slot<T> slot, const boost::function<void (T)>& f );
+
+    void refresh();
+
+    void collect_dirty_persistent( save_snapshot& s );
+    void clear_dirty();
+
+  private:
+    game_variable_table();
+    game_variable_table( const game_variable_table& that );
+    ~game_variable_table();
+
+    template<typename T>
+    void on_engine_change( std::size_t index, T value );
+
+    template<typename T>
+    void assign( storage<T>& s, std::size_t index, const T& value );
+
+    template<typename T>
+    static void set_dirty( storage<T>& s, std::size_t index );
+
+    template<typename T>
+    void refresh( storage<T>& s );
+
+    template<typename T>
+    static void collect_dirty( storage<T>& s, save_snapshot& snapshot );
+
+    template<typename T>
+    static void clear_dirty( storage<T>& s );
+
+    template<typename T>
+    static void disconnect( storage<T>& s );
+
+    template<typename T>
+    storage<T>& get_storage();
+
+    template<typename T>
+    const storage<T>& get_storage() const;
+
+    template<typename T>
+    static bool read_engine( const std::string& name, T& value );
+
+    template<typename T>
+    static void write_engine( const std::string& name, const T& value );
+
+    static boost::signals2::connection listen_engine
+    ( const std::string& name, const boost::function<void (bool)>& f );
+    static boost::signals2::connection listen_engine
+    ( const std::string& name, const boost::function<void (int)>& f );
+    static boost::signals2::connection listen_engine
+    ( const std::string& name, const boost::function<void (unsigned int)>& f );
+    static boost::signals2::connection listen_engine
+    ( const std::string& name, const boost::function<void (double)>& f );
+    static boost::signals2::connection listen_engine
+    ( const std::string& name,
+      const boost::function<void (std::string)>& f );
+
+  private:
+    /** \brief The slots of boolean variables. */
+    storage<bool> m_bool;
+
+    /** \brief The slots of signed integer variables. */
+    storage<int> m_int;
+
+    /** \brief The slots of unsigned integer variables. */
+    storage<unsigned int> m_uint;
+
+    /** \brief The slots of real variables. */
+    storage<double> m_double;
+
+    /** \brief The slots of string variables. */
+    storage<std::string> m_string;
+
+  }; // class game_variable_table
+} // namespace rp
+
+#include "rp/impl/game_variable_table.tpp"
+
+#endif // __RP_GAME_VARIABLE_TABLE_HPP__
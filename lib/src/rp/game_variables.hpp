@@ -14,6 +14,9 @@
 #ifndef __RP_GAME_VARIABLES_HPP__
 #define __RP_GAME_VARIABLES_HPP__
 
+#include <boost/function.hpp>
+#include <boost/signals2/connection.hpp>
+
 #include <string>
 
 namespace rp
@@ -140,6 +143,9 @@ namespace rp
     static unsigned int get_persistent_score
     (unsigned int serial, unsigned int number);
     static void set_persistent_score( unsigned int c );
+    static boost::signals2::connection listen_persistent_score
+    ( unsigned int serial, unsigned int number,
+      const boost::function<void (unsigned int)>& f );
     static unsigned int get_score();
     static void set_score( unsigned int c );
     static void add_score
@@ -157,6 +163,9 @@ namespace rp
     ( unsigned int serial, unsigned int number );
     static void set_level_state
     ( unsigned int serial, unsigned int number, unsigned int level_state );
+    static boost::signals2::connection listen_level_state
+    ( unsigned int serial, unsigned int number,
+      const boost::function<void (unsigned int)>& f );
     
     // medals
     static unsigned int get_last_medal();
@@ -226,6 +235,20 @@ namespace rp
 
     static void schedule_interstitial( bool b );
     static bool interstitial_scheduled();
+
+    // benchmark
+    static std::string get_benchmark_input();
+    static std::string get_benchmark_output();
+    static unsigned int get_benchmark_frames();
+
+    // screenshot sequence
+    static std::string get_capture_format();
+    static unsigned int get_capture_threads();
+
+    // population of the levels
+    static bool get_population_census();
+    static unsigned int get_decoration_budget
+    ( const std::string& category, unsigned int default_value );
     
     // persistent utilities
     static std::string make_persistent_variable_name( const std::string& n );
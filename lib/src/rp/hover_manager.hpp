@@ -0,0 +1,100 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that activates the interactive items under the cursor.
+ * \author Julien Jorge
+ */
+#ifndef __RP_HOVER_MANAGER_HPP__
+#define __RP_HOVER_MANAGER_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "universe/derived_item_handle.hpp"
+
+#include <vector>
+
+namespace rp
+{
+  class cursor;
+  class interactive_item;
+
+  /**
+   * \brief An item that activates the interactive items under the cursor.
+   *
+   * The interactive items register themselves in the manager of the level.
+   * At each iteration, the manager tests the box of the cursor against the
+   * items, then activates or deactivates the items whose state has changed.
+   * There is a single query per iteration, thus the items are tested
+   * directly instead of being placed in a spatial structure. The state of
+   * the weapons, which tells which stars are displayed on the activated
+   * items, is also read once here for all the items.
+   *
+   * \author Julien Jorge
+   */
+  class hover_manager:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( hover_manager );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+  private:
+    /** \brief The type of the handles on the interactive items. */
+    typedef bear::universe::derived_item_handle<interactive_item> item_handle;
+
+    /** \brief The type of the handle on the cursor. */
+    typedef bear::universe::derived_item_handle<cursor> cursor_handle;
+
+  public:
+    hover_manager();
+    ~hover_manager();
+
+    static hover_manager* get_instance();
+
+    void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
+
+    void add_item( interactive_item& item );
+
+    bool is_cannonball_ready() const;
+    bool is_plunger_ready() const;
+
+  private:
+    void find_cursor();
+    void update_weapons();
+    void remove_dead_items();
+    void find_hovered_items();
+    void update_items();
+
+  private:
+    /** \brief The interactive items of the level. */
+    std::vector<item_handle> m_items;
+
+    /** \brief Tells for each item if it is under the cursor. */
+    std::vector<bool> m_hovered;
+
+    /** \brief The cursor activating the items. */
+    cursor_handle m_cursor;
+
+    /** \brief Tells if the cannon is activated and can fire. */
+    bool m_cannonball_ready;
+
+    /** \brief Tells if the plunger is activated and can be thrown. */
+    bool m_plunger_ready;
+
+    /** \brief The manager of the current level. */
+    static hover_manager* s_instance;
+
+  }; // class hover_manager
+} // namespace rp
+
+#endif // __RP_HOVER_MANAGER_HPP__
@@ -0,0 +1,96 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::collision_dispatcher class.
+ * \author Julien Jorge
+ */
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+template<typename Self>
+rp::collision_dispatcher<Self>::collision_dispatcher()
+  : m_row( collision_table::add_row() )
+{
+
+} // collision_dispatcher::collision_dispatcher()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a handler receiving only the other item.
+ * \param t The type of the other item.
+ */
+template<typename Self>
+template<typename rp::collision_dispatcher<Self>::item_handler Handler>
+void rp::collision_dispatcher<Self>::add( item_type::value_type t )
+{
+  collision_table::set( m_row, t, &call_item_handler<Handler> );
+} // collision_dispatcher::add()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a handler receiving the collision info.
+ * \param t The type of the other item.
+ */
+template<typename Self>
+template<typename rp::collision_dispatcher<Self>::info_handler Handler>
+void rp::collision_dispatcher<Self>::add( item_type::value_type t )
+{
+  collision_table::set( m_row, t, &call_info_handler<Handler> );
+} // collision_dispatcher::add()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Call the handler associated with the type of the other item.
+ * \param self The item receiving the collision.
+ * \param that The other item.
+ * \param info Some informations about the collision.
+ * \return true if a handler has been called.
+ */
+template<typename Self>
+bool rp::collision_dispatcher<Self>::dispatch
+( Self& self, bear::engine::base_item& that,
+  bear::universe::collision_info& info ) const
+{
+  return collision_table::dispatch( m_row, self, that, info );
+} // collision_dispatcher::dispatch()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Call a handler receiving only the other item.
+ * \param self The item receiving the collision, an instance of Self.
+ * \param that The other item.
+ * \param info Some informations about the collision.
+ */
+template<typename Self>
+template<typename rp::collision_dispatcher<Self>::item_handler Handler>
+bool rp::collision_dispatcher<Self>::call_item_handler
+( bear::engine::base_item& self, bear::engine::base_item& that,
+  bear::universe::collision_info& info )
+{
+  return ( static_cast<Self&>( self ).*Handler )( that );
+} // collision_dispatcher::call_item_handler()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Call a handler receiving the collision info.
+ * \param self The item receiving the collision, an instance of Self.
+ * \param that The other item.
+ * \param info Some informations about the collision.
+ */
+template<typename Self>
+template<typename rp::collision_dispatcher<Self>::info_handler Handler>
+bool rp::collision_dispatcher<Self>::call_info_handler
+( bear::engine::base_item& self, bear::engine::base_item& that,
+  bear::universe::collision_info& info )
+{
+  return ( static_cast<Self&>( self ).*Handler )( that, info );
+} // collision_dispatcher::call_info_handler()
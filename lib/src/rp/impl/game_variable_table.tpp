@@ -0,0 +1,403 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the template methods of the
+ *        rp::game_variable_table class.
+ * \author Julien Jorge
+ */
+
+#include "rp/defines.hpp"
+#include "rp/save_snapshot.hpp"
+
+#include <boost/bind.hpp>
+
+#include <cassert>
+#include <limits>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the boolean slots.
+ */
+template<>
+inline rp::game_variable_table::storage<bool>&
+rp::game_variable_table::get_storage<bool>()
+{
+  return m_bool;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the boolean slots.
+ */
+template<>
+inline const rp::game_variable_table::storage<bool>&
+rp::game_variable_table::get_storage<bool>() const
+{
+  return m_bool;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the signed integer slots.
+ */
+template<>
+inline rp::game_variable_table::storage<int>&
+rp::game_variable_table::get_storage<int>()
+{
+  return m_int;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the signed integer slots.
+ */
+template<>
+inline const rp::game_variable_table::storage<int>&
+rp::game_variable_table::get_storage<int>() const
+{
+  return m_int;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the unsigned integer slots.
+ */
+template<>
+inline rp::game_variable_table::storage<unsigned int>&
+rp::game_variable_table::get_storage<unsigned int>()
+{
+  return m_uint;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the unsigned integer slots.
+ */
+template<>
+inline const rp::game_variable_table::storage<unsigned int>&
+rp::game_variable_table::get_storage<unsigned int>() const
+{
+  return m_uint;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the real slots.
+ */
+template<>
+inline rp::game_variable_table::storage<double>&
+rp::game_variable_table::get_storage<double>()
+{
+  return m_double;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the real slots.
+ */
+template<>
+inline const rp::game_variable_table::storage<double>&
+rp::game_variable_table::get_storage<double>() const
+{
+  return m_double;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the string slots.
+ */
+template<>
+inline rp::game_variable_table::storage<std::string>&
+rp::game_variable_table::get_storage<std::string>()
+{
+  return m_string;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the storage of the string slots.
+ */
+template<>
+inline const rp::game_variable_table::storage<std::string>&
+rp::game_variable_table::get_storage<std::string>() const
+{
+  return m_string;
+} // game_variable_table::get_storage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs an invalid slot.
+ */
+template<typename T>
+rp::game_variable_slot<T>::game_variable_slot()
+  : m_index( std::numeric_limits<std::size_t>::max() )
+{
+
+} // game_variable_slot::game_variable_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructs a slot.
+ * \param index The index of the slot in the storage of its type.
+ */
+template<typename T>
+rp::game_variable_slot<T>::game_variable_slot( std::size_t index )
+  : m_index( index )
+{
+
+} // game_variable_slot::game_variable_slot()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the slot has been declared in the table.
+ */
+template<typename T>
+bool rp::game_variable_slot<T>::is_valid() const
+{
+  return m_index != std::numeric_limits<std::size_t>::max();
+} // game_variable_slot::is_valid()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Declare a slot for a given game variable. If the variable is already
+ *        declared, the existing slot is returned.
+ * \param name The name of the game variable.
+ * \param default_value The value of the slot when the variable is not set.
+ */
+template<typename T>
+rp::game_variable_slot<T> rp::game_variable_table::declare
+( const std::string& name, const T& default_value )
+{
+  storage<T>& s( get_storage<T>() );
+  const auto it( s.index.find( name ) );
+
+  if ( it != s.index.end() )
+    return game_variable_slot<T>( it->second );
+
+  const std::size_t index( s.entries.size() );
+
+  s.entries.push_back( entry<T>() );
+  s.index[ name ] = index;
+
+  entry<T>& e( s.entries.back() );
+  e.name = name;
+  e.default_value = default_value;
+  e.changed.reset( new typename entry<T>::signal_type );
+  e.persistent =
+    ( name.compare
+      ( 0, sizeof( RP_PERSISTENT_PREFIX ) - 1, RP_PERSISTENT_PREFIX ) == 0 );
+  e.dirty = false;
+
+  // The variable may have been modified in the engine before being declared.
+  if ( !read_engine( name, e.value ) )
+    e.value = default_value;
+  else
+    set_dirty( s, index );
+
+  e.engine_connection =
+    listen_engine
+    ( name,
+      boost::function<void (T)>
+      ( boost::bind
+        ( &game_variable_table::on_engine_change<T>, this, index, _1 ) ) );
+
+  return game_variable_slot<T>( index );
+} // game_variable_table::declare()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the value of a slot.
+ * \param slot The slot to read.
+ */
+template<typename T>
+const T& rp::game_variable_table::get( game_variable_slot<T> slot ) const
+{
+  const storage<T>& s( get_storage<T>() );
+  assert( slot.m_index < s.entries.size() );
+
+  return s.entries[ slot.m_index ].value;
+} // game_variable_table::get()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the value of a slot and of the game variable it mirrors.
+ * \param slot The slot to write.
+ * \param value The new value.
+ */
+template<typename T>
+void rp::game_variable_table::set
+( game_variable_slot<T> slot, const T& value )
+{
+  storage<T>& s( get_storage<T>() );
+  assert( slot.m_index < s.entries.size() );
+
+  // The engine notifies its listeners, which may read the slot, thus the value
+  // must be up to date before. The listeners may also declare new slots, thus
+  // the name is copied before the assignment.
+  const std::string name( s.entries[ slot.m_index ].name );
+
+  assign( s, slot.m_index, value );
+  write_engine( name, value );
+} // game_variable_table::set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the name of the game variable mirrored by a slot.
+ * \param slot The slot.
+ */
+template<typename T>
+const std::string&
+rp::game_variable_table::get_name( game_variable_slot<T> slot ) const
+{
+  const storage<T>& s( get_storage<T>() );
+  assert( slot.m_index < s.entries.size() );
+
+  return s.entries[ slot.m_index ].name;
+} // game_variable_table::get_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Listen to the changes of the value of a slot.
+ * \param slot The slot to listen to.
+ * \param f The function called with the new value.
+ */
+template<typename T>
+boost::signals2::connection rp::game_variable_table::listen
+( game_variable_slot<T> slot, const boost::function<void (T)>& f )
+{
+  storage<T>& s( get_storage<T>() );
+  assert( slot.m_index < s.entries.size() );
+
+  return s.entries[ slot.m_index ].changed->connect( f );
+} // game_variable_table::listen()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Update a slot when the game variable changes in the engine.
+ * \param index The index of the slot.
+ * \param value The new value of the variable.
+ */
+template<typename T>
+void rp::game_variable_table::on_engine_change( std::size_t index, T value )
+{
+  storage<T>& s( get_storage<T>() );
+  assert( index < s.entries.size() );
+
+  assign( s, index, value );
+} // game_variable_table::on_engine_change()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Assign the value of an entry and notify the listeners if it changed.
+ * \param s The storage of the entry.
+ * \param index The index of the entry in the storage.
+ * \param value The new value.
+ */
+template<typename T>
+void rp::game_variable_table::assign
+( storage<T>& s, std::size_t index, const T& value )
+{
+  entry<T>& e( s.entries[ index ] );
+
+  if ( e.value == value )
+    return;
+
+  e.value = value;
+  set_dirty( s, index );
+
+  (*e.changed)( value );
+} // game_variable_table::assign()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mark an entry as modified since the last save, if it is persistent.
+ * \param s The storage of the entry.
+ * \param index The index of the entry in the storage.
+ */
+template<typename T>
+void rp::game_variable_table::set_dirty( storage<T>& s, std::size_t index )
+{
+  entry<T>& e( s.entries[ index ] );
+
+  if ( !e.persistent || e.dirty )
+    return;
+
+  e.dirty = true;
+  s.dirty.push_back( index );
+} // game_variable_table::set_dirty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read again the values of the slots of a given type from the engine.
+ * \param s The slots to update.
+ */
+template<typename T>
+void rp::game_variable_table::refresh( storage<T>& s )
+{
+  // A listener may declare a new variable, which moves the entries. Thus they
+  // are accessed by index.
+  for ( std::size_t i(0); i != s.entries.size(); ++i )
+    {
+      T value;
+
+      if ( read_engine( s.entries[i].name, value ) )
+        assign( s, i, value );
+      else
+        assign( s, i, s.entries[i].default_value );
+    }
+} // game_variable_table::refresh()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the dirty entries of a given type in a snapshot and mark them as
+ *        saved.
+ * \param s The entries to copy.
+ * \param snapshot The snapshot receiving the values.
+ */
+template<typename T>
+void rp::game_variable_table::collect_dirty
+( storage<T>& s, save_snapshot& snapshot )
+{
+  for ( const std::size_t i : s.dirty )
+    {
+      entry<T>& e( s.entries[i] );
+
+      snapshot.set( e.name, e.value );
+      e.dirty = false;
+    }
+
+  s.dirty.clear();
+} // game_variable_table::collect_dirty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Mark the entries of a given type as saved.
+ * \param s The entries to update.
+ */
+template<typename T>
+void rp::game_variable_table::clear_dirty( storage<T>& s )
+{
+  for ( const std::size_t i : s.dirty )
+    s.entries[i].dirty = false;
+
+  s.dirty.clear();
+} // game_variable_table::clear_dirty()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Disconnect the slots of a given type from the engine.
+ * \param s The slots to disconnect.
+ */
+template<typename T>
+void rp::game_variable_table::disconnect( storage<T>& s )
+{
+  for ( entry<T>& e : s.entries )
+    e.engine_connection.disconnect();
+} // game_variable_table::disconnect()
@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::indexed_model class.
+ * \author Julien Jorge
+ */
+#include "engine/model/model_action.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+template<class Base>
+rp::indexed_model<Base>::indexed_model()
+  : m_action( NULL ), m_action_id( model_action_id::unknown )
+{
+  m_marks.fill( bear::engine::model_action::not_an_id );
+} // indexed_model::indexed_model()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy constructor.
+ * \param that The instance to copy from.
+ *
+ * The identifiers are not copied since they are relative to the actions of
+ * the copied model.
+ */
+template<class Base>
+rp::indexed_model<Base>::indexed_model( const indexed_model<Base>& that )
+  : super( that ), m_action( NULL ), m_action_id( model_action_id::unknown )
+{
+  m_marks.fill( bear::engine::model_action::not_an_id );
+} // indexed_model::indexed_model()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the model actor and forget the identifiers of the previous one.
+ * \param actor The actor.
+ */
+template<class Base>
+void rp::indexed_model<Base>::set_model_actor
+( const bear::engine::model_actor& actor )
+{
+  super::set_model_actor( actor );
+
+  m_action = NULL;
+  update_ids();
+} // indexed_model::set_model_actor()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the identifier of the current action.
+ */
+template<class Base>
+rp::model_action_id::value_type
+rp::indexed_model<Base>::get_current_action_id() const
+{
+  update_ids();
+  return m_action_id;
+} // indexed_model::get_current_action_id()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the placement of a mark in the current action.
+ * \param id The identifier of the mark.
+ * \param m (out) The placement of the mark.
+ * \return false if the mark is not in the current action.
+ */
+template<class Base>
+bool rp::indexed_model<Base>::get_mark_placement
+( model_mark_id::value_type id, bear::engine::model_mark_placement& m ) const
+{
+  update_ids();
+
+  const std::size_t index( m_marks[id] );
+
+  if ( index == bear::engine::model_action::not_an_id )
+    return false;
+  else
+    return super::get_mark_placement( index, m );
+} // indexed_model::get_mark_placement()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set the position of a mark in the current action.
+ * \param id The identifier of the mark.
+ * \param pos The position of the mark.
+ *
+ * The engine only accepts the name of the mark here, thus this method passes
+ * a name built once instead of a temporary string.
+ */
+template<class Base>
+void rp::indexed_model<Base>::set_mark_position_in_action
+( model_mark_id::value_type id, const bear::universe::position_type& pos )
+{
+  update_ids();
+
+  if ( m_marks[id] != bear::engine::model_action::not_an_id )
+    super::set_mark_position_in_action( model_mark_id::get_name(id), pos );
+} // indexed_model::set_mark_position_in_action()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Resolve the identifiers of the current action and of its marks, if
+ *        the action has changed since the last call.
+ */
+template<class Base>
+void rp::indexed_model<Base>::update_ids() const
+{
+  const bear::engine::model_action* const action
+    ( this->get_current_action() );
+
+  if ( action == m_action )
+    return;
+
+  m_action = action;
+
+  if ( action == NULL )
+    {
+      m_action_id = model_action_id::unknown;
+      m_marks.fill( bear::engine::model_action::not_an_id );
+    }
+  else
+    {
+      m_action_id = model_action_id::get( this->get_current_action_name() );
+
+      for ( std::size_t i(0); i != model_mark_id::count; ++i )
+        m_marks[i] =
+          action->get_mark_id
+          ( model_mark_id::get_name( (model_mark_id::value_type)i ) );
+    }
+} // indexed_model::update_ids()
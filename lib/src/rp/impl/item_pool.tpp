@@ -0,0 +1,140 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::item_pool class.
+ * \author Julien Jorge
+ */
+
+#include <new>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the pool of the instances of T.
+ */
+template<typename T>
+rp::item_pool<T>& rp::item_pool<T>::get_instance()
+{
+  static item_pool<T> result;
+  return result;
+} // item_pool::get_instance()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the memory of a new instance.
+ * \param size The size of the memory, which may be larger than the size of T
+ *        if the instance is of a class derived from T. In this case, the
+ *        memory is allocated on the heap.
+ */
+template<typename T>
+void* rp::item_pool<T>::allocate( std::size_t size )
+{
+  if ( size != sizeof(T) )
+    return ::operator new( size );
+
+  const boost::mutex::scoped_lock lock( m_mutex );
+
+  if ( m_free_blocks.empty() )
+    return allocate_block();
+
+  void* const result( m_free_blocks.back() );
+  m_free_blocks.pop_back();
+
+  return result;
+} // item_pool::allocate()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Give back the memory of a deleted instance.
+ * \param p The memory of the instance.
+ * \param size The size of the memory, as passed to allocate().
+ */
+template<typename T>
+void rp::item_pool<T>::release( void* p, std::size_t size )
+{
+  if ( p == NULL )
+    return;
+
+  if ( size != sizeof(T) )
+    {
+      ::operator delete( p );
+      return;
+    }
+
+  const boost::mutex::scoped_lock lock( m_mutex );
+
+  // The capacity of the free blocks is at least the count of blocks, thus
+  // this does not allocate.
+  m_free_blocks.push_back( p );
+} // item_pool::release()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate the blocks needed to have at least a given count of free
+ *        blocks.
+ * \param count The count of free blocks.
+ */
+template<typename T>
+void rp::item_pool<T>::reserve( std::size_t count )
+{
+  const boost::mutex::scoped_lock lock( m_mutex );
+
+  while ( m_free_blocks.size() < count )
+    m_free_blocks.push_back( allocate_block() );
+} // item_pool::reserve()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of blocks allocated by the pool.
+ */
+template<typename T>
+std::size_t rp::item_pool<T>::get_block_count() const
+{
+  return m_block_count;
+} // item_pool::get_block_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+template<typename T>
+rp::item_pool<T>::item_pool()
+  : m_block_count( 0 )
+{
+
+} // item_pool::item_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Destructor. Releases the free blocks.
+ */
+template<typename T>
+rp::item_pool<T>::~item_pool()
+{
+  for ( std::size_t i(0); i != m_free_blocks.size(); ++i )
+    ::operator delete( m_free_blocks[i] );
+} // item_pool::~item_pool()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Allocate a new block on the heap. The mutex must be locked.
+ */
+template<typename T>
+void* rp::item_pool<T>::allocate_block()
+{
+  void* const result( ::operator new( sizeof(T) ) );
+
+  ++m_block_count;
+  count_heap_allocation();
+
+  if ( m_free_blocks.capacity() < m_block_count )
+    m_free_blocks.reserve( 2 * m_block_count );
+
+  return result;
+} // item_pool::allocate_block()
@@ -0,0 +1,38 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the template methods of the rp::save_snapshot
+ *        class.
+ * \author Julien Jorge
+ */
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Call a function on all the variables of the snapshot.
+ * \param v The function to call, with the name and the value of each variable.
+ */
+template<typename Visitor>
+void rp::save_snapshot::for_each( Visitor& v ) const
+{
+  for ( const auto& e : m_bool )
+    v( e.first, e.second );
+
+  for ( const auto& e : m_int )
+    v( e.first, e.second );
+
+  for ( const auto& e : m_uint )
+    v( e.first, e.second );
+
+  for ( const auto& e : m_double )
+    v( e.first, e.second );
+
+  for ( const auto& e : m_string )
+    v( e.first, e.second );
+} // save_snapshot::for_each()
@@ -0,0 +1,81 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A model whose actions and marks can be accessed with an identifier.
+ * \author Julien Jorge
+ */
+#ifndef __RP_INDEXED_MODEL_HPP__
+#define __RP_INDEXED_MODEL_HPP__
+
+#include "rp/model_id.hpp"
+
+#include "engine/model.hpp"
+
+#include <array>
+
+namespace rp
+{
+  /**
+   * \brief A model whose actions and marks can be accessed with an identifier.
+   *
+   * The identifier of the current action and the indices of the marks in this
+   * action are resolved from their names when the action changes, thus the
+   * tests on the state of the model and the accesses to the marks done at each
+   * iteration compare integers and index an array instead of comparing and
+   * searching strings.
+   *
+   * \b template \b parameters :
+   * - \a Base : the base class for this item. Must inherit from
+   *    bear::engine::base_item,
+   * \author Julien Jorge
+   */
+  template<class Base>
+  class indexed_model:
+    public bear::engine::model<Base>
+  {
+    typedef bear::engine::model<Base> super;
+
+  public:
+    indexed_model();
+    indexed_model( const indexed_model<Base>& that );
+
+    void set_model_actor( const bear::engine::model_actor& actor );
+
+    model_action_id::value_type get_current_action_id() const;
+
+    using super::get_mark_placement;
+    bool get_mark_placement
+    ( model_mark_id::value_type id,
+      bear::engine::model_mark_placement& m ) const;
+
+    using super::set_mark_position_in_action;
+    void set_mark_position_in_action
+    ( model_mark_id::value_type id,
+      const bear::universe::position_type& pos );
+
+  private:
+    void update_ids() const;
+
+  private:
+    /** \brief The action for which the identifiers have been resolved. */
+    mutable const bear::engine::model_action* m_action;
+
+    /** \brief The identifier of m_action. */
+    mutable model_action_id::value_type m_action_id;
+
+    /** \brief The indices of the marks in m_action. */
+    mutable std::array<std::size_t, model_mark_id::count> m_marks;
+
+  }; // class indexed_model
+} // namespace rp
+
+#include "rp/impl/indexed_model.tpp"
+
+#endif // __RP_INDEXED_MODEL_HPP__
@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A recorded sequence of inputs to replay on the cart.
+ * \author Julien Jorge
+ */
+#ifndef __RP_INPUT_SCRIPT_HPP__
+#define __RP_INPUT_SCRIPT_HPP__
+
+#include "universe/types.hpp"
+
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  class cart;
+
+  /**
+   * \brief A recorded sequence of inputs to replay on the cart.
+   *
+   * The script is a text file with one input per line, in increasing order
+   * of frames:
+   *
+   * <frame> <action> [<x> <y>]
+   *
+   * where the action is one of "jump", "crouch", "cannonball", "plunger" and
+   * "cursor". The cursor action is followed by the position of the cursor on
+   * the screen. The empty lines and the lines beginning with '#' are ignored.
+   *
+   * \author Julien Jorge
+   */
+  class input_script
+  {
+  private:
+    /** \brief The actions that can be replayed. */
+    enum action_type
+      {
+        action_jump,
+        action_crouch,
+        action_cannonball,
+        action_plunger,
+        action_cursor
+      }; // enum action_type
+
+    /** \brief An input of the script. */
+    struct event
+    {
+      /** \brief The frame at which the input is applied. */
+      std::size_t frame;
+
+      /** \brief The action done by the input. */
+      action_type action;
+
+      /** \brief The position of the cursor on the screen, for the cursor
+          action. */
+      bear::universe::position_type position;
+
+    }; // struct event
+
+  public:
+    input_script();
+
+    bool load( const std::string& path );
+
+    std::size_t get_event_count() const;
+    bool is_finished() const;
+
+    void apply( std::size_t frame, cart& c );
+
+  private:
+    static bool parse_action( const std::string& name, action_type& action );
+
+  private:
+    /** \brief The inputs of the script, sorted by frame. */
+    std::vector<event> m_events;
+
+    /** \brief The index of the next input to apply. */
+    std::size_t m_next;
+
+  }; // class input_script
+} // namespace rp
+
+#endif // __RP_INPUT_SCRIPT_HPP__
@@ -55,22 +55,17 @@ namespace rp
 
     void activate();
     void deactivate();
+    bool is_activated() const;
+    bool is_hovered_by( const bear::universe::rectangle_type& box ) const;
 
     void on_cannonball_factor_change( double factor );
     bear::universe::coordinate_type compute_size() const;
     void update_item();
 
-  private:
-    void find_cursor();
-    bool is_colliding_with_cursor() const;
-
   private:
     /** \brief The item to follow. */
     handle_type m_item;
 
-    /** \brief The cursor that triggers the item. */
-    handle_type m_cursor;
-
     /** \brief The sprite of background star. */
     bear::visual::sprite m_background_sprite;
 
@@ -101,6 +96,9 @@ namespace rp
     /** \brief The gap with the center of mass of the item. */
     bear::universe::position_type m_gap;
 
+    /** \brief Tells if the item has been added in the hover manager. */
+    bool m_registered;
+
   }; // class interactive_item
 } // namespace rp
 
@@ -0,0 +1,100 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A pool of memory blocks for the instances of an item class.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ITEM_POOL_HPP__
+#define __RP_ITEM_POOL_HPP__
+
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief The part of the pools of items that does not depend on the class
+   *        of the items.
+   * \author Julien Jorge
+   */
+  class item_pool_base
+  {
+  public:
+    static std::size_t get_heap_allocation_count();
+
+  protected:
+    static void count_heap_allocation();
+
+  private:
+    /** \brief The count of blocks allocated on the heap by all the pools. */
+    static std::atomic<std::size_t> s_heap_allocation_count;
+
+  }; // class item_pool_base
+
+  /**
+   * \brief A pool of memory blocks for the instances of an item class.
+   *
+   * The engine deletes the items when they are killed, thus the items can not
+   * be kept alive to be used again. Instead, the class of the items defines
+   * its operators new and delete with the pool, such that the memory of a
+   * deleted item is kept in the pool and given to the next instance, which is
+   * constructed in its initial state. Once the pool contains as many blocks as
+   * there are simultaneous instances, the creation of an item does not
+   * allocate its memory on the heap anymore.
+   *
+   * \b Template \b parameters:
+   * - \a T: the class of the items.
+   *
+   * \author Julien Jorge
+   */
+  template<typename T>
+  class item_pool:
+    public item_pool_base
+  {
+  public:
+    item_pool( const item_pool<T>& ) = delete;
+    item_pool<T>& operator=( const item_pool<T>& ) = delete;
+
+    static item_pool<T>& get_instance();
+
+    void* allocate( std::size_t size );
+    void release( void* p, std::size_t size );
+
+    void reserve( std::size_t count );
+
+    std::size_t get_block_count() const;
+
+  private:
+    item_pool();
+    ~item_pool();
+
+    void* allocate_block();
+
+  private:
+    /** \brief The mutex protecting the blocks, since the items of a level may
+        be created by the thread loading the level while the previous level
+        is deleted. */
+    boost::mutex m_mutex;
+
+    /** \brief The blocks not used by an item. */
+    std::vector<void*> m_free_blocks;
+
+    /** \brief The count of blocks allocated by the pool. */
+    std::size_t m_block_count;
+
+  }; // class item_pool
+} // namespace rp
+
+#include "rp/impl/item_pool.tpp"
+
+#endif // __RP_ITEM_POOL_HPP__
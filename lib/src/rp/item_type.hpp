@@ -0,0 +1,236 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The identifiers of the types of the items of the game.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ITEM_TYPE_HPP__
+#define __RP_ITEM_TYPE_HPP__
+
+#include "engine/base_item.hpp"
+
+#include <typeinfo>
+#include <unordered_map>
+
+namespace rp
+{
+  class balloon;
+  class bird;
+  class bomb;
+  class boss;
+  class cable;
+  class cannonball;
+  class cart;
+  class crate;
+  class explosion;
+  class hole;
+  class obstacle;
+  class plank;
+  class plunger;
+  class switching;
+  class tar;
+  class tnt;
+  class wall;
+  class zeppelin;
+
+  /**
+   * \brief The identifiers of the types of the items of the game.
+   *
+   * The identifier of each type is given at compile time by item_type::of.
+   * The engine gives no place to store it in the items, thus the identifier
+   * of an item is found from its dynamic type. The types are compared once
+   * per std::type_info, then the result is kept by the address of the
+   * std::type_info, such that an item whose type is not listed here, like
+   * the ground, costs a single lookup.
+   *
+   * \author Julien Jorge
+   */
+  class item_type
+  {
+  public:
+    /** \brief The identifiers of the types. */
+    enum value_type
+      {
+        balloon,
+        bird,
+        bomb,
+        boss,
+        cable,
+        cannonball,
+        cart,
+        crate,
+        explosion,
+        hole,
+        obstacle,
+        plank,
+        plunger,
+        switching,
+        tar,
+        tnt,
+        wall,
+        zeppelin,
+        unknown
+      }; // enum value_type
+
+    /** \brief The number of identifiers, including unknown. */
+    static const std::size_t count = unknown + 1;
+
+    /** \brief The identifier of a type of item, specialized for each
+        type. */
+    template<typename T>
+    struct of;
+
+  private:
+    /** \brief The identifiers already found, by type. */
+    typedef std::unordered_map<const std::type_info*, value_type> type_map;
+
+  public:
+    static value_type get( const bear::engine::base_item& item );
+
+  private:
+    static value_type find( const std::type_info& type );
+
+    template<typename T>
+    static bool test( const std::type_info& type, value_type& result );
+
+  private:
+    /** \brief The identifiers already found, by type. */
+    static type_map s_types;
+
+  }; // class item_type
+
+  /** \brief The identifier of the rp::balloon class. */
+  template<>
+  struct item_type::of<rp::balloon>
+  {
+    static const item_type::value_type value = item_type::balloon;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::bird class. */
+  template<>
+  struct item_type::of<rp::bird>
+  {
+    static const item_type::value_type value = item_type::bird;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::bomb class. */
+  template<>
+  struct item_type::of<rp::bomb>
+  {
+    static const item_type::value_type value = item_type::bomb;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::boss class. */
+  template<>
+  struct item_type::of<rp::boss>
+  {
+    static const item_type::value_type value = item_type::boss;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::cable class. */
+  template<>
+  struct item_type::of<rp::cable>
+  {
+    static const item_type::value_type value = item_type::cable;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::cannonball class. */
+  template<>
+  struct item_type::of<rp::cannonball>
+  {
+    static const item_type::value_type value = item_type::cannonball;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::cart class. */
+  template<>
+  struct item_type::of<rp::cart>
+  {
+    static const item_type::value_type value = item_type::cart;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::crate class. */
+  template<>
+  struct item_type::of<rp::crate>
+  {
+    static const item_type::value_type value = item_type::crate;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::explosion class. */
+  template<>
+  struct item_type::of<rp::explosion>
+  {
+    static const item_type::value_type value = item_type::explosion;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::hole class. */
+  template<>
+  struct item_type::of<rp::hole>
+  {
+    static const item_type::value_type value = item_type::hole;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::obstacle class. */
+  template<>
+  struct item_type::of<rp::obstacle>
+  {
+    static const item_type::value_type value = item_type::obstacle;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::plank class. */
+  template<>
+  struct item_type::of<rp::plank>
+  {
+    static const item_type::value_type value = item_type::plank;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::plunger class. */
+  template<>
+  struct item_type::of<rp::plunger>
+  {
+    static const item_type::value_type value = item_type::plunger;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::switching class. */
+  template<>
+  struct item_type::of<rp::switching>
+  {
+    static const item_type::value_type value = item_type::switching;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::tar class. */
+  template<>
+  struct item_type::of<rp::tar>
+  {
+    static const item_type::value_type value = item_type::tar;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::tnt class. */
+  template<>
+  struct item_type::of<rp::tnt>
+  {
+    static const item_type::value_type value = item_type::tnt;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::wall class. */
+  template<>
+  struct item_type::of<rp::wall>
+  {
+    static const item_type::value_type value = item_type::wall;
+  }; // struct item_type::of
+
+  /** \brief The identifier of the rp::zeppelin class. */
+  template<>
+  struct item_type::of<rp::zeppelin>
+  {
+    static const item_type::value_type value = item_type::zeppelin;
+  }; // struct item_type::of
+} // namespace rp
+
+#endif // __RP_ITEM_TYPE_HPP__
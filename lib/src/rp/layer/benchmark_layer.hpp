@@ -0,0 +1,58 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The layer marking the end of the iterations measured by the
+ *        benchmark.
+ * \author Julien Jorge
+ */
+#ifndef __RP_BENCHMARK_LAYER_HPP__
+#define __RP_BENCHMARK_LAYER_HPP__
+
+#include "engine/layer/gui_layer.hpp"
+#include "universe/derived_item_handle.hpp"
+
+namespace rp
+{
+  class benchmark;
+
+  /**
+   * \brief The layer marking the end of the iterations measured by the
+   *        benchmark.
+   *
+   * The layer is pushed on top of the others, thus it is progressed after the
+   * world and the other layers, and rendered after them.
+   *
+   * \author Julien Jorge
+   */
+  class benchmark_layer:
+    public bear::engine::gui_layer
+  {
+  public:
+    /** \brief The type of a list of scene elements retrieved from the layer. */
+    typedef bear::engine::gui_layer::scene_element_list scene_element_list;
+
+  private:
+    /** \brief The type of the handle on the benchmark. */
+    typedef bear::universe::derived_item_handle<benchmark> benchmark_handle;
+
+  public:
+    benchmark_layer( benchmark& b );
+
+    void progress( bear::universe::time_type elapsed_time );
+    void render( scene_element_list& e ) const;
+
+  private:
+    /** \brief The benchmark informed of the end of the iterations. */
+    benchmark_handle m_benchmark;
+
+  }; // class benchmark_layer
+} // namespace rp
+
+#endif // __RP_BENCHMARK_LAYER_HPP__
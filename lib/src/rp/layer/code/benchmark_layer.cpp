@@ -0,0 +1,49 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::benchmark_layer class.
+ * \author Julien Jorge
+ */
+#include "rp/layer/benchmark_layer.hpp"
+
+#include "rp/benchmark.hpp"
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param b The benchmark informed of the end of the iterations.
+ */
+rp::benchmark_layer::benchmark_layer( benchmark& b )
+  : m_benchmark( b )
+{
+
+} // benchmark_layer::benchmark_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Do one step in the progression of the layer.
+ * \param elapsed_time Elapsed time since the last call.
+ */
+void rp::benchmark_layer::progress( bear::universe::time_type elapsed_time )
+{
+  if ( m_benchmark != NULL )
+    m_benchmark->end_update();
+} // benchmark_layer::progress()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the visibles components of the layer on a screen.
+ * \param e (out) The scene elements.
+ */
+void rp::benchmark_layer::render( scene_element_list& e ) const
+{
+  if ( m_benchmark != NULL )
+    m_benchmark->end_render();
+} // benchmark_layer::render()
@@ -12,7 +12,13 @@
  * \author Julien Jorge
  */
 #include "rp/layer/misc_layer.hpp"
+#include "rp/collision_dispatcher.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/particle_system.hpp"
+#include "rp/population_manager.hpp"
+#include "rp/profiler.hpp"
+#include "rp/sequence_recorder.hpp"
+#include "rp/layer/status/status_component.hpp"
 
 #include "engine/game.hpp"
 #include "engine/level.hpp"
@@ -22,6 +28,7 @@
 #include "visual/font/font.hpp"
 #include "visual/scene_sprite.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <claw/bitmap.hpp>
@@ -62,14 +69,19 @@ void rp::misc_layer::screenshot_file_save<ImageWriter>::operator()() const
  * \brief Constructor.
  */
 rp::misc_layer::misc_layer()
-  : m_fps_text(NULL), m_fps_count(0), m_its_count(0),
+  : m_fps_text(NULL), m_fps_count(0), m_its_count(0), m_dispatch_count(0),
 #ifdef RP_TRACE_FPS
     m_show_fps(true),
 #else
     m_show_fps(false),
 #endif
-    m_cursor_position(-1, -1), m_first_screenshot(0),
+    m_profiler_text(NULL), m_show_profiler(false),
+    m_population_text(NULL), m_show_population(false),
+    m_cursor_position(-1, -1), m_sequence_recorder(NULL),
     m_fps_key(bear::input::keyboard::kc_F2),
+    m_profiler_key(bear::input::keyboard::kc_F3),
+    m_profiler_trace_key(bear::input::keyboard::kc_F4),
+    m_population_key(bear::input::keyboard::kc_F6),
     m_screenshot_key(bear::input::keyboard::kc_F5),
     m_fullscreen_key(bear::input::keyboard::kc_F12),
     m_screenshot_sequence_key(bear::input::keyboard::kc_F11),
@@ -86,8 +98,10 @@ rp::misc_layer::misc_layer()
 rp::misc_layer::~misc_layer()
 {
   delete m_fps_text;
+  delete m_profiler_text;
+  delete m_population_text;
 
-  if (m_first_screenshot != 0)
+  if ( m_sequence_recorder != NULL )
     stop_screenshot_sequence();
 
 #ifdef RP_TRACE_FPS
@@ -115,6 +129,26 @@ void rp::misc_layer::build()
 
   m_last_fps_check = bear::systime::get_date_ms();
 
+  m_profiler_text =
+    new bear::gui::static_text
+    ( get_level_globals().get_font("font/FrancoisOne.ttf",20) );
+
+  m_profiler_text->set_auto_size(true);
+  m_profiler_text->set_text("-");
+  m_profiler_text->get_rendering_attributes().set_intensity( 1, 1, 1 );
+
+  m_last_profiler_check = m_last_fps_check;
+
+  m_population_text =
+    new bear::gui::static_text
+    ( get_level_globals().get_font("font/FrancoisOne.ttf",20) );
+
+  m_population_text->set_auto_size(true);
+  m_population_text->set_text("-");
+  m_population_text->get_rendering_attributes().set_intensity( 1, 1, 1 );
+
+  m_last_population_check = m_last_fps_check;
+
   m_cursor =
     get_level_globals().auto_sprite( "gfx/status/cursor.png", "default" );
 } // misc_layer::build()
@@ -128,7 +162,7 @@ void rp::misc_layer::progress( bear::universe::time_type elapsed_time )
 {
   ++m_its_count;
 
-  if ( m_first_screenshot != 0 )
+  if ( m_sequence_recorder != NULL )
     sequence_screenshot();
 } // misc_layer::progress()
 
@@ -139,8 +173,17 @@ void rp::misc_layer::progress( bear::universe::time_type elapsed_time )
  */
 void rp::misc_layer::render( scene_element_list& e ) const
 {
+  profiler::get_instance().end_frame();
+
+  // The statistics are collected at each frame, even when they are not
+  // displayed.
+  m_dispatch_count += collision_dispatcher_statistics::get_dispatch_count();
+  collision_dispatcher_statistics::reset();
+
   ++m_fps_count;
   render_fps( e );
+  render_profiler( e );
+  render_population( e );
 
   if ( get_level().is_paused() || game_variables::get_ending_effect() )
     e.push_back
@@ -161,6 +204,16 @@ bool rp::misc_layer::key_pressed( const bear::input::key_info& key )
 
   if ( key.get_code() == m_fps_key )
     m_show_fps = !m_show_fps;
+  else if ( key.get_code() == m_profiler_key )
+    {
+      // The zones are measured only while their statistics are displayed.
+      m_show_profiler = !m_show_profiler;
+      profiler::get_instance().set_recording( m_show_profiler );
+    }
+  else if ( key.get_code() == m_profiler_trace_key )
+    write_profiler_trace();
+  else if ( key.get_code() == m_population_key )
+    toggle_population();
   else if ( key.get_code() == m_screenshot_key )
     screenshot();
   else if ( key.get_code() == m_fullscreen_key )
@@ -170,7 +223,7 @@ bool rp::misc_layer::key_pressed( const bear::input::key_info& key )
     levelshot();
   else if ( key.get_code() == m_screenshot_sequence_key )
     {
-      if (m_first_screenshot != 0)
+      if ( m_sequence_recorder != NULL )
         stop_screenshot_sequence();
       else
         start_screenshot_sequence();
@@ -271,16 +324,7 @@ void rp::misc_layer::screenshot( const std::string& name ) const
  */
 void rp::misc_layer::sequence_screenshot()
 {
-  //if ( bear::systime::get_date_ms() >= m_last_screenshot + 40 ) // 25 fps
-    {
-      std::ostringstream name;
-      name << m_screenshot_prefix << '-' << std::setw(8)
-           << std::setfill('0') << m_screenshots_count << ".bmp";
-      ++m_screenshots_count;
-
-      screenshot<claw::graphic::bitmap::writer>(name.str());
-      m_last_screenshot = bear::systime::get_date_ms();
-    }
+  m_sequence_recorder->capture();
 } // misc_layer::sequence_screenshot()
 
 /*----------------------------------------------------------------------------*/
@@ -289,46 +333,40 @@ void rp::misc_layer::sequence_screenshot()
  */
 void rp::misc_layer::start_screenshot_sequence()
 {
-  claw::logger << claw::log_verbose << "Starting screenshot sequence."
-               << std::endl;
-
-  m_first_screenshot = bear::systime::get_date_ms();
-  m_last_screenshot = m_first_screenshot;
-  m_screenshots_count = 0;
-
   std::ostringstream prefix;
   prefix << "s-" << bear::systime::get_date_ms();
-  m_screenshot_prefix = prefix.str();
-} // misc_layer::start_screenshot_sequence()
 
-/*----------------------------------------------------------------------------*/
-/**
- * \brief Save the data associated with the screenshots of the sequence.
- */
-void rp::misc_layer::stop_screenshot_sequence()
-{
   const bear::engine::game& g( bear::engine::game::get_instance() );
 
-  std::string file_name
-    ( g.get_game_filesystem().get_custom_data_file_name
-      ( m_screenshot_prefix + ".seq" ) );
+  std::size_t threads( game_variables::get_capture_threads() );
 
-  std::ofstream f( file_name.c_str() );
-
-  const bear::systime::milliseconds_type d = bear::systime::get_date_ms();
-  const unsigned int fps =
-    (unsigned int)
-    ( (double)m_screenshots_count
-      / ((double)(d - m_first_screenshot) / 1000.0)
-      + 0.5 );
+  // Keep a processor for the game.
+  if ( threads == 0 )
+    {
+      const unsigned int processors( boost::thread::hardware_concurrency() );
 
-  f << fps << " # fps" << std::endl;
+      if ( processors > 2 )
+        threads = std::min( processors - 1, 4u );
+      else
+        threads = 1;
+    }
 
-  claw::logger << claw::log_verbose << "Screenshot sequence stopped. " << fps
-               << " fps during " << ((double)(d - m_first_screenshot) / 1000.0)
-               << " seconds." << std::endl;
+  m_sequence_recorder =
+    new sequence_recorder
+    ( g.get_game_filesystem().get_custom_data_file_name( prefix.str() ),
+      sequence_recorder::get_format( game_variables::get_capture_format() ),
+      threads );
+} // misc_layer::start_screenshot_sequence()
 
-  m_first_screenshot = 0;
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Wait for the images of the sequence to be written and save the data
+ *        associated with them.
+ */
+void rp::misc_layer::stop_screenshot_sequence()
+{
+  delete m_sequence_recorder;
+  m_sequence_recorder = NULL;
 } // misc_layer::stop_screenshot_sequence()
 
 /*----------------------------------------------------------------------------*/
@@ -348,6 +386,25 @@ void rp::misc_layer::render_fps( scene_element_list& e ) const
           std::ostringstream oss;
           oss << m_fps_count << " fps - " << m_its_count << " its";
 
+          if ( m_its_count != 0 )
+            oss << " - " << m_dispatch_count / m_its_count
+                << " collisions/it";
+
+          m_dispatch_count = 0;
+
+          if ( m_fps_count != 0 )
+            oss << " - " << status_component::get_rebuild_count() / m_fps_count
+                << " status rebuilds/frame";
+
+          status_component::reset_rebuild_count();
+
+          const particle_system* const particles
+            ( particle_system::get_instance() );
+
+          if ( particles != NULL )
+            oss << " - " << particles->get_particle_count() << " particles in "
+                << particles->get_update_duration().count() << " ms";
+
 #ifdef RP_TRACE_FPS
           g_fps.push_back(m_fps_count);
 #endif
@@ -361,3 +418,133 @@ void rp::misc_layer::render_fps( scene_element_list& e ) const
       m_fps_text->render( e );
     }
 } // misc_layer::render_fps()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the statistics of the profiler: the percentiles of the
+ *        duration of the frames and the most expensive zones.
+ * \param e (out) The scene elements.
+ */
+void rp::misc_layer::render_profiler( scene_element_list& e ) const
+{
+  if ( !m_show_profiler )
+    return;
+
+  const bear::systime::milliseconds_type current_time =
+    bear::systime::get_date_ms();
+
+  if ( current_time - m_last_profiler_check >= 500 )
+    {
+      const profiler::frame_statistics stats
+        ( profiler::get_instance().get_statistics( 256, 6 ) );
+
+      std::ostringstream oss;
+      oss << std::fixed << std::setprecision(2) << "frame: p50 " << stats.p50
+          << " - p90 " << stats.p90 << " - p99 " << stats.p99 << " - max "
+          << stats.max << " ms (" << stats.frame_count << " frames)";
+
+      for ( std::size_t i(0); i != stats.zones.size(); ++i )
+        oss << '\n' << stats.zones[i].name << ": " << stats.zones[i].mean
+            << " ms/frame - max " << stats.zones[i].max << " ms";
+
+      m_profiler_text->set_text( oss.str() );
+      m_last_profiler_check = current_time;
+    }
+
+  m_profiler_text->set_position
+    ( m_fps_text->left(),
+      get_size().y - m_profiler_text->height() - m_fps_text->bottom() );
+  m_profiler_text->render( e );
+} // misc_layer::render_profiler()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the trace of the profiler in a file.
+ */
+void rp::misc_layer::write_profiler_trace() const
+{
+  std::ostringstream name;
+  name << "trace-" << bear::systime::get_date_ms() << ".json";
+
+  const bear::engine::game& g( bear::engine::game::get_instance() );
+
+  profiler::get_instance().write_trace
+    ( g.get_game_filesystem().get_custom_data_file_name( name.str() ) );
+} // misc_layer::write_profiler_trace()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Show or hide the population of the level. The items are counted at
+ *        each iteration while the population is displayed.
+ */
+void rp::misc_layer::toggle_population()
+{
+  m_show_population = !m_show_population;
+
+  population_manager* const population( population_manager::get_instance() );
+
+  if ( population != NULL )
+    population->set_census_enabled
+      ( m_show_population || game_variables::get_population_census() );
+} // misc_layer::toggle_population()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Render the population of the level: the count of live items of the
+ *        most common classes and the decorations in their budgets.
+ * \param e (out) The scene elements.
+ */
+void rp::misc_layer::render_population( scene_element_list& e ) const
+{
+  if ( !m_show_population )
+    return;
+
+  const population_manager* const population
+    ( population_manager::get_instance() );
+
+  if ( population == NULL )
+    return;
+
+  const bear::systime::milliseconds_type current_time =
+    bear::systime::get_date_ms();
+
+  if ( current_time - m_last_population_check >= 500 )
+    {
+      std::ostringstream oss;
+      oss << "items: " << population->get_item_count() << " - peak "
+          << population->get_item_peak();
+
+      const std::vector<population_manager::class_population> census
+        ( population->get_census() );
+
+      for ( std::size_t i(0); i != std::min( census.size(), std::size_t(10) );
+            ++i )
+        oss << '\n' << census[i].class_name << ": " << census[i].count
+            << " - peak " << census[i].peak;
+
+      const std::vector<population_manager::decoration_population>
+        decorations( population->get_decorations() );
+
+      for ( std::size_t i(0); i != decorations.size(); ++i )
+        {
+          oss << '\n' << decorations[i].name << ": " << decorations[i].count
+              << '/';
+
+          if ( decorations[i].budget == 0 )
+            oss << '-';
+          else
+            oss << decorations[i].budget;
+
+          oss << " - peak " << decorations[i].peak << " - "
+              << decorations[i].refused << " refused";
+        }
+
+      m_population_text->set_text( oss.str() );
+      m_last_population_check = current_time;
+    }
+
+  m_population_text->set_position
+    ( get_size().x - m_population_text->width() - m_fps_text->left(),
+      get_size().y - m_population_text->height() - m_fps_text->bottom() );
+  m_population_text->render( e );
+} // misc_layer::render_population()
@@ -15,6 +15,7 @@
 
 #include "rp/defines.hpp"
 #include "rp/game_variables.hpp"
+#include "rp/music_player.hpp"
 #include "rp/rp_gettext.hpp"
 #include "rp/util.hpp"
 #include "rp/events/tag_level_event.hpp"
@@ -325,12 +326,14 @@ bear::gui::visual_component* rp::pause_layer::create_music_component()
       {
         tag_level_event( "pause-music-off" );
         bear::engine::game::get_instance().set_sound_muted( true );
+        music_player::get_instance().update_volume();
       } );
   const auto music_on
     ( []() -> void
       {
         tag_level_event( "pause-music-on" );
         bear::engine::game::get_instance().set_sound_muted( false );
+        music_player::get_instance().update_volume();
       } );
   
   result->add_checked_callback
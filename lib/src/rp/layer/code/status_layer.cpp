@@ -25,6 +25,7 @@
 #include "rp/layer/status/status_component.hpp"
 
 #include "rp/game_variables.hpp"
+#include "rp/profiler.hpp"
 #include "engine/game.hpp"
 #include "engine/level.hpp"
 #include "visual/bitmap_writing.hpp"
@@ -67,6 +68,8 @@ void rp::status_layer::build()
  */
 void rp::status_layer::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "status_layer/progress" );
+
   if ( ! get_level().is_paused() )
     {
       component_list::iterator it2;
@@ -83,6 +86,8 @@ void rp::status_layer::progress( bear::universe::time_type elapsed_time )
  */
 void rp::status_layer::render( scene_element_list& e ) const
 {
+  RP_PROFILE_ZONE( "status_layer/render" );
+
   if ( game_variables::level_has_started() &&
        ! game_variables::is_level_ending() && 
        ! get_level().is_paused() && 
@@ -23,6 +23,8 @@
 
 namespace rp
 {
+  class sequence_recorder;
+
   /**
    * \brief Some interface related things that do not need an individual layer.
    * \author Julien Jorge
@@ -75,6 +77,11 @@ namespace rp
     void stop_screenshot_sequence();
 
     void render_fps( scene_element_list& e ) const;
+    void render_profiler( scene_element_list& e ) const;
+    void write_profiler_trace() const;
+
+    void toggle_population();
+    void render_population( scene_element_list& e ) const;
 
   private:
     /** \brief The component in which we show the numer of frames per second. */
@@ -86,27 +93,42 @@ namespace rp
     /** \brief The number of iterations done in the current second. */
     mutable unsigned int m_its_count;
 
+    /** \brief The number of collisions dispatched by the collision
+        dispatchers in the current second. */
+    mutable std::size_t m_dispatch_count;
+
     /** \brief Tell if we must show the number tof frames per second. */
     bool m_show_fps;
 
+    /** \brief The component in which we show the statistics of the
+        profiler. */
+    bear::gui::static_text* m_profiler_text;
+
+    /** \brief Tell if we must show the statistics of the profiler. */
+    bool m_show_profiler;
+
+    /** \brief The date of the last update of the statistics of the
+        profiler. */
+    mutable bear::systime::milliseconds_type m_last_profiler_check;
+
+    /** \brief The component in which we show the population of the level. */
+    bear::gui::static_text* m_population_text;
+
+    /** \brief Tell if we must show the population of the level. */
+    bool m_show_population;
+
+    /** \brief The date of the last update of the population of the level. */
+    mutable bear::systime::milliseconds_type m_last_population_check;
+
     /** \brief The mouse cursor. */
     bear::visual::sprite m_cursor;
 
     /** \brief The last position of the mouse. */
     bear::visual::position_type m_cursor_position;
 
-    /** \brief The prefix of the name given to the screenshots in the current
-        sequence. */
-    std::string m_screenshot_prefix;
-
-    /** \brief How many screenshots did we do in the current sequence. */
-    std::size_t m_screenshots_count;
-
-    /** \brief The date at which we started to record the game. */
-    bear::systime::milliseconds_type m_first_screenshot;
-
-    /** \brief The date of the last screenshot in the sequence. */
-    bear::systime::milliseconds_type m_last_screenshot;
+    /** \brief The recorder of the current sequence of screenshots, NULL if
+        the game is not recorded. */
+    sequence_recorder* m_sequence_recorder;
 
     /** \brief The date of the last fps check. */
     mutable bear::systime::milliseconds_type m_last_fps_check;
@@ -114,6 +136,15 @@ namespace rp
     /** \brief The key to display the number of frames per second. */
     bear::input::key_code m_fps_key;
 
+    /** \brief The key to display the statistics of the profiler. */
+    bear::input::key_code m_profiler_key;
+
+    /** \brief The key to write the trace of the profiler. */
+    bear::input::key_code m_profiler_trace_key;
+
+    /** \brief The key to display the population of the level. */
+    bear::input::key_code m_population_key;
+
     /** \brief The key to take a screenshot. */
     bear::input::key_code m_screenshot_key;
 
@@ -42,12 +42,12 @@ namespace rp
       const bear::universe::coordinate_type& hide_height, bool flip);
 
     void build();
-    void render( scene_element_list& e ) const;
     unsigned int width() const;
     unsigned int height() const;
 
   protected:
     void init_signals();
+    void build_scene_elements( scene_element_list& e ) const;
 
   private:
     void on_boss_changed(unsigned int hits_count); 
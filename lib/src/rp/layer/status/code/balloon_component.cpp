@@ -69,10 +69,11 @@ void rp::balloon_component::build()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Render the component.
+ * \brief Build the scene elements displaying the component.
  * \param e (out) The scene elements.
  */
-void rp::balloon_component::render( scene_element_list& e ) const
+void rp::balloon_component::build_scene_elements
+( scene_element_list& e ) const
 {
   if ( game_variables::is_level_ending() )
     return;
@@ -107,7 +108,7 @@ void rp::balloon_component::render( scene_element_list& e ) const
   current.set_shadow_opacity( 0.6 );
 
   e.push_back( current );
-} // balloon_component::render()
+} // balloon_component::build_scene_elements()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -170,5 +171,6 @@ void rp::balloon_component::on_balloon_changed(unsigned int number)
     }
 
   update_inactive_position();
+  invalidate();
 } // balloon_component::on_balloon_changed()
 
@@ -68,10 +68,11 @@ void rp::boss_component::build()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Render the component.
+ * \brief Build the scene elements displaying the component.
  * \param e (out) The scene elements.
  */
-void rp::boss_component::render( scene_element_list& e ) const
+void rp::boss_component::build_scene_elements
+( scene_element_list& e ) const
 {
   if ( ! game_variables::is_level_ending() )
     {
@@ -88,7 +89,7 @@ void rp::boss_component::render( scene_element_list& e ) const
           pos.x += m_sprite.width() + s_margin;
         }
     }
-} // boss_component::render()
+} // boss_component::build_scene_elements()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -131,6 +132,6 @@ void rp::boss_component::init_signals()
  */
 void rp::boss_component::on_boss_changed(unsigned int hits_count)
 {
-  // do nothing ? animation ?
+  invalidate();
 } // boss_component::on_boss_changed()
 
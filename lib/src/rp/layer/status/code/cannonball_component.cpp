@@ -67,10 +67,11 @@ void rp::cannonball_component::build()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Render the component.
+ * \brief Build the scene elements displaying the component.
  * \param e (out) The scene elements.
  */
-void rp::cannonball_component::render( scene_element_list& e ) const
+void rp::cannonball_component::build_scene_elements
+( scene_element_list& e ) const
 {
    if ( ! game_variables::is_level_ending() )
     {
@@ -83,7 +84,7 @@ void rp::cannonball_component::render( scene_element_list& e ) const
       e.push_back( s1 );
       e.push_back( s2 );
     }
-} // cannonball_component::render()
+} // cannonball_component::build_scene_elements()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -136,6 +137,8 @@ void rp::cannonball_component::on_cannonball_activation_changed(bool value)
     m_sprite.set_intensity(1,1,1);
   else
     m_sprite.set_intensity(0,0,0);
+
+  invalidate();
 } // cannonball_component::on_cannonball_activation_changed()
 
 /*----------------------------------------------------------------------------*/
@@ -155,4 +158,5 @@ void rp::cannonball_component::on_cannonball_validity_changed(bool value)
       ( "gfx/status/status.png", "cannon background out" );
 
   m_background.flip(is_flipped());
+  invalidate();
 } // cannonball_component::on_cannonball_validity_changed()
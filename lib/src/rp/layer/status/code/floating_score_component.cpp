@@ -16,7 +16,6 @@
 #include "rp/game_variables.hpp"
 
 #include "visual/scene_sprite.hpp"
-#include "visual/scene_writing.hpp"
 
 #include <boost/bind.hpp>
 #include <claw/tween/single_tweener.hpp>
@@ -52,6 +51,8 @@ typedef claw::tween::symmetric_easing<easing_back_large_func> easing_back_large;
  */
 rp::floating_score_component::floating_score_component
 ( bear::engine::level_globals& glob )
+  : m_points( glob.get_font("font/LuckiestGuy.ttf", 25) ),
+    m_combo( glob.get_font("font/LuckiestGuy.ttf", 40) )
 {
   m_combo_value = game_variables::get_combo();
   m_points_value = game_variables::get_points();
@@ -65,17 +66,10 @@ rp::floating_score_component::floating_score_component
   m_sprite = 
     glob.auto_sprite( "gfx/status/status.png", oss.str() );
   
-  std::ostringstream os;
-  os << m_points_value;
-  m_points.create( glob.get_font("font/LuckiestGuy.ttf", 25), os.str() );
-  
-  os.str( std::string() );
-  os.clear();
+  m_points.set_value( m_points_value );
   
   if ( m_combo_value > 1 )
-    os << m_combo_value;
-
-  m_combo.create( glob.get_font("font/LuckiestGuy.ttf", 40), os.str() );
+    m_combo.set_value( m_combo_value );
 } //floating_score_component::floating_score_component()
 
 /*----------------------------------------------------------------------------*/
@@ -102,16 +96,18 @@ void rp::floating_score_component::render
       m_sprite );
   e.push_back( sp );
   
-  bear::visual::scene_writing s1
-    ( get_position().x - m_points.get_width() + 10, 
-      get_position().y - 10, m_points );
+  bear::visual::scene_element_sequence s1
+    ( m_points.get_scene_element
+      ( get_position().x - m_points.get_width() + 10, 
+        get_position().y - 10 ) );
 
   s1.get_rendering_attributes().set_intensity(0.0, 0.0, 0.0);
   e.push_back( s1 );
   
-  bear::visual::scene_writing s2
-    ( get_position().x + 30, 
-      get_position().y -15, m_combo );
+  bear::visual::scene_element_sequence s2
+    ( m_combo.get_scene_element
+      ( get_position().x + 30, 
+        get_position().y -15 ) );
 
   s2.get_rendering_attributes().set_intensity(0.0, 0.0, 0.0);
   e.push_back( s2 );
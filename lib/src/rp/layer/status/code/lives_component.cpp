@@ -62,10 +62,11 @@ void rp::lives_component::build()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Render the component.
+ * \brief Build the scene elements displaying the component.
  * \param e (out) The scene elements.
  */
-void rp::lives_component::render( scene_element_list& e ) const
+void rp::lives_component::build_scene_elements
+( scene_element_list& e ) const
 {
    if ( ! game_variables::is_level_ending() )
     {
@@ -91,7 +92,7 @@ void rp::lives_component::render( scene_element_list& e ) const
         s3.get_rendering_attributes().set_intensity(0,0,0);
       e.push_back( s3 ); 
     }
-} // lives_component::render()
+} // lives_component::build_scene_elements()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -134,5 +135,5 @@ void rp::lives_component::init_signals()
  */
 void rp::lives_component::on_lives_changed(unsigned int value)
 {
-  // do nothing ? animation ?
+  invalidate();
 } // lives_component::on_lives_changed()
@@ -67,10 +67,11 @@ void rp::plunger_component::build()
 
 /*----------------------------------------------------------------------------*/
 /**
- * \brief Render the component.
+ * \brief Build the scene elements displaying the component.
  * \param e (out) The scene elements.
  */
-void rp::plunger_component::render( scene_element_list& e ) const
+void rp::plunger_component::build_scene_elements
+( scene_element_list& e ) const
 {
    if ( ! game_variables::is_level_ending() )
     {
@@ -103,7 +104,7 @@ void rp::plunger_component::render( scene_element_list& e ) const
           e.push_back( s2 );
         }
     }
-} // plunger_component::render()
+} // plunger_component::build_scene_elements()
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -167,7 +168,7 @@ void rp::plunger_component::init_signals()
  */
 void rp::plunger_component::on_plunger_total_number_changed(unsigned int value)
 {
-  // do nothing ? animation ?
+  invalidate();
 } // plunger_component::on_plunger_total_number_changed()
 
 /*----------------------------------------------------------------------------*/
@@ -177,7 +178,7 @@ void rp::plunger_component::on_plunger_total_number_changed(unsigned int value)
  */
 void rp::plunger_component::on_plunger_number_changed(unsigned int value)
 { 
-  // do nothing ? animation ?
+  invalidate();
 } // plunger_component::on_plunger_number_changed()
 
 /*----------------------------------------------------------------------------*/
@@ -197,6 +198,7 @@ void rp::plunger_component::on_plunger_validity_changed(bool value)
       ( "gfx/status/status.png", "plungers background out" );
 
   m_background.flip(is_flipped());
+  invalidate();
 } // plunger_component::on_plunger_validity_changed()
 
 /*----------------------------------------------------------------------------*/
@@ -206,5 +208,5 @@ void rp::plunger_component::on_plunger_validity_changed(bool value)
  */
 void rp::plunger_component::on_plunger_activation_changed(bool value)
 { 
-  // do nothing ? animation ?
+  invalidate();
 } // plunger_component::on_plunger_activation_changed()
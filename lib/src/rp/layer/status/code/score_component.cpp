@@ -19,8 +19,6 @@
 
 #include "engine/game.hpp"
 
-#include "visual/bitmap_writing.hpp"
-#include "visual/scene_writing.hpp"
 #include "visual/scene_sprite.hpp"
 
 #include <boost/bind.hpp>
@@ -48,7 +46,7 @@ rp::score_component::score_component
   const bear::universe::size_box_type& layer_size,
   const bear::universe::coordinate_type& hide_height, bool flip )
   : super(glob,active_position,side, x_p, y_p, layer_size, hide_height, flip),
-    m_font(glob.get_font("font/LuckiestGuy.ttf", 30))
+    m_font(glob.get_font("font/LuckiestGuy.ttf", 30)), m_score(m_font)
 {
 
 } // score_component::score_component()
@@ -59,10 +57,7 @@ rp::score_component::score_component
  */
 void rp::score_component::build()
 {
-  std::ostringstream oss;
-  oss << game_variables::get_score();
-  m_score.create(m_font, oss.str());
-  m_score->set_intensity(0, 0, 0);
+  m_score.set_value( game_variables::get_score() );
 
   super::build();
 } // score_component::build()
@@ -93,11 +88,6 @@ void rp::score_component::progress
       else
         ++it;
     }
-
-  std::ostringstream oss;
-  oss << game_variables::get_score();
-  m_score.create(m_font, oss.str());
-  m_score->set_intensity(0, 0, 0);
 } // score_component::progress()
 
 /*----------------------------------------------------------------------------*/
@@ -107,15 +97,7 @@ void rp::score_component::progress
  */
 void rp::score_component::render( scene_element_list& e ) const
 {
-  if ( ! game_variables::is_level_ending() )
-    {
-      bear::visual::scene_writing s
-        ( get_render_position().x + ( width() - m_score.get_width() ) / 2,
-          get_render_position().y + ( height() - m_score.get_height() ) / 2,
-          m_score );
-
-      e.push_back( s );
-    }
+  super::render( e );
 
   floating_score_list::const_iterator it;
   for ( it = m_floating_score.begin();
@@ -123,6 +105,28 @@ void rp::score_component::render( scene_element_list& e ) const
     it->render(e);
 } // score_component::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the scene elements displaying the score.
+ * \param e (out) The scene elements.
+ */
+void rp::score_component::build_scene_elements
+( scene_element_list& e ) const
+{
+  if ( game_variables::is_level_ending() )
+    return;
+
+  bear::visual::scene_element_sequence s
+    ( m_score.get_scene_element
+      ( get_render_position().x + ( width() - m_score.get_width() ) / 2,
+        get_render_position().y
+        + ( height() - m_score.get_height() ) / 2 ) );
+
+  s.get_rendering_attributes().set_intensity(0, 0, 0);
+
+  e.push_back( s );
+} // score_component::build_scene_elements()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get the visual width of the bar.
@@ -155,6 +159,13 @@ void rp::score_component::init_signals()
         boost::bind
         (&rp::score_component::on_new_score,
          this, _1) ) );
+
+  add_signal
+    ( bear::engine::game::get_instance().listen_uint_variable_change
+      ( game_variables::get_score_variable_name(),
+        boost::bind
+        (&rp::score_component::on_score_changed,
+         this, _1) ) );
 } // score_component::init_signals()
 
 /*----------------------------------------------------------------------------*/
@@ -222,3 +233,14 @@ void rp::score_component::on_new_score(bool value)
     (pos, get_render_position() +
      bear::universe::position_type( width() / 2, 0 ) );
 } // score_component::on_new_score()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief The fonction called when the score game variable changes.
+ * \param score The new score.
+ */
+void rp::score_component::on_score_changed(unsigned int score)
+{
+  m_score.set_value( score );
+  invalidate();
+} // score_component::on_score_changed()
@@ -23,6 +23,7 @@
 /*----------------------------------------------------------------------------*/
 const double rp::status_component::s_bar_length = 100;
 const unsigned int rp::status_component::s_margin = 5;
+std::size_t rp::status_component::s_rebuild_count( 0 );
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -46,7 +47,8 @@ rp::status_component::status_component
   : m_level_globals(glob), m_side(side),
     m_x_placement(x_p), m_y_placement(y_p),
     m_layer_size(layer_size), m_active_position(active_position),
-    m_hide_distance(hide_distance), m_flip(flip), m_active( true )
+    m_hide_distance(hide_distance), m_flip(flip), m_active( true ),
+    m_dirty( true )
 {
   
 } // status_component::status_component()
@@ -98,9 +100,36 @@ void rp::status_component::progress( bear::universe::time_type elapsed_time )
  */
 void rp::status_component::render( scene_element_list& e ) const
 {
-  // do nothing
+  if ( m_dirty )
+    {
+      m_scene_elements.clear();
+      build_scene_elements( m_scene_elements );
+      m_dirty = false;
+      ++s_rebuild_count;
+    }
+
+  e.insert( e.end(), m_scene_elements.begin(), m_scene_elements.end() );
 } // status_component::render()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of times the scene elements of the components have
+ *        been built since the last reset.
+ */
+std::size_t rp::status_component::get_rebuild_count()
+{
+  return s_rebuild_count;
+} // status_component::get_rebuild_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Reset the count of built scene elements.
+ */
+void rp::status_component::reset_rebuild_count()
+{
+  s_rebuild_count = 0;
+} // status_component::reset_rebuild_count()
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Add a new signal.
@@ -217,6 +246,8 @@ void rp::status_component::on_x_position_update(double x)
 {
   m_position.x = x;
   m_render_position.x = x;
+
+  invalidate();
 } // status_component::on_x_position_update()
 
 /*----------------------------------------------------------------------------*/
@@ -234,6 +265,8 @@ void rp::status_component::on_y_position_update(double y)
     m_render_position.y -= height();
   else if ( m_y_placement == middle_y_placement )
     m_render_position.y -= (height() / 2);
+
+  invalidate();
 } // status_component::on_y_position_update()
 
 /*----------------------------------------------------------------------------*/
@@ -280,3 +313,23 @@ void rp::status_component::on_visibility_changed(bool visibility)
 
   m_active = visibility;
 } // status_component::on_visibility_changed()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the scene elements displaying the component.
+ * \param e (out) The scene elements.
+ */
+void rp::status_component::build_scene_elements( scene_element_list& e ) const
+{
+  // do nothing
+} // status_component::build_scene_elements()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell that the scene elements must be built again in the next call to
+ *        render().
+ */
+void rp::status_component::invalidate()
+{
+  m_dirty = true;
+} // status_component::invalidate()
@@ -14,8 +14,8 @@
 #ifndef __RP_FLOATING_SCORE_HPP__
 #define __RP_FLOATING_SCORE_HPP__
 
+#include "rp/digit_writing.hpp"
 #include "rp/layer/status/status_component.hpp"
-#include "visual/writing.hpp"
 
 #include "universe/types.hpp"
 #include "visual/animation.hpp"
@@ -55,10 +55,10 @@ namespace rp
     bear::visual::position_type m_position;
 
     /** \brief The points text. */
-    bear::visual::writing m_points;
+    digit_writing m_points;
 
     /** \brief The combo text. */
-    bear::visual::writing m_combo;
+    digit_writing m_combo;
 
     /** \brief The sprite. */
     bear::visual::sprite m_sprite;
@@ -14,10 +14,9 @@
 #ifndef __RP_SCORE_COMPONENT_HPP__
 #define __RP_SCORE_COMPONENT_HPP__
 
+#include "rp/digit_writing.hpp"
 #include "rp/layer/status/status_component.hpp"
 
-#include "visual/writing.hpp"
-
 namespace rp
 {
   class floating_score_component;
@@ -54,18 +53,20 @@ namespace rp
 
   protected:
     void init_signals();
+    void build_scene_elements( scene_element_list& e ) const;
 
   private:
     void on_score_added(unsigned int combo, int points);  
     void create_tweener();
     void on_new_score(bool value);
+    void on_score_changed(unsigned int score);
 
   private:
     /** \brief The font for text. */
     bear::visual::font m_font;
     
     /** \brief The score. */
-    bear::visual::writing m_score;
+    digit_writing m_score;
 
     /** \brief map of floating score. */
     floating_score_list m_floating_score;
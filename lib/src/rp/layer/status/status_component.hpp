@@ -27,6 +27,12 @@ namespace rp
 {
   /**
    * \brief The base of component on status_layer.
+   *
+   * The scene elements built by the component are kept from a frame to the
+   * next and built again only after a call to invalidate(), which is done
+   * when the position changes and by the subclasses when the game variables
+   * they display change.
+   *
    * \author Sebastien Angibaud
    */
   class status_component
@@ -85,8 +91,13 @@ namespace rp
     void on_y_position_update(double x);
     void on_visibility_changed(bool visibility);
 
+    static std::size_t get_rebuild_count();
+    static void reset_rebuild_count();
+
   protected:
     virtual void init_signals();
+    virtual void build_scene_elements( scene_element_list& e ) const;
+    void invalidate();
 
   protected:
     /** \brief The length of the bars. */
@@ -138,6 +149,17 @@ namespace rp
     /** \brief Indicates if the component is active. */
     bool m_active;
 
+    /** \brief The scene elements built in the last call to
+        build_scene_elements(). */
+    mutable scene_element_list m_scene_elements;
+
+    /** \brief Indicates if the scene elements must be built again. */
+    mutable bool m_dirty;
+
+    /** \brief The number of calls to build_scene_elements() since the last
+        reset, for all the components. */
+    static std::size_t s_rebuild_count;
+
   }; // class status_component
 } // namespace rp
 
@@ -23,11 +23,19 @@
 
 #include "engine/export.hpp"
 
+#include <chrono>
+#include <deque>
+
 namespace rp
 {
   /**
    * \brief The class describing a level generator.
    *
+   * The track is generated by segments, a fixed distance ahead of the camera,
+   * and the segments left behind the camera are removed. Thus the track is
+   * endless but the count of items in the level is bounded, and at most
+   * a constant count of segments is generated at each iteration.
+   *
    * The valid fields for this item are
    *  - any field supported by the parent classes.
    *
@@ -62,9 +70,31 @@ namespace rp
     
     /** \brief The type of the vector of the handles to the obstacles. */
     typedef std::vector<obstacle_handle> obstacle_vector; 
-    
+
+    /** \brief The type of the handles on the generated items. */
+    typedef bear::universe::derived_item_handle<bear::engine::base_item>
+    item_handle;
+
+    /** \brief A part of the track, removed when the camera has passed it. */
+    struct segment
+    {
+      /** \brief The items created for this segment. */
+      std::vector<item_handle> items;
+
+      /** \brief The right edge of the segment. */
+      bear::universe::coordinate_type right;
+
+    }; // struct segment
+
+  public:
+    /** \brief The type of the durations measured by the generator. */
+    typedef std::chrono::duration<double, std::milli> duration_type;
+
   public:
+    level_generator();
+
     void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
 
     bool set_item_list_field
     ( const std::string& name, 
@@ -72,9 +102,19 @@ namespace rp
     bool set_item_field
     ( const std::string& name, bear::engine::base_item* value );
 
+    bool is_valid() const;
+
+    std::size_t get_live_item_count() const;
+    duration_type get_generation_duration() const;
+
   private:
-    void create_level();
-    void create_target(bear::universe::position_type& pos);
+    void update_window( std::size_t max_segments );
+    void retire_segments( bear::universe::coordinate_type limit );
+    void create_segment();
+    void add_generated_item( bear::engine::base_item& item );
+    void report() const;
+
+    void create_balloon(bear::universe::position_type& pos);
     void create_bonus(bear::universe::position_type& pos);
     void add_slope(bear::universe::position_type& pos);
     void add_ground(bear::universe::position_type& pos);
@@ -97,6 +137,37 @@ namespace rp
 
     /** \brief A vector of obstacles to build level. */
     obstacle_vector m_obstacles;
+
+    /** \brief The segments currently in the level, from left to right. */
+    std::deque<segment> m_segments;
+
+    /** \brief The position where the next segment begins. */
+    bear::universe::position_type m_position;
+
+    /** \brief Tells if the last segment ends with a slope. */
+    bool m_previous_is_slope;
+
+    /** \brief The count of segments generated since the beginning. */
+    std::size_t m_segment_count;
+
+    /** \brief The index of the segment of the last bonus. */
+    std::size_t m_last_bonus;
+
+    /** \brief The total time spent generating the segments. */
+    duration_type m_generation_duration;
+
+    /** \brief How far ahead of the camera the segments are generated. */
+    static const bear::universe::coordinate_type s_generation_distance;
+
+    /** \brief How far behind the camera the segments are removed. */
+    static const bear::universe::coordinate_type s_retire_distance;
+
+    /** \brief The maximum count of segments generated at each iteration. */
+    static const std::size_t s_segments_per_iteration;
+
+    /** \brief The count of segments between two reports in the logs. */
+    static const std::size_t s_report_period;
+
   }; // class level_generator
 } // namespace rp
 
@@ -14,6 +14,7 @@
 #ifndef __RP_LEVEL_SELECTOR_HPP__
 #define __RP_LEVEL_SELECTOR_HPP__
 
+#include "rp/digit_writing.hpp"
 #include "rp/entity.hpp"
 
 #include "engine/base_item.hpp"
@@ -23,7 +24,6 @@
 #include "generic_items/decorative_rectangle.hpp"
 #include "generic_items/decorative_item.hpp"
 #include "universe/derived_item_handle.hpp"
-#include "visual/writing.hpp"
 #include "visual/animation.hpp"
 
 #include <claw/tween/tweener_group.hpp>
@@ -101,6 +101,8 @@ namespace rp
     void update_visibility();
     void update_state();
     void update_score();
+    void invalidate_state();
+    bool is_state_valid() const;
     bool check_precedence() const;
     unsigned int get_state() const;
     unsigned int get_new_state() const;
@@ -134,6 +136,7 @@ namespace rp
     void on_move_on_center( double factor );
     void on_unlock_factor_change( double factor );
     void push_level();
+    std::string get_level_path() const;
     void on_star_angle_change( double angle );
     void on_medal_factor_change( double factor );
     void on_medal_y_gap_change( double gap_y );
@@ -202,7 +205,7 @@ namespace rp
     bear::visual::font m_font;
     
     /** \brief The points text. */
-    bear::visual::writing m_points;
+    digit_writing m_points;
 
     /** \brief The star. */
     bear::visual::animation m_star;
@@ -290,10 +293,28 @@ namespace rp
 
     boost::signals2::scoped_connection m_ad_connection;
     bool m_animate_unlock;
+
+    /** \brief The connection to the changes of the score of the level. */
+    boost::signals2::scoped_connection m_score_connection;
+
+    /** \brief The connection to the changes of the state of the level. */
+    boost::signals2::scoped_connection m_state_connection;
+
+    /** \brief The value of s_state_generation at the last update of the
+        state. */
+    unsigned int m_state_generation;
+
+    /** \brief The score displayed in m_points. */
+    unsigned int m_displayed_score;
     
     /** \brief Indicates if a level is selected. */
     static bool s_selection;
 
+    /** \brief A counter incremented each time the score or the state of a
+        level changes. The state of a selector depends on the state of the
+        other selectors, thus they are all updated after a change. */
+    static unsigned int s_state_generation;
+
   }; // class level_selector
 } // namespace rp
 
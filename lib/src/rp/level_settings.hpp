@@ -46,6 +46,7 @@ namespace rp
   public:
     level_settings();
 
+    void pre_cache();
     void build();
     void on_enters_layer();
     
@@ -0,0 +1,63 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A file mapped in memory for reading.
+ * \author Julien Jorge
+ */
+#ifndef __RP_MAPPED_FILE_HPP__
+#define __RP_MAPPED_FILE_HPP__
+
+#include <cstddef>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief A file mapped in memory for reading.
+   *
+   * The content of the file is accessed directly in the memory of the process,
+   * without copy, until the instance is destroyed.
+   *
+   * \author Julien Jorge
+   */
+  class mapped_file
+  {
+  public:
+    explicit mapped_file( const std::string& file_name );
+    mapped_file( const mapped_file& ) = delete;
+    mapped_file& operator=( const mapped_file& ) = delete;
+    ~mapped_file();
+
+    bool is_open() const;
+    const char* data() const;
+    std::size_t size() const;
+
+  private:
+    /** \brief The content of the file. */
+    const char* m_data;
+
+    /** \brief The size of the file. */
+    std::size_t m_size;
+
+    /** \brief Tells if the file has been opened. */
+    bool m_open;
+
+#ifdef _WIN32
+    /** \brief The handle of the file. */
+    void* m_file;
+
+    /** \brief The handle of the mapping. */
+    void* m_mapping;
+#endif
+
+  }; // class mapped_file
+} // namespace rp
+
+#endif // __RP_MAPPED_FILE_HPP__
@@ -0,0 +1,82 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The identifiers of the actions and of the marks of the models of the
+ *        game.
+ * \author Julien Jorge
+ */
+#ifndef __RP_MODEL_ID_HPP__
+#define __RP_MODEL_ID_HPP__
+
+#include <cstddef>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief The identifiers of the actions of the models tested at each
+   *        iteration.
+   * \author Julien Jorge
+   */
+  class model_action_id
+  {
+  public:
+    /** \brief The identifiers of the actions. */
+    enum value_type
+      {
+        afraid,
+        crouch,
+        dead,
+        fly,
+        hit,
+        idle,
+        jump,
+        move,
+        takeoff,
+        with_tar,
+        unknown
+      }; // enum value_type
+
+    /** \brief The number of identifiers, including unknown. */
+    static const std::size_t count = unknown + 1;
+
+  public:
+    static value_type get( const std::string& name );
+
+  }; // class model_action_id
+
+  /**
+   * \brief The identifiers of the marks of the models read or written at each
+   *        iteration.
+   * \author Julien Jorge
+   */
+  class model_mark_id
+  {
+  public:
+    /** \brief The identifiers of the marks. */
+    enum value_type
+      {
+        arm,
+        cannon,
+        fire,
+        gun,
+        plunger
+      }; // enum value_type
+
+    /** \brief The number of identifiers. */
+    static const std::size_t count = plunger + 1;
+
+  public:
+    static const std::string& get_name( value_type id );
+
+  }; // class model_mark_id
+} // namespace rp
+
+#endif // __RP_MODEL_ID_HPP__
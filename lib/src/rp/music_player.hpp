@@ -0,0 +1,225 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The player streaming the music of the levels.
+ * \author Julien Jorge
+ */
+#ifndef __RP_MUSIC_PLAYER_HPP__
+#define __RP_MUSIC_PLAYER_HPP__
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief The player streaming the music of the levels.
+   *
+   * The music of the levels whose header music has been removed at build time
+   * is listed in the file level/music.txt, where each line gives the path of
+   * a level and the path of its music. The compressed music is read then
+   * decoded by a worker thread in a ring buffer holding less than one second
+   * of sound, which is consumed by the music hook of the mixer. Thus a
+   * decoded track is never entirely in memory and the game thread does not
+   * decode anything.
+   *
+   * The player has two decks. A new track is decoded in the deck not being
+   * heard, then the volume of this deck increases while the volume of the
+   * other deck decreases, such that the tracks are crossfaded without a gap.
+   *
+   * The game thread never locks the audio: it passes the changes of volume to
+   * the mixer with an atomic fade_command, and the mixer is the only one to
+   * write the current volume of the decks.
+   *
+   * The tracks are decoded only if the game is built with RP_STREAM_MUSIC,
+   * which is not the case on Android. Otherwise the levels keep their music
+   * and the player never finds a track to play.
+   *
+   * \author Julien Jorge
+   */
+  class music_player
+  {
+  private:
+    /** \brief The type of the clock used to measure the durations. */
+    typedef std::chrono::steady_clock clock_type;
+
+    /** \brief A change of the volume of a deck, passed by the game thread to
+        the mixer. */
+    struct fade_command
+    {
+      /** \brief The volume to reach. */
+      float gain;
+
+      /** \brief The variation of the volume per frame, or zero to reach the
+          volume immediately. */
+      float step;
+
+    }; // struct fade_command
+
+    /** \brief A track decoded in a ring buffer. */
+    struct deck
+    {
+      deck();
+
+      /** \brief The path of the track, guarded by m_mutex. */
+      std::string name;
+
+      /** \brief Incremented each time the track of the deck changes. Written
+          with m_mutex locked, read by the mixer. */
+      std::atomic<std::size_t> generation;
+
+      /** \brief The generation of the track decoded by the worker, accessed
+          by the worker only. */
+      std::size_t decoded_generation;
+
+      /** \brief The compressed track and its decoder, accessed by the worker
+          only. */
+      void* track;
+
+      /** \brief The sampling rate of the track. */
+      double rate;
+
+      /** \brief The position in the decoded frames of the next frame written
+          in the ring buffer, in frames of the track. */
+      double frame_position;
+
+      /** \brief The decoded frames not yet resampled, two channels. */
+      std::vector<float> pending;
+
+      /** \brief The resampled frames, two interleaved channels. */
+      std::vector<float> ring;
+
+      /** \brief The count of frames read from the ring buffer by the mixer. */
+      std::atomic<std::size_t> read_count;
+
+      /** \brief The count of frames written in the ring buffer by the
+          worker. */
+      std::atomic<std::size_t> write_count;
+
+      /** \brief Tells if the ring buffer contains the current track. */
+      std::atomic<bool> ready;
+
+      /** \brief Tells if the mixer is reading the ring buffer. */
+      std::atomic<bool> mixing;
+
+      /** \brief The generation of the track whose volume is applied by the
+          mixer, accessed by the mixer only. */
+      std::size_t mixed_generation;
+
+      /** \brief The volume of the deck, written by the mixer only. */
+      std::atomic<float> gain;
+
+      /** \brief The last change of volume requested by the game thread. */
+      std::atomic<fade_command> fade;
+
+      /** \brief The size of the track if it was entirely decoded, in bytes.
+       */
+      std::size_t decoded_size;
+
+      /** \brief The time spent by the worker decoding the track. */
+      clock_type::duration decoding_duration;
+
+    }; // struct deck
+
+  public:
+    music_player( const music_player& ) = delete;
+    music_player& operator=( const music_player& ) = delete;
+
+    static music_player& get_instance();
+
+    bool play_level_music( const std::string& level, double fade );
+
+    void play( const std::string& name, double fade );
+    void stop( double fade );
+
+    void update_volume();
+
+  private:
+    music_player();
+    ~music_player();
+
+    bool open_mixer();
+    void load_level_musics();
+    bool find_level_music( const std::string& level, std::string& name );
+    std::size_t prepare_deck( const std::string& name );
+    void fade_deck( deck& d, float gain, double fade );
+    static bool is_audible( const deck& d );
+
+    void start_worker();
+    void run();
+    bool fill_decks();
+    bool open_track( deck& d, const std::string& name );
+    void close_track( deck& d );
+    bool decode( deck& d, std::size_t frame_count );
+    bool read_frames( deck& d );
+
+    void mix( unsigned char* stream, int length );
+    void mix_deck( deck& d, float* block, std::size_t n );
+    static void mix_callback( void* player, unsigned char* stream, int length );
+
+    void log_decoding( const deck& d );
+    void log_request
+    ( const std::string& name, clock_type::time_point start ) const;
+
+  private:
+    /** \brief The worker thread. */
+    boost::thread m_thread;
+
+    /** \brief The mutex protecting the members shared with the worker. */
+    boost::mutex m_mutex;
+
+    /** \brief The condition notified when the track of a deck changes. */
+    boost::condition_variable m_request_condition;
+
+    /** \brief Tells the worker to stop. */
+    bool m_quit;
+
+    /** \brief The decks playing the tracks. */
+    deck m_decks[2];
+
+    /** \brief The music of the levels, by level path. */
+    std::map<std::string, std::string> m_level_musics;
+
+    /** \brief Tells if the file listing the music of the levels has been
+        read. */
+    bool m_level_musics_loaded;
+
+    /** \brief Tells if the player is connected to the mixer. */
+    bool m_mixer_open;
+
+    /** \brief The sampling rate of the mixer. */
+    int m_mixer_rate;
+
+    /** \brief The volume of the music, as set in the game. Written by the
+        game thread, read by the mixer. */
+    std::atomic<float> m_volume;
+
+    /** \brief The count of frames the mixer could not read because the worker
+        was late. */
+    std::atomic<std::size_t> m_underrun_count;
+
+    /** \brief The count of frames in the ring buffer of a deck. */
+    static const std::size_t s_ring_frames;
+
+    /** \brief How long the worker waits before checking the ring buffers
+        again, in milliseconds. */
+    static const unsigned int s_poll_delay;
+
+  }; // class music_player
+} // namespace rp
+
+#endif // __RP_MUSIC_PLAYER_HPP__
@@ -0,0 +1,203 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that moves and renders the small decorations of the level.
+ * \author Julien Jorge
+ */
+#ifndef __RP_PARTICLE_SYSTEM_HPP__
+#define __RP_PARTICLE_SYSTEM_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "visual/sprite.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief An item that moves and renders the small decorations of the level:
+   *        the smoke, the sparks of the explosions and the feathers.
+   *
+   * These decorations were previously individual items, with a physical
+   * behavior and sometimes some reference items and forced movements. Here
+   * the particles are stored attribute by attribute in arrays allocated once
+   * with the item, and each attribute is updated in a single loop. All the
+   * particles are rendered by this item, which covers the camera.
+   *
+   * \author Julien Jorge
+   */
+  class particle_system:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( particle_system );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+    /** \brief The type of the durations measured by the system. */
+    typedef std::chrono::duration<double, std::milli> duration_type;
+
+  private:
+    /** \brief The sprites of a kind of particle. */
+    struct appearance
+    {
+      /** \brief The frames of the animation of the particle. */
+      std::vector<bear::visual::sprite> frames;
+
+      /** \brief The duration of a frame, in seconds. */
+      float frame_duration;
+
+      /** \brief Tells if the animation is played forward then backward. */
+      bool loop_back;
+
+    }; // struct appearance
+
+    /** \brief The indices of the appearances of the particles. */
+    enum appearance_index
+      {
+        smoke_appearance,
+        explosion_appearance,
+        brown_feather_appearance,
+        white_feather_appearance,
+        appearance_count
+      }; // enum appearance_index
+
+  public:
+    particle_system();
+    ~particle_system();
+
+    static particle_system* get_instance();
+
+    void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
+    void get_visual( std::list<bear::engine::scene_visual>& visuals ) const;
+
+    void add_smoke
+    ( const bear::engine::base_item& ref, double min_intensity,
+      double max_intensity, int z_shift );
+    void add_explosion
+    ( const bear::universe::position_type& center,
+      bear::universe::coordinate_type size, int z );
+    void add_floating_feather
+    ( const bear::universe::position_type& center, int z );
+    void add_flying_feather
+    ( const bear::universe::position_type& center, int z );
+
+    std::size_t get_particle_count() const;
+    std::size_t get_dropped_count() const;
+    duration_type get_update_duration() const;
+
+  private:
+    std::size_t create_particle
+    ( appearance_index a, const bear::universe::position_type& center, int z,
+      float life );
+    void integrate( float dt );
+    void remove_dead_particles();
+    void move_particle( std::size_t from, std::size_t to );
+    void follow_camera();
+
+    const bear::visual::sprite& get_sprite( std::size_t i ) const;
+
+    static std::size_t pick_feather();
+
+  private:
+    /** \brief The appearances of the particles. */
+    appearance m_appearance[ appearance_count ];
+
+    /** \brief The count of live particles, stored at the beginning of the
+        arrays. */
+    std::size_t m_count;
+
+    /** \brief The count of particles not created because the arrays were
+        full. */
+    std::size_t m_dropped;
+
+    /** \brief The time spent in the last update of the particles. */
+    duration_type m_update_duration;
+
+    /** \brief The horizontal positions of the centers of the particles. */
+    std::vector<float> m_x;
+
+    /** \brief The vertical positions of the centers of the particles. */
+    std::vector<float> m_y;
+
+    /** \brief The horizontal speeds of the particles. */
+    std::vector<float> m_speed_x;
+
+    /** \brief The vertical speeds of the particles. */
+    std::vector<float> m_speed_y;
+
+    /** \brief The vertical accelerations of the particles. */
+    std::vector<float> m_acceleration_y;
+
+    /** \brief The ratio of the speed lost each second. */
+    std::vector<float> m_friction;
+
+    /** \brief The angles of the particles. */
+    std::vector<float> m_angle;
+
+    /** \brief The angular speeds of the particles. */
+    std::vector<float> m_angular_speed;
+
+    /** \brief The scale factors of the particles. */
+    std::vector<float> m_scale;
+
+    /** \brief The variation of the scale factors per second. */
+    std::vector<float> m_scale_speed;
+
+    /** \brief The intensities of the colors of the particles. */
+    std::vector<float> m_intensity;
+
+    /** \brief The variation of the intensities per second. */
+    std::vector<float> m_intensity_speed;
+
+    /** \brief The opacities of the particles. */
+    std::vector<float> m_opacity;
+
+    /** \brief The variation of the opacities per second. */
+    std::vector<float> m_opacity_speed;
+
+    /** \brief The amplitude of the horizontal swing of the particles. */
+    std::vector<float> m_swing_amplitude;
+
+    /** \brief The angle in the swing of the particles. */
+    std::vector<float> m_swing_angle;
+
+    /** \brief The angular speed of the swing of the particles. */
+    std::vector<float> m_swing_speed;
+
+    /** \brief The time elapsed since the creation of the particles. */
+    std::vector<float> m_age;
+
+    /** \brief The duration of the life of the particles. */
+    std::vector<float> m_life;
+
+    /** \brief The factors applied to the speed of the animations. */
+    std::vector<float> m_time_factor;
+
+    /** \brief The depths of the particles. */
+    std::vector<int> m_z;
+
+    /** \brief The appearance of the particles. */
+    std::vector<unsigned char> m_appearance_index;
+
+    /** \brief The system of the current level. */
+    static particle_system* s_instance;
+
+    /** \brief The maximum count of particles. */
+    static const std::size_t s_capacity;
+
+  }; // class particle_system
+} // namespace rp
+
+#endif // __RP_PARTICLE_SYSTEM_HPP__
@@ -14,6 +14,9 @@
 #ifndef __RP_PLUNGER_HPP__
 #define __RP_PLUNGER_HPP__
 
+#include "rp/action_score.hpp"
+#include "rp/collision_dispatcher.hpp"
+
 #include "engine/model.hpp"
 #include "engine/base_item.hpp"
 #include "engine/export.hpp"
@@ -47,6 +50,9 @@ namespace rp
 
   public:
     plunger();
+
+    static void* operator new( std::size_t size );
+    static void operator delete( void* p, std::size_t size );
     
     void pre_cache();
     void on_enters_layer();    
@@ -66,6 +72,8 @@ namespace rp
     ( bear::engine::base_item& that, bear::universe::collision_info& info );
 
   private:
+    static collision_dispatcher<plunger> create_collision_dispatcher();
+
     bool collision_with_attractable( bear::engine::base_item& that );
     bool collision_with_zeppelin( bear::engine::base_item& that );
     bool collision_with_bird( bear::engine::base_item& that );
@@ -108,6 +116,9 @@ namespace rp
 
     /** \brief The rectangle of the camera. */
     bear::universe::rectangle_type m_camera_rect;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class plunger
 } // namespace rp
 
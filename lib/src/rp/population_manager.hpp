@@ -0,0 +1,192 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An item that counts the items of the level and limits the count of
+ *        the decorations.
+ * \author Julien Jorge
+ */
+#ifndef __RP_POPULATION_MANAGER_HPP__
+#define __RP_POPULATION_MANAGER_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+#include "universe/item_handle.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief An item that counts the items of the level and limits the count of
+   *        the decorations.
+   *
+   * The decorations created by the other items, which have no effect on the
+   * game, are registered in the manager of the level under a category. Each
+   * category has a budget, read from the game variables, and a decoration is
+   * not created when its category already has as many live items as its
+   * budget.
+   *
+   * When the census is enabled, the manager also counts the live items of
+   * each class at each iteration and keeps the highest counts reached since
+   * the beginning of the level. The census is written in the log when the
+   * level ends.
+   *
+   * \author Julien Jorge
+   */
+  class population_manager:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( population_manager );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+    /** \brief The categories of the decorations. */
+    enum decoration_category
+      {
+        /** \brief The waves displayed under the cursor. */
+        decoration_wave,
+
+        /** \brief The stars displayed behind the items hit by the cart. */
+        decoration_hit_star,
+
+        /** \brief The pieces of the items that break or explode. */
+        decoration_debris,
+
+        /** \brief The feathers of the birds. */
+        decoration_feather,
+
+        /** \brief The count of categories. Not a category. */
+        decoration_category_count
+
+      }; // enum decoration_category
+
+    /** \brief The population of a class of items. */
+    struct class_population
+    {
+      /** \brief The name of the class. */
+      std::string class_name;
+
+      /** \brief The count of live items in the last census. */
+      std::size_t count;
+
+      /** \brief The highest count of live items since the beginning of the
+          level. */
+      std::size_t peak;
+
+    }; // struct class_population
+
+    /** \brief The population of a category of decorations. */
+    struct decoration_population
+    {
+      /** \brief The name of the category. */
+      std::string name;
+
+      /** \brief The count of live decorations. */
+      std::size_t count;
+
+      /** \brief The highest count of live decorations since the beginning of
+          the level. */
+      std::size_t peak;
+
+      /** \brief The maximum count of live decorations. Zero means that the
+          count is not limited. */
+      std::size_t budget;
+
+      /** \brief The count of decorations not created because of the
+          budget. */
+      std::size_t refused;
+
+    }; // struct decoration_population
+
+  private:
+    /** \brief The live decorations of a category. */
+    struct decoration_set
+    {
+      /** \brief The live decorations. */
+      std::vector<bear::universe::item_handle> items;
+
+      /** \brief The highest count of live decorations. */
+      std::size_t peak;
+
+      /** \brief The maximum count of live decorations. */
+      std::size_t budget;
+
+      /** \brief The count of decorations not created because of the
+          budget. */
+      std::size_t refused;
+
+    }; // struct decoration_set
+
+    /** \brief The count and the highest count of the items of a class. */
+    typedef std::pair<std::size_t, std::size_t> count_and_peak;
+
+  public:
+    population_manager();
+    ~population_manager();
+
+    static population_manager* get_instance();
+
+    void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
+
+    static bool can_spawn( decoration_category c );
+    static void add_decoration
+    ( decoration_category c, bear::engine::base_item& item );
+
+    void set_census_enabled( bool b );
+    bool is_census_enabled() const;
+
+    std::vector<class_population> get_census() const;
+    std::size_t get_item_count() const;
+    std::size_t get_item_peak() const;
+
+    std::vector<decoration_population> get_decorations() const;
+
+    static const char* get_category_name( decoration_category c );
+
+  private:
+    bool has_room_for( decoration_category c );
+    void remove_dead_decorations( decoration_set& s );
+
+    void take_census();
+    void write_census() const;
+
+  private:
+    /** \brief The live decorations of each category. */
+    decoration_set m_decorations[ decoration_category_count ];
+
+    /** \brief The count and the highest count of the items of each class,
+        indexed by the name of the class. */
+    std::unordered_map<const char*, count_and_peak> m_census;
+
+    /** \brief The count of items in the last census. */
+    std::size_t m_item_count;
+
+    /** \brief The highest count of items since the beginning of the level. */
+    std::size_t m_item_peak;
+
+    /** \brief Tells if the items are counted at each iteration. */
+    bool m_census_enabled;
+
+    /** \brief The manager of the current level. */
+    static population_manager* s_instance;
+
+    /** \brief The budget of each category when the game variables do not
+        define it. */
+    static const std::size_t s_default_budget[ decoration_category_count ];
+
+  }; // class population_manager
+} // namespace rp
+
+#endif // __RP_POPULATION_MANAGER_HPP__
@@ -0,0 +1,145 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A list of resources to load in the level globals, with some
+ *        statistics about the loading.
+ * \author Julien Jorge
+ */
+#ifndef __RP_PRELOAD_PLAN_HPP__
+#define __RP_PRELOAD_PLAN_HPP__
+
+#include "engine/level_globals.hpp"
+
+#include <claw/image.hpp>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A list of resources to load in the level globals, with some
+   *        statistics about the loading.
+   *
+   * The resources can be loaded all at once or one by one, in the order in
+   * which they were added. When the decoding is started, the images are read
+   * and decoded by a worker thread, thus loading an image in the level
+   * globals only creates its texture.
+   *
+   * \author Julien Jorge
+   */
+  class preload_plan
+  {
+  private:
+    /** \brief The kinds of the resources. */
+    enum resource_kind
+      {
+        image_resource,
+        model_resource,
+        sound_resource
+      }; // enum resource_kind
+
+    /** \brief A resource to load. */
+    struct resource
+    {
+      resource( resource_kind k, const std::string& n );
+
+      /** \brief The kind of the resource. */
+      resource_kind kind;
+
+      /** \brief The path of the resource. */
+      std::string name;
+
+    }; // struct resource
+
+  public:
+    /** \brief The type of the durations measured during the loading. */
+    typedef std::chrono::duration<double, std::milli> duration_type;
+
+  public:
+    preload_plan();
+    preload_plan( const preload_plan& ) = delete;
+    preload_plan& operator=( const preload_plan& ) = delete;
+    ~preload_plan();
+
+    static const std::vector<std::string>& get_themes();
+    static const std::vector<std::string>& get_item_classes();
+
+    void add_image( const std::string& name );
+    void add_model( const std::string& name );
+    void add_sound( const std::string& name );
+    void add_theme( const std::string& theme );
+    void add_item_class( const std::string& class_name );
+
+    bool empty() const;
+
+    void start_decoding();
+
+    void load_all( bear::engine::level_globals& globals );
+    bool load_next( bear::engine::level_globals& globals );
+
+    std::size_t get_loaded_count() const;
+    std::size_t get_loaded_bytes() const;
+    duration_type get_loading_duration() const;
+    duration_type get_decoding_duration() const;
+
+  private:
+    static const std::map< std::string, std::vector<std::string> >&
+    get_item_class_models();
+
+    void decode( const std::vector<std::string>& names );
+    bool take_decoded
+    ( const std::string& name, std::shared_ptr<claw::graphic::image>& image );
+
+    static void read_atlas
+    ( const std::string& name, std::vector<std::string>& pages,
+      std::set<std::string>& packed );
+
+  private:
+    /** \brief The resources not loaded yet. */
+    std::deque<resource> m_resources;
+
+    /** \brief The number of resources loaded. */
+    std::size_t m_loaded_count;
+
+    /** \brief The size of the images loaded, in bytes of texture. */
+    std::size_t m_loaded_bytes;
+
+    /** \brief The time spent loading the resources. */
+    duration_type m_loading_duration;
+
+    /** \brief The thread decoding the images. */
+    boost::thread m_decoder;
+
+    /** \brief Tells if the images are decoded by m_decoder. */
+    bool m_decoding;
+
+    /** \brief The mutex protecting the members shared with the decoder. */
+    mutable boost::mutex m_decoded_mutex;
+
+    /** \brief The images decoded and not loaded yet, by path. An image that
+        could not be decoded is null. Guarded by m_decoded_mutex. */
+    std::map< std::string, std::shared_ptr<claw::graphic::image> > m_decoded;
+
+    /** \brief The time spent by the decoder, guarded by m_decoded_mutex. */
+    duration_type m_decoding_duration;
+
+  }; // class preload_plan
+} // namespace rp
+
+#endif // __RP_PRELOAD_PLAN_HPP__
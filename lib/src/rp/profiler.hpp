@@ -0,0 +1,278 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A profiler measuring the duration of named zones in the frames.
+ * \author Julien Jorge
+ */
+#ifndef __RP_PROFILER_HPP__
+#define __RP_PROFILER_HPP__
+
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/** \brief Concatenate two tokens after their expansion. */
+#define RP_PROFILER_CONCATENATE( a, b ) RP_PROFILER_CONCATENATE_IMPL( a, b )
+
+/** \brief Concatenate two tokens. */
+#define RP_PROFILER_CONCATENATE_IMPL( a, b ) a ## b
+
+/**
+ * \brief Measure the duration of the end of the current block in a zone of the
+ *        profiler.
+ * \param name The name of the zone.
+ */
+#define RP_PROFILE_ZONE( name )                                         \
+  static const rp::profiler::zone_id                                    \
+  RP_PROFILER_CONCATENATE( rp_profiler_zone_, __LINE__ )                \
+    ( rp::profiler::get_instance().get_zone( name ) );                  \
+  const rp::profiler::scope                                             \
+  RP_PROFILER_CONCATENATE( rp_profiler_scope_, __LINE__ )               \
+    ( RP_PROFILER_CONCATENATE( rp_profiler_zone_, __LINE__ ) )
+
+namespace rp
+{
+  /**
+   * \brief A profiler measuring the duration of named zones in the frames.
+   *
+   * The zones are measured with profiler::scope, usually through the
+   * RP_PROFILE_ZONE macro. Nothing is measured until the recording is
+   * enabled with set_recording(), thus a disabled scope only reads a flag.
+   * Each measure is stored in a ring buffer of events, written without lock
+   * from any thread, and the time spent in the zone but not in the zones
+   * nested in it is added to the total of the zone in the current frame. The
+   * totals of the last frames are kept in another ring buffer, from which the
+   * percentiles of the frame time and the most expensive zones are computed.
+   * The events can be exported in the trace format of Chrome
+   * (chrome://tracing), in order to find the cause of a slow frame after it
+   * happened.
+   *
+   * \author Julien Jorge
+   */
+  class profiler
+  {
+  public:
+    /** \brief The type of the clock used for the measures. */
+    typedef std::chrono::steady_clock clock_type;
+
+    /** \brief The identifier of a zone. */
+    typedef std::size_t zone_id;
+
+    /**
+     * \brief Measure the time spent between its construction and its
+     *        destruction in a zone.
+     */
+    class scope
+    {
+    public:
+      explicit scope( zone_id zone );
+      scope( const scope& ) = delete;
+      scope& operator=( const scope& ) = delete;
+      ~scope();
+
+    private:
+      /** \brief The zone in which the time is measured. */
+      const zone_id m_zone;
+
+      /** \brief Tells if the profiler was recording at the construction. */
+      const bool m_recording;
+
+      /** \brief The recording scope in which this one is nested. */
+      scope* const m_parent;
+
+      /** \brief The time spent in the nested scopes, in nanoseconds. */
+      uint64_t m_child_time;
+
+      /** \brief The date of the construction. */
+      clock_type::time_point m_start;
+
+      /** \brief The innermost recording scope of the current thread. */
+      static thread_local scope* s_current;
+
+    }; // class scope
+
+    /** \brief The cost of a zone in the last frames. */
+    struct zone_statistics
+    {
+      /** \brief The name of the zone. */
+      std::string name;
+
+      /** \brief The average duration of the zone in a frame, in
+          milliseconds. */
+      double mean;
+
+      /** \brief The longest duration of the zone in a frame, in
+          milliseconds. */
+      double max;
+
+    }; // struct zone_statistics
+
+    /** \brief The statistics of the last frames. */
+    struct frame_statistics
+    {
+      /** \brief The number of frames in the statistics. */
+      std::size_t frame_count;
+
+      /** \brief The median duration of the frames, in milliseconds. */
+      double p50;
+
+      /** \brief The 90th percentile of the duration of the frames, in
+          milliseconds. */
+      double p90;
+
+      /** \brief The 99th percentile of the duration of the frames, in
+          milliseconds. */
+      double p99;
+
+      /** \brief The longest duration of the frames, in milliseconds. */
+      double max;
+
+      /** \brief The most expensive zones, by decreasing mean. */
+      std::vector<zone_statistics> zones;
+
+    }; // struct frame_statistics
+
+  private:
+    /** \brief The maximum number of zones. The last one receives the
+        measures of the zones declared beyond. */
+    static const std::size_t s_max_zones = 64;
+
+    /** \brief The number of events kept in the ring buffer. Must be a power
+        of two. */
+    static const std::size_t s_event_capacity;
+
+    /** \brief The number of frames kept in the ring buffer. */
+    static const std::size_t s_frame_capacity;
+
+    /** \brief A measure of a zone, stored in the ring buffer of events. */
+    struct event
+    {
+      /** \brief Twice the index of the event plus two when the event is
+          complete, odd while it is written. */
+      std::atomic<uint64_t> sequence;
+
+      /** \brief The zone measured. */
+      std::atomic<uint32_t> zone;
+
+      /** \brief The index of the thread which did the measure. */
+      std::atomic<uint32_t> thread;
+
+      /** \brief The date of the beginning of the measure, in nanoseconds
+          since the creation of the profiler. */
+      std::atomic<uint64_t> start;
+
+      /** \brief The duration of the measure, in nanoseconds. */
+      std::atomic<uint64_t> duration;
+
+    }; // struct event
+
+    /** \brief A copy of an event, read from the ring buffer. */
+    struct event_record
+    {
+      /** \brief The zone measured. */
+      uint32_t zone;
+
+      /** \brief The index of the thread which did the measure. */
+      uint32_t thread;
+
+      /** \brief The date of the beginning of the measure. */
+      uint64_t start;
+
+      /** \brief The duration of the measure. */
+      uint64_t duration;
+
+    }; // struct event_record
+
+    /** \brief The measures of a frame. */
+    struct frame_record
+    {
+      /** \brief The duration of the frame, in nanoseconds. */
+      uint64_t duration;
+
+      /** \brief The time spent in each zone, in nanoseconds. */
+      uint64_t zones[ s_max_zones ];
+
+    }; // struct frame_record
+
+  public:
+    profiler( const profiler& ) = delete;
+    profiler& operator=( const profiler& ) = delete;
+
+    static profiler& get_instance();
+
+    void set_recording( bool r );
+    bool is_recording() const;
+
+    zone_id get_zone( const std::string& name );
+    void record
+    ( zone_id zone, clock_type::time_point start, clock_type::time_point end,
+      uint64_t child_time );
+
+    void end_frame();
+
+    frame_statistics get_statistics
+    ( std::size_t frame_count, std::size_t zone_count ) const;
+    bool write_trace( const std::string& file_name ) const;
+
+  private:
+    profiler();
+
+    void push_event
+    ( zone_id zone, clock_type::time_point start, clock_type::time_point end );
+
+    uint64_t get_date( clock_type::time_point date ) const;
+    static uint64_t get_duration
+    ( clock_type::time_point start, clock_type::time_point end );
+    static uint32_t get_thread_index();
+
+    std::vector<event_record> read_events() const;
+    void write_trace( std::ostream& os ) const;
+
+  private:
+    /** \brief The date of the creation of the profiler. */
+    const clock_type::time_point m_origin;
+
+    /** \brief The mutex protecting the names of the zones. */
+    mutable boost::mutex m_zone_mutex;
+
+    /** \brief The names of the zones. */
+    std::vector<std::string> m_zone_names;
+
+    /** \brief The ring buffer of the events. */
+    std::vector<event> m_events;
+
+    /** \brief The index of the next event to write. */
+    std::atomic<uint64_t> m_next_event;
+
+    /** \brief The time spent in each zone, out of the nested zones, since
+        the beginning of the current frame, in nanoseconds. */
+    std::atomic<uint64_t> m_zone_time[ s_max_zones ];
+
+    /** \brief The ring buffer of the frames, written by the game thread. */
+    std::vector<frame_record> m_frames;
+
+    /** \brief The number of frames written since the creation. */
+    std::size_t m_frame_count;
+
+    /** \brief The date of the beginning of the current frame. */
+    clock_type::time_point m_frame_start;
+
+    /** \brief Tells if the scopes measure the zones. */
+    static std::atomic<bool> s_recording;
+
+  }; // class profiler
+} // namespace rp
+
+#endif // __RP_PROFILER_HPP__
@@ -0,0 +1,111 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The random number generators of the game.
+ * \author Julien Jorge
+ */
+#ifndef __RP_RANDOM_HPP__
+#define __RP_RANDOM_HPP__
+
+#include <cstdint>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief A sequence of pseudo-random numbers, computed with the
+   *        xorshift128+ algorithm.
+   * \author Julien Jorge
+   */
+  class random_stream
+  {
+  public:
+    random_stream();
+
+    void seed( std::uint64_t s );
+
+    std::uint64_t next();
+    double real();
+    unsigned int integer( unsigned int n );
+
+  private:
+    /** \brief The state of the generator. */
+    std::uint64_t m_state[2];
+
+  }; // class random_stream
+
+  /**
+   * \brief The random number generators of the game.
+   *
+   * Each subsystem draws its numbers from its own stream, thus the numbers
+   * used by a subsystem do not depend on the calls done by the others. All
+   * the streams are derived from a single seed, which is logged when it is
+   * set.
+   *
+   * The seed is reset at the beginning of each level by mixing the initial
+   * seed with the name of the level. The initial seed is the time at which
+   * the game started, or the value of the game variable named "random_seed"
+   * if it is set. The states derived from the streams for a level, like a
+   * shuffled sequence, must be reset when get_level_serial() changes.
+   *
+   * The streams are not protected against concurrent accesses. They must be
+   * used in the thread of the game.
+   *
+   * \author Julien Jorge
+   */
+  class random
+  {
+  public:
+    /** \brief The type of the seeds. */
+    typedef unsigned int seed_type;
+
+  private:
+    /** \brief The identifiers of the streams. */
+    enum stream_id
+      {
+        level_generation_stream,
+        gameplay_stream,
+        effect_stream,
+        sound_stream,
+        stream_count
+      }; // enum stream_id
+
+  public:
+    static void initialize();
+    static void start_level( const std::string& name );
+
+    static seed_type get_seed();
+    static std::size_t get_level_serial();
+
+    static random_stream& level_generation();
+    static random_stream& gameplay();
+    static random_stream& effects();
+    static random_stream& sounds();
+
+  private:
+    static void seed( seed_type s );
+
+  private:
+    /** \brief The seed given at the start of the game. */
+    static seed_type s_initial_seed;
+
+    /** \brief The seed of the current streams. */
+    static seed_type s_seed;
+
+    /** \brief Incremented each time the streams are seeded for a level. */
+    static std::size_t s_level_serial;
+
+    /** \brief The streams of numbers, by subsystem. */
+    static random_stream s_streams[ stream_count ];
+
+  }; // class random
+} // namespace rp
+
+#endif // __RP_RANDOM_HPP__
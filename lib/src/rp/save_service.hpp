@@ -0,0 +1,119 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The service writing the save file and the configuration in the
+ *        background.
+ * \author Julien Jorge
+ */
+#ifndef __RP_SAVE_SERVICE_HPP__
+#define __RP_SAVE_SERVICE_HPP__
+
+#include "rp/save_snapshot.hpp"
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <map>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief The service writing the save file and the configuration in the
+   *        background.
+   *
+   * The game thread only copies the persistent variables modified since the
+   * previous save. A worker thread merges them with the content of the save
+   * file, formats the file in the binary format, writes it in a temporary
+   * file synchronized on the disk then renames it over the previous one, thus
+   * an interrupted write never leaves a truncated save. The requests received
+   * while the worker waits for the end of the coalescing delay are written
+   * together.
+   *
+   * \author Julien Jorge
+   */
+  class save_service
+  {
+  public:
+    save_service( const save_service& ) = delete;
+    save_service& operator=( const save_service& ) = delete;
+
+    static save_service& get_instance();
+
+    void load_game_variables
+    ( const std::string& file_name, const save_snapshot& variables,
+      bool migrate );
+    void save_game_variables( const std::string& file_name );
+    void save_file( const std::string& file_name, const std::string& content );
+
+    void flush();
+
+  private:
+    save_service();
+    ~save_service();
+
+    void start_worker();
+    void run();
+    void write_pending();
+
+    static bool write_file
+    ( const std::string& file_name, const std::string& content );
+
+  private:
+    /** \brief The worker thread. */
+    boost::thread m_thread;
+
+    /** \brief The mutex protecting the members shared with the worker. */
+    boost::mutex m_mutex;
+
+    /** \brief The condition notified when a request is added. */
+    boost::condition_variable m_request_condition;
+
+    /** \brief The condition notified when the requests have been written. */
+    boost::condition_variable m_done_condition;
+
+    /** \brief Tells the worker to stop. */
+    bool m_quit;
+
+    /** \brief Tells the worker to write the requests without waiting. */
+    bool m_flush;
+
+    /** \brief The number of requests received. */
+    std::size_t m_request_count;
+
+    /** \brief The number of requests written. */
+    std::size_t m_written_count;
+
+    /** \brief The name of the save file of the game variables. */
+    std::string m_save_file_name;
+
+    /** \brief Tells to write the save file even if no variable has changed,
+        in order to convert it in the binary format. */
+    bool m_rewrite;
+
+    /** \brief The variables modified since the last write. */
+    save_snapshot m_pending_variables;
+
+    /** \brief The content of the other files to write, by file name. */
+    std::map<std::string, std::string> m_pending_files;
+
+    /** \brief All the variables of the save file, accessed by the worker
+        only. */
+    save_snapshot m_saved_variables;
+
+    /** \brief How long the worker waits for other requests before writing,
+        in milliseconds. */
+    static const unsigned int s_coalescing_delay;
+
+  }; // class save_service
+} // namespace rp
+
+#endif // __RP_SAVE_SERVICE_HPP__
@@ -0,0 +1,175 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A set of persistent game variables to write in the save file.
+ * \author Julien Jorge
+ */
+#ifndef __RP_SAVE_SNAPSHOT_HPP__
+#define __RP_SAVE_SNAPSHOT_HPP__
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace rp
+{
+  /**
+   * \brief A set of persistent game variables to write in the save file.
+   *
+   * The values are kept with their type and are formatted only when the
+   * snapshot is written, either in the text format read by
+   * bear::engine::variable_list_reader or in a versioned binary format.
+   *
+   * The binary format begins with a header giving the version and the number
+   * of entries of each section, followed by a table of fixed size records for
+   * the persistent variables of the levels (score, state and balloons), then
+   * by the other variables, by type. All the integers are stored in little
+   * endian, the strings are prefixed by their length.
+   *
+   * \author Julien Jorge
+   */
+  class save_snapshot
+  {
+  public:
+    void set( const std::string& name, bool value );
+    void set( const std::string& name, int value );
+    void set( const std::string& name, unsigned int value );
+    void set( const std::string& name, double value );
+    void set( const std::string& name, const std::string& value );
+
+    void merge( const save_snapshot& that );
+    void clear();
+    bool empty() const;
+    std::size_t size() const;
+
+    bool read( std::istream& is );
+    void write( std::ostream& os ) const;
+
+    bool read_binary( const char* data, std::size_t size );
+    void write_binary( std::ostream& os ) const;
+
+    template<typename Visitor>
+    void for_each( Visitor& v ) const;
+
+  private:
+    /**
+     * \brief The persistent variables of a level, stored in the table of the
+     *        binary format.
+     */
+    struct level_record
+    {
+      /** \brief The serial of the level. */
+      unsigned int serial;
+
+      /** \brief The number of the level. */
+      unsigned int number;
+
+      /** \brief The bits telling which fields are set, one per field in
+          s_level_fields. */
+      unsigned int fields;
+
+      /** \brief The values of the fields, in the order of s_level_fields. */
+      unsigned int values[3];
+
+    }; // struct level_record
+
+    /** \brief A cursor in the content of a binary file. */
+    struct binary_input
+    {
+      /** \brief The next byte to read. */
+      const char* position;
+
+      /** \brief The end of the data. */
+      const char* end;
+
+    }; // struct binary_input
+
+  private:
+    template<typename T>
+    static void merge( std::map<std::string, T>& to,
+                       const std::map<std::string, T>& from );
+
+    template<typename T>
+    static void write
+    ( std::ostream& os, const char* type,
+      const std::map<std::string, T>& values );
+
+    template<typename T>
+    static bool parse
+    ( std::map<std::string, T>& values, const std::string& name,
+      const std::string& value );
+
+    static bool read_quoted( std::istream& is, std::string& s );
+    static std::string escape( const std::string& s );
+
+    static bool parse_level_name
+    ( const std::string& name, unsigned int& serial, unsigned int& number,
+      std::size_t& field );
+    static std::string make_level_name
+    ( unsigned int serial, unsigned int number, std::size_t field );
+
+    template<typename T>
+    static void write_binary
+    ( std::ostream& os, const std::map<std::string, T>& values );
+    template<typename T>
+    static bool
+    read_binary( binary_input& in, std::size_t count,
+                 std::map<std::string, T>& values );
+
+    static void write_binary( std::ostream& os, bool value );
+    static void write_binary( std::ostream& os, int value );
+    static void write_binary( std::ostream& os, unsigned int value );
+    static void write_binary( std::ostream& os, double value );
+    static void write_binary( std::ostream& os, const std::string& value );
+
+    static bool read_binary( binary_input& in, bool& value );
+    static bool read_binary( binary_input& in, int& value );
+    static bool read_binary( binary_input& in, unsigned int& value );
+    static bool read_binary( binary_input& in, double& value );
+    static bool read_binary( binary_input& in, std::string& value );
+
+    static void write_uint32( std::ostream& os, uint32_t value );
+    static void write_uint64( std::ostream& os, uint64_t value );
+    static bool read_uint32( binary_input& in, uint32_t& value );
+    static bool read_uint64( binary_input& in, uint64_t& value );
+
+  private:
+    /** \brief The boolean variables. */
+    std::map<std::string, bool> m_bool;
+
+    /** \brief The signed integer variables. */
+    std::map<std::string, int> m_int;
+
+    /** \brief The unsigned integer variables. */
+    std::map<std::string, unsigned int> m_uint;
+
+    /** \brief The real variables. */
+    std::map<std::string, double> m_double;
+
+    /** \brief The string variables. */
+    std::map<std::string, std::string> m_string;
+
+    /** \brief The names of the fields of the level records, as the end of the
+        names of the variables. */
+    static const char* const s_level_fields[3];
+
+    /** \brief The magic number at the beginning of the binary files. */
+    static const char s_binary_magic[4];
+
+    /** \brief The version of the binary format. */
+    static const uint32_t s_binary_version;
+
+  }; // class save_snapshot
+} // namespace rp
+
+#include "rp/impl/save_snapshot.tpp"
+
+#endif // __RP_SAVE_SNAPSHOT_HPP__
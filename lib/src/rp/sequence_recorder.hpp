@@ -0,0 +1,160 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A recorder of a sequence of screenshots, encoded in the background.
+ * \author Julien Jorge
+ */
+#ifndef __RP_SEQUENCE_RECORDER_HPP__
+#define __RP_SEQUENCE_RECORDER_HPP__
+
+#include <claw/image.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <chrono>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A recorder of a sequence of screenshots, encoded in the background.
+   *
+   * The game thread copies the screen in an image buffer taken from a fixed
+   * set of buffers, then queues the buffer for the encoder threads, which
+   * write the image in a file and give the buffer back. When all the buffers
+   * are in use, the frame is dropped and counted instead of waiting for the
+   * encoders, thus the recording never slows the game down.
+   *
+   * When the recording stops, the remaining images are written and a
+   * manifest is written next to them, in a file whose extension is ".seq". Its
+   * first line gives the average number of frames per second, followed by the
+   * count of dropped frames and by the date and the file of each recorded
+   * frame.
+   *
+   * \author Julien Jorge
+   */
+  class sequence_recorder
+  {
+  public:
+    /** \brief The formats of the images. */
+    enum format_type
+      {
+        /** \brief Uncompressed bitmaps. */
+        format_bmp,
+
+        /** \brief PNG images, the smallest but the slowest to encode. */
+        format_png,
+
+        /** \brief QOI images, a fast lossless compression. */
+        format_qoi,
+
+        /** \brief Uncompressed Netpbm PAM images. */
+        format_raw
+
+      }; // enum format_type
+
+  private:
+    /** \brief A frame to encode. */
+    struct job
+    {
+      /** \brief The index of the buffer containing the image. */
+      std::size_t buffer;
+
+      /** \brief The index of the frame in the sequence. */
+      std::size_t frame;
+
+    }; // struct job
+
+    /** \brief A frame in the manifest. */
+    struct frame_entry
+    {
+      /** \brief The date of the capture, in milliseconds since the beginning
+          of the recording. */
+      double date;
+
+      /** \brief The name of the file of the frame. */
+      std::string file_name;
+
+    }; // struct frame_entry
+
+  public:
+    sequence_recorder
+    ( const std::string& path_prefix, format_type format,
+      std::size_t thread_count );
+    sequence_recorder( const sequence_recorder& ) = delete;
+    sequence_recorder& operator=( const sequence_recorder& ) = delete;
+    ~sequence_recorder();
+
+    void capture();
+
+    static format_type get_format( const std::string& name );
+
+  private:
+    void run();
+    bool encode( const claw::graphic::image& image,
+                 const std::string& file_name ) const;
+    std::string get_file_name( std::size_t frame ) const;
+
+    void write_manifest() const;
+
+    static void
+    write_qoi( std::ostream& os, const claw::graphic::image& image );
+    static void
+    write_raw( std::ostream& os, const claw::graphic::image& image );
+
+  private:
+    /** \brief The prefix of the path of the files. */
+    const std::string m_path_prefix;
+
+    /** \brief The format of the images. */
+    const format_type m_format;
+
+    /** \brief The date of the beginning of the recording. */
+    const std::chrono::steady_clock::time_point m_start_date;
+
+    /** \brief The encoder threads. */
+    boost::thread_group m_threads;
+
+    /** \brief The mutex protecting the members shared with the encoders. */
+    boost::mutex m_mutex;
+
+    /** \brief The condition notified when a frame is queued. */
+    boost::condition_variable m_job_condition;
+
+    /** \brief The buffers of the images. */
+    std::vector<claw::graphic::image> m_buffers;
+
+    /** \brief The indices of the buffers not used by a job. */
+    std::vector<std::size_t> m_free_buffers;
+
+    /** \brief The frames waiting for an encoder. */
+    std::deque<job> m_jobs;
+
+    /** \brief The recorded frames. */
+    std::vector<frame_entry> m_frames;
+
+    /** \brief The number of frames dropped because no buffer was free. */
+    std::size_t m_dropped_count;
+
+    /** \brief The number of frames whose file could not be written. */
+    std::size_t m_failed_count;
+
+    /** \brief Tells the encoders to stop when the queue is empty. */
+    bool m_quit;
+
+  }; // class sequence_recorder
+} // namespace rp
+
+#endif // __RP_SEQUENCE_RECORDER_HPP__
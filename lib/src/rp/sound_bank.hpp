@@ -0,0 +1,135 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief The short sound effects played frequently during the game, with a
+ *        limited count of simultaneous voices.
+ * \author Julien Jorge
+ */
+#ifndef __RP_SOUND_BANK_HPP__
+#define __RP_SOUND_BANK_HPP__
+
+#include "engine/base_item.hpp"
+#include "engine/export.hpp"
+
+#include "audio/sample.hpp"
+#include "audio/sound_effect.hpp"
+
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief The short sound effects played frequently during the game, with a
+   *        limited count of simultaneous voices.
+   *
+   * The sounds of the bank are loaded, thus decoded, when the level is
+   * loaded, and the samples playing them are created once when the bank
+   * enters the level. The items play a sound by its identifier, without
+   * searching the sound by its name nor allocating a sample.
+   *
+   * Each sound has a maximum count of voices. When all the voices of a sound
+   * are playing, the oldest one is stopped and used to play the sound again,
+   * such that a chain of explosions does not stack dozens of identical
+   * voices to mix.
+   *
+   * \author Julien Jorge
+   */
+  class sound_bank:
+    public bear::engine::base_item
+  {
+    DECLARE_BASE_ITEM( sound_bank );
+
+  public:
+    /** \brief The type of the parent class. */
+    typedef bear::engine::base_item super;
+
+    /** \brief The identifiers of the sounds of the bank. */
+    enum sample_id
+      {
+        balloon_burst_1_sample,
+        balloon_burst_2_sample,
+        balloon_burst_3_sample,
+        balloon_burst_4_sample,
+        boing_sample,
+        explosion_1_sample,
+        explosion_2_sample,
+        explosion_3_sample,
+        explosion_4_sample,
+        explosion_5_sample,
+        hit_sample,
+        metal_2_sample,
+        metal_3_sample,
+        metal_4_sample,
+        over_sample,
+        wall_break_sample,
+        wall_explose_sample,
+        sample_count
+      }; // enum sample_id
+
+  private:
+    /** \brief The description of a sound of the bank. */
+    struct sample_description
+    {
+      /** \brief The path of the sound. */
+      const char* name;
+
+      /** \brief The maximum count of instances of the sound playing at
+          once. */
+      std::size_t voice_count;
+
+    }; // struct sample_description
+
+  public:
+    sound_bank();
+    ~sound_bank();
+
+    static void load_samples( bear::engine::level_globals& globals );
+
+    static void play
+    ( bear::engine::level_globals& globals, sample_id id,
+      const bear::audio::sound_effect& effect );
+    static void play_random
+    ( bear::engine::level_globals& globals, sample_id first,
+      std::size_t count, const bear::audio::sound_effect& effect );
+
+    void on_enters_layer();
+
+    std::size_t get_played_count() const;
+    std::size_t get_stolen_count() const;
+
+  private:
+    void play_voice( sample_id id, const bear::audio::sound_effect& effect );
+
+  private:
+    /** \brief The samples playing the sounds, grouped by sound. */
+    std::vector<bear::audio::sample*> m_voices;
+
+    /** \brief The value of m_played_count when each voice was started. */
+    std::vector<std::size_t> m_voice_start;
+
+    /** \brief The index in m_voices of the first voice of each sound. */
+    std::size_t m_first_voice[ sample_count + 1 ];
+
+    /** \brief The count of sounds played with the bank. */
+    std::size_t m_played_count;
+
+    /** \brief The count of voices stopped to play a new sound. */
+    std::size_t m_stolen_count;
+
+    /** \brief The bank of the current level. */
+    static sound_bank* s_instance;
+
+    /** \brief The sounds of the bank. */
+    static const sample_description s_samples[ sample_count ];
+
+  }; // class sound_bank
+} // namespace rp
+
+#endif // __RP_SOUND_BANK_HPP__
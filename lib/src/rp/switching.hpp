@@ -14,6 +14,7 @@
 #ifndef __RP_SWITCHING_HPP__
 #define __RP_SWITCHING_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/entity.hpp"
 #include "engine/model.hpp"
 #include "engine/base_item.hpp"
@@ -65,6 +66,7 @@ namespace rp
     void pre_cache();
     bool is_valid();
     void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
 
     bool set_string_field( const std::string& name, const std::string& value );
     bool set_real_field( const std::string& name, double value );
@@ -126,6 +128,9 @@ namespace rp
     /** \brief The block that kills the cart when the switching is moving. */
     hole* m_hole;
 
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
+
   }; // class switching
 } // namespace rp
 
@@ -14,6 +14,7 @@
 #ifndef __RP_TAR_HPP__
 #define __RP_TAR_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/entity.hpp"
 
 #include "engine/model.hpp"
@@ -69,6 +70,9 @@ namespace rp
         collision check. */
     bool m_cart_contact;
 
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
+
   }; // class tar
 } // namespace rp
 
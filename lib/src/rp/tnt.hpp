@@ -14,6 +14,7 @@
 #ifndef __RP_TNT_HPP__
 #define __RP_TNT_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/obstacle.hpp"
 #include "engine/export.hpp"
 
@@ -43,6 +44,7 @@ namespace rp
 
     void pre_cache();
     void on_enters_layer();
+    void progress( bear::universe::time_type elapsed_time );
     
     void collision
     ( bear::engine::base_item& that, bear::universe::collision_info& info );
@@ -70,6 +72,9 @@ namespace rp
   private:
     /** \brief Indicates if the bomb has been explosed. */
     bool m_explosed;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class tnt
 } // namespace rp
 
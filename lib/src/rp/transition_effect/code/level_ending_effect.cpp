@@ -17,6 +17,7 @@
 #include "rp/defines.hpp"
 #include "rp/rp_gettext.hpp"
 #include "rp/cart.hpp"
+#include "rp/profiler.hpp"
 #include "rp/util.hpp"
 #include "rp/events/make_event_property.hpp"
 #include "rp/events/tag_level_event.hpp"
@@ -62,7 +63,7 @@ static constexpr bear::universe::time_type s_intro_duration( 1 );
  */
 rp::level_ending_effect::score_line::score_line
 ( const bear::visual::font& f, const std::string& text, int points )
-  : m_font(f), m_label(m_font, text), 
+  : m_font(f), m_label(m_font, text), m_points_text(m_font),
     m_total_points( points ),
     m_current_points(0), m_y(0), m_negative( points < 0 )
 {
@@ -85,6 +86,7 @@ rp::level_ending_effect::score_line::score_line
   : m_font(f), m_label(m_font, text), 
     m_computation_label(m_font, count),
     m_computation_coefficient_label(m_font, coeff),
+    m_points_text(m_font),
     m_total_points(points),
     m_current_points(0), m_y(0), m_negative( points < 0 )
 {
@@ -129,8 +131,9 @@ void rp::level_ending_effect::score_line::render
   
   result.push_back( computation_label );
 
-  bear::visual::scene_writing points
-    ( right - m_points_text.get_width(), y, m_points_text);
+  bear::visual::scene_element_sequence points
+    ( m_points_text.get_scene_element
+      ( right - m_points_text.get_width(), y ) );
 
   if ( m_total_points < 0 )
     points.get_rendering_attributes().set_intensity( 0.82, 0.14, 0.14 );
@@ -157,10 +160,7 @@ int rp::level_ending_effect::score_line::update_score( int delta )
   else
     m_current_points = std::min( m_total_points, m_current_points + delta );
 
-  std::ostringstream oss;
-
-  oss << m_current_points;
-  m_points_text.create(m_font, oss.str());
+  m_points_text.set_value( m_current_points );
 
   return m_current_points - old_score;
 } // level_ending_effect::score_line::update_score()
@@ -414,7 +414,9 @@ void rp::level_ending_effect::build()
  */
 bear::universe::time_type
 rp::level_ending_effect::progress( bear::universe::time_type elapsed_time )
-{  
+{
+  RP_PROFILE_ZONE( "transition/ending/progress" );
+
   if ( get_level().is_paused() )
     return elapsed_time;
 
@@ -490,6 +492,8 @@ rp::level_ending_effect::progress( bear::universe::time_type elapsed_time )
  */
 void rp::level_ending_effect::render( scene_element_list& e ) const
 {
+  RP_PROFILE_ZONE( "transition/ending/render" );
+
   if ( m_age < s_intro_duration )
     return;
   
@@ -26,6 +26,7 @@
 #include "visual/scene_rectangle.hpp"
 
 #include "rp/defines.hpp"
+#include "rp/profiler.hpp"
 
 #include <algorithm>
 
@@ -86,6 +87,8 @@ void rp::level_starting_effect::build()
 bear::universe::time_type
 rp::level_starting_effect::progress( bear::universe::time_type elapsed_time )
 {
+  RP_PROFILE_ZONE( "transition/starting/progress" );
+
   bear::universe::time_type result(0);
 
   if ( ! get_level().is_paused() )
@@ -130,6 +133,8 @@ rp::level_starting_effect::progress( bear::universe::time_type elapsed_time )
  */
 void rp::level_starting_effect::render( scene_element_list& e ) const
 {
+  RP_PROFILE_ZONE( "transition/starting/render" );
+
   bear::visual::coordinate_type y_panel;
   const bear::visual::position_type center
         ( get_layer().get_size().x / 2, get_layer().get_size().y / 2);
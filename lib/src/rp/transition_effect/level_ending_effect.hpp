@@ -14,6 +14,8 @@
 #ifndef __RP_LEVEL_ENDING_EFFECT_HPP__
 #define __RP_LEVEL_ENDING_EFFECT_HPP__
 
+#include "rp/digit_writing.hpp"
+
 #include "audio/sound_manager.hpp"
 
 #include "communication/messageable.hpp"
@@ -89,7 +91,7 @@ namespace rp
       bear::visual::writing m_computation_coefficient_label;
 
       /** \brief The remaining points, as a text. */
-      bear::visual::writing m_points_text;
+      digit_writing m_points_text;
 
       /** \brief The total number of points. */
       const int m_total_points;
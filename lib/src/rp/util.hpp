@@ -18,6 +18,8 @@
 
 namespace rp
 {
+  class save_snapshot;
+
   /**
    * \brief Utility functions about roller painting.
    * \author Sbastien angibaud
@@ -68,6 +70,8 @@ namespace rp
 
     static void apply_random_smoke_effect( bear::engine::base_item& item );
 
+    static bool load_text_game_variables( save_snapshot& variables );
+
   }; // class util
 
 } // namespace rp
@@ -14,6 +14,7 @@
 #ifndef __RP_WALL_HPP__
 #define __RP_WALL_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/entity.hpp"
 
 #include "engine/base_item.hpp"
@@ -87,6 +88,9 @@ namespace rp
 
     /* \brief Number of impacts on the bottom section.*/
     unsigned int m_bottom_impacts;
+
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class wall
 } // namespace rp
 
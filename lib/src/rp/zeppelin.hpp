@@ -14,6 +14,7 @@
 #ifndef __RP_ZEPPELIN_HPP__
 #define __RP_ZEPPELIN_HPP__
 
+#include "rp/action_score.hpp"
 #include "rp/entity.hpp"
 
 #include "engine/base_item.hpp"
@@ -105,6 +106,8 @@ namespace rp
     /** \brief The item to drop. */
     handle_type m_drop_item;
 
+    /** \brief The contribution of the item to the score of the action. */
+    action_score m_action_score;
   }; // class zeppelin
 } // namespace rp
 
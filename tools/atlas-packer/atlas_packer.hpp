@@ -0,0 +1,198 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool repacking the parts of a set of images used by the game in
+ *        texture atlases.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ATLAS_PACKER_HPP__
+#define __RP_ATLAS_PACKER_HPP__
+
+#include "rgba_image.hpp"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A tool repacking the parts of a set of images used by the game in
+   *        texture atlases.
+   *
+   * The used parts of an image are the rectangles listed in the .spritepos
+   * file next to the image and the rectangles referenced by the resources of
+   * the game (levels, models, animations), where a sprite is written as the
+   * path of the image followed by the position and the size of the rectangle.
+   * The overlapping rectangles of an image are merged in a block, which is
+   * copied in a page of the atlas with a margin of one pixel taken from the
+   * source image, such that the filtering of the texture gives the same
+   * colors on the edges of the sprites.
+   *
+   * The images which are entirely used and whose size is a power of two are
+   * not repacked, nor are the images which are not used.
+   *
+   * The description of the atlas is a text file where each line is either
+   *
+   * <tt>page path width height</tt>
+   *
+   * or
+   *
+   * <tt>block image x y width height page x y</tt>
+   *
+   * telling that the block at (x, y) with the given size in the image is
+   * copied in the page whose index is given, at the position following the
+   * index.
+   *
+   * \author Julien Jorge
+   */
+  class atlas_packer
+  {
+  private:
+    /** \brief A rectangle in an image. */
+    struct rectangle
+    {
+      rectangle();
+      rectangle( int x, int y, int w, int h );
+
+      int right() const;
+      int bottom() const;
+
+      bool intersects( const rectangle& that ) const;
+      bool contains( const rectangle& that ) const;
+      rectangle join( const rectangle& that ) const;
+
+      /** \brief The left edge. */
+      int x;
+
+      /** \brief The top edge. */
+      int y;
+
+      /** \brief The width of the rectangle. */
+      int width;
+
+      /** \brief The height of the rectangle. */
+      int height;
+
+    }; // struct rectangle
+
+    /** \brief A rectangle of an image copied in the atlas. */
+    struct block
+    {
+      /** \brief The index of the image in atlas_packer::m_images. */
+      std::size_t image;
+
+      /** \brief The rectangle in the image. */
+      rectangle source;
+
+      /** \brief The index of the page in the atlas. */
+      std::size_t page;
+
+      /** \brief The position of the block in the page, margin excluded. */
+      int x;
+
+      /** \brief The position of the block in the page, margin excluded. */
+      int y;
+
+    }; // struct block
+
+    /** \brief An image to repack. */
+    struct source_image
+    {
+      /** \brief The path of the image, relative to the data directory. */
+      std::string name;
+
+      /** \brief The pixels of the image. */
+      rgba_image pixels;
+
+      /** \brief The rectangles used in the image. */
+      std::vector<rectangle> used;
+
+      /** \brief Tell if the image is repacked in the atlas. */
+      bool packed;
+
+    }; // struct source_image
+
+    /** \brief A page of the atlas being built. */
+    struct page
+    {
+      /** \brief The free rectangles of the page. */
+      std::vector<rectangle> free;
+
+      /** \brief The width of the part of the page containing blocks. */
+      int width;
+
+      /** \brief The height of the part of the page containing blocks. */
+      int height;
+
+    }; // struct page
+
+  public:
+    atlas_packer( const std::string& data_dir, const std::string& name );
+
+    bool add_image( const std::string& name );
+    void add_references( std::istream& is );
+
+    void pack();
+    bool write( const std::string& output_dir ) const;
+    bool check( const std::string& output_dir ) const;
+
+    void print_report( std::ostream& os ) const;
+
+  private:
+    bool read_sprite_positions( source_image& image ) const;
+    void add_used_rectangle( source_image& image, const rectangle& r ) const;
+
+    void merge_blocks( std::vector<block>& blocks ) const;
+    bool is_kept( const source_image& image ) const;
+
+    void pack_pages
+    ( std::vector<block>& blocks, int width, int height,
+      std::vector<int>& page_width, std::vector<int>& page_height ) const;
+    void shrink_pages
+    ( std::vector<block>& blocks, std::vector<int>& page_width,
+      std::vector<int>& page_height ) const;
+    bool insert_block( page& p, block& b ) const;
+    void split_free_rectangles( page& p, const rectangle& r ) const;
+
+    std::string get_page_name( std::size_t i ) const;
+    rgba_image render_page( std::size_t i ) const;
+
+    static int get_power_of_two( int v );
+
+  private:
+    /** \brief The directory containing the images. */
+    const std::string m_data_dir;
+
+    /** \brief The name of the atlas, relative to the data directory. */
+    const std::string m_name;
+
+    /** \brief The images to repack. */
+    std::vector<source_image> m_images;
+
+    /** \brief The blocks of the atlas. */
+    std::vector<block> m_blocks;
+
+    /** \brief The width of the pages of the atlas. */
+    std::vector<int> m_page_width;
+
+    /** \brief The height of the pages of the atlas. */
+    std::vector<int> m_page_height;
+
+    /** \brief The size of the margin around the blocks. */
+    static const int s_margin;
+
+    /** \brief The maximum sizes of the pages tried when packing. */
+    static const int s_page_sizes[];
+
+  }; // class atlas_packer
+} // namespace rp
+
+#endif // __RP_ATLAS_PACKER_HPP__
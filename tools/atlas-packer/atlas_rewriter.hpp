@@ -0,0 +1,96 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool replacing the references to the images of the resources by
+ *        references to the pages of the atlases.
+ * \author Julien Jorge
+ */
+#ifndef __RP_ATLAS_REWRITER_HPP__
+#define __RP_ATLAS_REWRITER_HPP__
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A tool replacing the references to the images of the resources by
+   *        references to the pages of the atlases.
+   *
+   * The resources are read with one value per line, as in the compiled levels,
+   * models and animations, where a sprite is the path of the image followed by
+   * the position and the size of the rectangle. When the rectangle is in a
+   * block of an atlas, the path and the position are replaced by the path of
+   * the page and the position in the page. The other values are copied as is.
+   *
+   * \author Julien Jorge
+   */
+  class atlas_rewriter
+  {
+  private:
+    /** \brief A rectangle of an image copied in a page of an atlas. */
+    struct block
+    {
+      /** \brief The left edge of the block in the image. */
+      int x;
+
+      /** \brief The top edge of the block in the image. */
+      int y;
+
+      /** \brief The width of the block. */
+      int width;
+
+      /** \brief The height of the block. */
+      int height;
+
+      /** \brief The path of the page containing the block. */
+      std::string page;
+
+      /** \brief The left edge of the block in the page. */
+      int page_x;
+
+      /** \brief The top edge of the block in the page. */
+      int page_y;
+
+    }; // struct block
+
+    /** \brief The blocks of each image, by image path. */
+    typedef std::map< std::string, std::vector<block> > block_map;
+
+  public:
+    atlas_rewriter();
+
+    bool read_atlas( std::istream& is );
+    void rewrite( std::istream& is, std::ostream& os );
+
+    std::size_t get_rewritten_count() const;
+    std::size_t get_unmapped_count() const;
+
+  private:
+    const block* find_block
+    ( const std::vector<block>& blocks, int x, int y, int w, int h ) const;
+
+  private:
+    /** \brief The blocks of the atlases. */
+    block_map m_blocks;
+
+    /** \brief The count of references replaced by rewrite(). */
+    std::size_t m_rewritten_count;
+
+    /** \brief The count of references to a packed image which are in no
+        block. */
+    std::size_t m_unmapped_count;
+
+  }; // class atlas_rewriter
+} // namespace rp
+
+#endif // __RP_ATLAS_REWRITER_HPP__
@@ -0,0 +1,802 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::atlas_packer class.
+ * \author Julien Jorge
+ */
+#include "atlas_packer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+const int rp::atlas_packer::s_margin( 1 );
+const int rp::atlas_packer::s_page_sizes[] = { 512, 1024, 2048, 0 };
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read an integer written alone on a line.
+ * \param line The line to read.
+ * \param v (out) The integer.
+ */
+static bool parse_integer( const std::string& line, int& v )
+{
+  if ( line.empty() )
+    return false;
+
+  char* end;
+  const long result( std::strtol( line.c_str(), &end, 10 ) );
+
+  if ( *end != '\0' )
+    return false;
+
+  v = result;
+  return true;
+} // parse_integer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor of an empty rectangle.
+ */
+rp::atlas_packer::rectangle::rectangle()
+  : x(0), y(0), width(0), height(0)
+{
+
+} // atlas_packer::rectangle::rectangle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param x The left edge.
+ * \param y The top edge.
+ * \param w The width of the rectangle.
+ * \param h The height of the rectangle.
+ */
+rp::atlas_packer::rectangle::rectangle( int x, int y, int w, int h )
+  : x(x), y(y), width(w), height(h)
+{
+
+} // atlas_packer::rectangle::rectangle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position following the right edge of the rectangle.
+ */
+int rp::atlas_packer::rectangle::right() const
+{
+  return x + width;
+} // atlas_packer::rectangle::right()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the position following the bottom edge of the rectangle.
+ */
+int rp::atlas_packer::rectangle::bottom() const
+{
+  return y + height;
+} // atlas_packer::rectangle::bottom()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if this rectangle shares some pixels with another one.
+ * \param that The other rectangle.
+ */
+bool rp::atlas_packer::rectangle::intersects( const rectangle& that ) const
+{
+  return ( x < that.right() ) && ( that.x < right() )
+    && ( y < that.bottom() ) && ( that.y < bottom() );
+} // atlas_packer::rectangle::intersects()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if this rectangle contains another one.
+ * \param that The other rectangle.
+ */
+bool rp::atlas_packer::rectangle::contains( const rectangle& that ) const
+{
+  return ( x <= that.x ) && ( that.right() <= right() )
+    && ( y <= that.y ) && ( that.bottom() <= bottom() );
+} // atlas_packer::rectangle::contains()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the smallest rectangle containing this rectangle and another one.
+ * \param that The other rectangle.
+ */
+rp::atlas_packer::rectangle
+rp::atlas_packer::rectangle::join( const rectangle& that ) const
+{
+  const int left( std::min( x, that.x ) );
+  const int top( std::min( y, that.y ) );
+
+  return rectangle
+    ( left, top, std::max( right(), that.right() ) - left,
+      std::max( bottom(), that.bottom() ) - top );
+} // atlas_packer::rectangle::join()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param data_dir The directory containing the images.
+ * \param name The name of the atlas, relative to the data directory.
+ */
+rp::atlas_packer::atlas_packer
+( const std::string& data_dir, const std::string& name )
+  : m_data_dir( data_dir ), m_name( name )
+{
+
+} // atlas_packer::atlas_packer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add an image to repack.
+ * \param name The path of the image, relative to the data directory.
+ */
+bool rp::atlas_packer::add_image( const std::string& name )
+{
+  source_image image;
+  image.name = name;
+  image.packed = false;
+
+  if ( !image.pixels.load( m_data_dir + '/' + name ) )
+    {
+      std::cerr << "Can't read the image '" << name << "'." << std::endl;
+      return false;
+    }
+
+  if ( !read_sprite_positions( image ) )
+    return false;
+
+  m_images.push_back( image );
+  return true;
+} // atlas_packer::add_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add the rectangles of the images referenced by a resource of the
+ *        game, written with one value per line.
+ * \param is The stream from which the resource is read.
+ */
+void rp::atlas_packer::add_references( std::istream& is )
+{
+  std::vector<std::string> lines;
+  std::string line;
+
+  while ( std::getline( is, line ) )
+    lines.push_back( line );
+
+  for ( std::size_t i(0); i + 4 < lines.size(); ++i )
+    for ( std::size_t j(0); j != m_images.size(); ++j )
+      if ( lines[i] == m_images[j].name )
+        {
+          rectangle r;
+
+          if ( parse_integer( lines[i + 1], r.x )
+               && parse_integer( lines[i + 2], r.y )
+               && parse_integer( lines[i + 3], r.width )
+               && parse_integer( lines[i + 4], r.height ) )
+            add_used_rectangle( m_images[j], r );
+
+          break;
+        }
+} // atlas_packer::add_references()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Build the blocks of the images and place them in the pages of the
+ *        atlas.
+ *
+ * The blocks are packed in pages of several maximum sizes, then each page is
+ * reduced to the smallest power of two size in which its blocks can be
+ * packed. The packing giving the smallest area of textures is kept.
+ */
+void rp::atlas_packer::pack()
+{
+  std::vector<block> blocks;
+  int min_width( 0 );
+  int min_height( 0 );
+
+  for ( std::size_t i(0); i != m_images.size(); ++i )
+    {
+      std::vector<block> image_blocks;
+
+      for ( std::size_t j(0); j != m_images[i].used.size(); ++j )
+        {
+          block b;
+          b.image = i;
+          b.source = m_images[i].used[j];
+          image_blocks.push_back( b );
+        }
+
+      merge_blocks( image_blocks );
+      m_images[i].packed = !image_blocks.empty() && !is_kept( m_images[i] );
+
+      if ( m_images[i].packed )
+        for ( std::size_t j(0); j != image_blocks.size(); ++j )
+          {
+            blocks.push_back( image_blocks[j] );
+            min_width = std::max
+              ( min_width, image_blocks[j].source.width + 2 * s_margin );
+            min_height = std::max
+              ( min_height, image_blocks[j].source.height + 2 * s_margin );
+          }
+    }
+
+  m_blocks.clear();
+  m_page_width.clear();
+  m_page_height.clear();
+
+  if ( blocks.empty() )
+    return;
+
+  std::sort
+    ( blocks.begin(), blocks.end(),
+      []( const block& a, const block& b ) -> bool
+      {
+        if ( a.source.height != b.source.height )
+          return a.source.height > b.source.height;
+        else
+          return a.source.width > b.source.width;
+      } );
+
+  std::size_t best_area( std::numeric_limits<std::size_t>::max() );
+
+  for ( std::size_t w(0); s_page_sizes[w] != 0; ++w )
+    for ( std::size_t h(0); s_page_sizes[h] != 0; ++h )
+      if ( ( s_page_sizes[w] >= min_width )
+           && ( s_page_sizes[h] >= min_height ) )
+        {
+          std::vector<block> candidate( blocks );
+          std::vector<int> widths;
+          std::vector<int> heights;
+
+          pack_pages
+            ( candidate, s_page_sizes[w], s_page_sizes[h], widths, heights );
+          shrink_pages( candidate, widths, heights );
+
+          std::size_t area( 0 );
+
+          for ( std::size_t i(0); i != widths.size(); ++i )
+            area += widths[i] * heights[i];
+
+          if ( ( area < best_area )
+               || ( ( area == best_area )
+                    && ( widths.size() < m_page_width.size() ) ) )
+            {
+              best_area = area;
+              m_blocks.swap( candidate );
+              m_page_width.swap( widths );
+              m_page_height.swap( heights );
+            }
+        }
+
+  // The images whose blocks are too large for the pages are kept unchanged.
+  if ( m_blocks.empty() )
+    for ( std::size_t i(0); i != m_images.size(); ++i )
+      m_images[i].packed = false;
+} // atlas_packer::pack()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the pages of the atlas and its description.
+ * \param output_dir The directory where the atlas is written.
+ */
+bool rp::atlas_packer::write( const std::string& output_dir ) const
+{
+  const std::string path( output_dir + '/' + m_name + ".atlas" );
+  std::ofstream os( path.c_str() );
+
+  for ( std::size_t i(0); i != m_page_width.size(); ++i )
+    {
+      const std::string page_name( get_page_name( i ) );
+
+      if ( !render_page( i ).save( output_dir + '/' + page_name ) )
+        {
+          std::cerr << "Can't write the page '" << page_name << "'."
+                    << std::endl;
+          return false;
+        }
+
+      os << "page " << page_name << ' ' << m_page_width[i] << ' '
+         << m_page_height[i] << '\n';
+    }
+
+  for ( std::size_t i(0); i != m_blocks.size(); ++i )
+    {
+      const block& b( m_blocks[i] );
+
+      os << "block " << m_images[ b.image ].name << ' ' << b.source.x << ' '
+         << b.source.y << ' ' << b.source.width << ' ' << b.source.height
+         << ' ' << b.page << ' ' << b.x << ' ' << b.y << '\n';
+    }
+
+  if ( !os )
+    {
+      std::cerr << "Can't write '" << path << "'." << std::endl;
+      return false;
+    }
+
+  return true;
+} // atlas_packer::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Decode the pages written by write() and compare the blocks, margins
+ *        included, with the pixels of the source images.
+ * \param output_dir The directory where the atlas has been written.
+ */
+bool rp::atlas_packer::check( const std::string& output_dir ) const
+{
+  std::vector<rgba_image> pages( m_page_width.size() );
+  bool result( true );
+
+  for ( std::size_t i(0); i != pages.size(); ++i )
+    if ( !pages[i].load( output_dir + '/' + get_page_name( i ) )
+         || ( (int)pages[i].width() != m_page_width[i] )
+         || ( (int)pages[i].height() != m_page_height[i] ) )
+      {
+        std::cerr << "The page '" << get_page_name( i )
+                  << "' can't be read or has a wrong size." << std::endl;
+        return false;
+      }
+
+  for ( std::size_t i(0); i != m_blocks.size(); ++i )
+    {
+      const block& b( m_blocks[i] );
+      const rgba_image& source( m_images[ b.image ].pixels );
+      std::size_t errors( 0 );
+
+      for ( int y(-s_margin); y != b.source.height + s_margin; ++y )
+        for ( int x(-s_margin); x != b.source.width + s_margin; ++x )
+          if ( pages[ b.page ].get_pixel( b.x + x, b.y + y )
+               != source.get_pixel( b.source.x + x, b.source.y + y ) )
+            ++errors;
+
+      if ( errors != 0 )
+        {
+          std::cerr << errors << " pixels differ in the block at ("
+                    << b.source.x << ", " << b.source.y << ") of '"
+                    << m_images[ b.image ].name << "'." << std::endl;
+          result = false;
+        }
+    }
+
+  return result;
+} // atlas_packer::check()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the sizes of the textures before and after the packing.
+ * \param os The stream in which the report is written.
+ */
+void rp::atlas_packer::print_report( std::ostream& os ) const
+{
+  std::size_t packed( 0 );
+  std::size_t unused( 0 );
+  std::size_t source_texels( 0 );
+  std::size_t texture_texels( 0 );
+
+  for ( std::size_t i(0); i != m_images.size(); ++i )
+    if ( m_images[i].packed )
+      {
+        const int w( m_images[i].pixels.width() );
+        const int h( m_images[i].pixels.height() );
+
+        ++packed;
+        source_texels += w * h;
+        texture_texels += get_power_of_two( w ) * get_power_of_two( h );
+      }
+    else if ( m_images[i].used.empty() )
+      ++unused;
+
+  std::size_t atlas_texels( 0 );
+  std::size_t used_texels( 0 );
+
+  for ( std::size_t i(0); i != m_page_width.size(); ++i )
+    atlas_texels += m_page_width[i] * m_page_height[i];
+
+  for ( std::size_t i(0); i != m_blocks.size(); ++i )
+    used_texels += m_blocks[i].source.width * m_blocks[i].source.height;
+
+  os << m_name << ": " << packed << " images packed in "
+     << m_page_width.size() << " pages, "
+     << ( m_images.size() - packed - unused ) << " kept, " << unused
+     << " unused.\n"
+     << "  source texels: " << source_texels << " (" << texture_texels
+     << " in power-of-two textures)\n"
+     << "  atlas texels:  " << atlas_texels << '\n'
+     << "  used texels:   " << used_texels << '\n'
+     << "  wasted texels: " << ( atlas_texels - used_texels );
+
+  if ( atlas_texels != 0 )
+    os << " (" << ( 100 * ( atlas_texels - used_texels ) / atlas_texels )
+       << "%)";
+
+  os << '\n';
+
+  for ( std::size_t i(0); i != m_page_width.size(); ++i )
+    os << "  page " << get_page_name( i ) << ": " << m_page_width[i] << 'x'
+       << m_page_height[i] << '\n';
+} // atlas_packer::print_report()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the rectangles of the sprites from the .spritepos file next to
+ *        an image, if any.
+ * \param image The image whose sprites are read.
+ *
+ * Each line of the file is the name of the sprite, a colon, then the position
+ * and the size of the rectangle.
+ */
+bool
+rp::atlas_packer::read_sprite_positions( source_image& image ) const
+{
+  const std::string::size_type dot( image.name.rfind( '.' ) );
+  const std::string path
+    ( m_data_dir + '/' + image.name.substr( 0, dot ) + ".spritepos" );
+  std::ifstream f( path.c_str() );
+  std::string line;
+
+  while ( std::getline( f, line ) )
+    {
+      const std::string::size_type colon( line.rfind( ':' ) );
+
+      if ( colon == std::string::npos )
+        continue;
+
+      std::istringstream iss( line.substr( colon + 1 ) );
+      rectangle r;
+
+      if ( iss >> r.x >> r.y >> r.width >> r.height )
+        add_used_rectangle( image, r );
+      else
+        {
+          std::cerr << "Invalid sprite position in '" << path << "': '"
+                    << line << "'." << std::endl;
+          return false;
+        }
+    }
+
+  return true;
+} // atlas_packer::read_sprite_positions()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a rectangle in the used parts of an image, restricted to the
+ *        bounds of the image.
+ * \param image The image.
+ * \param r The rectangle.
+ */
+void rp::atlas_packer::add_used_rectangle
+( source_image& image, const rectangle& r ) const
+{
+  const int left( std::max( r.x, 0 ) );
+  const int top( std::max( r.y, 0 ) );
+  const int right( std::min( r.right(), (int)image.pixels.width() ) );
+  const int bottom( std::min( r.bottom(), (int)image.pixels.height() ) );
+
+  if ( ( left < right ) && ( top < bottom ) )
+    image.used.push_back( rectangle( left, top, right - left, bottom - top ) );
+} // atlas_packer::add_used_rectangle()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Replace the overlapping blocks of an image by the box around them.
+ * \param blocks The blocks of the image.
+ */
+void rp::atlas_packer::merge_blocks( std::vector<block>& blocks ) const
+{
+  bool merged( true );
+
+  while ( merged )
+    {
+      merged = false;
+
+      for ( std::size_t i(0); i < blocks.size(); ++i )
+        for ( std::size_t j(i + 1); j < blocks.size(); )
+          if ( blocks[i].source.intersects( blocks[j].source ) )
+            {
+              blocks[i].source = blocks[i].source.join( blocks[j].source );
+              blocks.erase( blocks.begin() + j );
+              merged = true;
+            }
+          else
+            ++j;
+    }
+} // atlas_packer::merge_blocks()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if an image is better kept as is than repacked, i.e. if it is
+ *        entirely used and its sides are powers of two.
+ * \param image The image.
+ */
+bool rp::atlas_packer::is_kept( const source_image& image ) const
+{
+  const int w( image.pixels.width() );
+  const int h( image.pixels.height() );
+
+  if ( ( get_power_of_two( w ) != w ) || ( get_power_of_two( h ) != h ) )
+    return false;
+
+  const rectangle all( 0, 0, w, h );
+  rectangle box( image.used.front() );
+
+  for ( std::size_t i(1); i != image.used.size(); ++i )
+    box = box.join( image.used[i] );
+
+  return box.contains( all );
+} // atlas_packer::is_kept()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Place the blocks in pages of a given maximum size.
+ * \param blocks (in/out) The blocks to place, updated with their position.
+ * \param width The maximum width of the pages.
+ * \param height The maximum height of the pages.
+ * \param page_width (out) The power of two width of each page.
+ * \param page_height (out) The power of two height of each page.
+ */
+void rp::atlas_packer::pack_pages
+( std::vector<block>& blocks, int width, int height,
+  std::vector<int>& page_width, std::vector<int>& page_height ) const
+{
+  std::vector<page> pages;
+
+  for ( std::size_t i(0); i != blocks.size(); ++i )
+    {
+      bool inserted( false );
+
+      for ( std::size_t j(0); !inserted && ( j != pages.size() ); ++j )
+        if ( insert_block( pages[j], blocks[i] ) )
+          {
+            blocks[i].page = j;
+            inserted = true;
+          }
+
+      if ( !inserted )
+        {
+          page p;
+          p.free.push_back( rectangle( 0, 0, width, height ) );
+          p.width = 0;
+          p.height = 0;
+
+          insert_block( p, blocks[i] );
+          blocks[i].page = pages.size();
+          pages.push_back( p );
+        }
+    }
+
+  page_width.resize( pages.size() );
+  page_height.resize( pages.size() );
+
+  for ( std::size_t i(0); i != pages.size(); ++i )
+    {
+      page_width[i] = get_power_of_two( pages[i].width );
+      page_height[i] = get_power_of_two( pages[i].height );
+    }
+} // atlas_packer::pack_pages()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pack again the blocks of each page in the smallest power of two page
+ *        in which they fit.
+ * \param blocks (in/out) The blocks, updated with their new position.
+ * \param page_width (in/out) The width of each page.
+ * \param page_height (in/out) The height of each page.
+ */
+void rp::atlas_packer::shrink_pages
+( std::vector<block>& blocks, std::vector<int>& page_width,
+  std::vector<int>& page_height ) const
+{
+  for ( std::size_t i(0); i != page_width.size(); ++i )
+    {
+      std::vector<block> page_blocks;
+      int min_width( 1 );
+      int min_height( 1 );
+
+      for ( std::size_t j(0); j != blocks.size(); ++j )
+        if ( blocks[j].page == i )
+          {
+            page_blocks.push_back( blocks[j] );
+            min_width = std::max
+              ( min_width, blocks[j].source.width + 2 * s_margin );
+            min_height = std::max
+              ( min_height, blocks[j].source.height + 2 * s_margin );
+          }
+
+      std::vector<block> best;
+
+      for ( int w( get_power_of_two( min_width ) ); w <= page_width[i];
+            w *= 2 )
+        for ( int h( get_power_of_two( min_height ) ); h <= page_height[i];
+              h *= 2 )
+          if ( w * h < page_width[i] * page_height[i] )
+            {
+              std::vector<block> candidate( page_blocks );
+              std::vector<int> widths;
+              std::vector<int> heights;
+
+              pack_pages( candidate, w, h, widths, heights );
+
+              if ( widths.size() == 1 )
+                {
+                  best.swap( candidate );
+                  page_width[i] = widths[0];
+                  page_height[i] = heights[0];
+                }
+            }
+
+      for ( std::size_t j(0), k(0);
+            ( k != best.size() ) && ( j != blocks.size() ); ++j )
+        if ( blocks[j].page == i )
+          {
+            blocks[j] = best[k];
+            blocks[j].page = i;
+            ++k;
+          }
+    }
+} // atlas_packer::shrink_pages()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Place a block in the free rectangle of a page which leaves the
+ *        shortest remaining side.
+ * \param p The page in which the block is inserted.
+ * \param b (in/out) The block, updated with its position in the page.
+ */
+bool rp::atlas_packer::insert_block( page& p, block& b ) const
+{
+  const int w( b.source.width + 2 * s_margin );
+  const int h( b.source.height + 2 * s_margin );
+  int best_side( std::numeric_limits<int>::max() );
+  std::size_t best( p.free.size() );
+
+  for ( std::size_t i(0); i != p.free.size(); ++i )
+    if ( ( p.free[i].width >= w ) && ( p.free[i].height >= h ) )
+      {
+        const int side
+          ( std::min( p.free[i].width - w, p.free[i].height - h ) );
+
+        if ( side < best_side )
+          {
+            best_side = side;
+            best = i;
+          }
+      }
+
+  if ( best == p.free.size() )
+    return false;
+
+  const rectangle r( p.free[best].x, p.free[best].y, w, h );
+
+  b.x = r.x + s_margin;
+  b.y = r.y + s_margin;
+  p.width = std::max( p.width, r.right() );
+  p.height = std::max( p.height, r.bottom() );
+
+  split_free_rectangles( p, r );
+
+  return true;
+} // atlas_packer::insert_block()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Remove a rectangle from the free rectangles of a page.
+ * \param p The page.
+ * \param r The rectangle occupied by a block.
+ *
+ * Each free rectangle intersecting \a r is replaced by the maximal parts of
+ * it not intersecting \a r, then the free rectangles contained in another one
+ * are removed.
+ */
+void
+rp::atlas_packer::split_free_rectangles( page& p, const rectangle& r ) const
+{
+  std::vector<rectangle> result;
+
+  for ( std::size_t i(0); i != p.free.size(); ++i )
+    {
+      const rectangle& f( p.free[i] );
+
+      if ( !f.intersects( r ) )
+        result.push_back( f );
+      else
+        {
+          if ( r.x > f.x )
+            result.push_back( rectangle( f.x, f.y, r.x - f.x, f.height ) );
+
+          if ( r.right() < f.right() )
+            result.push_back
+              ( rectangle
+                ( r.right(), f.y, f.right() - r.right(), f.height ) );
+
+          if ( r.y > f.y )
+            result.push_back( rectangle( f.x, f.y, f.width, r.y - f.y ) );
+
+          if ( r.bottom() < f.bottom() )
+            result.push_back
+              ( rectangle
+                ( f.x, r.bottom(), f.width, f.bottom() - r.bottom() ) );
+        }
+    }
+
+  p.free.clear();
+
+  for ( std::size_t i(0); i != result.size(); ++i )
+    {
+      bool contained( false );
+
+      for ( std::size_t j(0); !contained && ( j != result.size() ); ++j )
+        contained =
+          ( i != j ) && result[j].contains( result[i] )
+          && ( !result[i].contains( result[j] ) || ( j < i ) );
+
+      if ( !contained )
+        p.free.push_back( result[i] );
+    }
+} // atlas_packer::split_free_rectangles()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the path of a page of the atlas, relative to the data directory.
+ * \param i The index of the page.
+ */
+std::string rp::atlas_packer::get_page_name( std::size_t i ) const
+{
+  std::ostringstream oss;
+  oss << m_name << '-' << i << ".png";
+
+  return oss.str();
+} // atlas_packer::get_page_name()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy the blocks of a page, with their margin, in a new image.
+ * \param i The index of the page.
+ */
+rp::rgba_image rp::atlas_packer::render_page( std::size_t i ) const
+{
+  rgba_image result( m_page_width[i], m_page_height[i] );
+
+  for ( std::size_t j(0); j != m_blocks.size(); ++j )
+    if ( m_blocks[j].page == i )
+      {
+        const block& b( m_blocks[j] );
+        const rgba_image& source( m_images[ b.image ].pixels );
+
+        for ( int y(-s_margin); y != b.source.height + s_margin; ++y )
+          for ( int x(-s_margin); x != b.source.width + s_margin; ++x )
+            result.set_pixel
+              ( b.x + x, b.y + y,
+                source.get_pixel( b.source.x + x, b.source.y + y ) );
+      }
+
+  return result;
+} // atlas_packer::render_page()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the smallest power of two greater or equal to a given value.
+ * \param v The value.
+ */
+int rp::atlas_packer::get_power_of_two( int v )
+{
+  int result( 1 );
+
+  while ( result < v )
+    result *= 2;
+
+  return result;
+} // atlas_packer::get_power_of_two()
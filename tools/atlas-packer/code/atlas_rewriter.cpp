@@ -0,0 +1,168 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::atlas_rewriter class.
+ * \author Julien Jorge
+ */
+#include "atlas_rewriter.hpp"
+
+#include <iostream>
+#include <sstream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ */
+rp::atlas_rewriter::atlas_rewriter()
+  : m_rewritten_count( 0 ), m_unmapped_count( 0 )
+{
+
+} // atlas_rewriter::atlas_rewriter()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the blocks of an atlas written by rp::atlas_packer.
+ * \param is The stream from which the atlas is read.
+ */
+bool rp::atlas_rewriter::read_atlas( std::istream& is )
+{
+  std::vector<std::string> pages;
+  std::string line;
+
+  while ( std::getline( is, line ) )
+    {
+      std::istringstream iss( line );
+      std::string kind;
+      iss >> kind;
+
+      if ( kind == "page" )
+        {
+          std::string path;
+
+          if ( !( iss >> path ) )
+            return false;
+
+          pages.push_back( path );
+        }
+      else if ( kind == "block" )
+        {
+          std::string image;
+          std::size_t page;
+          block b;
+
+          if ( !( iss >> image >> b.x >> b.y >> b.width >> b.height >> page
+                  >> b.page_x >> b.page_y )
+               || ( page >= pages.size() ) )
+            return false;
+
+          b.page = pages[page];
+          m_blocks[image].push_back( b );
+        }
+      else if ( !kind.empty() )
+        return false;
+    }
+
+  return true;
+} // atlas_rewriter::read_atlas()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Copy a resource, replacing the references to the packed images.
+ * \param is The stream from which the resource is read.
+ * \param os The stream in which the resource is written.
+ */
+void rp::atlas_rewriter::rewrite( std::istream& is, std::ostream& os )
+{
+  std::vector<std::string> lines;
+  std::string line;
+
+  while ( std::getline( is, line ) )
+    lines.push_back( line );
+
+  for ( std::size_t i(0); i < lines.size(); ++i )
+    {
+      const block_map::const_iterator it( m_blocks.find( lines[i] ) );
+
+      if ( ( it == m_blocks.end() ) || ( i + 4 >= lines.size() ) )
+        {
+          os << lines[i] << '\n';
+          continue;
+        }
+
+      int v[4];
+      bool valid( true );
+
+      for ( std::size_t j(0); valid && ( j != 4 ); ++j )
+        {
+          std::istringstream iss( lines[i + 1 + j] );
+          valid = ( iss >> v[j] ) && iss.eof();
+        }
+
+      const block* b
+        ( valid ? find_block( it->second, v[0], v[1], v[2], v[3] ) : NULL );
+
+      if ( b == NULL )
+        {
+          std::cerr << "Warning: the reference to '" << lines[i]
+                    << "' on line " << ( i + 1 ) << " is in no block."
+                    << std::endl;
+          ++m_unmapped_count;
+          os << lines[i] << '\n';
+        }
+      else
+        {
+          os << b->page << '\n' << ( b->page_x + v[0] - b->x ) << '\n'
+             << ( b->page_y + v[1] - b->y ) << '\n';
+          ++m_rewritten_count;
+          i += 2;
+        }
+    }
+} // atlas_rewriter::rewrite()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of references replaced by rewrite().
+ */
+std::size_t rp::atlas_rewriter::get_rewritten_count() const
+{
+  return m_rewritten_count;
+} // atlas_rewriter::get_rewritten_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the count of references to a packed image which have not been
+ *        replaced by rewrite() because they are in no block.
+ */
+std::size_t rp::atlas_rewriter::get_unmapped_count() const
+{
+  return m_unmapped_count;
+} // atlas_rewriter::get_unmapped_count()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the block containing a rectangle of an image.
+ * \param blocks The blocks of the image.
+ * \param x The left edge of the rectangle.
+ * \param y The top edge of the rectangle.
+ * \param w The width of the rectangle.
+ * \param h The height of the rectangle.
+ * \return The block or NULL if the rectangle is in no block.
+ */
+const rp::atlas_rewriter::block* rp::atlas_rewriter::find_block
+( const std::vector<block>& blocks, int x, int y, int w, int h ) const
+{
+  for ( std::size_t i(0); i != blocks.size(); ++i )
+    if ( ( blocks[i].x <= x ) && ( blocks[i].y <= y )
+         && ( x + w <= blocks[i].x + blocks[i].width )
+         && ( y + h <= blocks[i].y + blocks[i].height ) )
+      return &blocks[i];
+
+  return NULL;
+} // atlas_rewriter::find_block()
@@ -0,0 +1,174 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool packing the images of the themes in texture atlases and
+ *        rewriting the resources to use the atlases.
+ * \author Julien Jorge
+ */
+#include "atlas_packer.hpp"
+#include "atlas_rewriter.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the usage of the program.
+ * \param name The name of the program.
+ */
+static void print_usage( const char* name )
+{
+  std::cerr << "Usage: " << name << " pack [--report] data_dir output_dir"
+            << " atlas_name images... [--references files...]\n"
+            << "       " << name << " rewrite input output atlases...\n"
+            << "\npack copies the parts of the images, relative to data_dir,"
+            << " used by their\n.spritepos files and by the referencing files"
+            << " in the pages of an atlas\nwritten in output_dir, then checks"
+            << " the decoded pages against the images.\n--report prints the"
+            << " count of texels before and after the packing.\n"
+            << "\nrewrite replaces the references to the packed images in"
+            << " input by references\nto the pages of the atlases."
+            << std::endl;
+} // print_usage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pack the images of a theme in an atlas.
+ * \param argc The count of arguments following the "pack" command.
+ * \param argv The arguments following the "pack" command.
+ */
+static int pack( int argc, char* argv[] )
+{
+  bool report( false );
+  int first( 0 );
+
+  if ( ( argc != 0 ) && ( std::strcmp( argv[0], "--report" ) == 0 ) )
+    {
+      report = true;
+      first = 1;
+    }
+
+  if ( argc - first < 4 )
+    return -1;
+
+  rp::atlas_packer packer( argv[first], argv[first + 2] );
+  int i( first + 3 );
+
+  for ( ; ( i != argc ) && ( std::strcmp( argv[i], "--references" ) != 0 );
+        ++i )
+    if ( !packer.add_image( argv[i] ) )
+      return EXIT_FAILURE;
+
+  if ( i != argc )
+    for ( ++i; i != argc; ++i )
+      {
+        std::ifstream f( argv[i] );
+
+        if ( !f )
+          {
+            std::cerr << "Can't read '" << argv[i] << "'." << std::endl;
+            return EXIT_FAILURE;
+          }
+
+        packer.add_references( f );
+      }
+
+  packer.pack();
+
+  if ( !packer.write( argv[first + 1] ) )
+    return EXIT_FAILURE;
+
+  if ( !packer.check( argv[first + 1] ) )
+    {
+      std::cerr << "The atlas '" << argv[first + 2]
+                << "' does not match the images." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  if ( report )
+    packer.print_report( std::cout );
+
+  return EXIT_SUCCESS;
+} // pack()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Replace the references to the packed images in a resource.
+ * \param argc The count of arguments following the "rewrite" command.
+ * \param argv The arguments following the "rewrite" command.
+ */
+static int rewrite( int argc, char* argv[] )
+{
+  if ( argc < 3 )
+    return -1;
+
+  rp::atlas_rewriter rewriter;
+
+  for ( int i(2); i != argc; ++i )
+    {
+      std::ifstream f( argv[i] );
+
+      if ( !f || !rewriter.read_atlas( f ) )
+        {
+          std::cerr << "Can't read the atlas '" << argv[i] << "'."
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+    }
+
+  std::ifstream input( argv[0] );
+
+  if ( !input )
+    {
+      std::cerr << "Can't read '" << argv[0] << "'." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  std::ofstream output( argv[1] );
+  rewriter.rewrite( input, output );
+
+  if ( !output )
+    {
+      std::cerr << "Can't write '" << argv[1] << "'." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+} // rewrite()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Pack the images in an atlas or rewrite a resource.
+ * \param argc The count of arguments.
+ * \param argv The arguments.
+ */
+int main( int argc, char* argv[] )
+{
+  int result( -1 );
+
+  if ( argc >= 2 )
+    {
+      if ( std::strcmp( argv[1], "pack" ) == 0 )
+        result = pack( argc - 2, argv + 2 );
+      else if ( std::strcmp( argv[1], "rewrite" ) == 0 )
+        result = rewrite( argc - 2, argv + 2 );
+    }
+
+  if ( result == -1 )
+    {
+      print_usage( argv[0] );
+      result = EXIT_FAILURE;
+    }
+
+  return result;
+} // main()
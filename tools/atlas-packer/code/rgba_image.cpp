@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::rgba_image class.
+ * \author Julien Jorge
+ */
+#include "rgba_image.hpp"
+
+#include <png.h>
+
+#include <cstring>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor of an empty image.
+ */
+rp::rgba_image::rgba_image()
+  : m_width( 0 ), m_height( 0 )
+{
+
+} // rgba_image::rgba_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor of a transparent image.
+ * \param width The width of the image.
+ * \param height The height of the image.
+ */
+rp::rgba_image::rgba_image( unsigned int width, unsigned int height )
+  : m_width( width ), m_height( height ), m_pixels( width * height, 0 )
+{
+
+} // rgba_image::rgba_image()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read the image from a PNG file.
+ * \param path The path to the file.
+ */
+bool rp::rgba_image::load( const std::string& path )
+{
+  png_image image;
+  std::memset( &image, 0, sizeof( image ) );
+  image.version = PNG_IMAGE_VERSION;
+
+  if ( !png_image_begin_read_from_file( &image, path.c_str() ) )
+    return false;
+
+  image.format = PNG_FORMAT_RGBA;
+  m_width = image.width;
+  m_height = image.height;
+  m_pixels.resize( m_width * m_height );
+
+  if ( !png_image_finish_read( &image, NULL, m_pixels.data(), 0, NULL ) )
+    {
+      png_image_free( &image );
+      return false;
+    }
+
+  return true;
+} // rgba_image::load()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the image in a PNG file.
+ * \param path The path to the file.
+ */
+bool rp::rgba_image::save( const std::string& path ) const
+{
+  png_image image;
+  std::memset( &image, 0, sizeof( image ) );
+  image.version = PNG_IMAGE_VERSION;
+  image.width = m_width;
+  image.height = m_height;
+  image.format = PNG_FORMAT_RGBA;
+
+  return png_image_write_to_file
+    ( &image, path.c_str(), 0, m_pixels.data(), 0, NULL ) != 0;
+} // rgba_image::save()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the width of the image.
+ */
+unsigned int rp::rgba_image::width() const
+{
+  return m_width;
+} // rgba_image::width()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the height of the image.
+ */
+unsigned int rp::rgba_image::height() const
+{
+  return m_height;
+} // rgba_image::height()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get a pixel of the image, transparent if the position is outside the
+ *        image.
+ * \param x The column of the pixel.
+ * \param y The row of the pixel, from the top of the image.
+ */
+uint32_t rp::rgba_image::get_pixel( int x, int y ) const
+{
+  if ( ( x < 0 ) || ( y < 0 ) || ( (unsigned int)x >= m_width )
+       || ( (unsigned int)y >= m_height ) )
+    return 0;
+  else
+    return m_pixels[ y * m_width + x ];
+} // rgba_image::get_pixel()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Set a pixel of the image.
+ * \param x The column of the pixel.
+ * \param y The row of the pixel, from the top of the image.
+ * \param p The value of the pixel.
+ */
+void rp::rgba_image::set_pixel( unsigned int x, unsigned int y, uint32_t p )
+{
+  m_pixels[ y * m_width + x ] = p;
+} // rgba_image::set_pixel()
@@ -0,0 +1,61 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief An image with four bytes per pixel, read from and written to PNG
+ *        files.
+ * \author Julien Jorge
+ */
+#ifndef __RP_RGBA_IMAGE_HPP__
+#define __RP_RGBA_IMAGE_HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief An image with four bytes per pixel, read from and written to PNG
+   *        files.
+   *
+   * The pixels are stored row by row, from the top of the image. The pixels
+   * outside the image are transparent.
+   *
+   * \author Julien Jorge
+   */
+  class rgba_image
+  {
+  public:
+    rgba_image();
+    rgba_image( unsigned int width, unsigned int height );
+
+    bool load( const std::string& path );
+    bool save( const std::string& path ) const;
+
+    unsigned int width() const;
+    unsigned int height() const;
+
+    uint32_t get_pixel( int x, int y ) const;
+    void set_pixel( unsigned int x, unsigned int y, uint32_t p );
+
+  private:
+    /** \brief The width of the image. */
+    unsigned int m_width;
+
+    /** \brief The height of the image. */
+    unsigned int m_height;
+
+    /** \brief The pixels of the image. */
+    std::vector<uint32_t> m_pixels;
+
+  }; // class rgba_image
+} // namespace rp
+
+#endif // __RP_RGBA_IMAGE_HPP__
@@ -0,0 +1,609 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief Implementation of the rp::decoration_baker class.
+ * \author Julien Jorge
+ */
+#include "decoration_baker.hpp"
+
+#include "rp/compiled_level.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param chunk_size The maximum width and height of the chunks.
+ * \param view_width The width of the view used to estimate the count of
+ *        visible items.
+ * \param view_height The height of the view used to estimate the count of
+ *        visible items.
+ */
+rp::decoration_baker::decoration_baker
+( double chunk_size, double view_width, double view_height )
+  : m_chunk_size( chunk_size ), m_view_width( view_width ),
+    m_view_height( view_height ), m_level_width( 0 ), m_level_height( 0 ),
+    m_item_count( 0 ), m_decoration_count( 0 ), m_parsed_end( 0 )
+{
+
+} // decoration_baker::decoration_baker()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a level and group its decorations.
+ * \param is The stream containing the level in the text format.
+ */
+bool rp::decoration_baker::read( std::istream& is )
+{
+  std::string line;
+
+  while ( std::getline( is, line ) )
+    m_tokens.push_back( line );
+
+  if ( !is.eof() )
+    return false;
+
+  // The version, the name, the size, the music, the count of items and the
+  // count of layers.
+  int layer_count;
+
+  if ( ( m_tokens.size() < 9 ) || !get_real( 4, m_level_width )
+       || !get_real( 5, m_level_height ) || !get_integer( 7, m_item_count )
+       || !get_integer( 8, layer_count ) )
+    return false;
+
+  std::size_t p( 9 );
+  m_parsed_end = p;
+
+  for ( int i(0); ( i != layer_count ) && parse_layer( p ); ++i )
+    m_parsed_end = p;
+
+  return true;
+} // decoration_baker::read()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the level with the chunks in place of the decorations.
+ * \param os The stream in which the level is written.
+ */
+void rp::decoration_baker::write( std::ostream& os ) const
+{
+  std::size_t baked( 0 );
+
+  for ( std::size_t i(0); i != m_chunks.size(); ++i )
+    baked += m_chunks[i].decorations.size();
+
+  std::size_t c(0);
+
+  for ( std::size_t i(0); i != m_tokens.size(); )
+    if ( i == 7 )
+      {
+        os << ( m_item_count - baked + m_chunks.size() ) << '\n';
+        ++i;
+      }
+    else if ( ( c != m_chunks.size() )
+              && ( i == m_chunks[c].decorations.front().first ) )
+      {
+        write_chunk( os, m_chunks[c] );
+        i = m_chunks[c].decorations.back().last;
+        ++c;
+      }
+    else
+      {
+        os << m_tokens[i] << '\n';
+        ++i;
+      }
+} // decoration_baker::write()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the count of items and of visible sprites before and after
+ *        the grouping of the decorations.
+ * \param os The stream in which the report is written.
+ */
+void rp::decoration_baker::print_report( std::ostream& os ) const
+{
+  std::size_t baked( 0 );
+  std::size_t largest( 0 );
+
+  for ( std::size_t i(0); i != m_chunks.size(); ++i )
+    {
+      baked += m_chunks[i].decorations.size();
+      largest = std::max( largest, m_chunks[i].decorations.size() );
+    }
+
+  os << m_tokens[3] << ": " << m_decoration_count
+     << " decorations in the decoration layers, " << baked << " baked in "
+     << m_chunks.size() << " chunks of at most " << largest << " sprites.\n"
+     << "  items: " << m_item_count << " -> "
+     << ( m_item_count - baked + m_chunks.size() ) << '\n';
+
+  if ( m_parsed_end != m_tokens.size() - 1 )
+    os << "  the layers starting at value " << m_parsed_end
+       << " are kept unchanged.\n";
+
+  // Move the view across the level, with a step of half its size, and count
+  // the items and the sprites of the decoration layers intersecting the view.
+  const double x_range( std::max( 0.0, m_level_width - m_view_width ) );
+  const double y_range( std::max( 0.0, m_level_height - m_view_height ) );
+
+  std::size_t views( 0 );
+  std::size_t decorations( 0 );
+  std::size_t items( 0 );
+  std::size_t sprites( 0 );
+
+  for ( double y(0); y <= y_range; y += m_view_height / 2 )
+    for ( double x(0); x <= x_range; x += m_view_width / 2 )
+      {
+        ++views;
+
+        for ( std::size_t i(0); i != m_layers.size(); ++i )
+          {
+            const layer& lay( m_layers[i] );
+            box_type view;
+
+            // The smaller layers scroll proportionally to the camera.
+            view.left = ( x_range == 0 ) ? 0
+              : x * std::max( 0.0, lay.width - m_view_width ) / x_range;
+            view.bottom = ( y_range == 0 ) ? 0
+              : y * std::max( 0.0, lay.height - m_view_height ) / y_range;
+            view.right = view.left + m_view_width;
+            view.top = view.bottom + m_view_height;
+
+            decorations += count_visible( lay, view, items, sprites );
+          }
+      }
+
+  if ( views == 0 )
+    return;
+
+  os << "  per view of " << m_view_width << 'x' << m_view_height << ": "
+     << double( decorations ) / views << " decorative items -> "
+     << double( items ) / views << " items rendering "
+     << double( sprites ) / views << " sprites." << std::endl;
+} // decoration_baker::print_report()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse a layer and group its decorations.
+ * \param p (in/out) The index of the first value of the layer, then of the
+ *        value following the layer.
+ * \return false if the layer could not be parsed.
+ */
+bool rp::decoration_baker::parse_layer( std::size_t& p )
+{
+  layer lay;
+
+  if ( ( p + 5 > m_tokens.size() ) || ( m_tokens[p] != "70" )
+       || !get_real( p + 2, lay.width ) || !get_real( p + 3, lay.height ) )
+    return false;
+
+  const bool decoration_layer( m_tokens[p + 1] == "decoration_layer" );
+  const std::size_t chunk_count( m_chunks.size() );
+  const std::size_t decoration_count( m_decoration_count );
+  std::size_t i( p + 5 );
+
+  // The classes of the items that can be referenced by the other items.
+  int class_count;
+
+  if ( ( i < m_tokens.size() ) && ( m_tokens[i] == "30" ) )
+    {
+      if ( !get_integer( i + 1, class_count ) )
+        return false;
+
+      i += 2 + class_count;
+    }
+
+  m_pending.clear();
+
+  while ( ( i < m_tokens.size() )
+          && ( ( m_tokens[i] == "31" ) || ( m_tokens[i] == "32" ) ) )
+    if ( !parse_item( i, decoration_layer, lay ) )
+      {
+        m_chunks.resize( chunk_count );
+        m_decoration_count = decoration_count;
+        return false;
+      }
+
+  close_chunk( lay );
+
+  if ( decoration_layer )
+    m_layers.push_back( lay );
+
+  p = i;
+  return true;
+} // decoration_baker::parse_layer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Parse an item and add it in the current chunk if it is a decoration
+ *        that can be baked.
+ * \param p (in/out) The index of the first value of the item, then of the
+ *        value following the item.
+ * \param decoration_layer Tells if the item is in a decoration layer.
+ * \param lay The layer containing the item.
+ * \return false if the item could not be parsed.
+ */
+bool rp::decoration_baker::parse_item
+( std::size_t& p, bool decoration_layer, layer& lay )
+{
+  const std::size_t first( p );
+  const bool declared( m_tokens[p] == "31" );
+
+  // The code, the class for the items not declared in the layer, then the
+  // fixed flag.
+  p += declared ? 2 : 3;
+
+  while ( ( p < m_tokens.size() ) && ( m_tokens[p] != "31" )
+          && ( m_tokens[p] != "32" ) && ( m_tokens[p] != "70" )
+          && ( m_tokens[p] != "0" ) )
+    if ( !skip_field( p ) )
+      return false;
+
+  if ( p >= m_tokens.size() )
+    return false;
+
+  if ( !decoration_layer )
+    return true;
+
+  decoration d;
+
+  if ( declared || ( m_tokens[first + 1] != "bear::decorative_item" ) )
+    close_chunk( lay );
+  else
+    {
+      ++m_decoration_count;
+
+      if ( read_decoration( first, p, d ) )
+        add_decoration( d, lay );
+      else
+        close_chunk( lay );
+    }
+
+  return true;
+} // decoration_baker::parse_item()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move after a field of an item.
+ * \param p (in/out) The index of the code of the field, then of the value
+ *        following the field.
+ * \return false if the type of the field is not supported.
+ */
+bool rp::decoration_baker::skip_field( std::size_t& p ) const
+{
+  int code;
+
+  if ( !get_integer( p, code ) )
+    return false;
+
+  if ( code != 50 )
+    {
+      // The code, the name, then the value.
+      p += 2;
+      return skip_value( p, code );
+    }
+
+  // The code of the lists, the code of the values, the name, the count of
+  // values, then the values.
+  int value_code;
+  int count;
+
+  if ( !get_integer( p + 1, value_code ) || !get_integer( p + 3, count ) )
+    return false;
+
+  p += 4;
+
+  for ( int i(0); i != count; ++i )
+    if ( !skip_value( p, value_code ) )
+      return false;
+
+  return true;
+} // decoration_baker::skip_field()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Move after a value of a field.
+ * \param p (in/out) The index of the first value, then of the value following
+ *        the field.
+ * \param code The code of the type of the field.
+ * \return false if the type of the field is not supported.
+ */
+bool rp::decoration_baker::skip_value( std::size_t& p, int code ) const
+{
+  switch ( code )
+    {
+      // integer, unsigned integer, real, boolean, string, item.
+    case 40: case 41: case 42: case 43: case 44: case 47:
+      p += 1;
+      break;
+      // sprite: the image, the clip, the opaque rectangle, the size, the
+      // mirror and flip flags, the opacity, the intensities and the angle.
+    case 45:
+      p += 18;
+      break;
+      // font: the file and the size.
+    case 49:
+      p += 2;
+      break;
+      // color: the opacity and the intensities.
+    case 100:
+      p += 4;
+      break;
+    default:
+      return false;
+    }
+
+  return p <= m_tokens.size();
+} // decoration_baker::skip_value()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a decoration that can be baked.
+ * \param first The index of the first value of the item.
+ * \param last The index of the value following the item.
+ * \param d (out) The decoration.
+ * \return false if the item is not a decoration that can be baked.
+ */
+bool rp::decoration_baker::read_decoration
+( std::size_t first, std::size_t last, decoration& d ) const
+{
+  if ( m_tokens[first + 2] != "1" )
+    return false;
+
+  d.first = first;
+  d.last = last;
+  d.sprite = 0;
+  d.box.left = 0;
+  d.box.bottom = 0;
+  d.depth = 0;
+
+  for ( std::size_t p( first + 3 ); p != last; )
+    {
+      const std::string& code( m_tokens[p] );
+      const std::string& name( m_tokens[p + 1] );
+
+      if ( ( code == "42" ) && ( name == "base_item.position.left" ) )
+        {
+          if ( !get_real( p + 2, d.box.left ) )
+            return false;
+        }
+      else if ( ( code == "42" ) && ( name == "base_item.position.bottom" ) )
+        {
+          if ( !get_real( p + 2, d.box.bottom ) )
+            return false;
+        }
+      else if ( ( code == "40" ) && ( name == "base_item.position.depth" ) )
+        {
+          if ( !get_integer( p + 2, d.depth ) )
+            return false;
+        }
+      else if ( ( code == "45" ) && ( name == "item_with_decoration.sprite" ) )
+        d.sprite = p + 2;
+      else
+        return false;
+
+      skip_field( p );
+    }
+
+  double width;
+  double height;
+
+  if ( ( d.sprite == 0 ) || !get_real( d.sprite + 9, width )
+       || !get_real( d.sprite + 10, height ) )
+    return false;
+
+  d.box.right = d.box.left + width;
+  d.box.top = d.box.bottom + height;
+
+  return true;
+} // decoration_baker::read_decoration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a decoration in the current chunk, or in a new chunk if the
+ *        current one would be too large.
+ * \param d The decoration.
+ * \param lay The layer containing the decoration.
+ */
+void rp::decoration_baker::add_decoration( const decoration& d, layer& lay )
+{
+  lay.decorations.push_back( d.box );
+
+  if ( !m_pending.empty() )
+    {
+      box_type box;
+      box.left = std::min( m_pending_box.left, d.box.left );
+      box.bottom = std::min( m_pending_box.bottom, d.box.bottom );
+      box.right = std::max( m_pending_box.right, d.box.right );
+      box.top = std::max( m_pending_box.top, d.box.top );
+
+      if ( ( box.right - box.left <= m_chunk_size )
+           && ( box.top - box.bottom <= m_chunk_size ) )
+        {
+          m_pending.push_back( d );
+          m_pending_box = box;
+          return;
+        }
+
+      close_chunk( lay );
+    }
+
+  m_pending.push_back( d );
+  m_pending_box = d.box;
+} // decoration_baker::add_decoration()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Create a chunk with the pending decorations. A single decoration is
+ *        kept as is.
+ * \param lay The layer containing the decorations.
+ */
+void rp::decoration_baker::close_chunk( layer& lay )
+{
+  if ( m_pending.size() > 1 )
+    {
+      chunk c;
+      c.decorations.swap( m_pending );
+      c.box = m_pending_box;
+
+      lay.chunks.push_back( m_chunks.size() );
+      m_chunks.push_back( c );
+    }
+
+  m_pending.clear();
+} // decoration_baker::close_chunk()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Write the item replacing the decorations of a chunk.
+ * \param os The stream in which the item is written.
+ * \param c The chunk to write.
+ */
+void rp::decoration_baker::write_chunk( std::ostream& os, const chunk& c ) const
+{
+  const std::size_t n( c.decorations.size() );
+
+  os << "32\nrp::decoration_chunk\n1\n"
+     << "42\nbase_item.position.left\n"
+     << compiled_level::format_real( c.box.left ) << '\n'
+     << "42\nbase_item.position.bottom\n"
+     << compiled_level::format_real( c.box.bottom ) << '\n'
+     << "42\nbase_item.size.width\n"
+     << compiled_level::format_real( c.box.right - c.box.left ) << '\n'
+     << "42\nbase_item.size.height\n"
+     << compiled_level::format_real( c.box.top - c.box.bottom ) << '\n';
+
+  os << "50\n45\ndecoration_chunk.sprites\n" << n << '\n';
+
+  for ( std::size_t i(0); i != n; ++i )
+    for ( std::size_t j(0); j != 18; ++j )
+      os << m_tokens[ c.decorations[i].sprite + j ] << '\n';
+
+  os << "50\n42\ndecoration_chunk.left\n" << n << '\n';
+
+  for ( std::size_t i(0); i != n; ++i )
+    os << compiled_level::format_real
+      ( c.decorations[i].box.left - c.box.left ) << '\n';
+
+  os << "50\n42\ndecoration_chunk.bottom\n" << n << '\n';
+
+  for ( std::size_t i(0); i != n; ++i )
+    os << compiled_level::format_real
+      ( c.decorations[i].box.bottom - c.box.bottom ) << '\n';
+
+  os << "50\n40\ndecoration_chunk.depth\n" << n << '\n';
+
+  for ( std::size_t i(0); i != n; ++i )
+    os << c.decorations[i].depth << '\n';
+} // decoration_baker::write_chunk()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Count the decorations of a layer intersecting a view, before and
+ *        after the grouping.
+ * \param lay The layer.
+ * \param view The view in the layer.
+ * \param items (in/out) The count of the chunks intersecting the view, and of
+ *        the decorations intersecting the view which are not in a chunk, is
+ *        added to this value.
+ * \param sprites (in/out) The count of the sprites rendered by these items is
+ *        added to this value.
+ * \return The count of decorations intersecting the view, before the
+ *         grouping.
+ */
+std::size_t rp::decoration_baker::count_visible
+( const layer& lay, const box_type& view, std::size_t& items,
+  std::size_t& sprites ) const
+{
+  std::size_t result( 0 );
+
+  for ( std::size_t i(0); i != lay.decorations.size(); ++i )
+    if ( intersects( lay.decorations[i], view ) )
+      ++result;
+
+  std::size_t baked( 0 );
+
+  for ( std::size_t i(0); i != lay.chunks.size(); ++i )
+    {
+      const chunk& c( m_chunks[ lay.chunks[i] ] );
+
+      if ( intersects( c.box, view ) )
+        {
+          ++items;
+          sprites += c.decorations.size();
+
+          for ( std::size_t j(0); j != c.decorations.size(); ++j )
+            if ( intersects( c.decorations[j].box, view ) )
+              ++baked;
+        }
+    }
+
+  // The decorations which are not in a chunk are still rendered one by one.
+  items += result - baked;
+  sprites += result - baked;
+
+  return result;
+} // decoration_baker::count_visible()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a value as an integer.
+ * \param i The index of the value.
+ * \param v (out) The integer.
+ */
+bool rp::decoration_baker::get_integer( std::size_t i, int& v ) const
+{
+  if ( i >= m_tokens.size() )
+    return false;
+
+  char* end;
+  errno = 0;
+  const long result( std::strtol( m_tokens[i].c_str(), &end, 10 ) );
+
+  if ( m_tokens[i].empty() || ( *end != '\0' ) || ( errno != 0 ) )
+    return false;
+
+  v = result;
+  return true;
+} // decoration_baker::get_integer()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a value as a real number.
+ * \param i The index of the value.
+ * \param v (out) The number.
+ */
+bool rp::decoration_baker::get_real( std::size_t i, double& v ) const
+{
+  if ( i >= m_tokens.size() )
+    return false;
+
+  char* end;
+  v = std::strtod( m_tokens[i].c_str(), &end );
+
+  return !m_tokens[i].empty() && ( *end == '\0' );
+} // decoration_baker::get_real()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if two boxes intersect.
+ * \param a The first box.
+ * \param b The second box.
+ */
+bool rp::decoration_baker::intersects( const box_type& a, const box_type& b )
+{
+  return ( a.left < b.right ) && ( b.left < a.right )
+    && ( a.bottom < b.top ) && ( b.bottom < a.top );
+} // decoration_baker::intersects()
@@ -0,0 +1,122 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool grouping the static decorations of the compiled levels in
+ *        chunks.
+ * \author Julien Jorge
+ */
+#include "decoration_baker.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the usage of the program.
+ * \param name The name of the program.
+ */
+static void print_usage( const char* name )
+{
+  std::cerr << "Usage: " << name
+            << " [--chunk-size=N] [--view=WxH] [--report] input.cl output.cl\n"
+            << "\nReplace the static decorations of the decoration layers by"
+            << " chunks of at most\nN×N pixels (default 1024). --report prints"
+            << " the count of items and the count\nof decorations visible in a"
+            << " view of W×H pixels (default 1280x720) before and\nafter the"
+            << " grouping." << std::endl;
+} // print_usage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if an argument is a given option and get its value.
+ * \param arg The argument.
+ * \param option The option, including the equal sign.
+ * \param value (out) The value of the option.
+ */
+static bool get_option
+( const char* arg, const char* option, const char*& value )
+{
+  const std::size_t length( std::strlen( option ) );
+
+  if ( std::strncmp( arg, option, length ) != 0 )
+    return false;
+
+  value = arg + length;
+  return true;
+} // get_option()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Group the decorations of a level.
+ * \param argc The count of arguments.
+ * \param argv The arguments.
+ */
+int main( int argc, char* argv[] )
+{
+  double chunk_size( 1024 );
+  double view_width( 1280 );
+  double view_height( 720 );
+  bool report( false );
+  const char* files[2] = { NULL, NULL };
+  std::size_t file_count( 0 );
+
+  for ( int i(1); i != argc; ++i )
+    {
+      const char* value;
+
+      if ( get_option( argv[i], "--chunk-size=", value ) )
+        chunk_size = std::atof( value );
+      else if ( get_option( argv[i], "--view=", value ) )
+        {
+          char* end;
+          view_width = std::strtod( value, &end );
+          view_height = ( *end == 'x' ) ? std::atof( end + 1 ) : 0;
+        }
+      else if ( std::strcmp( argv[i], "--report" ) == 0 )
+        report = true;
+      else if ( file_count != 2 )
+        files[ file_count++ ] = argv[i];
+      else
+        file_count = 3;
+    }
+
+  if ( ( file_count != 2 ) || ( chunk_size <= 0 ) || ( view_width <= 0 )
+       || ( view_height <= 0 ) )
+    {
+      print_usage( argv[0] );
+      return EXIT_FAILURE;
+    }
+
+  rp::decoration_baker baker( chunk_size, view_width, view_height );
+  std::ifstream input( files[0] );
+
+  if ( !input || !baker.read( input ) )
+    {
+      std::cerr << "Can't read the level '" << files[0] << "'." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  std::ofstream output( files[1] );
+  baker.write( output );
+
+  if ( !output )
+    {
+      std::cerr << "Can't write '" << files[1] << "'." << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  if ( report )
+    baker.print_report( std::cout );
+
+  return EXIT_SUCCESS;
+} // main()
@@ -0,0 +1,189 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool grouping the static decorations of a compiled level in
+ *        chunks.
+ * \author Julien Jorge
+ */
+#ifndef __RP_DECORATION_BAKER_HPP__
+#define __RP_DECORATION_BAKER_HPP__
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace rp
+{
+  /**
+   * \brief A tool grouping the static decorations of a compiled level in
+   *        chunks.
+   *
+   * The level is read in the text format of the compiled levels, where each
+   * value is on its own line. In the decoration layers, the consecutive
+   * bear::decorative_item which are fixed, have a sprite and no other field
+   * than their position and their depth are replaced by a single
+   * rp::decoration_chunk, as long as the box around the decorations fits in
+   * the size of the chunks. Since the chunk replaces the decorations at their
+   * place in the layer, the decorations are rendered in the same order.
+   *
+   * The layers are parsed until the first field of a type not supported by
+   * the tool; this layer and the next ones are kept unchanged.
+   *
+   * \author Julien Jorge
+   */
+  class decoration_baker
+  {
+  private:
+    /** \brief The type of the values of the level. */
+    typedef std::vector<std::string> token_list;
+
+    /** \brief A rectangle in a layer. */
+    struct box_type
+    {
+      /** \brief The left edge. */
+      double left;
+
+      /** \brief The bottom edge. */
+      double bottom;
+
+      /** \brief The right edge. */
+      double right;
+
+      /** \brief The top edge. */
+      double top;
+
+    }; // struct box_type
+
+    /** \brief A decoration that can be baked. */
+    struct decoration
+    {
+      /** \brief The index of the first value of the item. */
+      std::size_t first;
+
+      /** \brief The index of the value following the item. */
+      std::size_t last;
+
+      /** \brief The index of the first value of the sprite. */
+      std::size_t sprite;
+
+      /** \brief The box of the sprite. */
+      box_type box;
+
+      /** \brief The depth of the decoration. */
+      int depth;
+
+    }; // struct decoration
+
+    /** \brief A group of consecutive decorations replaced by a single
+        item. */
+    struct chunk
+    {
+      /** \brief The decorations of the chunk. */
+      std::vector<decoration> decorations;
+
+      /** \brief The box around the decorations. */
+      box_type box;
+
+    }; // struct chunk
+
+    /** \brief A decoration layer whose items have been parsed. */
+    struct layer
+    {
+      /** \brief The width of the layer. */
+      double width;
+
+      /** \brief The height of the layer. */
+      double height;
+
+      /** \brief The boxes of the decorations that can be baked. */
+      std::vector<box_type> decorations;
+
+      /** \brief The indices, in decoration_baker::m_chunks, of the chunks of
+          the layer. */
+      std::vector<std::size_t> chunks;
+
+    }; // struct layer
+
+  public:
+    decoration_baker
+    ( double chunk_size, double view_width, double view_height );
+
+    bool read( std::istream& is );
+    void write( std::ostream& os ) const;
+    void print_report( std::ostream& os ) const;
+
+  private:
+    bool parse_layer( std::size_t& p );
+    bool parse_item( std::size_t& p, bool decoration_layer, layer& lay );
+    bool skip_field( std::size_t& p ) const;
+    bool skip_value( std::size_t& p, int code ) const;
+    bool read_decoration
+    ( std::size_t first, std::size_t last, decoration& d ) const;
+
+    void add_decoration( const decoration& d, layer& lay );
+    void close_chunk( layer& lay );
+
+    void write_chunk( std::ostream& os, const chunk& c ) const;
+
+    std::size_t count_visible
+    ( const layer& lay, const box_type& view, std::size_t& items,
+      std::size_t& sprites ) const;
+
+    bool get_integer( std::size_t i, int& v ) const;
+    bool get_real( std::size_t i, double& v ) const;
+
+    static bool intersects( const box_type& a, const box_type& b );
+
+  private:
+    /** \brief The maximum width and height of the chunks. */
+    const double m_chunk_size;
+
+    /** \brief The width of the view used to estimate the count of visible
+        items. */
+    const double m_view_width;
+
+    /** \brief The height of the view used to estimate the count of visible
+        items. */
+    const double m_view_height;
+
+    /** \brief The values of the level. */
+    token_list m_tokens;
+
+    /** \brief The width of the level. */
+    double m_level_width;
+
+    /** \brief The height of the level. */
+    double m_level_height;
+
+    /** \brief The count of items announced in the header of the level. */
+    int m_item_count;
+
+    /** \brief The decoration layers parsed in the level. */
+    std::vector<layer> m_layers;
+
+    /** \brief The chunks of decorations. */
+    std::vector<chunk> m_chunks;
+
+    /** \brief The decorations of the chunk being built. */
+    std::vector<decoration> m_pending;
+
+    /** \brief The box around the decorations of the chunk being built. */
+    box_type m_pending_box;
+
+    /** \brief The count of decorations in the decoration layers. */
+    std::size_t m_decoration_count;
+
+    /** \brief The index of the first value that could not be parsed. */
+    std::size_t m_parsed_end;
+
+  }; // class decoration_baker
+} // namespace rp
+
+#endif // __RP_DECORATION_BAKER_HPP__
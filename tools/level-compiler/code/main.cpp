@@ -0,0 +1,357 @@
+/*
+  Copyright (C) 2012 Stuffomatic Ltd. <contact@stuff-o-matic.com>
+
+  All rights reserved.
+
+  See the accompanying license file for details about usage, modification and
+  distribution of this file.
+*/
+/**
+ * \file
+ * \brief A tool converting the compiled levels from the text format to the
+ *        binary format, and comparing the time needed to load each format.
+ * \author Julien Jorge
+ */
+#include "rp/compiled_level.hpp"
+#include "rp/compiled_level_writer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Print the usage of the program.
+ * \param name The name of the program.
+ */
+static void print_usage( const char* name )
+{
+  std::cerr << "Usage: " << name << " input.cl output.clb\n"
+            << "       " << name << " --benchmark [--repeat=N] level.cl...\n"
+            << "\nThe second form converts each level in a temporary file and"
+            << " compares the time\nneeded to read all its values from the text"
+            << " format and from the binary\nformat mapped in memory."
+            << std::endl;
+} // print_usage()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read a level in the text format.
+ * \param file_name The path to the level.
+ * \param writer (out) The converter in which the level is read.
+ */
+static bool read_level
+( const std::string& file_name, rp::compiled_level_writer& writer )
+{
+  std::ifstream f( file_name.c_str() );
+
+  if ( !f )
+    {
+      std::cerr << "Can't open '" << file_name << "'." << std::endl;
+      return false;
+    }
+
+  if ( !writer.read_text( f ) )
+    {
+      std::cerr << "Can't read '" << file_name << "'." << std::endl;
+      return false;
+    }
+
+  if ( writer.get_item_count() != writer.get_declared_item_count() )
+    std::cerr << "Warning: '" << file_name << "' declares "
+              << writer.get_declared_item_count() << " items but "
+              << writer.get_item_count() << " were found." << std::endl;
+
+  return true;
+} // read_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Convert a level from the text format to the binary format.
+ * \param input The path to the level in the text format.
+ * \param output The path to the level in the binary format.
+ */
+static bool compile_level( const std::string& input, const std::string& output )
+{
+  rp::compiled_level_writer writer;
+
+  if ( !read_level( input, writer ) )
+    return false;
+
+  std::ofstream f( output.c_str(), std::ios::binary );
+  writer.write( f );
+
+  if ( !f )
+    {
+      std::cerr << "Can't write '" << output << "'." << std::endl;
+      return false;
+    }
+
+  return true;
+} // compile_level()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read all the values of a level in the text format, as the engine
+ *        does: the file is loaded in memory then each value is extracted with
+ *        the operator of its type.
+ * \param file_name The path to the level.
+ * \param writer The converted level, giving the type of each value.
+ */
+static std::size_t read_text_values
+( const std::string& file_name, const rp::compiled_level_writer& writer )
+{
+  std::ifstream f( file_name.c_str() );
+  std::stringstream content;
+  content << f.rdbuf();
+
+  std::size_t checksum( 0 );
+  std::string s;
+  int integer;
+  double real;
+
+  for ( std::size_t i(0); i != writer.get_value_count(); ++i )
+    switch ( writer.get_kind( i ) )
+      {
+      case rp::compiled_level::integer_value:
+        content >> integer;
+        content.ignore();
+        checksum += integer;
+        break;
+      case rp::compiled_level::real_value:
+        content >> real;
+        content.ignore();
+        checksum += real;
+        break;
+      case rp::compiled_level::string_value:
+        std::getline( content, s );
+        checksum += s.size();
+        break;
+      }
+
+  return checksum;
+} // read_text_values()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Read all the values of a level in the binary format.
+ * \param file_name The path to the level.
+ * \param writer The converted level, giving the type of each value.
+ */
+static std::size_t read_binary_values
+( const std::string& file_name, const rp::compiled_level_writer& writer )
+{
+  rp::compiled_level level( file_name );
+
+  std::size_t checksum( 0 );
+  std::string s;
+  int integer;
+  double real;
+
+  for ( std::size_t i(0); i != writer.get_value_count(); ++i )
+    switch ( writer.get_kind( i ) )
+      {
+      case rp::compiled_level::integer_value:
+        level >> integer;
+        checksum += integer;
+        break;
+      case rp::compiled_level::real_value:
+        level >> real;
+        checksum += real;
+        break;
+      case rp::compiled_level::string_value:
+        level >> s;
+        checksum += s.size();
+        break;
+      }
+
+  return checksum;
+} // read_binary_values()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Check that the binary format gives back the text of each value of
+ *        the text format.
+ * \param text_file The path to the level in the text format.
+ * \param binary_file The path to the level in the binary format.
+ */
+static bool check_values
+( const std::string& text_file, const std::string& binary_file )
+{
+  std::ifstream f( text_file.c_str() );
+  rp::compiled_level level( binary_file );
+
+  if ( !level.is_open() )
+    {
+      std::cerr << "Invalid binary level '" << binary_file << "'."
+                << std::endl;
+      return false;
+    }
+
+  std::string expected;
+  std::string value;
+  std::size_t i(0);
+
+  while ( std::getline( f, expected ) )
+    {
+      if ( !( level >> value ) || ( value != expected ) )
+        {
+          std::cerr << text_file << ": value " << i << " is '" << value
+                    << "' instead of '" << expected << "'." << std::endl;
+          return false;
+        }
+
+      ++i;
+    }
+
+  if ( i != level.get_value_count() )
+    {
+      std::cerr << text_file << ": " << level.get_value_count()
+                << " values in the binary format, " << i << " expected."
+                << std::endl;
+      return false;
+    }
+
+  return true;
+} // check_values()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the size of a file.
+ * \param file_name The path to the file.
+ */
+static std::size_t get_file_size( const std::string& file_name )
+{
+  std::ifstream f( file_name.c_str(), std::ios::binary | std::ios::ate );
+  return f.tellg();
+} // get_file_size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Compare the time needed to read the levels in the text format and in
+ *        the binary format.
+ * \param files The paths to the levels in the text format.
+ * \param repeat How many times each level is read.
+ */
+static bool benchmark
+( const std::vector<std::string>& files, std::size_t repeat )
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  const std::string binary_file( "rp-level-compiler-benchmark.clb" );
+
+  bool result( true );
+  std::size_t checksum( 0 );
+  std::size_t total_text_size( 0 );
+  std::size_t total_binary_size( 0 );
+  std::size_t total_values( 0 );
+  std::size_t total_strings( 0 );
+  std::size_t total_items( 0 );
+  clock_type::duration text_duration( clock_type::duration::zero() );
+  clock_type::duration binary_duration( clock_type::duration::zero() );
+
+  for ( std::size_t i(0); result && ( i != files.size() ); ++i )
+    {
+      rp::compiled_level_writer writer;
+
+      result = read_level( files[i], writer )
+        && compile_level( files[i], binary_file )
+        && check_values( files[i], binary_file );
+
+      if ( !result )
+        break;
+
+      total_text_size += get_file_size( files[i] );
+      total_binary_size += get_file_size( binary_file );
+      total_values += writer.get_value_count();
+      total_strings += writer.get_string_count();
+      total_items += writer.get_item_count();
+
+      clock_type::time_point start( clock_type::now() );
+
+      for ( std::size_t j(0); j != repeat; ++j )
+        checksum += read_text_values( files[i], writer );
+
+      text_duration += clock_type::now() - start;
+      start = clock_type::now();
+
+      for ( std::size_t j(0); j != repeat; ++j )
+        checksum -= read_binary_values( binary_file, writer );
+
+      binary_duration += clock_type::now() - start;
+    }
+
+  std::remove( binary_file.c_str() );
+
+  if ( !result )
+    return false;
+
+  if ( checksum != 0 )
+    std::cerr << "Warning: the values read from the two formats differ."
+              << std::endl;
+
+  typedef std::chrono::duration<double, std::milli> milliseconds;
+  const double text_ms
+    ( milliseconds( text_duration ).count() / repeat );
+  const double binary_ms
+    ( milliseconds( binary_duration ).count() / repeat );
+
+  std::cout << files.size() << " levels, " << total_values << " values, "
+            << total_strings << " distinct strings, " << total_items
+            << " items.\n"
+            << "text:   " << total_text_size << " bytes, " << text_ms
+            << " ms per load of all the levels.\n"
+            << "binary: " << total_binary_size << " bytes, " << binary_ms
+            << " ms per load of all the levels.\n";
+
+  if ( binary_ms > 0 )
+    std::cout << "speedup: " << text_ms / binary_ms << std::endl;
+
+  return true;
+} // benchmark()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Convert a level or compare the loading of the formats.
+ * \param argc The count of arguments.
+ * \param argv The arguments.
+ */
+int main( int argc, char* argv[] )
+{
+  if ( ( argc > 1 ) && ( std::strcmp( argv[1], "--benchmark" ) == 0 ) )
+    {
+      std::size_t repeat( 20 );
+      std::vector<std::string> files;
+      const char* const repeat_option( "--repeat=" );
+
+      for ( int i(2); i != argc; ++i )
+        if ( std::strncmp
+             ( argv[i], repeat_option, std::strlen( repeat_option ) ) == 0 )
+          repeat = std::max
+            ( 1L, std::atol( argv[i] + std::strlen( repeat_option ) ) );
+        else
+          files.push_back( argv[i] );
+
+      if ( files.empty() )
+        {
+          print_usage( argv[0] );
+          return EXIT_FAILURE;
+        }
+
+      return benchmark( files, repeat ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  else if ( argc == 3 )
+    return compile_level( argv[1], argv[2] ) ? EXIT_SUCCESS : EXIT_FAILURE;
+  else
+    {
+      print_usage( argv[0] );
+      return EXIT_FAILURE;
+    }
+} // main()